@@ -8,3 +8,4 @@
 #include "common/metaprogramming.hpp"
 #include "common/stream.hpp"
 #include "common/string.hpp"
+#include "common/ThreadPool.hpp"
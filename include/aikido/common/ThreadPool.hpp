@@ -0,0 +1,102 @@
+#ifndef AIKIDO_COMMON_THREADPOOL_HPP_
+#define AIKIDO_COMMON_THREADPOOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace aikido {
+namespace common {
+
+/// ThreadPool executes tasks on a fixed number of worker threads. Tasks are
+/// executed in the order they are submitted.
+///
+/// \code
+/// ThreadPool pool(4);
+///
+/// auto future = pool.submit([]() { return 42; });
+/// future.get(); // 42
+///
+/// // The destructor of ThreadPool waits for all submitted tasks.
+/// \endcode
+class ThreadPool final
+{
+public:
+  /// Constructs a pool and starts its worker threads.
+  /// \param[in] numThreads Number of worker threads. If zero, the number of
+  /// concurrent threads supported by the hardware is used.
+  explicit ThreadPool(std::size_t numThreads = 0u);
+
+  /// Waits for all submitted tasks to finish and stops the worker threads.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// Returns the number of worker threads.
+  std::size_t getNumThreads() const;
+
+  /// Submits a task for execution on one of the worker threads.
+  /// \param[in] task Callable that takes no arguments.
+  /// \return Future that holds the return value of the task, or the exception
+  /// thrown by it.
+  template <typename Task>
+  std::future<typename std::result_of<Task()>::type> submit(Task&& task);
+
+  /// Calls function(index, worker) once for each index in [0, numIndices).
+  /// The indices are distributed dynamically between the calling thread and
+  /// up to getNumThreads() tasks submitted to this pool. The argument worker,
+  /// in [0, getNumThreads()], identifies the calling thread (zero) or the task
+  /// that processes an index, so per-worker data can be kept in an array of
+  /// getNumThreads() + 1 elements.
+  ///
+  /// Returns once every index has been processed. Since the calling thread
+  /// processes indices too, this may be called from a task of the same pool.
+  /// If function throws, the indices that have not been started are skipped
+  /// and the first exception is rethrown.
+  /// \param[in] numIndices Number of indices.
+  /// \param[in] function Callable that takes the index and the worker.
+  template <typename Function>
+  void parallelFor(std::size_t numIndices, const Function& function);
+
+private:
+  /// Adds a task to the queue and wakes up one of the worker threads.
+  void enqueue(std::function<void()> task);
+
+  /// The loop function that is executed by each worker thread.
+  void spin();
+
+private:
+  /// Tasks that have not been started yet.
+  std::deque<std::function<void()>> mTasks;
+
+  /// Protects mTasks and mIsRunning.
+  std::mutex mMutex;
+
+  /// Signaled when a task is added or the pool is stopped.
+  std::condition_variable mCondition;
+
+  /// Flag whether the worker threads keep waiting for new tasks.
+  bool mIsRunning;
+
+  /// Worker threads.
+  std::vector<std::thread> mThreads;
+};
+
+using ThreadPoolPtr = std::shared_ptr<ThreadPool>;
+
+} // namespace common
+} // namespace aikido
+
+#include <aikido/common/detail/ThreadPool-impl.hpp>
+
+#endif // AIKIDO_COMMON_THREADPOOL_HPP_
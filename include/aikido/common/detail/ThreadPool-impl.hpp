@@ -0,0 +1,91 @@
+namespace aikido {
+namespace common {
+
+//==============================================================================
+template <typename Task>
+std::future<typename std::result_of<Task()>::type> ThreadPool::submit(
+    Task&& task)
+{
+  using ResultType = typename std::result_of<Task()>::type;
+
+  // std::function requires a copyable target, so the packaged_task is shared.
+  auto packagedTask = std::make_shared<std::packaged_task<ResultType()>>(
+      std::forward<Task>(task));
+  auto future = packagedTask->get_future();
+
+  enqueue([packagedTask]() { (*packagedTask)(); });
+
+  return future;
+}
+
+//==============================================================================
+template <typename Function>
+void ThreadPool::parallelFor(std::size_t numIndices, const Function& function)
+{
+  if (numIndices == 0u)
+    return;
+
+  // Shared between the calling thread and the submitted tasks. A task may
+  // start after this function returns, in which case it finds no index left
+  // to claim and only touches this context.
+  struct Context
+  {
+    std::atomic<std::size_t> mNextIndex;
+    std::atomic<bool> mIsCancelled;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::size_t mNumFinishedIndices;
+    std::exception_ptr mException;
+  };
+
+  const auto context = std::make_shared<Context>();
+  context->mNextIndex = 0u;
+  context->mIsCancelled = false;
+  context->mNumFinishedIndices = 0u;
+
+  // function is only called for a claimed index, i.e. before this function
+  // returns, so it is safe to refer to it from the tasks.
+  const auto processIndices = [context, numIndices, &function](
+      std::size_t worker) {
+    std::size_t index;
+    while ((index = context->mNextIndex++) < numIndices)
+    {
+      std::exception_ptr exception;
+      if (!context->mIsCancelled.load())
+      {
+        try
+        {
+          function(index, worker);
+        }
+        catch (...)
+        {
+          exception = std::current_exception();
+          context->mIsCancelled = true;
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(context->mMutex);
+      if (exception && !context->mException)
+        context->mException = exception;
+
+      if (++context->mNumFinishedIndices == numIndices)
+        context->mCondition.notify_all();
+    }
+  };
+
+  const auto numTasks = std::min(getNumThreads(), numIndices - 1);
+  for (std::size_t i = 0; i < numTasks; ++i)
+    submit(std::bind(processIndices, i + 1));
+
+  processIndices(0u);
+
+  std::unique_lock<std::mutex> lock(context->mMutex);
+  context->mCondition.wait(
+      lock, [&]() { return context->mNumFinishedIndices == numIndices; });
+
+  if (context->mException)
+    std::rethrow_exception(context->mException);
+}
+
+} // namespace common
+} // namespace aikido
@@ -1,6 +1,19 @@
 namespace aikido {
 namespace common {
 
+//==============================================================================
+template <std::size_t N, std::size_t... Indices>
+struct make_index_sequence : make_index_sequence<N - 1, N - 1, Indices...>
+{
+};
+
+//==============================================================================
+template <std::size_t... Indices>
+struct make_index_sequence<0, Indices...>
+{
+  using type = index_sequence<Indices...>;
+};
+
 //==============================================================================
 template <class Pointee>
 struct DynamicCastFactory_shared_ptr
@@ -1,6 +1,7 @@
 #ifndef AIKIDO_COMMON_METAPROGRAMMING_HPP_
 #define AIKIDO_COMMON_METAPROGRAMMING_HPP_
 
+#include <cstddef>
 #include <memory>
 
 namespace aikido {
@@ -14,6 +15,22 @@ class type_list
 {
 };
 
+/// Compile-time sequence of indices, equivalent to C++14's
+/// \c std::index_sequence.
+///
+/// \tparam Indices... list of indices
+template <std::size_t... Indices>
+struct index_sequence
+{
+};
+
+/// Generates an \c index_sequence of the indices 0, 1, ..., N - 1 as the
+/// member type \c type, equivalent to C++14's \c std::make_index_sequence.
+///
+/// \tparam N length of the sequence
+template <std::size_t N, std::size_t... Indices>
+struct make_index_sequence;
+
 /// Call a template factory function based on runtime type of the first
 /// argument to a function. This class has a \c create function that takes
 /// a pointer to \c BaseParameter as its first parameter, optionally followed
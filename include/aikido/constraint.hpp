@@ -1,17 +1,21 @@
 #include "constraint/CartesianProductProjectable.hpp"
 #include "constraint/CartesianProductSampleable.hpp"
 #include "constraint/CartesianProductTestable.hpp"
+#include "constraint/CollisionClearance.hpp"
 #include "constraint/CollisionFree.hpp"
 #include "constraint/CyclicSampleable.hpp"
 #include "constraint/Differentiable.hpp"
 #include "constraint/DifferentiableIntersection.hpp"
 #include "constraint/DifferentiableSubspace.hpp"
+#include "constraint/DistanceTestable.hpp"
 #include "constraint/FiniteSampleable.hpp"
 #include "constraint/FrameDifferentiable.hpp"
 #include "constraint/FramePairDifferentiable.hpp"
 #include "constraint/FrameTestable.hpp"
 #include "constraint/InverseKinematicsSampleable.hpp"
+#include "constraint/InverseKinematicsSeedDatabase.hpp"
 #include "constraint/JointStateSpaceHelpers.hpp"
+#include "constraint/LevenbergMarquardtProjectable.hpp"
 #include "constraint/NewtonsMethodProjectable.hpp"
 #include "constraint/Projectable.hpp"
 #include "constraint/RejectionSampleable.hpp"
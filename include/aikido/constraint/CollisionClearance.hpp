@@ -0,0 +1,153 @@
+#ifndef AIKIDO_CONSTRAINT_COLLISIONCLEARANCE_HPP_
+#define AIKIDO_CONSTRAINT_COLLISIONCLEARANCE_HPP_
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include <dart/collision/CollisionDetector.hpp>
+#include <dart/collision/CollisionGroup.hpp>
+#include <dart/collision/DistanceFilter.hpp>
+#include <dart/collision/DistanceOption.hpp>
+#include "../statespace/dart/MetaSkeletonStateSpace.hpp"
+#include "../statespace/dart/SkeletonReplicaPool.hpp"
+#include "DistanceTestable.hpp"
+
+namespace aikido {
+namespace constraint {
+
+/// A distance testable that uses the distance queries of a collision detector
+/// to compute the minimum distance between and within specified collision
+/// groups. A metaskeleton state satisfies this constraint if the minimum
+/// distance is positive.
+///
+/// Distance queries are more expensive than collision queries, but the
+/// clearance lets edge checkers skip portions of edges that are provably
+/// collision-free. Not every collision detector supports distance queries,
+/// e.g. \c dart::collision::FCLCollisionDetector does.
+///
+/// The displacement bound holds for each body separately, so two bodies that
+/// both move with the state may approach each other twice as fast. The
+/// clearance is therefore half the distance for self checks and for pairwise
+/// checks between groups that both contain bodies of the state space's
+/// skeletons, and the full distance for checks against static groups.
+class CollisionClearance : public DistanceTestable
+{
+public:
+  /// Constructs an empty constraint that uses \c _collisionDetector to compute
+  /// distances. You should call \c addPairwiseCheck and \c addSelfCheck to
+  /// register distance checks before calling \c getClearance.
+  ///
+  /// \param _statespace state space on which the constraint operates
+  /// \param _collisionDetector collision detector used to compute distances
+  /// \param _maxDisplacementPerDistance upper bound on the distance that any
+  ///        point of the collision groups moves in the workspace per unit of
+  ///        distance in \c _statespace, e.g. the distance from the first
+  ///        joint to the farthest point of a serial manipulator
+  /// \param _distanceOptions options passed to \c _collisionDetector
+  CollisionClearance(
+      statespace::dart::MetaSkeletonStateSpacePtr _statespace,
+      std::shared_ptr<dart::collision::CollisionDetector> _collisionDetector,
+      double _maxDisplacementPerDistance,
+      dart::collision::DistanceOption _distanceOptions
+      = dart::collision::DistanceOption(
+          false,
+          0.,
+          std::make_shared<dart::collision::BodyNodeDistanceFilter>()));
+
+  // Documentation inherited.
+  statespace::StateSpacePtr getStateSpace() const override;
+
+  /// Returns the minimum clearance of all registered checks, or infinity if
+  /// no check is registered.
+  ///
+  /// \param _state state in \c getStateSpace()
+  /// \return minimum distance between the registered collision groups, halved
+  ///         for checks between moving bodies
+  double getClearance(
+      const statespace::StateSpace::State* _state) const override;
+
+  // Documentation inherited.
+  double getMaxDisplacementPerDistance() const override;
+
+  /// Computes the distance between group1 and group2.
+  /// \param group1 First collision group.
+  /// \param group2 Second collision group.
+  void addPairwiseCheck(
+      std::shared_ptr<dart::collision::CollisionGroup> _group1,
+      std::shared_ptr<dart::collision::CollisionGroup> _group2);
+
+  /// Remove distance check between group1 and group2.
+  /// \param group1 First collision group.
+  /// \param group2 Second collision group.
+  void removePairwiseCheck(
+      std::shared_ptr<dart::collision::CollisionGroup> _group1,
+      std::shared_ptr<dart::collision::CollisionGroup> _group2);
+
+  /// Computes the distance within group.
+  /// \param group Collision group.
+  void addSelfCheck(std::shared_ptr<dart::collision::CollisionGroup> _group);
+
+  /// Remove distance check within group.
+  /// \param group Collision group.
+  void removeSelfCheck(std::shared_ptr<dart::collision::CollisionGroup> _group);
+
+  /// Sets the pool of skeleton replicas used by \c getClearance. If
+  /// \c _skeletonReplicaPool is not \c nullptr, \c getClearance sets the
+  /// state and computes distances on the replica of the calling thread, so it
+  /// may be called concurrently from multiple threads. Otherwise, it uses the
+  /// \c MetaSkeleton of the state space and the collision groups directly,
+  /// and must not be called concurrently.
+  ///
+  /// The distance filter of the options is consulted with the original
+  /// <tt>BodyNode</tt>s of each replica, see
+  /// \c SkeletonReplica::getDistanceFilter.
+  ///
+  /// \param _skeletonReplicaPool pool that replicates every skeleton of the
+  ///        state space, or \c nullptr
+  void setSkeletonReplicaPool(
+      statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool);
+
+  /// Gets the pool of skeleton replicas used by \c getClearance.
+  ///
+  /// \return pool of skeleton replicas, or \c nullptr if none is used
+  statespace::dart::SkeletonReplicaPoolPtr getSkeletonReplicaPool() const;
+
+private:
+  using CollisionGroup = dart::collision::CollisionGroup;
+
+  /// Returns whether \c _group contains a body of a skeleton that moves with
+  /// the state.
+  bool isMoving(const CollisionGroup& _group) const;
+
+  /// Computes the minimum clearance of all registered checks in the current
+  /// state of the skeletons. If \c _replica is not \c nullptr, its replica
+  /// of each collision group is used.
+  ///
+  /// \param _collisionDetector collision detector of the collision groups
+  /// \param _replica replica of the skeletons, or \c nullptr
+  double computeClearance(
+      dart::collision::CollisionDetector* _collisionDetector,
+      statespace::dart::SkeletonReplica* _replica) const;
+
+  std::shared_ptr<aikido::statespace::dart::MetaSkeletonStateSpace> mStatespace;
+  std::shared_ptr<dart::collision::CollisionDetector> mCollisionDetector;
+  double mMaxDisplacementPerDistance;
+  dart::collision::DistanceOption mDistanceOptions;
+
+  /// Skeletons of the degrees of freedom of \c mStatespace.
+  std::unordered_set<const dart::dynamics::Skeleton*> mMovingSkeletons;
+
+  std::vector<std::pair<std::shared_ptr<CollisionGroup>,
+                        std::shared_ptr<CollisionGroup>>>
+      mGroupsToPairwiseCheck;
+  std::vector<std::shared_ptr<CollisionGroup>> mGroupsToSelfCheck;
+
+  statespace::dart::SkeletonReplicaPoolPtr mSkeletonReplicaPool;
+};
+
+using CollisionClearancePtr = std::shared_ptr<CollisionClearance>;
+
+} // namespace constraint
+} // namespace aikido
+
+#endif // AIKIDO_CONSTRAINT_COLLISIONCLEARANCE_HPP_
@@ -1,14 +1,19 @@
 #ifndef AIKIDO_CONSTRAINT_COLLISIONFREE_HPP_
 #define AIKIDO_CONSTRAINT_COLLISIONFREE_HPP_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <vector>
 #include <dart/collision/CollisionDetector.hpp>
 #include <dart/collision/CollisionFilter.hpp>
 #include <dart/collision/CollisionGroup.hpp>
 #include <dart/collision/CollisionOption.hpp>
+#include "../common/ThreadPool.hpp"
 #include "../statespace/dart/MetaSkeletonStateSpace.hpp"
+#include "../statespace/dart/SkeletonReplicaPool.hpp"
 #include "Testable.hpp"
 
 namespace aikido {
@@ -20,6 +25,33 @@ namespace constraint {
 class CollisionFree : public Testable
 {
 public:
+  /// Statistics of a registered collision check, collected by
+  /// \c isSatisfied.
+  struct CheckStatistics
+  {
+    /// First collision group of the check.
+    std::shared_ptr<dart::collision::CollisionGroup> mGroup1;
+
+    /// Second collision group of a pairwise check, or \c nullptr for a
+    /// self-collision check.
+    std::shared_ptr<dart::collision::CollisionGroup> mGroup2;
+
+    /// Number of times the check was evaluated. A check that is cancelled
+    /// because another check found a collision is not counted.
+    std::size_t mNumEvaluations;
+
+    /// Number of evaluations that found a collision.
+    std::size_t mNumCollisions;
+
+    /// Total time spent evaluating the check. This is only measured while
+    /// timing is enabled with \c setCheckTimingEnabled.
+    std::chrono::duration<double> mTotalTime;
+  };
+
+  /// Number of states evaluated by \c isSatisfied between updates of the
+  /// adaptive order.
+  static constexpr std::size_t ADAPTIVE_ORDERING_PERIOD = 16u;
+
   /// Constructs an empty constraint that uses \c _collisionDetector to test
   /// for collision. You should call \c addPairWiseCheck and \c addSelfCheck
   /// to register collision checks before calling \c isSatisfied.
@@ -43,9 +75,37 @@ public:
   bool isSatisfied(
       const aikido::statespace::StateSpace::State* _state) const override;
 
-  /// Checks collision between group1 and group2.
+  /// Tests every state of \c _states. If a thread pool is set with
+  /// \c setThreadPool, the states are distributed between the calling thread
+  /// and the threads of the pool, each of which evaluates all checks of a
+  /// state on its own replica. With \c _earlyExit, the states after the first
+  /// state in collision are skipped.
+  ///
+  /// \param _states states in \c getStateSpace()
+  /// \param[out] _out result of each state, resized to the number of states
+  /// \param _earlyExit whether to stop at the first state in collision
+  /// \return true if no state is in collision
+  bool isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& _states,
+      std::vector<bool>& _out,
+      bool _earlyExit) const override;
+
+  /// Tests every state of \c _states. If a thread pool is set with
+  /// \c setThreadPool, the states are distributed between the calling thread
+  /// and the threads of the pool as in \c isSatisfiedBatch, but all threads
+  /// stop as soon as any state is found in collision.
+  ///
+  /// \param _states states in \c getStateSpace()
+  /// \return true if no state is in collision
+  bool areAllSatisfied(const std::vector<const statespace::StateSpace::State*>&
+                           _states) const override;
+
+  /// Checks collision between group1 and group2. Unless adaptive ordering is
+  /// enabled, pairwise checks are evaluated before self-collision checks, in
+  /// the order they were added.
   /// \param group1 First collision group.
   /// \param group2 Second collision group.
+  /// \throws std::invalid_argument if either group is \c nullptr
   void addPairwiseCheck(
       std::shared_ptr<dart::collision::CollisionGroup> _group1,
       std::shared_ptr<dart::collision::CollisionGroup> _group2);
@@ -57,24 +117,209 @@ public:
       std::shared_ptr<dart::collision::CollisionGroup> _group1,
       std::shared_ptr<dart::collision::CollisionGroup> _group2);
 
-  /// Checks collision within group.
+  /// Checks collision within group. Unless adaptive ordering is enabled,
+  /// self-collision checks are evaluated after pairwise checks, in the order
+  /// they were added.
   /// \param group Collision group.
+  /// \throws std::invalid_argument if \c _group is \c nullptr
   void addSelfCheck(std::shared_ptr<dart::collision::CollisionGroup> _group);
 
   /// Remove self-collision check within group.
   /// \param group Collision group.
   void removeSelfCheck(std::shared_ptr<dart::collision::CollisionGroup> _group);
 
+  /// Sets the pool of skeleton replicas used by \c isSatisfied. If
+  /// \c _skeletonReplicaPool is not \c nullptr, \c isSatisfied sets the state
+  /// and checks collision on the replica of the calling thread, so it may be
+  /// called concurrently from multiple threads. Otherwise, it uses the
+  /// \c MetaSkeleton of the state space and the collision groups directly.
+  ///
+  /// The collision filter of the options is consulted with the original
+  /// <tt>BodyNode</tt>s of each replica, see
+  /// \c SkeletonReplica::getCollisionFilter.
+  ///
+  /// \param _skeletonReplicaPool pool that replicates every skeleton of the
+  ///        state space, or \c nullptr
+  void setSkeletonReplicaPool(
+      statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool);
+
+  /// Gets the pool of skeleton replicas used by \c isSatisfied.
+  ///
+  /// \return pool of skeleton replicas, or \c nullptr if none is used
+  statespace::dart::SkeletonReplicaPoolPtr getSkeletonReplicaPool() const;
+
+  /// Sets the thread pool used by \c isSatisfied. If \c _threadPool is not
+  /// \c nullptr, the registered collision checks are distributed between the
+  /// calling thread and the threads of \c _threadPool. As soon as one check
+  /// finds a collision, the checks that have not been started are cancelled.
+  /// Each thread checks collision on its own replica, so a skeleton replica
+  /// pool must be set with \c setSkeletonReplicaPool as well.
+  ///
+  /// \param _threadPool thread pool, or \c nullptr to evaluate the checks
+  ///        sequentially on the calling thread
+  void setThreadPool(common::ThreadPoolPtr _threadPool);
+
+  /// Gets the thread pool used by \c isSatisfied.
+  ///
+  /// \return thread pool, or \c nullptr if the checks are evaluated
+  ///         sequentially
+  common::ThreadPoolPtr getThreadPool() const;
+
+  /// Gets the statistics of the registered collision checks, e.g. to find the
+  /// pair of collision groups that dominates the time spent in
+  /// \c isSatisfied.
+  ///
+  /// \return statistics of each registered check
+  std::vector<CheckStatistics> getCheckStatistics() const;
+
+  /// Resets the statistics of all registered collision checks. If adaptive
+  /// ordering is enabled, the checks are evaluated in the default order until
+  /// new statistics are collected.
+  void resetCheckStatistics();
+
+  /// Sets whether \c isSatisfied measures the time spent in each collision
+  /// check. This is disabled by default, since reading the clock twice per
+  /// check is a significant overhead for cheap checks. The number of
+  /// evaluations and collisions of each check is always counted.
+  ///
+  /// \param _enabled whether to measure the time of each check
+  void setCheckTimingEnabled(bool _enabled);
+
+  /// Returns whether \c isSatisfied measures the time spent in each collision
+  /// check.
+  ///
+  /// \return true if timing is enabled
+  bool isCheckTimingEnabled() const;
+
+  /// Sets whether \c isSatisfied evaluates the registered checks in an
+  /// adaptive, fail-first order. If enabled, the checks are sorted every
+  /// \c ADAPTIVE_ORDERING_PERIOD states by their observed collision
+  /// probability, divided by their mean
+  /// evaluation time if timing is enabled, so the check most likely to
+  /// cheaply find a collision runs first. This reduces the time spent on
+  /// states that are in collision, which dominate rejection sampling and tree
+  /// extension. Otherwise, pairwise checks are evaluated before
+  /// self-collision checks.
+  ///
+  /// \param _adaptiveOrdering whether to enable adaptive ordering
+  void setAdaptiveOrdering(bool _adaptiveOrdering);
+
+  /// Returns whether the registered checks are evaluated in an adaptive,
+  /// fail-first order.
+  ///
+  /// \return true if adaptive ordering is enabled
+  bool isAdaptiveOrdering() const;
+
 private:
   using CollisionGroup = dart::collision::CollisionGroup;
 
+  /// Registered collision check. Its statistics are updated concurrently by
+  /// \c isSatisfied, so they are stored in atomic counters.
+  struct Check
+  {
+    Check(
+        std::shared_ptr<CollisionGroup> _group1,
+        std::shared_ptr<CollisionGroup> _group2);
+
+    std::shared_ptr<CollisionGroup> mGroup1;
+    std::shared_ptr<CollisionGroup> mGroup2;
+    std::atomic<std::size_t> mNumEvaluations;
+    std::atomic<std::size_t> mNumCollisions;
+
+    /// Total time spent evaluating the check, in ticks of
+    /// \c std::chrono::steady_clock.
+    std::atomic<std::chrono::steady_clock::rep> mTotalTime;
+  };
+
+  /// Evaluates the registered checks on the calling thread.
+  ///
+  /// \param _collisionDetector collision detector of the groups
+  /// \param _replica replica of the skeletons, or \c nullptr
+  /// \return true if no group is in collision
+  bool isCollisionFree(
+      dart::collision::CollisionDetector* _collisionDetector,
+      statespace::dart::SkeletonReplica* _replica) const;
+
+  /// Evaluates the registered checks on the calling thread and the threads
+  /// of \c mThreadPool.
+  ///
+  /// \param _state state to check
+  /// \return true if no group is in collision
+  bool isCollisionFreeParallel(
+      const statespace::dart::MetaSkeletonStateSpace::State* _state) const;
+
+  /// Gets a snapshot of the statistics of \c _check.
+  ///
+  /// \param _check registered check
+  /// \return statistics of \c _check
+  static CheckStatistics getStatistics(const Check& _check);
+
+  /// Evaluates a single registered check and updates its statistics. If
+  /// \c _replica is not \c nullptr, its replica of each collision group is
+  /// checked instead.
+  ///
+  /// \param _index index of the check
+  /// \param _collisionDetector collision detector of the groups
+  /// \param _replica replica of the skeletons, or \c nullptr
+  /// \return true if the check found no collision
+  bool isCheckCollisionFree(
+      std::size_t _index,
+      dart::collision::CollisionDetector* _collisionDetector,
+      statespace::dart::SkeletonReplica* _replica) const;
+
+  /// Gets the order in which the checks are evaluated. If adaptive ordering
+  /// is enabled, the returned order is kept alive by \c _adaptiveCheckOrder,
+  /// so it remains valid while the order is updated concurrently.
+  ///
+  /// \param[out] _adaptiveCheckOrder adaptive order, or \c nullptr
+  /// \return indices of the checks in evaluation order
+  const std::vector<std::size_t>& getCheckOrder(
+      std::shared_ptr<const std::vector<std::size_t>>& _adaptiveCheckOrder)
+      const;
+
+  /// Counts a state evaluated by \c isSatisfied and updates the adaptive
+  /// order every \c ADAPTIVE_ORDERING_PERIOD states.
+  void countEvaluatedState() const;
+
+  /// Sorts a copy of mCheckOrder by decreasing fail-first score and publishes
+  /// it as mAdaptiveCheckOrder. mStatisticsMutex must be locked by the
+  /// caller.
+  void updateCheckOrder() const;
+
+  /// Rebuilds mCheckOrder in the default order, with pairwise checks before
+  /// self-collision checks, and resets the adaptive order.
+  /// mStatisticsMutex must be locked by the caller.
+  void initializeCheckOrder();
+
   std::shared_ptr<aikido::statespace::dart::MetaSkeletonStateSpace> mStatespace;
   std::shared_ptr<dart::collision::CollisionDetector> mCollisionDetector;
   dart::collision::CollisionOption mCollisionOptions;
-  std::vector<std::pair<std::shared_ptr<CollisionGroup>,
-                        std::shared_ptr<CollisionGroup>>>
-      mGroupsToPairwiseCheck;
-  std::vector<std::shared_ptr<CollisionGroup>> mGroupsToSelfCheck;
+
+  /// Registered pairwise and self-collision checks, with their statistics.
+  std::vector<std::unique_ptr<Check>> mChecks;
+
+  /// Serializes the updates of mAdaptiveCheckOrder.
+  mutable std::mutex mStatisticsMutex;
+
+  /// Whether the checks are periodically reordered by their statistics.
+  bool mAdaptiveOrdering;
+
+  /// Whether the time spent in each check is measured.
+  bool mCheckTimingEnabled;
+
+  /// Indices of the checks in mChecks, in the default evaluation order.
+  std::vector<std::size_t> mCheckOrder;
+
+  /// Indices of the checks in mChecks, in adaptive evaluation order, or
+  /// \c nullptr if adaptive ordering is disabled. Each update publishes a new
+  /// vector with \c std::atomic_store, so readers never copy it.
+  mutable std::shared_ptr<const std::vector<std::size_t>> mAdaptiveCheckOrder;
+
+  /// Number of states evaluated since mAdaptiveCheckOrder was last updated.
+  mutable std::atomic<std::size_t> mNumStatesSinceUpdate;
+
+  statespace::dart::SkeletonReplicaPoolPtr mSkeletonReplicaPool;
+  common::ThreadPoolPtr mThreadPool;
 };
 
 using CollisionFreePtr = std::shared_ptr<CollisionFree>;
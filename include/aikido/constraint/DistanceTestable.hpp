@@ -0,0 +1,47 @@
+#ifndef AIKIDO_CONSTRAINT_DISTANCETESTABLE_HPP_
+#define AIKIDO_CONSTRAINT_DISTANCETESTABLE_HPP_
+
+#include "Testable.hpp"
+
+namespace aikido {
+namespace constraint {
+
+/// Testable that also computes the clearance of a state, i.e. a lower bound
+/// on how far the robot can move in the workspace before the constraint is
+/// violated. Together with a bound on the workspace displacement per unit of
+/// state space distance, the clearance of a state proves that all states
+/// within a ball around it satisfy the constraint. This allows edge checkers
+/// to skip large portions of edges in free space (conservative advancement).
+class DistanceTestable : public Testable
+{
+public:
+  /// Returns the clearance of a state. The clearance is positive if the state
+  /// satisfies this constraint, and zero or negative otherwise. A violation
+  /// between two parts that both move with the state, e.g. a self collision,
+  /// is approached by both of them, so its clearance is at most half of their
+  /// workspace distance.
+  ///
+  /// \param _state state in \c getStateSpace()
+  /// \return lower bound on how far each point of the robot can move in the
+  ///         workspace before the constraint is violated
+  virtual double getClearance(
+      const statespace::StateSpace::State* _state) const = 0;
+
+  /// Returns an upper bound on the distance that any point of the robot moves
+  /// in the workspace per unit of distance in the state space, under the
+  /// distance metric used by the edge checker.
+  ///
+  /// \return positive bound on the workspace displacement
+  virtual double getMaxDisplacementPerDistance() const = 0;
+
+  /// Returns true if the clearance of \c _state is positive.
+  bool isSatisfied(
+      const statespace::StateSpace::State* _state) const override;
+};
+
+using DistanceTestablePtr = std::shared_ptr<DistanceTestable>;
+
+} // namespace constraint
+} // namespace aikido
+
+#endif // AIKIDO_CONSTRAINT_DISTANCETESTABLE_HPP_
@@ -4,6 +4,7 @@
 #include <Eigen/Dense>
 #include <dart/dynamics/dynamics.hpp>
 #include "../statespace/dart/MetaSkeletonStateSpace.hpp"
+#include "../statespace/dart/SkeletonReplicaPool.hpp"
 #include "Differentiable.hpp"
 
 namespace aikido {
@@ -56,12 +57,43 @@ public:
   // Documentation inherited.
   statespace::StateSpacePtr getStateSpace() const override;
 
+  /// Sets the pool of skeleton replicas used to evaluate this constraint. If
+  /// \c _skeletonReplicaPool is not \c nullptr, the constraint is evaluated
+  /// on the replica of the calling thread, so it may be evaluated
+  /// concurrently from multiple threads.
+  ///
+  /// \param _skeletonReplicaPool pool that replicates every skeleton of the
+  ///        state space and of both frames, or \c nullptr
+  void setSkeletonReplicaPool(
+      statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool);
+
+  /// Gets the pool of skeleton replicas used to evaluate this constraint.
+  ///
+  /// \return pool of skeleton replicas, or \c nullptr if none is used
+  statespace::dart::SkeletonReplicaPoolPtr getSkeletonReplicaPool() const;
+
 private:
+  /// MetaSkeleton and frames that the constraint is evaluated on.
+  struct Frames
+  {
+    const dart::dynamics::MetaSkeleton* mMetaSkeleton;
+    const dart::dynamics::JacobianNode* mJacobianNode1;
+    const dart::dynamics::JacobianNode* mJacobianNode2;
+  };
+
+  /// Sets the configuration to \c _s, on the replica of the calling thread if
+  /// a \c SkeletonReplicaPool is set.
+  ///
+  /// \param _s state of the \c MetaSkeletonStateSpace
+  /// \return MetaSkeleton and frames to evaluate the constraint on
+  Frames setState(const statespace::StateSpace::State* _s) const;
+
   dart::dynamics::ConstJacobianNodePtr mJacobianNode1;
   dart::dynamics::ConstJacobianNodePtr mJacobianNode2;
   DifferentiablePtr mRelPoseConstraint;
   statespace::dart::MetaSkeletonStateSpacePtr mMetaSkeletonStateSpace;
   dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+  statespace::dart::SkeletonReplicaPoolPtr mSkeletonReplicaPool;
 };
 
 } // namespace constraint
@@ -4,6 +4,7 @@
 #include <dart/dynamics/dynamics.hpp>
 #include "../statespace/SE3.hpp"
 #include "../statespace/dart/MetaSkeletonStateSpace.hpp"
+#include "../statespace/dart/SkeletonReplicaPool.hpp"
 #include "Testable.hpp"
 
 namespace aikido {
@@ -34,11 +35,27 @@ public:
   // Documentation inhereted
   std::shared_ptr<statespace::StateSpace> getStateSpace() const override;
 
+  /// Sets the pool of skeleton replicas used by \c isSatisfied. If
+  /// \c _skeletonReplicaPool is not \c nullptr, \c isSatisfied performs
+  /// forward kinematics on the replica of the calling thread, so it may be
+  /// called concurrently from multiple threads.
+  ///
+  /// \param _skeletonReplicaPool pool that replicates every skeleton of the
+  ///        state space and of the frame, or \c nullptr
+  void setSkeletonReplicaPool(
+      statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool);
+
+  /// Gets the pool of skeleton replicas used by \c isSatisfied.
+  ///
+  /// \return pool of skeleton replicas, or \c nullptr if none is used
+  statespace::dart::SkeletonReplicaPoolPtr getSkeletonReplicaPool() const;
+
 private:
   statespace::dart::MetaSkeletonStateSpacePtr mStateSpace;
   dart::dynamics::ConstJacobianNodePtr mFrame;
   TestablePtr mPoseConstraint;
   std::shared_ptr<statespace::SE3> mPoseStateSpace;
+  statespace::dart::SkeletonReplicaPoolPtr mSkeletonReplicaPool;
 };
 
 } // namespace constraint
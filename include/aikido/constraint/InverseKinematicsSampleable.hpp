@@ -2,7 +2,10 @@
 #define AIKIDO_CONSTRAINT_INVERSEKINEMATICSSAMPLEABLEABLE_HPP_
 
 #include <dart/dynamics/dynamics.hpp>
+#include "../common/ThreadPool.hpp"
 #include "../statespace/dart/MetaSkeletonStateSpace.hpp"
+#include "../statespace/dart/SkeletonReplicaPool.hpp"
+#include "InverseKinematicsSeedDatabase.hpp"
 #include "Sampleable.hpp"
 
 namespace aikido {
@@ -43,12 +46,72 @@ public:
   // Documentation inherited.
   std::unique_ptr<SampleGenerator> createSampleGenerator() const override;
 
+  /// Sets the pool of skeleton replicas used by the sample generators created
+  /// afterwards to solve inverse kinematics in parallel.
+  ///
+  /// \param _skeletonReplicaPool pool that replicates the skeleton of the
+  ///        inverse kinematics solver, or \c nullptr
+  void setSkeletonReplicaPool(
+      statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool);
+
+  /// Gets the pool of skeleton replicas used by the sample generators.
+  ///
+  /// \return pool of skeleton replicas, or \c nullptr if none is used
+  statespace::dart::SkeletonReplicaPoolPtr getSkeletonReplicaPool() const;
+
+  /// Sets the thread pool used by the sample generators created afterwards.
+  /// If \c _threadPool is not \c nullptr, each call to \c sample draws up to
+  /// one seed and pose pair per thread, plus one for the calling thread, and
+  /// solves inverse kinematics for them concurrently, each on the skeleton
+  /// replica of the thread it runs on. The solution of the first pair, in
+  /// the order the pairs were drawn, that converges is returned, and the
+  /// pairs after it that have not been started are cancelled. This repeats
+  /// until a pair converges or the maximum number of trials is reached. The
+  /// skeleton of the state space is left unchanged, so a skeleton replica
+  /// pool must be set with \c setSkeletonReplicaPool as well.
+  ///
+  /// \param _threadPool thread pool, or \c nullptr to try one pair at a time
+  ///        on the calling thread
+  void setThreadPool(common::ThreadPoolPtr _threadPool);
+
+  /// Gets the thread pool used by the sample generators.
+  ///
+  /// \return thread pool, or \c nullptr if the pairs are tried sequentially
+  common::ThreadPoolPtr getThreadPool() const;
+
+  /// Sets a database of configurations used as seeds, instead of the samples
+  /// of the seed constraint, by the sample generators created afterwards.
+  /// For each pose sampled from the pose constraint, the configurations of
+  /// the \c _numSeedsPerPose entries nearest to the pose are tried in turn,
+  /// each as one trial, before the next pose is sampled. The database must
+  /// be built for the frame of the inverse kinematics solver and the
+  /// MetaSkeleton of the state space.
+  ///
+  /// \param _seedDatabase database of seeds, or \c nullptr to sample seeds
+  ///        from the seed constraint
+  /// \param _numSeedsPerPose number of seeds tried per pose
+  /// \throw std::invalid_argument if the configurations of the database do
+  ///        not match the state space or \c _numSeedsPerPose is zero
+  void setSeedDatabase(
+      InverseKinematicsSeedDatabasePtr _seedDatabase,
+      std::size_t _numSeedsPerPose = 1);
+
+  /// Gets the database of seeds used by the sample generators.
+  ///
+  /// \return database of seeds, or \c nullptr if seeds are sampled from the
+  ///         seed constraint
+  InverseKinematicsSeedDatabasePtr getSeedDatabase() const;
+
 private:
   statespace::dart::MetaSkeletonStateSpacePtr mStateSpace;
   SampleablePtr mPoseConstraint;
   SampleablePtr mSeedConstraint;
   dart::dynamics::InverseKinematicsPtr mInverseKinematics;
   int mMaxNumTrials;
+  statespace::dart::SkeletonReplicaPoolPtr mSkeletonReplicaPool;
+  common::ThreadPoolPtr mThreadPool;
+  InverseKinematicsSeedDatabasePtr mSeedDatabase;
+  std::size_t mNumSeedsPerPose;
 };
 
 } // namespace constraint
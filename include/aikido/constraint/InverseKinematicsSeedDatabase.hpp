@@ -0,0 +1,147 @@
+#ifndef AIKIDO_CONSTRAINT_INVERSEKINEMATICSSEEDDATABASE_HPP_
+#define AIKIDO_CONSTRAINT_INVERSEKINEMATICSSEEDDATABASE_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <Eigen/Geometry>
+#include <dart/dynamics/dynamics.hpp>
+#include "../statespace/dart/MetaSkeletonStateSpace.hpp"
+#include "Sampleable.hpp"
+
+namespace aikido {
+namespace constraint {
+
+/// Database of poses of a frame of a skeleton and the configurations of a
+/// MetaSkeleton that reach them, used to seed inverse kinematics close to a
+/// solution.
+///
+/// The database is built offline by sampling configurations, and queried for
+/// the configurations whose poses are nearest to a target pose. Poses are
+/// compared by the Euclidean distance between (p, w * q), where p is the
+/// position, q the unit quaternion with non-negative real part, and w the
+/// rotation weight. The entries are stored in a single array of doubles,
+/// ordered as an implicit balanced k-d tree over these keys, so a saved
+/// database is memory-mapped by load() and queried without being parsed.
+///
+/// The file starts with a header of 32 bytes: the magic string "AIKIDOIK",
+/// the format version and the number of degrees of freedom as 32-bit
+/// unsigned integers, the number of entries as a 64-bit unsigned integer and
+/// the rotation weight as a double. Each entry then consists of the position
+/// (x, y, z), the quaternion (w, x, y, z) and the positions of the degrees of
+/// freedom, all as doubles in the byte order of the machine that built it.
+class InverseKinematicsSeedDatabase
+{
+public:
+  /// Builds a database by sampling configurations of a MetaSkeleton and
+  /// recording the world transform of _node in each of them. The positions
+  /// of the MetaSkeleton are restored afterwards.
+  ///
+  /// \param _stateSpace state space of the MetaSkeleton
+  /// \param _node frame whose pose is recorded, e.g. the end-effector
+  /// \param _configurationConstraint samples configurations in _stateSpace
+  /// \param _numEntries number of configurations to sample
+  /// \param _rotationWeight weight of the rotation relative to the position
+  ///        in the distance between poses
+  /// \return database with up to _numEntries entries, fewer if the sample
+  ///         generator is exhausted or fails to sample
+  static std::shared_ptr<InverseKinematicsSeedDatabase> build(
+      statespace::dart::MetaSkeletonStateSpacePtr _stateSpace,
+      dart::dynamics::ConstJacobianNodePtr _node,
+      const SampleablePtr& _configurationConstraint,
+      std::size_t _numEntries,
+      double _rotationWeight = 1.);
+
+  /// Memory-maps a database saved with save().
+  ///
+  /// \param _path path of the database file
+  /// \throw std::runtime_error if the file cannot be mapped or is not a valid
+  ///        database
+  static std::shared_ptr<InverseKinematicsSeedDatabase> load(
+      const std::string& _path);
+
+  /// Saves the database to a file that can be loaded with load().
+  ///
+  /// \param _path path of the database file
+  /// \throw std::runtime_error if the file cannot be written
+  void save(const std::string& _path) const;
+
+  InverseKinematicsSeedDatabase(const InverseKinematicsSeedDatabase&) = delete;
+  InverseKinematicsSeedDatabase& operator=(
+      const InverseKinematicsSeedDatabase&) = delete;
+
+  ~InverseKinematicsSeedDatabase();
+
+  /// Returns the number of entries.
+  std::size_t getNumEntries() const;
+
+  /// Returns the number of degrees of freedom of each configuration.
+  std::size_t getNumDofs() const;
+
+  /// Returns the weight of the rotation in the distance between poses.
+  double getRotationWeight() const;
+
+  /// Returns the pose of an entry.
+  ///
+  /// \param _index index of the entry
+  Eigen::Isometry3d getPose(std::size_t _index) const;
+
+  /// Returns the configuration of an entry.
+  ///
+  /// \param _index index of the entry
+  Eigen::Map<const Eigen::VectorXd> getPositions(std::size_t _index) const;
+
+  /// Finds the entries whose poses are nearest to a pose.
+  ///
+  /// \param _pose target pose
+  /// \param _numNeighbors maximum number of entries to find
+  /// \return indices of up to _numNeighbors entries, nearest first
+  std::vector<std::size_t> findNearest(
+      const Eigen::Isometry3d& _pose, std::size_t _numNeighbors) const;
+
+private:
+  /// Entry index and squared distance, ordered by distance.
+  using Neighbor = std::pair<double, std::size_t>;
+
+  InverseKinematicsSeedDatabase(
+      std::size_t _numDofs, std::size_t _numEntries, double _rotationWeight);
+
+  /// Returns the number of doubles in an entry.
+  std::size_t getEntrySize() const;
+
+  /// Returns the key of an entry in the k-d tree.
+  Eigen::Matrix<double, 7, 1> getKey(std::size_t _index) const;
+
+  /// Visits the subtree of the k-d tree over the entries in [_begin, _end).
+  /// Each query key is compared against the key of an entry as well as its
+  /// negated quaternion, since both represent the same rotation.
+  void findNearest(
+      const Eigen::Matrix<double, 7, 1> (&_keys)[2],
+      std::size_t _numNeighbors,
+      std::size_t _begin,
+      std::size_t _end,
+      std::size_t _depth,
+      std::vector<Neighbor>& _neighbors) const;
+
+  std::size_t mNumDofs;
+  std::size_t mNumEntries;
+  double mRotationWeight;
+
+  /// Entries of a database that was built in memory.
+  std::vector<double> mBuffer;
+
+  /// Mapping of a loaded database file, or nullptr.
+  void* mMapping;
+  std::size_t mMappingSize;
+
+  /// Start of the entries, in mBuffer or mMapping.
+  const double* mEntries;
+};
+
+using InverseKinematicsSeedDatabasePtr
+    = std::shared_ptr<InverseKinematicsSeedDatabase>;
+
+} // namespace constraint
+} // namespace aikido
+
+#endif // AIKIDO_CONSTRAINT_INVERSEKINEMATICSSEEDDATABASE_HPP_
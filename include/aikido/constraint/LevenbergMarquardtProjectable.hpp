@@ -0,0 +1,126 @@
+#ifndef AIKIDO_CONSTRAINT_LEVENBERGMARQUARDTPROJECTABLE_HPP_
+#define AIKIDO_CONSTRAINT_LEVENBERGMARQUARDTPROJECTABLE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <Eigen/Dense>
+#include "Differentiable.hpp"
+#include "Projectable.hpp"
+
+namespace aikido {
+namespace constraint {
+
+/// Uses the Levenberg-Marquardt method to project state.
+///
+/// Each iteration solves the damped least-squares problem
+/// (J^T J + lambda * I) * step = -J^T * r, where r is the vector of violated
+/// constraint values and J its Jacobian, and takes the largest step
+/// 2^-k * step that satisfies the Armijo condition on 0.5 * |r|^2. The damping
+/// lambda is decreased after full steps and increased after backtracking. If
+/// the line search fails, e.g. at a kink of a TSR distance, the full step is
+/// taken as in NewtonsMethodProjectable and lambda is increased further.
+/// Inequality constraints contribute to r only while they are violated.
+///
+/// The intermediate values, Jacobians and states of a projection are kept in
+/// a workspace that is returned to a pool when the projection ends and reused
+/// by later projections, so projections do not allocate once the pool holds
+/// one workspace per concurrent caller. project() may be called concurrently.
+/// With warm starting enabled, each projection starts with the damping that
+/// the previous projection ended with.
+class LevenbergMarquardtProjectable : public Projectable
+{
+public:
+  /// Constructor.
+  /// \param _differentiable Differentiable constraint to be projected.
+  /// \param _tolerance Tolerances for checking whether the constraints
+  ///        are been satisfied. e.g. For equality,
+  ///        |_differentiable->getValue(state)| <= tolerance
+  ///        The size of tolerances should match _differentiable's constraint
+  ///        dimension.
+  /// \param _maxIteration Max iteration for the Levenberg-Marquardt method.
+  /// \param _minStepSize Minimum step size to be taken.
+  /// \param _initialDamping Damping of the first iteration.
+  /// \param _warmStart Whether to start each projection with the damping of
+  ///        the previous projection instead of _initialDamping.
+  LevenbergMarquardtProjectable(
+      DifferentiablePtr _differentiable,
+      std::vector<double> _tolerance,
+      int _maxIteration = 100,
+      double _minStepSize = 1e-8,
+      double _initialDamping = 1e-3,
+      bool _warmStart = true);
+
+  // Documentation inherited.
+  bool project(
+      const statespace::StateSpace::State* _s,
+      statespace::StateSpace::State* _out) const override;
+
+  // Documentation inherited.
+  statespace::StateSpacePtr getStateSpace() const override;
+
+private:
+  /// Intermediate values and states of a call to project(), reused between
+  /// its iterations and by later calls.
+  struct Workspace
+  {
+    explicit Workspace(const statespace::StateSpace* _stateSpace);
+
+    Eigen::VectorXd mValue;
+    Eigen::MatrixXd mJacobian;
+    Eigen::VectorXd mResidual;
+    Eigen::VectorXd mGradient;
+    Eigen::MatrixXd mNormalMatrix;
+    Eigen::LDLT<Eigen::MatrixXd> mSolver;
+    Eigen::VectorXd mSolution;
+    Eigen::VectorXd mStep;
+    Eigen::VectorXd mScaledStep;
+    Eigen::VectorXd mTrialValue;
+    Eigen::VectorXd mTrialResidual;
+    statespace::StateSpace::ScopedState mStepState;
+    statespace::StateSpace::ScopedState mTrialState;
+  };
+
+  /// Takes a workspace from mWorkspaces, or creates one if it is empty.
+  std::unique_ptr<Workspace> acquireWorkspace() const;
+
+  /// Returns a workspace to mWorkspaces.
+  void releaseWorkspace(std::unique_ptr<Workspace> _workspace) const;
+
+  /// Returns whether _value is within mTolerance.
+  bool contains(const Eigen::VectorXd& _value) const;
+
+  /// Computes the residual of the violated constraints in _value.
+  /// \param _value Value of the constraints.
+  /// \param[out] _residual Residual, zero for satisfied inequalities.
+  void computeResidual(
+      const Eigen::VectorXd& _value, Eigen::VectorXd& _residual) const;
+
+  /// Computes the damped least-squares step for the residual and Jacobian in
+  /// _workspace.
+  /// \param _damping Damping of the normal equations.
+  /// \param[in,out] _workspace Workspace of the current projection.
+  void computeStep(double _damping, Workspace& _workspace) const;
+
+  DifferentiablePtr mDifferentiable;
+  std::vector<double> mTolerance;
+  std::vector<ConstraintType> mConstraintTypes;
+  int mMaxIteration;
+  double mMinStepSize;
+  double mInitialDamping;
+  bool mWarmStart;
+  statespace::StateSpacePtr mStateSpace;
+
+  /// Damping at the end of the previous projection.
+  mutable std::atomic<double> mDamping;
+
+  /// Workspaces that are not used by a projection.
+  mutable std::mutex mWorkspaceMutex;
+  mutable std::vector<std::unique_ptr<Workspace>> mWorkspaces;
+};
+
+} // namespace constraint
+} // namespace aikido
+
+#endif // AIKIDO_CONSTRAINT_LEVENBERGMARQUARDTPROJECTABLE_HPP_
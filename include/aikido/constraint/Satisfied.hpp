@@ -36,6 +36,22 @@ public:
   /// \param state a state in \c getStateSpace()
   bool isSatisfied(const statespace::StateSpace::State* state) const override;
 
+  /// Sets all results to \c true and returns \c true.
+  ///
+  /// \param _states states in \c getStateSpace()
+  /// \param[out] _out result of each state, resized to the number of states
+  /// \param _earlyExit unused
+  bool isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& _states,
+      std::vector<bool>& _out,
+      bool _earlyExit) const override;
+
+  /// Returns \c true.
+  ///
+  /// \param _states states in \c getStateSpace()
+  bool areAllSatisfied(const std::vector<const statespace::StateSpace::State*>&
+                           _states) const override;
+
   /// Sets \c _out to \c _s.
   ///
   /// \param _s input state
@@ -136,6 +136,13 @@ public:
   Eigen::Isometry3d mTw_e;
 
 private:
+  /// Jacobian of TSR computed by central finite differences. This is used
+  /// by getJacobian when the Euler angles of _s are close to gimbal lock.
+  /// \param _s State to be evaluated at.
+  /// \param[out] _out Jacobian, 6 x 6 matrix.
+  void getJacobianNumerically(
+      const statespace::StateSpace::State* _s, Eigen::MatrixXd& _out) const;
+
   /// Tolerance used in isSatisfied as a testable
   double mTestableTolerance;
   std::unique_ptr<common::RNG> mRng;
@@ -2,6 +2,8 @@
 #define AIKIDO_CONSTRAINT_TESTABLE_HPP_
 
 #include <memory>
+#include <vector>
+#include "../statespace/EdgeInterpolation.hpp"
 #include "../statespace/StateSpace.hpp"
 
 namespace aikido {
@@ -17,12 +19,61 @@ public:
   virtual bool isSatisfied(
       const statespace::StateSpace::State* _state) const = 0;
 
+  /// Batched version of \c isSatisfied that tests every state of
+  /// \c _states, e.g. all states of a discretized edge. If \c _earlyExit is
+  /// true, testing stops at the first state that does not satisfy this
+  /// constraint and the results of all following states are set to false.
+  ///
+  /// The default implementation calls \c isSatisfied once for each state.
+  /// Constraints override this to amortize per-state overhead or to test
+  /// several states at once.
+  ///
+  /// \param _states states in \c getStateSpace()
+  /// \param[out] _out result of each state, resized to the number of states
+  /// \param _earlyExit whether to stop at the first unsatisfied state
+  /// \return true if all states satisfy this constraint
+  virtual bool isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& _states,
+      std::vector<bool>& _out,
+      bool _earlyExit) const;
+
+  /// Returns true if all states of \c _states satisfy this constraint. Unlike
+  /// \c isSatisfiedBatch, the states may be tested in any order and testing
+  /// stops at any unsatisfied state, e.g. all workers of a thread pool stop as
+  /// soon as one of them finds an unsatisfied state. This suits edges that
+  /// are discretized in a \c VanDerCorput sequence, for which only the
+  /// validity of the whole edge matters.
+  ///
+  /// The default implementation calls \c isSatisfiedBatch with early exit.
+  ///
+  /// \param _states states in \c getStateSpace()
+  /// \return true if all states satisfy this constraint
+  virtual bool areAllSatisfied(
+      const std::vector<const statespace::StateSpace::State*>& _states) const;
+
   /// Returns StateSpace in which this constraint operates.
   virtual statespace::StateSpacePtr getStateSpace() const = 0;
 };
 
 using TestablePtr = std::shared_ptr<Testable>;
 
+/// Returns true if the states at path parameters \c _alphas along \c _edge
+/// all satisfy \c _testable. The states are interpolated in chunks of
+/// consecutive path parameters that fit in the inline buffer of a
+/// \c statespace::StateArray, and each chunk is tested with a single call to
+/// \c Testable::areAllSatisfied. No further chunk is interpolated after a
+/// chunk with an unsatisfied state, so \c _alphas should be ordered to cover
+/// the edge coarsely first, e.g. by a \c common::VanDerCorput sequence.
+///
+/// \param _testable constraint to test
+/// \param _edge edge in \c _testable.getStateSpace()
+/// \param _alphas path parameters in the range [0, 1]
+/// \return true if all states satisfy \c _testable
+bool areAllSatisfied(
+    const Testable& _testable,
+    const statespace::EdgeInterpolation& _edge,
+    const std::vector<double>& _alphas);
+
 } // namespace constraint
 } // namespace aikido
 
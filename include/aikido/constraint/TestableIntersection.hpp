@@ -25,6 +25,26 @@ public:
   bool isSatisfied(
       const aikido::statespace::StateSpace::State* state) const override;
 
+  /// Tests the states with each constraint in turn. Each constraint only
+  /// tests the states that satisfy all previous constraints.
+  ///
+  /// \param _states states in \c getStateSpace()
+  /// \param[out] _out result of each state, resized to the number of states
+  /// \param _earlyExit whether to stop at the first unsatisfied state
+  /// \return true if all states satisfy all constraints
+  bool isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& _states,
+      std::vector<bool>& _out,
+      bool _earlyExit) const override;
+
+  /// Tests all states with each constraint in turn, stopping at the first
+  /// constraint that is not satisfied by all of them.
+  ///
+  /// \param _states states in \c getStateSpace()
+  /// \return true if all states satisfy all constraints
+  bool areAllSatisfied(const std::vector<const statespace::StateSpace::State*>&
+                           _states) const override;
+
   // Documentation inherited.
   statespace::StateSpacePtr getStateSpace() const override;
 
@@ -38,6 +38,19 @@ public:
   // Documentation inherited.
   bool isSatisfied(const statespace::StateSpace::State* state) const override;
 
+  /// Tests the limits of all states at once, after gathering their log maps
+  /// into the columns of a matrix.
+  ///
+  /// \param _states states in \c getStateSpace()
+  /// \param[out] _out result of each state, resized to the number of states
+  /// \param _earlyExit whether to set the results after the first unsatisfied
+  ///        state to false
+  /// \return true if all states satisfy this constraint
+  bool isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& _states,
+      std::vector<bool>& _out,
+      bool _earlyExit) const override;
+
   // Documentation inherited.
   bool project(
       const statespace::StateSpace::State* s,
@@ -188,6 +188,45 @@ bool RBoxConstraint<N>::isSatisfied(
   return true;
 }
 
+//==============================================================================
+template <int N>
+bool RBoxConstraint<N>::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& _states,
+    std::vector<bool>& _out,
+    bool _earlyExit) const
+{
+  const auto numStates = _states.size();
+  _out.assign(numStates, false);
+
+  Eigen::Matrix<double, N, Eigen::Dynamic> values(
+      mSpace->getDimension(), numStates);
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    values.col(i) = mSpace->getValue(
+        static_cast<const typename statespace::R<N>::State*>(_states[i]));
+  }
+
+  // Written as violations, rather than as satisfied limits, to match
+  // isSatisfied for NaN values.
+  const Eigen::Array<bool, 1, Eigen::Dynamic> belowLowerLimits
+      = ((values.colwise() - mLowerLimits).array() < 0.).colwise().any();
+  const Eigen::Array<bool, 1, Eigen::Dynamic> aboveUpperLimits
+      = ((values.colwise() - mUpperLimits).array() > 0.).colwise().any();
+
+  bool allSatisfied = true;
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    _out[i] = !belowLowerLimits[i] && !aboveUpperLimits[i];
+    if (!_out[i])
+    {
+      allSatisfied = false;
+      if (_earlyExit)
+        break;
+    }
+  }
+  return allSatisfied;
+}
+
 //==============================================================================
 template <int N>
 bool RBoxConstraint<N>::project(
@@ -1,5 +1,6 @@
 #include "distance/CartesianProductWeighted.hpp"
 #include "distance/DistanceMetric.hpp"
+#include "distance/NearestNeighborIndex.hpp"
 #include "distance/RnEuclidean.hpp"
 #include "distance/SE2.hpp"
 #include "distance/SE2Weighted.hpp"
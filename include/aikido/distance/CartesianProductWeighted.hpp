@@ -11,6 +11,13 @@ namespace distance {
 ///
 /// This metric computes the weighted sum of distances on the individual
 /// components of the statespace.
+///
+/// If every component metric is an REuclidean, SO2Angular, SO3Angular,
+/// SE2Weighted or CartesianProductWeighted of such metrics, the constructor
+/// compiles the metric into flat arrays of terms grouped by type, with their
+/// byte offsets in the state and their accumulated weights. The distance is
+/// then evaluated directly on the memory of the states, without a virtual
+/// call per component or recursion into nested products.
 class CartesianProductWeighted : public DistanceMetric
 {
 public:
@@ -47,9 +54,70 @@ public:
       const statespace::StateSpace::State* _state1,
       const statespace::StateSpace::State* _state2) const override;
 
+  /// Accumulates the weighted distances of the components until the sum
+  /// exceeds the bound. Each component is evaluated with the remaining bound.
+  double distanceBounded(
+      const statespace::StateSpace::State* _state1,
+      const statespace::StateSpace::State* _state2,
+      double _bound) const override;
+
+  // Documentation inherited
+  void distanceBatch(
+      const statespace::StateSpace::State* _state,
+      const std::vector<const statespace::StateSpace::State*>& _states,
+      std::vector<double>& _distances) const override;
+
+  /// Returns whether the metric is compiled into flat terms.
+  bool isCompiled() const;
+
+  /// Gets the metrics of the components of the statespace and the weights
+  /// applied to them.
+  ///
+  /// \return pairs of metric and weight, one for every component
+  const std::vector<std::pair<DistanceMetricPtr, double>>& getMetrics() const;
+
 private:
+  /// Term of the compiled metric whose state starts at mOffset bytes in the
+  /// state of the product.
+  struct Term
+  {
+    std::size_t mOffset;
+    std::size_t mDimension;
+    double mWeight;
+    double mTranslationWeight;
+  };
+
+  /// Compiles the metrics of all components, or clears the compiled terms if
+  /// any of them is not supported.
+  void compile();
+
+  /// Appends the terms of a metric whose state is at _offset bytes in the
+  /// state of the product. Returns false if the metric is not supported.
+  bool compile(
+      const DistanceMetric& _metric, std::size_t _offset, double _weight);
+
+  /// Computes the distance with the compiled terms. Returns as soon as the
+  /// partial sum exceeds _bound.
+  double computeCompiledDistance(
+      const unsigned char* _state1,
+      const unsigned char* _state2,
+      double _bound) const;
+
   std::shared_ptr<statespace::CartesianProduct> mStateSpace;
   std::vector<std::pair<DistanceMetricPtr, double>> mMetrics;
+
+  bool mIsCompiled;
+
+  /// Compiled R1 and SO2 terms, as parallel arrays of offsets and weights.
+  std::vector<std::size_t> mScalarOffsets;
+  std::vector<double> mScalarWeights;
+  std::vector<std::size_t> mAngleOffsets;
+  std::vector<double> mAngleWeights;
+
+  /// Compiled Rn terms with more than one dimension, SO3 and SE2 terms.
+  std::vector<Term> mVectorTerms;
+  std::vector<Term> mSO3Terms;
+  std::vector<Term> mSE2Terms;
 };
 
 } // namespace distance
@@ -1,6 +1,7 @@
 #ifndef AIKIDO_DISTANCE_DISTANCEMETRIC_HPP_
 #define AIKIDO_DISTANCE_DISTANCEMETRIC_HPP_
 
+#include <vector>
 #include "../statespace/StateSpace.hpp"
 
 namespace aikido {
@@ -25,6 +26,38 @@ public:
   virtual double distance(
       const statespace::StateSpace::State* _state1,
       const statespace::StateSpace::State* _state2) const = 0;
+
+  /// Computes the distance between two states if it is at most a bound. This
+  /// is for callers that only compare the distance to a threshold, e.g. when
+  /// pruning nearest neighbor candidates. Metrics may stop evaluating the
+  /// distance as soon as it is known to exceed the bound.
+  ///
+  /// The default implementation calls \c distance.
+  ///
+  /// \param _state1 The first state
+  /// \param _state2 The second state
+  /// \param _bound distance threshold
+  /// \return the distance between the states if it is at most \c _bound,
+  /// otherwise any value greater than \c _bound
+  virtual double distanceBounded(
+      const statespace::StateSpace::State* _state1,
+      const statespace::StateSpace::State* _state2,
+      double _bound) const;
+
+  /// Computes the distances from one state to each of several states, e.g.
+  /// all nodes of a tree.
+  ///
+  /// The default implementation calls \c distance once for each state.
+  /// Metrics override this to amortize per-call overhead.
+  ///
+  /// \param _state state in \c getStateSpace()
+  /// \param _states states in \c getStateSpace()
+  /// \param[out] _distances distance from \c _state to each of \c _states,
+  ///        resized to the number of states
+  virtual void distanceBatch(
+      const statespace::StateSpace::State* _state,
+      const std::vector<const statespace::StateSpace::State*>& _states,
+      std::vector<double>& _distances) const;
 };
 
 using DistanceMetricPtr = std::shared_ptr<DistanceMetric>;
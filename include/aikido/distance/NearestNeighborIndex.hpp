@@ -0,0 +1,194 @@
+#ifndef AIKIDO_DISTANCE_NEARESTNEIGHBORINDEX_HPP_
+#define AIKIDO_DISTANCE_NEARESTNEIGHBORINDEX_HPP_
+
+#include <functional>
+#include <limits>
+#include <vector>
+#include "../statespace/StateSpace.hpp"
+#include "DistanceMetric.hpp"
+
+namespace aikido {
+namespace distance {
+
+/// Index of states for nearest neighbor queries under a DistanceMetric.
+///
+/// The metric must be an REuclidean, an SO2Angular or a
+/// CartesianProductWeighted of supported metrics, such as the default metric
+/// of a MetaSkeletonStateSpace. The coordinates of each state are copied into
+/// a single contiguous array when it is added, and distances are computed on
+/// these coordinates with the weights of the metric and the wraparound of
+/// SO2, without calling the metric.
+///
+/// States are organized in a k-d tree that is built incrementally. Each leaf
+/// holds a bucket of states whose distances to the query are computed
+/// together. Subtrees are pruned with a lower bound of the distance to their
+/// cell, which accounts for the wraparound of SO2 coordinates. Optionally,
+/// queries are approximate: with an approximation factor eps, every returned
+/// state is at most (1 + eps) times farther than the corresponding exact
+/// neighbor.
+///
+/// Queries are thread-safe as long as no states are added or removed
+/// concurrently.
+class NearestNeighborIndex
+{
+public:
+  /// Returns whether the index supports a metric. Metrics are matched by
+  /// their exact type, so subclasses, which may override distance(), are not
+  /// supported.
+  ///
+  /// \param _metric distance metric
+  /// \return true if _metric is an REuclidean, an SO2Angular or a
+  ///         CartesianProductWeighted of supported metrics
+  static bool isSupported(const DistanceMetric& _metric);
+
+  /// Constructor.
+  ///
+  /// \param _metric distance metric, see isSupported()
+  /// \param _bucketSize maximum number of distinct states in a leaf
+  /// \throw std::invalid_argument if _metric is not supported or _bucketSize
+  ///        is zero
+  explicit NearestNeighborIndex(
+      DistanceMetricPtr _metric, std::size_t _bucketSize = 16);
+
+  /// Gets the distance metric of this index.
+  const DistanceMetricPtr& getMetric() const;
+
+  /// Sets the approximation factor of queries.
+  ///
+  /// \param _epsilon approximation factor, zero for exact queries
+  /// \throw std::invalid_argument if _epsilon is negative
+  void setApproximationFactor(double _epsilon);
+
+  /// Gets the approximation factor of queries.
+  double getApproximationFactor() const;
+
+  /// Adds a state to the index. The state is not referenced afterwards.
+  ///
+  /// \param _state state in the state space of the metric
+  /// \return index of the state, which is the number of states added before
+  std::size_t add(const statespace::StateSpace::State* _state);
+
+  /// Removes a state from the index. Its index is not reused.
+  ///
+  /// \param _index index of the state
+  /// \return false if the state was already removed
+  bool remove(std::size_t _index);
+
+  /// Removes all states and resets the indices.
+  void clear();
+
+  /// Returns the number of states that were added and not removed.
+  std::size_t size() const;
+
+  /// Finds the states nearest to a state.
+  ///
+  /// \param _state query state
+  /// \param _k maximum number of states to find
+  /// \param[out] _indices indices of up to _k states, nearest first
+  void nearestK(
+      const statespace::StateSpace::State* _state,
+      std::size_t _k,
+      std::vector<std::size_t>& _indices) const;
+
+  /// Finds the states within a distance of a state.
+  ///
+  /// \param _state query state
+  /// \param _radius maximum distance
+  /// \param[out] _indices indices of the states within _radius of _state,
+  ///        nearest first
+  void nearestR(
+      const statespace::StateSpace::State* _state,
+      double _radius,
+      std::vector<std::size_t>& _indices) const;
+
+  /// Computes the distances from a state to states in the index.
+  ///
+  /// \param _state query state
+  /// \param _indices indices of states in the index
+  /// \param[out] _distances distance to each state in _indices
+  void computeDistances(
+      const statespace::StateSpace::State* _state,
+      const std::vector<std::size_t>& _indices,
+      std::vector<double>& _distances) const;
+
+private:
+  /// Coordinates of a subspace whose distance is the Euclidean norm of their
+  /// differences, times a weight.
+  struct Group
+  {
+    std::size_t mOffset;
+    std::size_t mSize;
+    double mWeight;
+    bool mIsAngular;
+  };
+
+  /// Writes the coordinates of a group for a state of the metric.
+  using CoordinateFunction = std::function<void(
+      const statespace::StateSpace::State*, double*)>;
+
+  /// Node of the k-d tree. Leaves have no split coordinate.
+  struct Node
+  {
+    int mSplitCoordinate;
+    double mSplitValue;
+    std::size_t mChildren[2];
+    std::vector<std::size_t> mBucket;
+  };
+
+  /// State of a query, see search().
+  struct Search;
+
+  /// Appends the groups of a metric, whose states are obtained from the
+  /// states of mMetric by _getState. Returns false if it is not supported.
+  bool addGroups(
+      const DistanceMetricPtr& _metric,
+      double _weight,
+      const std::function<const statespace::StateSpace::State*(
+          const statespace::StateSpace::State*)>& _getState);
+
+  /// Writes the coordinates of _state to _coordinates.
+  void computeCoordinates(
+      const statespace::StateSpace::State* _state, double* _coordinates) const;
+
+  /// Computes the distance between two points given by their coordinates, or
+  /// returns a value greater than _bound as soon as the distance exceeds it.
+  double computeDistance(
+      const double* _a,
+      const double* _b,
+      double _bound = std::numeric_limits<double>::infinity()) const;
+
+  /// Splits the bucket of a leaf into two children, if its states differ.
+  void split(std::size_t _node);
+
+  /// Distance from _value to the interval [_lower, _upper] of _coordinate.
+  double computeOffset(
+      std::size_t _coordinate,
+      double _value,
+      double _lower,
+      double _upper) const;
+
+  /// Visits the subtree of _node, whose cell is at least _bound away from
+  /// the query.
+  void search(Search& _search, std::size_t _node, double _bound) const;
+
+  DistanceMetricPtr mMetric;
+  std::size_t mBucketSize;
+  double mApproximationFactor;
+
+  std::vector<Group> mGroups;
+  std::vector<CoordinateFunction> mCoordinateFunctions;
+  std::vector<std::size_t> mCoordinateGroups;
+  std::size_t mNumCoordinates;
+
+  /// Coordinates of all states, in the order they were added.
+  std::vector<double> mCoordinates;
+  std::vector<char> mRemoved;
+  std::size_t mNumRemoved;
+
+  std::vector<Node> mNodes;
+};
+
+} // namespace distance
+} // namespace aikido
+
+#endif // AIKIDO_DISTANCE_NEARESTNEIGHBORINDEX_HPP_
@@ -26,6 +26,13 @@ public:
       const statespace::StateSpace::State* _state1,
       const statespace::StateSpace::State* _state2) const override;
 
+  /// Compares the squared distance to the squared bound, and only takes the
+  /// square root if the distance is within the bound.
+  double distanceBounded(
+      const statespace::StateSpace::State* _state1,
+      const statespace::StateSpace::State* _state2,
+      double _bound) const override;
+
 private:
   std::shared_ptr<statespace::R<N>> mStateSpace;
 };
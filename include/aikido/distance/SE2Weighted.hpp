@@ -37,6 +37,9 @@ public:
       const statespace::StateSpace::State* state1,
       const statespace::StateSpace::State* state2) const override;
 
+  /// Gets the weights of the angular and translational distances.
+  const Eigen::Vector2d& getWeights() const;
+
 private:
   std::shared_ptr<statespace::SE2> mStateSpace;
 
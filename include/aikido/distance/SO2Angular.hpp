@@ -26,7 +26,19 @@ public:
       const statespace::StateSpace::State* _state1,
       const statespace::StateSpace::State* _state2) const override;
 
+  /// Computes the wrapped difference of the angles without a virtual call
+  /// and compares it to the bound.
+  double distanceBounded(
+      const statespace::StateSpace::State* _state1,
+      const statespace::StateSpace::State* _state2,
+      double _bound) const override;
+
 private:
+  /// Computes the shortest distance between two angles.
+  double computeDistance(
+      const statespace::StateSpace::State* _state1,
+      const statespace::StateSpace::State* _state2) const;
+
   std::shared_ptr<statespace::SO2> mStateSpace;
 };
 
@@ -25,6 +25,13 @@ public:
       const statespace::StateSpace::State* _state1,
       const statespace::StateSpace::State* _state2) const override;
 
+  /// Compares the dot product of the quaternions to the cosine of half the
+  /// bound before computing the angle.
+  double distanceBounded(
+      const statespace::StateSpace::State* _state1,
+      const statespace::StateSpace::State* _state2,
+      double _bound) const override;
+
 private:
   std::shared_ptr<statespace::SO3> mStateSpace;
 };
@@ -1,3 +1,5 @@
+#include <cmath>
+#include <limits>
 #include <aikido/distance/RnEuclidean.hpp>
 
 namespace aikido {
@@ -47,5 +49,23 @@ double REuclidean<N>::distance(
   return (v2 - v1).norm();
 }
 
+//==============================================================================
+template <int N>
+double REuclidean<N>::distanceBounded(
+    const statespace::StateSpace::State* _state1,
+    const statespace::StateSpace::State* _state2,
+    double _bound) const
+{
+  auto v1 = mStateSpace->getValue(
+      static_cast<const typename statespace::R<N>::State*>(_state1));
+  auto v2 = mStateSpace->getValue(
+      static_cast<const typename statespace::R<N>::State*>(_state2));
+
+  const double squaredDistance = (v2 - v1).squaredNorm();
+  if (_bound >= 0. && squaredDistance > _bound * _bound)
+    return std::numeric_limits<double>::infinity();
+  return std::sqrt(squaredDistance);
+}
+
 } // namespace distance
 } // namespace aikido
@@ -7,6 +7,7 @@
 #include "planner/ompl/GeometricStateSpace.hpp"
 #include "planner/ompl/GoalRegion.hpp"
 #include "planner/ompl/MotionValidator.hpp"
+#include "planner/ompl/NearestNeighborsKdTree.hpp"
 #include "planner/ompl/Planner.hpp"
 #include "planner/ompl/StateSampler.hpp"
 #include "planner/ompl/StateValidityChecker.hpp"
@@ -158,6 +158,12 @@ protected:
   /// A nearest-neighbor datastructure representing a tree of motions */
   using TreeData = ompl_shared_ptr<::ompl::NearestNeighbors<Motion*>>;
 
+  /// Configure a tree for planning. If the tree is null, it defaults to a
+  /// NearestNeighborsKdTree when the distance metric of the state space is
+  /// supported by it, and to a GNAT otherwise.
+  /// \param[in,out] tree The tree to configure
+  void setupTree(TreeData& tree);
+
   /// A nearest-neighbors datastructure containing the tree of motions
   TreeData mStartTree;
 
@@ -98,6 +98,19 @@ public:
       const ::ompl::base::State* _state1,
       const ::ompl::base::State* _state2) const override;
 
+  /// Computes distance between two states if it is at most a bound, using
+  /// the _dmetric defined in the constructor. See
+  /// distance::DistanceMetric::distanceBounded.
+  /// \param _state1 The first state
+  /// \param _state2 The second state
+  /// \param _bound The distance threshold
+  /// \return the distance if it is at most _bound, otherwise any value
+  /// greater than _bound
+  double distanceBounded(
+      const ::ompl::base::State* _state1,
+      const ::ompl::base::State* _state2,
+      double _bound) const;
+
   /// Check state equality. The returns true if the distance between the states
   /// is 0.
   /// \param _state1 The first state
@@ -118,6 +131,15 @@ public:
       double _t,
       ::ompl::base::State* _state) const override;
 
+  /// Prepares the segment that connects two states to be interpolated at
+  /// many times, see statespace::Interpolator::prepare. The states must
+  /// outlive the returned segment.
+  /// \param _from The state that begins the segment
+  /// \param _to The state that ends the segment
+  /// \return The segment between the wrapped aikido states
+  statespace::EdgeInterpolationPtr prepareInterpolation(
+      const ::ompl::base::State* _from, const ::ompl::base::State* _to) const;
+
   /// Allocate an instance of the state sampler for this space.
   ::ompl::base::StateSamplerPtr allocDefaultStateSampler() const override;
 
@@ -137,6 +159,9 @@ public:
   /// Return the Aikido StateSpace that this OMPL StateSpace wraps
   statespace::StateSpacePtr getAikidoStateSpace() const;
 
+  /// Return the Aikido DistanceMetric used by distance()
+  distance::DistanceMetricPtr getAikidoDistanceMetric() const;
+
 private:
   statespace::StateSpacePtr mStateSpace;
   statespace::InterpolatorPtr mInterpolator;
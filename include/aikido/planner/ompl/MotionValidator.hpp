@@ -1,7 +1,15 @@
 #ifndef AIKIDO_PLANNER_OMPL_MOTIONVALIDATOR_HPP_
 #define AIKIDO_PLANNER_OMPL_MOTIONVALIDATOR_HPP_
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <ompl/base/MotionValidator.h>
+#include "../../constraint/DistanceTestable.hpp"
 
 namespace aikido {
 namespace planner {
@@ -9,6 +17,17 @@ namespace ompl {
 
 /// Implement an OMPL MotionValidator.  This class checks the validity
 ///  of path segments between states.
+///
+/// Optionally, the results of whole segments are kept in a bounded cache
+/// with least recently used eviction, since shortcutting and repeated
+/// connection attempts check the same segments many times. Segments are
+/// identified by their endpoints, whose log maps are quantized to a
+/// resolution. The cache is cleared when the environment version changes.
+///
+/// If a clearance constraint is set, segments are checked by conservative
+/// advancement instead of sampling at a fixed resolution: the clearance of
+/// each checked state proves a portion of the segment valid, which is
+/// skipped. In free space, this takes only a few queries per segment.
 class MotionValidator : public ::ompl::base::MotionValidator
 {
 public:
@@ -43,8 +62,191 @@ public:
       const ::ompl::base::State* _s2,
       std::pair<::ompl::base::State*, double>& _lastValid) const override;
 
+  /// Enables or disables the segment cache. This clears the cache.
+  /// \param _capacity Maximum number of cached segments, or zero to disable
+  /// the cache
+  /// \param _resolution Resolution at which the log maps of the endpoints
+  /// are quantized. Segments whose endpoints are within this resolution of
+  /// each other share a cache entry.
+  /// \throw std::invalid_argument if the cache is enabled and the planning
+  /// StateSpace is not a GeometricStateSpace or _resolution is not positive
+  void setCache(std::size_t _capacity, double _resolution = 1e-6);
+
+  /// Get the maximum number of cached segments, zero if the cache is disabled
+  std::size_t getCacheCapacity() const;
+
+  /// Removes all cached segments.
+  void clearCache();
+
+  /// Sets the version of the environment, e.g. a counter that is incremented
+  /// whenever an obstacle moves. Cached segments are discarded when the
+  /// version changes, and segments that were being checked concurrently with
+  /// the change are not cached.
+  /// \param _version Version of the environment
+  void setEnvironmentVersion(std::uint64_t _version);
+
+  /// Get the version of the environment
+  std::uint64_t getEnvironmentVersion() const;
+
+  /// Enables or disables conservative advancement. States on a segment are
+  /// then only tested against \c _constraint, and the end of the segment is
+  /// tested with the validity checker of the planning space as well. This
+  /// clears the segment cache.
+  /// \param _constraint Constraint that computes the clearance of states, or
+  /// \c nullptr to sample segments at a fixed resolution. Its displacement
+  /// bound must hold for the distance metric of the planning space.
+  /// \throw std::invalid_argument if the planning StateSpace is not a
+  /// GeometricStateSpace, _constraint does not match its aikido StateSpace or
+  /// the displacement bound of _constraint is not positive
+  void setClearanceConstraint(constraint::DistanceTestablePtr _constraint);
+
+  /// Get the constraint used for conservative advancement, or \c nullptr
+  constraint::DistanceTestablePtr getClearanceConstraint() const;
+
+  /// Get the number of segments whose result was found in the cache
+  std::size_t getNumCacheHits() const;
+
+  /// Get the number of segments that were checked while the cache was enabled
+  /// because their result was not in the cache
+  std::size_t getNumCacheMisses() const;
+
 private:
+  /// Quantized endpoints of a segment.
+  using CacheKey = std::vector<std::int64_t>;
+
+  /// Hash function for CacheKey.
+  struct CacheKeyHash
+  {
+    std::size_t operator()(const CacheKey& _key) const;
+  };
+
+  /// Cached result of a segment.
+  struct CacheEntry
+  {
+    /// Whether the whole segment is valid
+    bool mValid;
+
+    /// Segment time of the last valid state, negative if the segment was
+    /// only checked by the overload without the last valid state
+    double mLastValidTime;
+  };
+
+  using CacheList = std::list<std::pair<CacheKey, CacheEntry>>;
+
+  /// Computes the cache key of the segment from \c _s1 to \c _s2.
+  CacheKey computeCacheKey(
+      const ::ompl::base::State* _s1, const ::ompl::base::State* _s2) const;
+
+  /// Looks up a segment in the cache, marks it as most recently used and
+  /// counts a hit or a miss.
+  /// \param _key Key of the segment
+  /// \param _needsLastValidTime Whether an entry without the last valid time
+  /// of an invalid segment counts as a miss
+  /// \param[out] _entry Cached entry of the segment
+  /// \return Whether the segment was found
+  bool findCacheEntry(
+      const CacheKey& _key,
+      bool _needsLastValidTime,
+      CacheEntry& _entry) const;
+
+  /// Adds or replaces the cached result of a segment, evicting the least
+  /// recently used segment if the cache is full. The result is discarded if
+  /// the environment changed while the segment was checked.
+  /// \param _key Key of the segment
+  /// \param _entry Result of the segment
+  /// \param _environmentVersion Version of the environment when the check of
+  /// the segment started
+  void insertCacheEntry(
+      CacheKey _key,
+      const CacheEntry& _entry,
+      std::uint64_t _environmentVersion) const;
+
+  /// Checks the segment from \c _s1 to \c _s2 by conservative advancement
+  /// with mClearanceConstraint.
+  /// \param _s1 The state at the start of the segment
+  /// \param _s2 The state at the end of the segment
+  /// \param[out] _lastValidTime Segment time of the last checked valid state
+  /// \return Whether the segment is valid
+  bool checkMotionConservatively(
+      const ::ompl::base::State* _s1,
+      const ::ompl::base::State* _s2,
+      double& _lastValidTime) const;
+
+  /// Finds the first invalid state among the states at times \c _times on
+  /// the segment from \c _s1 to \c _s2. If the validity checker of the
+  /// planning space is an aikido \c StateValidityChecker, the states are
+  /// tested in chunks with \c StateValidityChecker::isValidBatch.
+  /// \param _s1 The state at the start of the segment
+  /// \param _s2 The state at the end of the segment
+  /// \param _times Segment times (between 0 and 1) of the states to check
+  /// \return Index of the first invalid state in \c _times, or its size if
+  /// all states are valid
+  std::size_t findFirstInvalidState(
+      const ::ompl::base::State* _s1,
+      const ::ompl::base::State* _s2,
+      const std::vector<double>& _times) const;
+
+  /// Returns whether all states at times \c _times on the segment from
+  /// \c _s1 to \c _s2 are valid. Unlike \c findFirstInvalidState, the states
+  /// may be tested in any order, so a parallel checker stops all of its
+  /// workers at the first invalid state it finds, see
+  /// \c StateValidityChecker::areAllValid.
+  /// \param _s1 The state at the start of the segment
+  /// \param _s2 The state at the end of the segment
+  /// \param _times Segment times (between 0 and 1) of the states to check
+  bool areAllStatesValid(
+      const ::ompl::base::State* _s1,
+      const ::ompl::base::State* _s2,
+      const std::vector<double>& _times) const;
+
+  /// Interpolates the states at times \c _times on the segment from \c _s1
+  /// to \c _s2 in chunks of consecutive times, and calls \c _testChunk on
+  /// each chunk. The same states are reused for all chunks, and no further
+  /// chunk is interpolated once \c _testChunk finds an invalid state.
+  /// \param _s1 The state at the start of the segment
+  /// \param _s2 The state at the end of the segment
+  /// \param _times Segment times (between 0 and 1) of the states to check
+  /// \param _testChunk Function that returns the index of the first invalid
+  /// state of a chunk, or the size of the chunk if all of its states are
+  /// valid
+  /// \return Index of the first invalid state in \c _times, or its size if
+  /// all states are valid
+  std::size_t testStatesInChunks(
+      const ::ompl::base::State* _s1,
+      const ::ompl::base::State* _s2,
+      const std::vector<double>& _times,
+      const std::function<
+          std::size_t(const std::vector<const ::ompl::base::State*>&)>&
+          _testChunk) const;
+
+  /// Prepares the segment from \c _s1 to \c _s2 to be interpolated at many
+  /// times. If the planning space is a GeometricStateSpace, quantities that
+  /// only depend on the endpoints are computed once, see
+  /// statespace::Interpolator::prepare.
+  /// \param _s1 The state at the start of the segment
+  /// \param _s2 The state at the end of the segment
+  /// \return Function that sets its second argument to the state at the
+  /// segment time given by its first argument
+  std::function<void(double, ::ompl::base::State*)> prepareSegment(
+      const ::ompl::base::State* _s1, const ::ompl::base::State* _s2) const;
+
   double mSequenceResolution;
+  constraint::DistanceTestablePtr mClearanceConstraint;
+
+  /// Cache configuration and version of the environment. They are written
+  /// under mCacheMutex, and are atomic so checkMotion can read them without
+  /// locking it.
+  std::atomic<std::size_t> mCacheCapacity;
+  std::atomic<double> mCacheResolution;
+  std::atomic<std::uint64_t> mEnvironmentVersion;
+
+  /// Cached segments, most recently used first, and their index by key.
+  mutable std::mutex mCacheMutex;
+  mutable CacheList mCacheList;
+  mutable std::unordered_map<CacheKey, CacheList::iterator, CacheKeyHash>
+      mCacheIndex;
+  mutable std::size_t mNumCacheHits;
+  mutable std::size_t mNumCacheMisses;
 };
 
 } // namespace ompl
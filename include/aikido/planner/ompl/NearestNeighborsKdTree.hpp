@@ -0,0 +1,108 @@
+#ifndef AIKIDO_PLANNER_OMPL_NEARESTNEIGHBORSKDTREE_HPP_
+#define AIKIDO_PLANNER_OMPL_NEARESTNEIGHBORSKDTREE_HPP_
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <ompl/datastructures/NearestNeighbors.h>
+#include "../../distance/NearestNeighborIndex.hpp"
+
+namespace aikido {
+namespace planner {
+namespace ompl {
+
+/// Nearest neighbors datastructure backed by a distance::NearestNeighborIndex.
+///
+/// The data is indexed by the aikido states returned by a state function,
+/// using a metric that must be supported by distance::NearestNeighborIndex.
+/// The metric must be consistent with the distance function of this
+/// datastructure, which is only used if no metric is set. In that case,
+/// queries fall back to a linear scan.
+template <typename _T>
+class NearestNeighborsKdTree : public ::ompl::NearestNeighbors<_T>
+{
+public:
+  /// Returns the aikido state of an element.
+  using StateFunction
+      = std::function<const statespace::StateSpace::State*(const _T&)>;
+
+  NearestNeighborsKdTree();
+
+  virtual ~NearestNeighborsKdTree() = default;
+
+  /// Sets the metric used to index the data. Data that was already added is
+  /// indexed again.
+  ///
+  /// \param _metric distance metric, see
+  ///        distance::NearestNeighborIndex::isSupported()
+  /// \param _stateFunction returns the aikido state of an element
+  /// \throw std::invalid_argument if _metric is not supported or
+  ///        _stateFunction is empty
+  void setMetric(
+      distance::DistanceMetricPtr _metric, StateFunction _stateFunction);
+
+  /// Sets the approximation factor of queries, see
+  /// distance::NearestNeighborIndex::setApproximationFactor().
+  void setApproximationFactor(double _epsilon);
+
+  /// Gets the approximation factor of queries.
+  double getApproximationFactor() const;
+
+  // Documentation inherited.
+  bool reportsSortedResults() const override;
+
+  // Documentation inherited.
+  void clear() override;
+
+  // Documentation inherited.
+  void add(const _T& _data) override;
+
+  // Documentation inherited.
+  void add(const std::vector<_T>& _data) override;
+
+  // Documentation inherited.
+  bool remove(const _T& _data) override;
+
+  // Documentation inherited.
+  _T nearest(const _T& _data) const override;
+
+  // Documentation inherited.
+  void nearestK(
+      const _T& _data, std::size_t _k, std::vector<_T>& _nbh) const override;
+
+  // Documentation inherited.
+  void nearestR(
+      const _T& _data, double _radius, std::vector<_T>& _nbh) const override;
+
+  // Documentation inherited.
+  std::size_t size() const override;
+
+  // Documentation inherited.
+  void list(std::vector<_T>& _data) const override;
+
+private:
+  /// Sorts the data that is not removed by distance to _data with the
+  /// distance function, keeping the first _k within _radius.
+  void linearSearch(
+      const _T& _data,
+      std::size_t _k,
+      double _radius,
+      std::vector<_T>& _nbh) const;
+
+  std::unique_ptr<distance::NearestNeighborIndex> mIndex;
+  StateFunction mStateFunction;
+  double mApproximationFactor;
+
+  /// Data in the order it was added, including removed data.
+  std::vector<_T> mData;
+  std::vector<bool> mRemoved;
+  std::size_t mNumRemoved;
+};
+
+} // namespace ompl
+} // namespace planner
+} // namespace aikido
+
+#include "detail/NearestNeighborsKdTree-impl.hpp"
+
+#endif // AIKIDO_PLANNER_OMPL_NEARESTNEIGHBORSKDTREE_HPP_
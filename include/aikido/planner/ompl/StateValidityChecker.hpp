@@ -1,6 +1,7 @@
 #ifndef AIKIDO_OMPL_AIKIDOSTATEVALIDITYCHECKER_HPP_
 #define AIKIDO_OMPL_AIKIDOSTATEVALIDITYCHECKER_HPP_
 
+#include <vector>
 #include <ompl/base/SpaceInformation.h>
 #include <ompl/base/StateValidityChecker.h>
 #include "../../constraint/Testable.hpp"
@@ -31,6 +32,24 @@ public:
   /// \param _state The state to check
   bool isValid(const ::ompl::base::State* _state) const override;
 
+  /// Batched version of \c isValid that tests all states with a single call
+  /// to \c Testable::isSatisfiedBatch.
+  /// \param _states The states to check
+  /// \param[out] _out Validity of each state, resized to the number of states
+  /// \param _earlyExit Whether to stop at the first invalid state, in which
+  /// case the validity of all following states is set to false
+  /// \return true if all states are valid
+  bool isValidBatch(
+      const std::vector<const ::ompl::base::State*>& _states,
+      std::vector<bool>& _out,
+      bool _earlyExit) const;
+
+  /// Returns true if all states are valid, testing them with a single call to
+  /// \c Testable::areAllSatisfied. The states may be tested in any order.
+  /// \param _states The states to check
+  bool areAllValid(
+      const std::vector<const ::ompl::base::State*>& _states) const;
+
 private:
   constraint::TestablePtr mConstraint;
 };
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <ompl/util/Exception.h>
+
+namespace aikido {
+namespace planner {
+namespace ompl {
+
+//==============================================================================
+template <typename _T>
+NearestNeighborsKdTree<_T>::NearestNeighborsKdTree()
+  : ::ompl::NearestNeighbors<_T>(), mApproximationFactor(0.), mNumRemoved(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename _T>
+void NearestNeighborsKdTree<_T>::setMetric(
+    distance::DistanceMetricPtr _metric, StateFunction _stateFunction)
+{
+  if (!_stateFunction)
+    throw std::invalid_argument("State function is empty.");
+
+  std::unique_ptr<distance::NearestNeighborIndex> index(
+      new distance::NearestNeighborIndex(std::move(_metric)));
+  index->setApproximationFactor(mApproximationFactor);
+
+  for (std::size_t i = 0; i < mData.size(); ++i)
+  {
+    index->add(_stateFunction(mData[i]));
+    if (mRemoved[i])
+      index->remove(i);
+  }
+
+  mIndex = std::move(index);
+  mStateFunction = std::move(_stateFunction);
+}
+
+//==============================================================================
+template <typename _T>
+void NearestNeighborsKdTree<_T>::setApproximationFactor(double _epsilon)
+{
+  if (_epsilon < 0.)
+    throw std::invalid_argument("Approximation factor is negative.");
+
+  mApproximationFactor = _epsilon;
+  if (mIndex)
+    mIndex->setApproximationFactor(_epsilon);
+}
+
+//==============================================================================
+template <typename _T>
+double NearestNeighborsKdTree<_T>::getApproximationFactor() const
+{
+  return mApproximationFactor;
+}
+
+//==============================================================================
+template <typename _T>
+bool NearestNeighborsKdTree<_T>::reportsSortedResults() const
+{
+  return true;
+}
+
+//==============================================================================
+template <typename _T>
+void NearestNeighborsKdTree<_T>::clear()
+{
+  mData.clear();
+  mRemoved.clear();
+  mNumRemoved = 0;
+
+  if (mIndex)
+    mIndex->clear();
+}
+
+//==============================================================================
+template <typename _T>
+void NearestNeighborsKdTree<_T>::add(const _T& _data)
+{
+  mData.push_back(_data);
+  mRemoved.push_back(false);
+
+  if (mIndex)
+    mIndex->add(mStateFunction(_data));
+}
+
+//==============================================================================
+template <typename _T>
+void NearestNeighborsKdTree<_T>::add(const std::vector<_T>& _data)
+{
+  for (const auto& data : _data)
+    add(data);
+}
+
+//==============================================================================
+template <typename _T>
+bool NearestNeighborsKdTree<_T>::remove(const _T& _data)
+{
+  for (std::size_t i = 0; i < mData.size(); ++i)
+  {
+    if (!mRemoved[i] && mData[i] == _data)
+    {
+      mRemoved[i] = true;
+      ++mNumRemoved;
+
+      if (mIndex)
+        mIndex->remove(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+//==============================================================================
+template <typename _T>
+_T NearestNeighborsKdTree<_T>::nearest(const _T& _data) const
+{
+  std::vector<_T> nbh;
+  nearestK(_data, 1, nbh);
+
+  if (nbh.empty())
+    throw ::ompl::Exception("No elements found in nearest neighbors data "
+                            "structure");
+  return nbh.front();
+}
+
+//==============================================================================
+template <typename _T>
+void NearestNeighborsKdTree<_T>::nearestK(
+    const _T& _data, std::size_t _k, std::vector<_T>& _nbh) const
+{
+  if (!mIndex)
+  {
+    linearSearch(_data, _k, std::numeric_limits<double>::infinity(), _nbh);
+    return;
+  }
+
+  std::vector<std::size_t> indices;
+  mIndex->nearestK(mStateFunction(_data), _k, indices);
+
+  _nbh.clear();
+  _nbh.reserve(indices.size());
+  for (const auto index : indices)
+    _nbh.push_back(mData[index]);
+}
+
+//==============================================================================
+template <typename _T>
+void NearestNeighborsKdTree<_T>::nearestR(
+    const _T& _data, double _radius, std::vector<_T>& _nbh) const
+{
+  if (!mIndex)
+  {
+    linearSearch(_data, mData.size(), _radius, _nbh);
+    return;
+  }
+
+  std::vector<std::size_t> indices;
+  mIndex->nearestR(mStateFunction(_data), _radius, indices);
+
+  _nbh.clear();
+  _nbh.reserve(indices.size());
+  for (const auto index : indices)
+    _nbh.push_back(mData[index]);
+}
+
+//==============================================================================
+template <typename _T>
+std::size_t NearestNeighborsKdTree<_T>::size() const
+{
+  return mData.size() - mNumRemoved;
+}
+
+//==============================================================================
+template <typename _T>
+void NearestNeighborsKdTree<_T>::list(std::vector<_T>& _data) const
+{
+  _data.clear();
+  _data.reserve(size());
+  for (std::size_t i = 0; i < mData.size(); ++i)
+  {
+    if (!mRemoved[i])
+      _data.push_back(mData[i]);
+  }
+}
+
+//==============================================================================
+template <typename _T>
+void NearestNeighborsKdTree<_T>::linearSearch(
+    const _T& _data,
+    std::size_t _k,
+    double _radius,
+    std::vector<_T>& _nbh) const
+{
+  std::vector<std::pair<double, std::size_t>> neighbors;
+  neighbors.reserve(size());
+  for (std::size_t i = 0; i < mData.size(); ++i)
+  {
+    if (mRemoved[i])
+      continue;
+
+    const double distance = this->distFun_(_data, mData[i]);
+    if (distance <= _radius)
+      neighbors.emplace_back(distance, i);
+  }
+
+  const auto numNeighbors = std::min(_k, neighbors.size());
+  std::partial_sort(
+      neighbors.begin(), neighbors.begin() + numNeighbors, neighbors.end());
+
+  _nbh.clear();
+  _nbh.reserve(numNeighbors);
+  for (std::size_t i = 0; i < numNeighbors; ++i)
+    _nbh.push_back(mData[neighbors[i].second]);
+}
+
+} // namespace ompl
+} // namespace planner
+} // namespace aikido
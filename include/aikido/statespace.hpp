@@ -1,13 +1,19 @@
 #include "statespace/CartesianProduct.hpp"
+#include "statespace/EdgeInterpolation.hpp"
 #include "statespace/GeodesicInterpolator.hpp"
+#include "statespace/InlineScopedState.hpp"
 #include "statespace/Interpolator.hpp"
+#include "statespace/PooledState.hpp"
 #include "statespace/Rn.hpp"
 #include "statespace/SE2.hpp"
 #include "statespace/SE3.hpp"
 #include "statespace/SO2.hpp"
 #include "statespace/SO3.hpp"
 #include "statespace/ScopedState.hpp"
+#include "statespace/StateArray.hpp"
 #include "statespace/StateHandle.hpp"
+#include "statespace/StatePool.hpp"
+#include "statespace/StaticCartesianProduct.hpp"
 #include "statespace/StateSpace.hpp"
 #include "statespace/dart/JointStateSpace.hpp"
 #include "statespace/dart/JointStateSpaceHelpers.hpp"
@@ -16,6 +22,7 @@
 #include "statespace/dart/RnJoint.hpp"
 #include "statespace/dart/SE2Joint.hpp"
 #include "statespace/dart/SE3Joint.hpp"
+#include "statespace/dart/SkeletonReplicaPool.hpp"
 #include "statespace/dart/SO2Joint.hpp"
 #include "statespace/dart/SO3Joint.hpp"
 #include "statespace/dart/WeldJoint.hpp"
@@ -74,6 +74,13 @@ public:
   const typename Space::State* getSubState(
       const State* _state, std::size_t _index) const;
 
+  /// Gets the offset in bytes of the substate at an index from the start of
+  /// a state in this \c CartesianProduct.
+  ///
+  /// \param _index in the range [ 0, \c getNumSubspaces() ]
+  /// \return offset of the substate at \c _index
+  std::size_t getSubStateOffset(std::size_t _index) const;
+
   /// Gets substate of type \c Space::State from a CompoundState by index and
   /// wraps it in a \c Space::StateHandle helper class.
   ///
@@ -145,6 +152,31 @@ public:
   void logMap(
       const StateSpace::State* _in, Eigen::VectorXd& _tangent) const override;
 
+  /// Batched version of \c compose. This makes one batched call per subspace,
+  /// rather than one call per subspace for each state.
+  void composeBatch(
+      const StateSpace::State* _states1,
+      std::size_t _stride1,
+      const StateSpace::State* _states2,
+      std::size_t _stride2,
+      StateSpace::State* _out,
+      std::size_t _strideOut,
+      std::size_t _numStates) const override;
+
+  /// Batched version of \c expMap. This makes one batched call per subspace
+  /// on the corresponding rows of \c _tangents.
+  void expMapBatch(
+      const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+      StateSpace::State* _out,
+      std::size_t _stride) const override;
+
+  /// Batched version of \c logMap. This makes one batched call per subspace
+  /// on the corresponding rows of \c _tangents.
+  void logMapBatch(
+      const StateSpace::State* _in,
+      std::size_t _stride,
+      Eigen::Ref<Eigen::MatrixXd> _tangents) const override;
+
   /// Print the contents of each substate contained in the state
   /// as a list with each substate enclosed in brackets and including its
   /// index
@@ -0,0 +1,61 @@
+#ifndef AIKIDO_STATESPACE_EDGEINTERPOLATION_HPP_
+#define AIKIDO_STATESPACE_EDGEINTERPOLATION_HPP_
+
+#include <memory>
+#include <Eigen/Core>
+#include "StateSpace.hpp"
+
+namespace aikido {
+namespace statespace {
+
+/// Path between two states that is prepared by \c Interpolator::prepare to be
+/// evaluated at many path parameters, e.g. to check an edge for collision at
+/// a fine resolution. Quantities that only depend on the endpoints, such as
+/// the tangent vector of a geodesic, are computed once when the path is
+/// prepared instead of once per path parameter.
+///
+/// The endpoints are not copied, so they must outlive the path.
+class EdgeInterpolation
+{
+public:
+  virtual ~EdgeInterpolation() = default;
+
+  /// Computes the state that lies at path parameter \c _alpha along the path,
+  /// as \c Interpolator::interpolate does for the endpoints of the path.
+  ///
+  /// \param _alpha path parameter in the range [0, 1]
+  /// \param[out] _state output interpolated state
+  virtual void interpolate(
+      double _alpha, statespace::StateSpace::State* _state) const = 0;
+
+  /// Batched version of \c interpolate, as \c Interpolator::interpolateBatch.
+  ///
+  /// The default implementation calls \c interpolate once for each element
+  /// of \c _alphas.
+  ///
+  /// \param _alphas path parameters in the range [0, 1]
+  /// \param[out] _out array of output interpolated states
+  /// \param _stride stride of \c _out in bytes
+  virtual void interpolateBatch(
+      const Eigen::VectorXd& _alphas,
+      statespace::StateSpace::State* _out,
+      std::size_t _stride) const;
+
+  /// Computes the <tt>_derivative</tt>-th derivative of the path at path
+  /// parameter \c _alpha, as \c Interpolator::getDerivative.
+  ///
+  /// \param _derivative order of the derivative to compute
+  /// \param _alpha path parameter in the range [0, 1]
+  /// \param[out] _tangentVector output element of the tangent space
+  virtual void getDerivative(
+      std::size_t _derivative,
+      double _alpha,
+      Eigen::VectorXd& _tangentVector) const = 0;
+};
+
+using EdgeInterpolationPtr = std::unique_ptr<EdgeInterpolation>;
+
+} // namespace statespace
+} // namespace aikido
+
+#endif // ifndef AIKIDO_STATESPACE_EDGEINTERPOLATION_HPP_
@@ -45,6 +45,16 @@ public:
       double _alpha,
       statespace::StateSpace::State* _state) const override;
 
+  /// Batched version of \c interpolate. The tangent vector is computed once
+  /// and the states are generated with \c StateSpace::expMapBatch and
+  /// \c StateSpace::composeBatch.
+  void interpolateBatch(
+      const statespace::StateSpace::State* _from,
+      const statespace::StateSpace::State* _to,
+      const Eigen::VectorXd& _alphas,
+      statespace::StateSpace::State* _out,
+      std::size_t _stride) const override;
+
   // Documentation inherited.
   void getDerivative(
       const statespace::StateSpace::State* _from,
@@ -53,6 +63,17 @@ public:
       double _alpha,
       Eigen::VectorXd& _tangentVector) const override;
 
+  /// Prepares the geodesic from \c _from to \c _to, computing its tangent
+  /// vector once. Evaluating the returned path only requires an \c expMap
+  /// and a \c compose per path parameter.
+  ///
+  /// \param _from start state in \c getStateSpace()
+  /// \param _to end state in \c getStateSpace()
+  /// \return path from \c _from to \c _to
+  EdgeInterpolationPtr prepare(
+      const statespace::StateSpace::State* _from,
+      const statespace::StateSpace::State* _to) const override;
+
 private:
   statespace::StateSpacePtr mStateSpace;
 };
@@ -0,0 +1,72 @@
+#ifndef AIKIDO_STATESPACE_INLINESCOPEDSTATE_HPP_
+#define AIKIDO_STATESPACE_INLINESCOPEDSTATE_HPP_
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include "StateHandle.hpp"
+
+namespace aikido {
+namespace statespace {
+
+/// Default size, in bytes, of the inline buffer of an \c InlineScopedState.
+/// This is large enough for an \c SO2 state, an \c SE3 state, or the state of
+/// a \c MetaSkeletonStateSpace of a typical manipulator.
+constexpr std::size_t INLINE_SCOPED_STATE_BUFFER_SIZE = 128;
+
+/// CRTP RAII wrapper for a \c StateHandle that stores its state in an inline
+/// buffer of \c _BufferSize bytes. This is a variant of \c ScopedState for
+/// temporary states that are created on the stack: the state is only
+/// allocated on the heap if \c getStateSizeInBytes() exceeds \c _BufferSize.
+///
+/// Since the state may live inside the object itself, \c InlineScopedState is
+/// neither copyable nor movable.
+///
+/// \tparam _Handle \c StateHandle class being wrapped.
+/// \tparam _BufferSize size of the inline buffer in bytes.
+template <class _Handle,
+          std::size_t _BufferSize = INLINE_SCOPED_STATE_BUFFER_SIZE>
+class InlineScopedState : public _Handle
+{
+public:
+  using Handle = _Handle;
+  using typename Handle::StateSpace;
+  using typename Handle::State;
+  using typename Handle::QualifiedState;
+
+  static_assert(_BufferSize > 0, "Buffer size must be positive.");
+
+  /// Size of the inline buffer in bytes.
+  static constexpr std::size_t BufferSize = _BufferSize;
+
+  /// Construct an \c InlineScopedState by allocating a new state in
+  /// \c _space. This state will be freed when \c InlineScopedState is
+  /// destructed.
+  ///
+  /// \param _space state space
+  explicit InlineScopedState(const StateSpace* _space);
+
+  virtual ~InlineScopedState();
+
+  InlineScopedState(const InlineScopedState&) = delete;
+  InlineScopedState(InlineScopedState&&) = delete;
+  InlineScopedState& operator=(const InlineScopedState&) = delete;
+  InlineScopedState& operator=(InlineScopedState&&) = delete;
+
+  /// Returns whether the state is stored in the inline buffer, i.e. it did
+  /// not require a heap allocation.
+  ///
+  /// \return true if the state is stored inline
+  bool isInline() const;
+
+private:
+  typename std::aligned_storage<_BufferSize, alignof(std::max_align_t)>::type
+      mInlineBuffer;
+  std::unique_ptr<char[]> mHeapBuffer;
+};
+
+} // namespace statespace
+} // namespace aikido
+
+#include "detail/InlineScopedState-impl.hpp"
+
+#endif // ifndef AIKIDO_STATESPACE_INLINESCOPEDSTATE_HPP_
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include "../statespace/StateSpace.hpp"
+#include "EdgeInterpolation.hpp"
 
 namespace aikido {
 namespace statespace {
@@ -34,6 +35,25 @@ public:
       double _alpha,
       statespace::StateSpace::State* _state) const = 0;
 
+  /// Batched version of \c interpolate that computes the state at each path
+  /// parameter in \c _alphas. The i-th output state starts \c _stride bytes
+  /// after the (i-1)-th output state, as in \c StateSpace::composeBatch.
+  ///
+  /// The default implementation calls \c interpolate once for each element
+  /// of \c _alphas.
+  ///
+  /// \param _from start state in \c getStateSpace()
+  /// \param _to end state in \c getStateSpace()
+  /// \param _alphas path parameters in the range [0, 1]
+  /// \param[out] _out array of output interpolated states
+  /// \param _stride stride of \c _out in bytes
+  virtual void interpolateBatch(
+      const statespace::StateSpace::State* _from,
+      const statespace::StateSpace::State* _to,
+      const Eigen::VectorXd& _alphas,
+      statespace::StateSpace::State* _out,
+      std::size_t _stride) const;
+
   /// Computes the <tt>_derivative</tt>-th derivative of the path at path
   /// parameter \c _alpha between \c _from and \c _to. The output is an element
   /// of the tangent space in the local (i.e. "body") frame.
@@ -49,6 +69,21 @@ public:
       std::size_t _derivative,
       double _alpha,
       Eigen::VectorXd& _tangentVector) const = 0;
+
+  /// Prepares the path that connects \c _from to \c _to to be evaluated at
+  /// many path parameters. Use this instead of \c interpolate when the same
+  /// path is evaluated repeatedly. The endpoints and this \c Interpolator
+  /// must outlive the returned path.
+  ///
+  /// The default implementation returns a path that calls \c interpolate and
+  /// \c getDerivative with the endpoints.
+  ///
+  /// \param _from start state in \c getStateSpace()
+  /// \param _to end state in \c getStateSpace()
+  /// \return path from \c _from to \c _to
+  virtual EdgeInterpolationPtr prepare(
+      const statespace::StateSpace::State* _from,
+      const statespace::StateSpace::State* _to) const;
 };
 
 using InterpolatorPtr = std::shared_ptr<Interpolator>;
@@ -0,0 +1,50 @@
+#ifndef AIKIDO_STATESPACE_POOLEDSTATE_HPP_
+#define AIKIDO_STATESPACE_POOLEDSTATE_HPP_
+#include "StateHandle.hpp"
+#include "StatePool.hpp"
+
+namespace aikido {
+namespace statespace {
+
+/// CRTP RAII wrapper for a \c StateHandle that borrows its state from a
+/// \c StatePool. The constructor of \c PooledState acquires a state from the
+/// pool and the destructor releases it. Unlike \c ScopedState, this does not
+/// allocate memory once the pool is warmed up.
+///
+/// \tparam _Handle \c StateHandle class being wrapped.
+template <class _Handle>
+class PooledState : public _Handle
+{
+public:
+  using Handle = _Handle;
+  using typename Handle::StateSpace;
+  using typename Handle::State;
+  using typename Handle::QualifiedState;
+
+  /// Construct a \c PooledState by acquiring a state from \c _pool. This state
+  /// will be released when \c PooledState is destructed.
+  ///
+  /// \param _space state space of the state, must be the state space of
+  /// \c _pool
+  /// \param _pool pool to acquire the state from
+  PooledState(const StateSpace* _space, StatePool* _pool);
+
+  virtual ~PooledState();
+
+  // PooledState is uncopyable, must use std::move
+  PooledState(const PooledState&) = delete;
+  PooledState& operator=(const PooledState&) = delete;
+
+  PooledState(PooledState&& _other);
+  PooledState& operator=(PooledState&&) = delete;
+
+private:
+  StatePool* mPool;
+};
+
+} // namespace statespace
+} // namespace aikido
+
+#include "detail/PooledState-impl.hpp"
+
+#endif // ifndef AIKIDO_STATESPACE_POOLEDSTATE_HPP_
@@ -130,6 +130,32 @@ public:
   void logMap(
       const StateSpace::State* _in, Eigen::VectorXd& _tangent) const override;
 
+  /// Batched version of \c compose. This is evaluated as a single Eigen
+  /// expression over the matrix formed by the states when the strides are
+  /// multiples of \c sizeof(double).
+  void composeBatch(
+      const StateSpace::State* _states1,
+      std::size_t _stride1,
+      const StateSpace::State* _states2,
+      std::size_t _stride2,
+      StateSpace::State* _out,
+      std::size_t _strideOut,
+      std::size_t _numStates) const override;
+
+  /// Batched version of \c expMap. This is a single matrix copy when the
+  /// stride is a multiple of \c sizeof(double).
+  void expMapBatch(
+      const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+      StateSpace::State* _out,
+      std::size_t _stride) const override;
+
+  /// Batched version of \c logMap. This is a single matrix copy when the
+  /// stride is a multiple of \c sizeof(double).
+  void logMapBatch(
+      const StateSpace::State* _in,
+      std::size_t _stride,
+      Eigen::Ref<Eigen::MatrixXd> _tangents) const override;
+
   /// Print the n-dimensional vector represented by the state
   /// Format: [x_1, x_2, ..., x_n]
   void print(const StateSpace::State* _state, std::ostream& _os) const override;
@@ -142,6 +168,31 @@ private:
   /// \return mutable reference to real vector stored in \c _state
   Eigen::Map<VectorNd> getMutableValue(State* _state) const;
 
+  using MatrixNd = Eigen::Matrix<double, N, Eigen::Dynamic>;
+
+  /// Maps an array of states, whose stride must be a multiple of
+  /// \c sizeof(double), to a matrix with one column per state.
+  ///
+  /// \param _states array of states in this state space
+  /// \param _stride stride of \c _states in bytes
+  /// \param _numStates number of states in \c _states
+  /// \return matrix view of \c _states
+  Eigen::Map<const MatrixNd, 0, Eigen::OuterStride<>> getValues(
+      const StateSpace::State* _states,
+      std::size_t _stride,
+      std::size_t _numStates) const;
+
+  /// Mutable version of \c getValues.
+  ///
+  /// \param _states array of states in this state space
+  /// \param _stride stride of \c _states in bytes
+  /// \param _numStates number of states in \c _states
+  /// \return mutable matrix view of \c _states
+  Eigen::Map<MatrixNd, 0, Eigen::OuterStride<>> getMutableValues(
+      StateSpace::State* _states,
+      std::size_t _stride,
+      std::size_t _numStates) const;
+
   /// Dimension of the real vector space. Note that this value is only used for
   /// dynamic sized vector space (the dimension is changable).
   ///
@@ -141,6 +141,31 @@ public:
   void logMap(
       const StateSpace::State* _in, Eigen::VectorXd& _tangent) const override;
 
+  /// Batched version of \c compose. Angles are added directly, without a
+  /// virtual call per state.
+  void composeBatch(
+      const StateSpace::State* _states1,
+      std::size_t _stride1,
+      const StateSpace::State* _states2,
+      std::size_t _stride2,
+      StateSpace::State* _out,
+      std::size_t _strideOut,
+      std::size_t _numStates) const override;
+
+  /// Batched version of \c expMap. Angles are copied directly, without a
+  /// virtual call per state.
+  void expMapBatch(
+      const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+      StateSpace::State* _out,
+      std::size_t _stride) const override;
+
+  /// Batched version of \c logMap. Angles are copied directly, without a
+  /// virtual call per state.
+  void logMapBatch(
+      const StateSpace::State* _in,
+      std::size_t _stride,
+      Eigen::Ref<Eigen::MatrixXd> _tangents) const override;
+
   /// Print the angle represented by the state
   void print(const StateSpace::State* _state, std::ostream& _os) const override;
 };
@@ -0,0 +1,87 @@
+#ifndef AIKIDO_STATESPACE_STATEARRAY_HPP_
+#define AIKIDO_STATESPACE_STATEARRAY_HPP_
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include "StateSpace.hpp"
+
+namespace aikido {
+namespace statespace {
+
+/// Size, in bytes, of the inline buffer of a \c StateArray.
+constexpr std::size_t STATE_ARRAY_BUFFER_SIZE = 2048;
+
+/// Fixed-size array of states of a \c StateSpace that are stored contiguously
+/// with a stride of \c StateSpace::getStateStrideInBytes(). This is the layout
+/// expected by the batched operations of \c StateSpace, e.g.
+/// \c StateSpace::expMapBatch.
+///
+/// Arrays of up to \c getInlineCapacity() states are stored in an inline
+/// buffer, so a temporary \c StateArray created on the stack does not allocate
+/// memory. Batched algorithms over an arbitrary number of states should reuse
+/// one such array for chunks of at most \c getInlineCapacity() states.
+///
+/// Since the states may live inside the object itself, \c StateArray is
+/// neither copyable nor movable.
+class StateArray
+{
+public:
+  /// Constructs an array of \c _size states allocated in \c _stateSpace.
+  /// These states are freed when the \c StateArray is destructed.
+  ///
+  /// \param _stateSpace state space
+  /// \param _size number of states
+  StateArray(const StateSpace* _stateSpace, std::size_t _size);
+
+  ~StateArray();
+
+  StateArray(const StateArray&) = delete;
+  StateArray(StateArray&&) = delete;
+  StateArray& operator=(const StateArray&) = delete;
+  StateArray& operator=(StateArray&&) = delete;
+
+  /// Gets the maximum number of states of \c _stateSpace that a
+  /// \c StateArray stores without allocating memory, or one if a single state
+  /// does not fit in the inline buffer.
+  ///
+  /// \param _stateSpace state space
+  /// \return number of states that fit in the inline buffer
+  static std::size_t getInlineCapacity(const StateSpace* _stateSpace);
+
+  /// Gets the number of states in this array.
+  ///
+  /// \return number of states
+  std::size_t getSize() const;
+
+  /// Gets the distance, in bytes, between consecutive states in this array.
+  ///
+  /// \return stride passed to the batched operations of \c StateSpace
+  std::size_t getStride() const;
+
+  /// Returns whether the states are stored in the inline buffer, i.e. they
+  /// did not require a heap allocation.
+  ///
+  /// \return true if the states are stored inline
+  bool isInline() const;
+
+  /// Gets the state at \c _index. Passing an index equal to \c getSize()
+  /// returns the end of the array.
+  ///
+  /// \param _index index of the state
+  /// \return state at \c _index
+  StateSpace::State* getState(std::size_t _index) const;
+
+private:
+  const StateSpace* mStateSpace;
+  std::size_t mSize;
+  std::size_t mStride;
+  typename std::aligned_storage<STATE_ARRAY_BUFFER_SIZE,
+                                alignof(std::max_align_t)>::type mInlineBuffer;
+  std::unique_ptr<char[]> mHeapBuffer;
+  char* mBuffer;
+};
+
+} // namespace statespace
+} // namespace aikido
+
+#endif // ifndef AIKIDO_STATESPACE_STATEARRAY_HPP_
@@ -0,0 +1,109 @@
+#ifndef AIKIDO_STATESPACE_STATEPOOL_HPP_
+#define AIKIDO_STATESPACE_STATEPOOL_HPP_
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "StateSpace.hpp"
+
+namespace aikido {
+namespace statespace {
+
+// Defined in PooledState.hpp
+template <class>
+class PooledState;
+
+/// Pool of reusable states from a single \c StateSpace. States are allocated
+/// with \c allocateStateInBuffer in contiguous blocks of memory that are
+/// recycled when a state is released. Once the pool has grown to the peak
+/// number of states used at the same time, acquiring and releasing a state
+/// does not allocate memory.
+///
+/// This is intended for temporary states that are created in tight loops, e.g.
+/// inside \c Interpolator::interpolate or \c Trajectory::evaluate. Acquiring
+/// and releasing states is thread-safe.
+class StatePool
+{
+public:
+  /// Constructs an empty pool of states in \c _stateSpace.
+  ///
+  /// \param _stateSpace state space to allocate states from
+  /// \param _blockSize minimum number of states allocated at once
+  explicit StatePool(StateSpacePtr _stateSpace, std::size_t _blockSize = 8);
+
+  /// All states acquired from this pool must have been released before it is
+  /// destructed.
+  ~StatePool() = default;
+
+  // StatePool is uncopyable and unmovable, since it owns the memory of the
+  // states it has handed out.
+  StatePool(const StatePool&) = delete;
+  StatePool(StatePool&&) = delete;
+  StatePool& operator=(const StatePool&) = delete;
+  StatePool& operator=(StatePool&&) = delete;
+
+  /// Gets the state space that this pool allocates states from.
+  ///
+  /// \return state space of this pool
+  const StateSpacePtr& getStateSpace() const;
+
+  /// Acquires a state from the pool, allocating a new block of memory only if
+  /// no released states are available. The state must be returned by calling
+  /// \c releaseState.
+  ///
+  /// \return state in \c getStateSpace()
+  StateSpace::State* acquireState();
+
+  /// Returns a state previously created by \c acquireState to the pool. It is
+  /// undefined behavior to access \c _state after calling this function.
+  ///
+  /// \param _state state to release
+  void releaseState(StateSpace::State* _state);
+
+  /// Helper function to acquire a state wrapped in a \c PooledState, which
+  /// releases it back to this pool when it goes out of scope.
+  ///
+  /// \return new \c PooledState
+  PooledState<StateSpace::StateHandle> createState();
+
+  /// Grows the pool so it holds at least \c _numStates states in total.
+  ///
+  /// \param _numStates number of states to preallocate
+  void reserve(std::size_t _numStates);
+
+  /// Gets the total number of states owned by this pool, including those that
+  /// are currently acquired.
+  ///
+  /// \return number of states owned by this pool
+  std::size_t getCapacity() const;
+
+  /// Gets the number of states that can be acquired without allocating memory.
+  ///
+  /// \return number of released states
+  std::size_t getNumAvailableStates() const;
+
+private:
+  /// Allocates a new block of at least \c _numStates states and adds them to
+  /// the free list. \c mMutex must be held by the caller.
+  void addBlock(std::size_t _numStates);
+
+  StateSpacePtr mStateSpace;
+  std::size_t mBlockSize;
+
+  /// Size of a state in bytes, rounded up to preserve the alignment of states
+  /// packed into the same block.
+  std::size_t mStride;
+
+  std::size_t mCapacity;
+  std::vector<std::unique_ptr<char[]>> mBlocks;
+  std::vector<char*> mFreeBuffers;
+  mutable std::mutex mMutex;
+};
+
+using StatePoolPtr = std::shared_ptr<StatePool>;
+
+} // namespace statespace
+} // namespace aikido
+
+#include "PooledState.hpp"
+
+#endif // ifndef AIKIDO_STATESPACE_STATEPOOL_HPP_
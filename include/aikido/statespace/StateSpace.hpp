@@ -72,6 +72,13 @@ public:
   /// \return size, in bytes, requires to store a \c State
   virtual std::size_t getStateSizeInBytes() const = 0;
 
+  /// Gets the distance, in bytes, between consecutive states in a contiguous
+  /// array of states. This is \c getStateSizeInBytes() rounded up so every
+  /// state is aligned the same way as a buffer returned by \c new[].
+  ///
+  /// \return stride, in bytes, of an array of states
+  std::size_t getStateStrideInBytes() const;
+
   /// Create a new state in a pre-allocated buffer. The input argument must
   /// contain at least \c getStateSizeInBytes() bytes of memory. This state
   /// must be freed with \c freeStateInBuffer before freeing \c _buffer.
@@ -160,6 +167,58 @@ public:
   /// \param[out] _tangent corresponding element of the tangent space
   virtual void logMap(const State* _in, Eigen::VectorXd& _tangent) const = 0;
 
+  /// Batched version of \c compose over arrays of states. The i-th state of
+  /// an array starts \c _stride bytes after the (i-1)-th state; e.g. states
+  /// in a \c StateArray have a stride of \c getStateStrideInBytes(). A
+  /// stride of zero repeats the same state for every element of the array.
+  /// The output array must not share memory with either input array.
+  ///
+  /// The default implementation calls \c compose once for each state. State
+  /// spaces override this to amortize the cost of virtual dispatch.
+  ///
+  /// \param _states1 array of left input states
+  /// \param _stride1 stride of \c _states1 in bytes
+  /// \param _states2 array of right input states
+  /// \param _stride2 stride of \c _states2 in bytes
+  /// \param[out] _out array of output states
+  /// \param _strideOut stride of \c _out in bytes
+  /// \param _numStates number of states in each array
+  virtual void composeBatch(
+      const State* _states1,
+      std::size_t _stride1,
+      const State* _states2,
+      std::size_t _stride2,
+      State* _out,
+      std::size_t _strideOut,
+      std::size_t _numStates) const;
+
+  /// Batched version of \c expMap. The i-th column of \c _tangents is mapped
+  /// to the i-th state of the array \c _out. See \c composeBatch for the
+  /// layout of an array of states.
+  ///
+  /// \param _tangents (dimension) x (number of states) matrix of tangent
+  /// vectors
+  /// \param[out] _out array of output states
+  /// \param _stride stride of \c _out in bytes
+  virtual void expMapBatch(
+      const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+      State* _out,
+      std::size_t _stride) const;
+
+  /// Batched version of \c logMap. The i-th state of the array \c _in is
+  /// mapped to the i-th column of \c _tangents, which must already have
+  /// \c getDimension() rows. See \c composeBatch for the layout of an array
+  /// of states.
+  ///
+  /// \param _in array of input states
+  /// \param _stride stride of \c _in in bytes
+  /// \param[out] _tangents (dimension) x (number of states) matrix of tangent
+  /// vectors
+  virtual void logMapBatch(
+      const State* _in,
+      std::size_t _stride,
+      Eigen::Ref<Eigen::MatrixXd> _tangents) const;
+
   /// Print the state to the output stream
   /// \param _state The element to print
   /// \param _os The stream to print to
@@ -0,0 +1,215 @@
+#ifndef AIKIDO_STATESPACE_STATICCARTESIANPRODUCT_HPP_
+#define AIKIDO_STATESPACE_STATICCARTESIANPRODUCT_HPP_
+#include <tuple>
+#include "../common/metaprogramming.hpp"
+#include "CartesianProduct.hpp"
+#include "Rn.hpp"
+#include "SE2.hpp"
+#include "SE3.hpp"
+#include "SO2.hpp"
+#include "SO3.hpp"
+
+namespace aikido {
+namespace statespace {
+
+namespace detail {
+
+// Defined in detail/StaticCartesianProduct-impl.hpp
+template <class Space>
+struct StaticSubspaceTraits;
+
+// Defined in detail/StaticCartesianProduct-impl.hpp
+template <class... Spaces>
+struct StaticProductTraits;
+
+} // namespace detail
+
+/// Cartesian product of <tt>StateSpace</tt>s whose types are known at compile
+/// time. The state layout is identical to a \c CartesianProduct of the same
+/// subspaces, but offsets and dimensions are computed at compile time and
+/// every subspace operation is called directly instead of through a virtual
+/// call. The \c R<N>, with fixed \c N, and \c SO2 operations are fully
+/// inlined, and \c expMap and \c logMap of every subspace use fixed-size
+/// vectors instead of allocating an \c Eigen::VectorXd.
+///
+/// Since this is a \c CartesianProduct, it can be used anywhere a
+/// \c CartesianProduct is accepted, e.g. with \c createDistanceMetric,
+/// \c GeodesicInterpolator and the OMPL \c GeometricStateSpace.
+///
+/// The supported subspaces are \c R<N> (with fixed \c N), \c SO2, \c SO3,
+/// \c SE2 and \c SE3. Operations are dispatched to these types directly, so
+/// subspaces must not override them.
+///
+/// \tparam Spaces... types of the subspaces
+template <class... Spaces>
+class StaticCartesianProduct : public CartesianProduct
+{
+public:
+  using CartesianProduct::State;
+  using CartesianProduct::StateHandle;
+  using CartesianProduct::StateHandleConst;
+  using CartesianProduct::ScopedState;
+  using CartesianProduct::ScopedStateConst;
+
+  /// Type of the subspace at index \c I.
+  template <std::size_t I>
+  using Subspace = typename std::tuple_element<I, std::tuple<Spaces...>>::type;
+
+  /// Number of subspaces.
+  static constexpr std::size_t NumSubspacesAtCompileTime = sizeof...(Spaces);
+
+  /// Dimension of the space.
+  static constexpr std::size_t DimensionAtCompileTime
+      = detail::StaticProductTraits<Spaces...>::Dimension;
+
+  /// Size of a state in bytes.
+  static constexpr std::size_t StateSizeInBytesAtCompileTime
+      = detail::StaticProductTraits<Spaces...>::StateSizeInBytes;
+
+  /// Constructs the Cartesian product of default-constructed subspaces.
+  StaticCartesianProduct();
+
+  /// Constructs the Cartesian product of \c _subspaces.
+  ///
+  /// \param _subspaces subspaces, which must not be null
+  explicit StaticCartesianProduct(std::shared_ptr<Spaces>... _subspaces);
+
+  /// Gets the subspace at index \c I.
+  ///
+  /// \tparam I index of the subspace
+  /// \return subspace at \c I
+  template <std::size_t I>
+  const std::shared_ptr<Subspace<I>>& getStaticSubspace() const;
+
+  /// Gets the substate at index \c I without any runtime type checks.
+  ///
+  /// \tparam I index of the subspace
+  /// \param _state state in this state space
+  /// \return substate at \c I
+  template <std::size_t I>
+  typename Subspace<I>::State* getStaticSubState(State* _state) const;
+
+  /// Gets the substate at index \c I without any runtime type checks. This is
+  /// an overload for when \c _state is \c const.
+  ///
+  /// \tparam I index of the subspace
+  /// \param _state state in this state space
+  /// \return substate at \c I
+  template <std::size_t I>
+  const typename Subspace<I>::State* getStaticSubState(
+      const State* _state) const;
+
+  // Documentation inherited.
+  std::size_t getStateSizeInBytes() const override;
+
+  // Documentation inherited.
+  StateSpace::State* allocateStateInBuffer(void* _buffer) const override;
+
+  // Documentation inherited.
+  void freeStateInBuffer(StateSpace::State* _state) const override;
+
+  // Documentation inherited.
+  void compose(
+      const StateSpace::State* _state1,
+      const StateSpace::State* _state2,
+      StateSpace::State* _out) const override;
+
+  // Documentation inherited.
+  void getIdentity(StateSpace::State* _out) const override;
+
+  // Documentation inherited.
+  void getInverse(
+      const StateSpace::State* _in, StateSpace::State* _out) const override;
+
+  // Documentation inherited.
+  std::size_t getDimension() const override;
+
+  // Documentation inherited.
+  void copyState(
+      const StateSpace::State* _source,
+      StateSpace::State* _destination) const override;
+
+  // Documentation inherited.
+  void expMap(
+      const Eigen::VectorXd& _tangent, StateSpace::State* _out) const override;
+
+  // Documentation inherited.
+  void logMap(
+      const StateSpace::State* _in, Eigen::VectorXd& _tangent) const override;
+
+  /// Batched version of \c compose. Every state is composed with one direct
+  /// call per subspace, instead of one virtual call per subspace and state.
+  void composeBatch(
+      const StateSpace::State* _states1,
+      std::size_t _stride1,
+      const StateSpace::State* _states2,
+      std::size_t _stride2,
+      StateSpace::State* _out,
+      std::size_t _strideOut,
+      std::size_t _numStates) const override;
+
+  /// Batched version of \c expMap. The columns of \c _tangents are mapped
+  /// without copying them into temporary vectors.
+  void expMapBatch(
+      const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+      StateSpace::State* _out,
+      std::size_t _stride) const override;
+
+  /// Batched version of \c logMap. The tangent vectors are written directly
+  /// into the columns of \c _tangents.
+  void logMapBatch(
+      const StateSpace::State* _in,
+      std::size_t _stride,
+      Eigen::Ref<Eigen::MatrixXd> _tangents) const override;
+
+private:
+  using Indices = typename common::make_index_sequence<sizeof...(Spaces)>::type;
+
+  template <std::size_t... Is>
+  void allocateStateInBuffer(
+      common::index_sequence<Is...>, State* _state) const;
+
+  template <std::size_t... Is>
+  void freeStateInBuffer(common::index_sequence<Is...>, State* _state) const;
+
+  template <std::size_t... Is>
+  void compose(
+      common::index_sequence<Is...>,
+      const State* _state1,
+      const State* _state2,
+      State* _out) const;
+
+  template <std::size_t... Is>
+  void getIdentity(common::index_sequence<Is...>, State* _out) const;
+
+  template <std::size_t... Is>
+  void getInverse(
+      common::index_sequence<Is...>, const State* _in, State* _out) const;
+
+  template <std::size_t... Is>
+  void copyState(
+      common::index_sequence<Is...>,
+      const State* _source,
+      State* _destination) const;
+
+  template <std::size_t... Is>
+  void expMap(
+      common::index_sequence<Is...>,
+      const Eigen::Ref<const Eigen::VectorXd>& _tangent,
+      State* _out) const;
+
+  template <std::size_t... Is>
+  void logMap(
+      common::index_sequence<Is...>,
+      const State* _in,
+      Eigen::Ref<Eigen::VectorXd> _tangent) const;
+
+  std::tuple<std::shared_ptr<Spaces>...> mStaticSubspaces;
+};
+
+} // namespace statespace
+} // namespace aikido
+
+#include "detail/StaticCartesianProduct-impl.hpp"
+
+#endif // ifndef AIKIDO_STATESPACE_STATICCARTESIANPRODUCT_HPP_
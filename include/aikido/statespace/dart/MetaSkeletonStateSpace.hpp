@@ -13,6 +13,12 @@ namespace dart {
 /// the \c MetaSkeleton. This class provides functions for converting between
 /// \c State objects and vectors of DART joint positions.
 ///
+/// If every \c Joint is represented by an \c R<N> or \c SO2 subspace, e.g. a
+/// typical manipulator, then a \c State is a flat array of doubles that
+/// stores one position per \c DegreeOfFreedom. In that case, the conversions
+/// between states and positions are a single gather or scatter and
+/// \c getFlatValues maps the state directly as an Eigen vector.
+///
 /// The behavior of this class is undefined if you modify the structure of the
 /// \c MetaSkeleton or its position limits after construction.
 class MetaSkeletonStateSpace : public CartesianProduct
@@ -48,6 +54,38 @@ public:
   template <class Space = JointStateSpace>
   std::shared_ptr<Space> getJointSpace(std::size_t _index) const;
 
+  /// Returns whether a \c State of this state space is a flat array of one
+  /// double per \c DegreeOfFreedom. This is true if every \c Joint is
+  /// represented by an \c R<N> or \c SO2 subspace.
+  ///
+  /// \return true if \c getFlatValues may be called
+  bool hasFlatLayout() const;
+
+  /// Maps a \c State as a vector of doubles. Element \c i of the vector
+  /// stores the position of the \c DegreeOfFreedom with index
+  /// \c getDofIndices()[i] in the \c MetaSkeleton.
+  ///
+  /// \param _state state in this state space
+  /// \return vector of positions stored in \c _state
+  /// \throws std::logic_error if \c hasFlatLayout() is false
+  Eigen::Map<Eigen::VectorXd> getFlatValues(State* _state) const;
+
+  /// Maps a \c State as a vector of doubles. This is an overload for when
+  /// \c _state is \c const.
+  ///
+  /// \param _state state in this state space
+  /// \return vector of positions stored in \c _state
+  /// \throws std::logic_error if \c hasFlatLayout() is false
+  Eigen::Map<const Eigen::VectorXd> getFlatValues(const State* _state) const;
+
+  /// Gets the index in the \c MetaSkeleton of every \c DegreeOfFreedom, in
+  /// the order they are stored in a \c State, i.e. the order of the
+  /// subspaces followed by the order of the \c DegreeOfFreedom in each
+  /// \c Joint.
+  ///
+  /// \return \c MetaSkeleton index of each \c DegreeOfFreedom
+  const std::vector<std::size_t>& getDofIndices() const;
+
   /// Converts DART \c MetaSkeleton positions, e.g. those returned by
   /// \c getPositions, to a \c State in this state space.
   ///
@@ -81,6 +119,15 @@ public:
 
 private:
   ::dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+
+  /// Index in mMetaSkeleton of each DegreeOfFreedom, in state order.
+  std::vector<std::size_t> mDofIndices;
+
+  /// Whether a state is a flat array of one double per DegreeOfFreedom.
+  bool mHasFlatLayout;
+
+  /// Whether mDofIndices is the identity permutation.
+  bool mHasIdentityDofOrder;
 };
 
 using MetaSkeletonStateSpacePtr = std::shared_ptr<MetaSkeletonStateSpace>;
@@ -0,0 +1,279 @@
+#ifndef AIKIDO_STATESPACE_DART_SKELETONREPLICAPOOL_HPP_
+#define AIKIDO_STATESPACE_DART_SKELETONREPLICAPOOL_HPP_
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <dart/collision/CollisionDetector.hpp>
+#include <dart/collision/CollisionFilter.hpp>
+#include <dart/collision/CollisionGroup.hpp>
+#include <dart/collision/CollisionObject.hpp>
+#include <dart/collision/DistanceFilter.hpp>
+#include <dart/dynamics/dynamics.hpp>
+#include "MetaSkeletonStateSpace.hpp"
+
+namespace aikido {
+namespace statespace {
+namespace dart {
+namespace detail {
+
+// Defined in SkeletonReplicaPool.cpp
+struct SkeletonReplicaStorage;
+
+} // namespace detail
+
+/// Private copy of a set of DART <tt>Skeleton</tt>s that is owned by a single
+/// thread. Objects that refer to the original skeletons, e.g. a
+/// \c MetaSkeletonStateSpace, a \c JacobianNode or a \c CollisionGroup, are
+/// mapped to the corresponding objects of the replica. The mapped objects are
+/// created the first time they are requested and cached afterwards.
+///
+/// \c SkeletonReplica is created by \c SkeletonReplicaPool and must only be
+/// used by the thread it is bound to.
+class SkeletonReplica
+{
+public:
+  /// Constructs a replica of \c _sourceSkeletons.
+  ///
+  /// \param _sourceSkeletons skeletons that are replicated
+  /// \param _skeletons clones of \c _sourceSkeletons, in the same order
+  /// \param _mutex mutex held while a mapped object is created, since that
+  ///        reads the source objects
+  SkeletonReplica(
+      const std::vector<::dart::dynamics::SkeletonPtr>& _sourceSkeletons,
+      const std::vector<::dart::dynamics::SkeletonPtr>& _skeletons,
+      std::mutex& _mutex);
+
+  SkeletonReplica(const SkeletonReplica&) = delete;
+  SkeletonReplica& operator=(const SkeletonReplica&) = delete;
+
+  /// Gets the replica of \c _sourceSkeleton.
+  ///
+  /// \param _sourceSkeleton replicated skeleton
+  /// \return replica of \c _sourceSkeleton
+  /// \throws std::invalid_argument if \c _sourceSkeleton is not replicated
+  ::dart::dynamics::SkeletonPtr getSkeleton(
+      const ::dart::dynamics::Skeleton* _sourceSkeleton) const;
+
+  /// Gets the replica of \c _sourceMetaSkeleton. All of its
+  /// <tt>BodyNode</tt>s, <tt>Joint</tt>s and <tt>DegreeOfFreedom</tt>s must
+  /// belong to replicated skeletons. The replica lists them in the same
+  /// order.
+  ///
+  /// \param _sourceMetaSkeleton \c MetaSkeleton of replicated skeletons
+  /// \return replica of \c _sourceMetaSkeleton
+  ::dart::dynamics::MetaSkeletonPtr getMetaSkeleton(
+      const ::dart::dynamics::MetaSkeletonPtr& _sourceMetaSkeleton);
+
+  /// Gets a \c MetaSkeletonStateSpace for the replica of the \c MetaSkeleton
+  /// of \c _sourceStateSpace. States of \c _sourceStateSpace can be passed
+  /// directly to the returned state space.
+  ///
+  /// \param _sourceStateSpace state space of a replicated \c MetaSkeleton
+  /// \return state space of the replica
+  MetaSkeletonStateSpacePtr getStateSpace(
+      const MetaSkeletonStateSpacePtr& _sourceStateSpace);
+
+  /// Gets the replica of \c _sourceBodyNode.
+  ///
+  /// \param _sourceBodyNode \c BodyNode of a replicated skeleton
+  /// \return replica of \c _sourceBodyNode
+  ::dart::dynamics::BodyNode* getBodyNode(
+      const ::dart::dynamics::BodyNode* _sourceBodyNode) const;
+
+  /// Gets the replica of \c _sourceNode, which must be a \c BodyNode or an
+  /// \c EndEffector.
+  ///
+  /// \param _sourceNode \c JacobianNode of a replicated skeleton
+  /// \return replica of \c _sourceNode
+  ::dart::dynamics::JacobianNode* getJacobianNode(
+      const ::dart::dynamics::JacobianNode* _sourceNode) const;
+
+  /// Gets the replica of \c _sourceFrame. A \c ShapeFrame that is not part of
+  /// a replicated skeleton, e.g. one in the environment, is shared between
+  /// all replicas and returned unchanged.
+  ///
+  /// \param _sourceFrame \c ShapeFrame
+  /// \return replica of \c _sourceFrame
+  const ::dart::dynamics::ShapeFrame* getShapeFrame(
+      const ::dart::dynamics::ShapeFrame* _sourceFrame) const;
+
+  /// Gets a clone of \c _sourceDetector that does not share any collision
+  /// objects with it.
+  ///
+  /// \param _sourceDetector collision detector
+  /// \return clone of \c _sourceDetector owned by this replica
+  std::shared_ptr<::dart::collision::CollisionDetector> getCollisionDetector(
+      ::dart::collision::CollisionDetector* _sourceDetector);
+
+  /// Gets the replica of \c _sourceGroup. The replica is created in the
+  /// \c getCollisionDetector clone of the detector of \c _sourceGroup and
+  /// contains the replica of each of its <tt>ShapeFrame</tt>s.
+  ///
+  /// \param _sourceGroup collision group
+  /// \return replica of \c _sourceGroup
+  std::shared_ptr<::dart::collision::CollisionGroup> getCollisionGroup(
+      const std::shared_ptr<::dart::collision::CollisionGroup>& _sourceGroup);
+
+  /// Gets the source of \c _frame, i.e. the inverse of \c getShapeFrame.
+  /// A \c ShapeFrame that is not part of this replica is returned unchanged.
+  ///
+  /// \param _frame \c ShapeFrame of this replica
+  /// \return \c ShapeFrame of the replicated skeleton
+  const ::dart::dynamics::ShapeFrame* getSourceShapeFrame(
+      const ::dart::dynamics::ShapeFrame* _frame) const;
+
+  /// Gets a collision filter for the collision groups of this replica that
+  /// consults \c _sourceFilter with the source of each \c ShapeFrame. This
+  /// preserves filters that refer to the <tt>BodyNode</tt>s of the
+  /// replicated skeletons, e.g. the blacklist of a
+  /// \c dart::collision::BodyNodeCollisionFilter.
+  ///
+  /// \param _sourceFilter filter of the replicated skeletons, or \c nullptr
+  /// \return filter of this replica, or \c nullptr if \c _sourceFilter is
+  ///         \c nullptr
+  std::shared_ptr<::dart::collision::CollisionFilter> getCollisionFilter(
+      const std::shared_ptr<::dart::collision::CollisionFilter>& _sourceFilter);
+
+  /// Gets a distance filter for the collision groups of this replica that
+  /// consults \c _sourceFilter with the source of each \c ShapeFrame, see
+  /// \c getCollisionFilter.
+  ///
+  /// \param _sourceFilter filter of the replicated skeletons, or \c nullptr
+  /// \return filter of this replica, or \c nullptr if \c _sourceFilter is
+  ///         \c nullptr
+  std::shared_ptr<::dart::collision::DistanceFilter> getDistanceFilter(
+      const std::shared_ptr<::dart::collision::DistanceFilter>& _sourceFilter);
+
+  /// Gets a collision object of the source of the \c ShapeFrame of
+  /// \c _object, which may be passed to filters of the replicated skeletons.
+  /// The object of a \c ShapeFrame that is not part of this replica is
+  /// returned unchanged.
+  ///
+  /// \param _object collision object of a \c ShapeFrame of this replica
+  /// \return collision object of the source \c ShapeFrame
+  const ::dart::collision::CollisionObject* getSourceCollisionObject(
+      const ::dart::collision::CollisionObject* _object);
+
+private:
+  using CollisionDetectorPtr
+      = std::shared_ptr<::dart::collision::CollisionDetector>;
+  using CollisionGroupPtr = std::shared_ptr<::dart::collision::CollisionGroup>;
+  using CollisionFilterPtr
+      = std::shared_ptr<::dart::collision::CollisionFilter>;
+  using DistanceFilterPtr = std::shared_ptr<::dart::collision::DistanceFilter>;
+
+  std::unordered_map<const ::dart::dynamics::Skeleton*,
+                     ::dart::dynamics::SkeletonPtr>
+      mSkeletons;
+
+  /// Replicated skeletons, indexed by their replica.
+  std::unordered_map<const ::dart::dynamics::Skeleton*,
+                     ::dart::dynamics::SkeletonPtr>
+      mSourceSkeletons;
+
+  std::mutex& mMutex;
+
+  // The source objects are kept alive so that their addresses, which are used
+  // as keys, can not be reused by other objects.
+  std::unordered_map<const ::dart::dynamics::MetaSkeleton*,
+                     std::pair<::dart::dynamics::MetaSkeletonPtr,
+                               ::dart::dynamics::MetaSkeletonPtr>>
+      mMetaSkeletons;
+  std::unordered_map<const MetaSkeletonStateSpace*,
+                     std::pair<MetaSkeletonStateSpacePtr,
+                               MetaSkeletonStateSpacePtr>>
+      mStateSpaces;
+  std::unordered_map<const ::dart::collision::CollisionGroup*,
+                     std::pair<CollisionGroupPtr, CollisionGroupPtr>>
+      mCollisionGroups;
+  std::unordered_map<const ::dart::collision::CollisionDetector*,
+                     CollisionDetectorPtr>
+      mCollisionDetectors;
+  std::unordered_map<const ::dart::collision::CollisionFilter*,
+                     std::pair<CollisionFilterPtr, CollisionFilterPtr>>
+      mCollisionFilters;
+  std::unordered_map<const ::dart::collision::DistanceFilter*,
+                     std::pair<DistanceFilterPtr, DistanceFilterPtr>>
+      mDistanceFilters;
+
+  /// Collision objects of source <tt>ShapeFrame</tt>s that are passed to
+  /// filters, indexed by their \c ShapeFrame.
+  std::unordered_map<const ::dart::dynamics::ShapeFrame*,
+                     std::unique_ptr<::dart::collision::CollisionObject>>
+      mSourceCollisionObjects;
+};
+
+/// Pool of <tt>SkeletonReplica</tt>s with one replica per thread. This allows
+/// constraints that write configurations into DART skeletons, e.g.
+/// \c CollisionFree, to be evaluated concurrently: each thread sets the
+/// configuration of and checks collision on its own replica.
+///
+/// The skeletons are cloned once at construction. The replica of a thread is
+/// cloned from this copy the first time \c getReplica is called on that
+/// thread. When a thread exits, its replica is returned to the pool and is
+/// reused by the next thread that needs one. Later changes to the original
+/// skeletons are not reflected in the replicas; in particular, the positions
+/// of <tt>DegreeOfFreedom</tt>s that are not set through a replicated state
+/// space keep the values they had when the pool was constructed.
+/// <tt>ShapeFrame</tt>s that are not part of a replicated skeleton are shared
+/// by all replicas and must not move while replicas are in use.
+class SkeletonReplicaPool
+{
+public:
+  /// Constructs a pool of replicas of \c _skeleton.
+  ///
+  /// \param _skeleton skeleton to replicate
+  explicit SkeletonReplicaPool(::dart::dynamics::SkeletonPtr _skeleton);
+
+  /// Constructs a pool of replicas of \c _skeletons.
+  ///
+  /// \param _skeletons skeletons to replicate
+  explicit SkeletonReplicaPool(
+      std::vector<::dart::dynamics::SkeletonPtr> _skeletons);
+
+  virtual ~SkeletonReplicaPool() = default;
+
+  SkeletonReplicaPool(const SkeletonReplicaPool&) = delete;
+  SkeletonReplicaPool& operator=(const SkeletonReplicaPool&) = delete;
+
+  /// Gets the replicated skeletons.
+  ///
+  /// \return replicated skeletons
+  const std::vector<::dart::dynamics::SkeletonPtr>& getSkeletons() const;
+
+  /// Gets the replica bound to the calling thread. The first call on a thread
+  /// binds a replica released by an exited thread, if any, or a new one.
+  ///
+  /// \return replica of the calling thread
+  SkeletonReplica& getReplica();
+
+  /// Gets the number of replicas that have been created.
+  ///
+  /// \return number of replicas
+  std::size_t getNumReplicas() const;
+
+private:
+  /// Unique identifier of this pool, used to find the replica of the calling
+  /// thread in a thread-local map.
+  const std::size_t mId;
+
+  std::vector<::dart::dynamics::SkeletonPtr> mSkeletons;
+
+  /// Clones of mSkeletons made at construction. Replicas are cloned from
+  /// these, since the original skeletons may be modified concurrently.
+  std::vector<::dart::dynamics::SkeletonPtr> mPrototypes;
+
+  /// Replicas owned by this pool. This is shared with the threads that use a
+  /// replica, so they can return it to the pool when they exit.
+  std::shared_ptr<detail::SkeletonReplicaStorage> mStorage;
+};
+
+using SkeletonReplicaPoolPtr = std::shared_ptr<SkeletonReplicaPool>;
+
+} // namespace dart
+} // namespace statespace
+} // namespace aikido
+
+#endif // ifndef AIKIDO_STATESPACE_DART_SKELETONREPLICAPOOL_HPP_
@@ -0,0 +1,41 @@
+namespace aikido {
+namespace statespace {
+
+//==============================================================================
+template <class _Handle, std::size_t _BufferSize>
+constexpr std::size_t InlineScopedState<_Handle, _BufferSize>::BufferSize;
+
+//==============================================================================
+template <class _Handle, std::size_t _BufferSize>
+InlineScopedState<_Handle, _BufferSize>::InlineScopedState(
+    const StateSpace* _space)
+{
+  this->mSpace = _space;
+
+  void* buffer = &mInlineBuffer;
+  if (_space->getStateSizeInBytes() > _BufferSize)
+  {
+    mHeapBuffer.reset(new char[_space->getStateSizeInBytes()]);
+    buffer = mHeapBuffer.get();
+  }
+
+  this->mState = static_cast<typename InlineScopedState::State*>(
+      _space->allocateStateInBuffer(buffer));
+}
+
+//==============================================================================
+template <class _Handle, std::size_t _BufferSize>
+InlineScopedState<_Handle, _BufferSize>::~InlineScopedState()
+{
+  this->mSpace->freeStateInBuffer(this->mState);
+}
+
+//==============================================================================
+template <class _Handle, std::size_t _BufferSize>
+bool InlineScopedState<_Handle, _BufferSize>::isInline() const
+{
+  return mHeapBuffer == nullptr;
+}
+
+} // namespace statespace
+} // namespace aikido
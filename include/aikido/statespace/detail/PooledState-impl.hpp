@@ -0,0 +1,43 @@
+#include <stdexcept>
+
+namespace aikido {
+namespace statespace {
+
+//==============================================================================
+template <class _Handle>
+PooledState<_Handle>::PooledState(const StateSpace* _space, StatePool* _pool)
+  : mPool(_pool)
+{
+  // TODO: Skip this check in release mode.
+  if (_pool == nullptr || _pool->getStateSpace().get() != _space)
+    throw std::invalid_argument("StatePool is not for this StateSpace.");
+
+  this->mSpace = _space;
+  this->mState = static_cast<PooledState::State*>(mPool->acquireState());
+}
+
+//==============================================================================
+template <class _Handle>
+PooledState<_Handle>::PooledState(PooledState&& _other)
+  : _Handle(_other), mPool(_other.mPool)
+{
+  _other.mPool = nullptr;
+  _other.reset();
+}
+
+//==============================================================================
+template <class _Handle>
+PooledState<_Handle>::~PooledState()
+{
+  if (mPool)
+    mPool->releaseState(this->mState);
+}
+
+//==============================================================================
+inline PooledState<StateSpace::StateHandle> StatePool::createState()
+{
+  return PooledState<StateSpace::StateHandle>(mStateSpace.get(), this);
+}
+
+} // namespace statespace
+} // namespace aikido
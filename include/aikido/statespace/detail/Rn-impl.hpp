@@ -271,6 +271,125 @@ void R<N>::logMap(const StateSpace::State* _in, Eigen::VectorXd& _tangent) const
   _tangent = getValue(in);
 }
 
+//==============================================================================
+template <int N>
+void R<N>::composeBatch(
+    const StateSpace::State* _states1,
+    std::size_t _stride1,
+    const StateSpace::State* _states2,
+    std::size_t _stride2,
+    StateSpace::State* _out,
+    std::size_t _strideOut,
+    std::size_t _numStates) const
+{
+  if (_stride1 % sizeof(double) != 0 || _stride2 % sizeof(double) != 0
+      || _strideOut % sizeof(double) != 0)
+  {
+    StateSpace::composeBatch(
+        _states1, _stride1, _states2, _stride2, _out, _strideOut, _numStates);
+    return;
+  }
+
+  if (_numStates == 0)
+    return;
+
+  auto out = getMutableValues(_out, _strideOut, _numStates);
+
+  // A stride of zero broadcasts a single state to every column.
+  if (_stride1 == 0 && _stride2 == 0)
+  {
+    out.colwise() = getValue(static_cast<const State*>(_states1))
+                    + getValue(static_cast<const State*>(_states2));
+  }
+  else if (_stride1 == 0)
+  {
+    out = getValues(_states2, _stride2, _numStates).colwise()
+          + getValue(static_cast<const State*>(_states1));
+  }
+  else if (_stride2 == 0)
+  {
+    out = getValues(_states1, _stride1, _numStates).colwise()
+          + getValue(static_cast<const State*>(_states2));
+  }
+  else
+  {
+    out = getValues(_states1, _stride1, _numStates)
+          + getValues(_states2, _stride2, _numStates);
+  }
+}
+
+//==============================================================================
+template <int N>
+void R<N>::expMapBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+    StateSpace::State* _out,
+    std::size_t _stride) const
+{
+  // TODO: Skip this check in release mode.
+  if (static_cast<std::size_t>(_tangents.rows()) != getDimension())
+  {
+    std::stringstream msg;
+    msg << "Tangent vectors have incorrect size: expected " << getDimension()
+        << ", got " << _tangents.rows() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  if (_stride % sizeof(double) != 0 || _stride == 0)
+  {
+    StateSpace::expMapBatch(_tangents, _out, _stride);
+    return;
+  }
+
+  getMutableValues(_out, _stride, _tangents.cols()) = _tangents;
+}
+
+//==============================================================================
+template <int N>
+void R<N>::logMapBatch(
+    const StateSpace::State* _in,
+    std::size_t _stride,
+    Eigen::Ref<Eigen::MatrixXd> _tangents) const
+{
+  if (_stride % sizeof(double) != 0 || _stride == 0
+      || static_cast<std::size_t>(_tangents.rows()) != getDimension())
+  {
+    StateSpace::logMapBatch(_in, _stride, _tangents);
+    return;
+  }
+
+  _tangents = getValues(_in, _stride, _tangents.cols());
+}
+
+//==============================================================================
+template <int N>
+auto R<N>::getValues(
+    const StateSpace::State* _states,
+    std::size_t _stride,
+    std::size_t _numStates) const
+    -> Eigen::Map<const MatrixNd, 0, Eigen::OuterStride<>>
+{
+  return Eigen::Map<const MatrixNd, 0, Eigen::OuterStride<>>(
+      reinterpret_cast<const double*>(_states),
+      getDimension(),
+      _numStates,
+      Eigen::OuterStride<>(_stride / sizeof(double)));
+}
+
+//==============================================================================
+template <int N>
+auto R<N>::getMutableValues(
+    StateSpace::State* _states,
+    std::size_t _stride,
+    std::size_t _numStates) const
+    -> Eigen::Map<MatrixNd, 0, Eigen::OuterStride<>>
+{
+  return Eigen::Map<MatrixNd, 0, Eigen::OuterStride<>>(
+      reinterpret_cast<double*>(_states),
+      getDimension(),
+      _numStates,
+      Eigen::OuterStride<>(_stride / sizeof(double)));
+}
+
 //==============================================================================
 template <int N>
 void R<N>::print(const StateSpace::State* _state, std::ostream& _os) const
@@ -0,0 +1,749 @@
+#include <sstream>
+#include <stdexcept>
+#include <dart/math/Geometry.hpp>
+
+namespace aikido {
+namespace statespace {
+namespace detail {
+
+//==============================================================================
+/// Implements the operations of a subspace of \c StaticCartesianProduct by
+/// calling the functions of \c Space directly, i.e. without virtual dispatch.
+/// \c expMap and \c logMap are implemented by each specialization, since the
+/// functions of \c Space take a heap-allocated \c Eigen::VectorXd.
+template <class Space, std::size_t _Dimension>
+struct DirectCallSubspaceTraits
+{
+  static constexpr std::size_t Dimension = _Dimension;
+  static constexpr std::size_t StateSizeInBytes
+      = sizeof(typename Space::State);
+
+  static void allocateStateInBuffer(const Space& _space, StateSpace::State* _s)
+  {
+    _space.Space::allocateStateInBuffer(_s);
+  }
+
+  static void freeStateInBuffer(const Space& _space, StateSpace::State* _s)
+  {
+    _space.Space::freeStateInBuffer(_s);
+  }
+
+  static void compose(
+      const Space& _space,
+      const StateSpace::State* _state1,
+      const StateSpace::State* _state2,
+      StateSpace::State* _out)
+  {
+    _space.Space::compose(_state1, _state2, _out);
+  }
+
+  static void getIdentity(const Space& _space, StateSpace::State* _out)
+  {
+    _space.Space::getIdentity(_out);
+  }
+
+  static void getInverse(
+      const Space& _space,
+      const StateSpace::State* _in,
+      StateSpace::State* _out)
+  {
+    _space.Space::getInverse(_in, _out);
+  }
+
+  static void copyState(
+      const Space& _space,
+      const StateSpace::State* _source,
+      StateSpace::State* _destination)
+  {
+    _space.Space::copyState(_source, _destination);
+  }
+};
+
+//==============================================================================
+/// Implements the operations of an \c R<N> subspace inline. The \c R<N>
+/// functions themselves can not be inlined because they are explicitly
+/// instantiated in the library.
+template <int N>
+struct StaticSubspaceTraits<R<N>>
+{
+  static_assert(
+      N != Eigen::Dynamic,
+      "StaticCartesianProduct requires R<N> with a fixed dimension.");
+
+  using Vector = Eigen::Matrix<double, N, 1>;
+
+  static constexpr std::size_t Dimension = N;
+  static constexpr std::size_t StateSizeInBytes = N * sizeof(double);
+
+  static Eigen::Map<Vector> getValue(StateSpace::State* _state)
+  {
+    return Eigen::Map<Vector>(reinterpret_cast<double*>(_state));
+  }
+
+  static Eigen::Map<const Vector> getValue(const StateSpace::State* _state)
+  {
+    return Eigen::Map<const Vector>(reinterpret_cast<const double*>(_state));
+  }
+
+  static void allocateStateInBuffer(const R<N>&, StateSpace::State* _state)
+  {
+    getValue(_state).setZero();
+  }
+
+  static void freeStateInBuffer(const R<N>&, StateSpace::State*)
+  {
+    // Do nothing.
+  }
+
+  static void compose(
+      const R<N>&,
+      const StateSpace::State* _state1,
+      const StateSpace::State* _state2,
+      StateSpace::State* _out)
+  {
+    getValue(_out) = getValue(_state1) + getValue(_state2);
+  }
+
+  static void getIdentity(const R<N>&, StateSpace::State* _out)
+  {
+    getValue(_out).setZero();
+  }
+
+  static void getInverse(
+      const R<N>&, const StateSpace::State* _in, StateSpace::State* _out)
+  {
+    getValue(_out) = -getValue(_in);
+  }
+
+  static void copyState(
+      const R<N>&,
+      const StateSpace::State* _source,
+      StateSpace::State* _destination)
+  {
+    getValue(_destination) = getValue(_source);
+  }
+
+  static void expMap(
+      const R<N>&,
+      const Eigen::Ref<const Eigen::VectorXd>& _tangent,
+      StateSpace::State* _out)
+  {
+    getValue(_out) = _tangent;
+  }
+
+  static void logMap(
+      const R<N>&,
+      const StateSpace::State* _in,
+      Eigen::Ref<Eigen::VectorXd> _tangent)
+  {
+    _tangent = getValue(_in);
+  }
+};
+
+//==============================================================================
+/// Implements the operations of an \c SO2 subspace inline by treating the
+/// state as its rotation angle.
+template <>
+struct StaticSubspaceTraits<SO2>
+{
+  static_assert(
+      sizeof(SO2::State) == sizeof(double),
+      "SO2::State must only store its rotation angle.");
+
+  static constexpr std::size_t Dimension = 1;
+  static constexpr std::size_t StateSizeInBytes = sizeof(SO2::State);
+
+  static double& getAngle(StateSpace::State* _state)
+  {
+    return *reinterpret_cast<double*>(_state);
+  }
+
+  static double getAngle(const StateSpace::State* _state)
+  {
+    return *reinterpret_cast<const double*>(_state);
+  }
+
+  static void allocateStateInBuffer(const SO2&, StateSpace::State* _state)
+  {
+    getAngle(_state) = 0.;
+  }
+
+  static void freeStateInBuffer(const SO2&, StateSpace::State*)
+  {
+    // Do nothing.
+  }
+
+  static void compose(
+      const SO2&,
+      const StateSpace::State* _state1,
+      const StateSpace::State* _state2,
+      StateSpace::State* _out)
+  {
+    getAngle(_out) = getAngle(_state1) + getAngle(_state2);
+  }
+
+  static void getIdentity(const SO2&, StateSpace::State* _out)
+  {
+    getAngle(_out) = 0.;
+  }
+
+  static void getInverse(
+      const SO2&, const StateSpace::State* _in, StateSpace::State* _out)
+  {
+    getAngle(_out) = -getAngle(_in);
+  }
+
+  static void copyState(
+      const SO2&,
+      const StateSpace::State* _source,
+      StateSpace::State* _destination)
+  {
+    getAngle(_destination) = getAngle(_source);
+  }
+
+  static void expMap(
+      const SO2&,
+      const Eigen::Ref<const Eigen::VectorXd>& _tangent,
+      StateSpace::State* _out)
+  {
+    getAngle(_out) = _tangent[0];
+  }
+
+  static void logMap(
+      const SO2&,
+      const StateSpace::State* _in,
+      Eigen::Ref<Eigen::VectorXd> _tangent)
+  {
+    _tangent[0] = getAngle(_in);
+  }
+};
+
+//==============================================================================
+/// Implements \c expMap and \c logMap of an \c SO3 subspace inline with
+/// fixed-size vectors. This matches \c SO3::expMap and \c SO3::logMap.
+template <>
+struct StaticSubspaceTraits<SO3> : DirectCallSubspaceTraits<SO3, 3>
+{
+  static void expMap(
+      const SO3&,
+      const Eigen::Ref<const Eigen::VectorXd>& _tangent,
+      StateSpace::State* _out)
+  {
+    Eigen::Vector6d tangent(Eigen::Vector6d::Zero());
+    tangent.head<3>() = _tangent;
+
+    const Eigen::Isometry3d transform = dart::math::expMap(tangent);
+    static_cast<SO3::State*>(_out)->setQuaternion(
+        SO3::State::Quaternion(transform.rotation()));
+  }
+
+  static void logMap(
+      const SO3&,
+      const StateSpace::State* _in,
+      Eigen::Ref<Eigen::VectorXd> _tangent)
+  {
+    const Eigen::Matrix3d rotation = static_cast<const SO3::State*>(_in)
+                                         ->getQuaternion()
+                                         .toRotationMatrix();
+    _tangent = dart::math::logMap(rotation);
+  }
+};
+
+//==============================================================================
+/// Implements \c expMap and \c logMap of an \c SE2 subspace inline with
+/// fixed-size vectors. This matches \c SE2::expMap and \c SE2::logMap.
+template <>
+struct StaticSubspaceTraits<SE2> : DirectCallSubspaceTraits<SE2, 3>
+{
+  static void expMap(
+      const SE2&,
+      const Eigen::Ref<const Eigen::VectorXd>& _tangent,
+      StateSpace::State* _out)
+  {
+    SE2::Isometry2d transform(SE2::Isometry2d::Identity());
+    transform.linear() = Eigen::Rotation2Dd(_tangent[0]).matrix();
+    transform.translation() = _tangent.tail<2>();
+
+    static_cast<SE2::State*>(_out)->setIsometry(transform);
+  }
+
+  static void logMap(
+      const SE2&,
+      const StateSpace::State* _in,
+      Eigen::Ref<Eigen::VectorXd> _tangent)
+  {
+    const auto& transform
+        = static_cast<const SE2::State*>(_in)->getIsometry();
+    _tangent.tail<2>() = transform.translation();
+
+    Eigen::Rotation2Dd rotation = Eigen::Rotation2Dd::Identity();
+    rotation.fromRotationMatrix(transform.rotation());
+    _tangent[0] = rotation.angle();
+  }
+};
+
+//==============================================================================
+/// Implements \c expMap and \c logMap of an \c SE3 subspace inline with
+/// fixed-size vectors. This matches \c SE3::expMap and \c SE3::logMap.
+template <>
+struct StaticSubspaceTraits<SE3> : DirectCallSubspaceTraits<SE3, 6>
+{
+  static void expMap(
+      const SE3&,
+      const Eigen::Ref<const Eigen::VectorXd>& _tangent,
+      StateSpace::State* _out)
+  {
+    const Eigen::Vector6d tangent = _tangent;
+    static_cast<SE3::State*>(_out)->setIsometry(dart::math::expMap(tangent));
+  }
+
+  static void logMap(
+      const SE3&,
+      const StateSpace::State* _in,
+      Eigen::Ref<Eigen::VectorXd> _tangent)
+  {
+    const Eigen::Isometry3d transform
+        = static_cast<const SE3::State*>(_in)->getIsometry();
+    _tangent = dart::math::logMap(transform);
+  }
+};
+
+//==============================================================================
+template <>
+struct StaticProductTraits<>
+{
+  static constexpr std::size_t Dimension = 0;
+  static constexpr std::size_t StateSizeInBytes = 0;
+};
+
+//==============================================================================
+template <class Space, class... Spaces>
+struct StaticProductTraits<Space, Spaces...>
+{
+  static constexpr std::size_t Dimension
+      = StaticSubspaceTraits<Space>::Dimension
+        + StaticProductTraits<Spaces...>::Dimension;
+  static constexpr std::size_t StateSizeInBytes
+      = StaticSubspaceTraits<Space>::StateSizeInBytes
+        + StaticProductTraits<Spaces...>::StateSizeInBytes;
+};
+
+//==============================================================================
+/// Offset of the \c I-th subspace, in bytes and in tangent space coordinates.
+/// The layout matches the one computed at runtime by \c CartesianProduct.
+template <std::size_t I, class... Spaces>
+struct StaticSubspaceOffset;
+
+//==============================================================================
+template <class Space, class... Spaces>
+struct StaticSubspaceOffset<0, Space, Spaces...>
+{
+  static constexpr std::size_t Bytes = 0;
+  static constexpr std::size_t Dimension = 0;
+};
+
+//==============================================================================
+template <std::size_t I, class Space, class... Spaces>
+struct StaticSubspaceOffset<I, Space, Spaces...>
+{
+  static constexpr std::size_t Bytes
+      = StaticSubspaceTraits<Space>::StateSizeInBytes
+        + StaticSubspaceOffset<I - 1, Spaces...>::Bytes;
+  static constexpr std::size_t Dimension
+      = StaticSubspaceTraits<Space>::Dimension
+        + StaticSubspaceOffset<I - 1, Spaces...>::Dimension;
+};
+
+} // namespace detail
+
+//==============================================================================
+template <class... Spaces>
+constexpr std::size_t
+    StaticCartesianProduct<Spaces...>::NumSubspacesAtCompileTime;
+
+//==============================================================================
+template <class... Spaces>
+constexpr std::size_t StaticCartesianProduct<Spaces...>::DimensionAtCompileTime;
+
+//==============================================================================
+template <class... Spaces>
+constexpr std::size_t
+    StaticCartesianProduct<Spaces...>::StateSizeInBytesAtCompileTime;
+
+//==============================================================================
+template <class... Spaces>
+StaticCartesianProduct<Spaces...>::StaticCartesianProduct()
+  : StaticCartesianProduct(std::make_shared<Spaces>()...)
+{
+  // Do nothing.
+}
+
+//==============================================================================
+template <class... Spaces>
+StaticCartesianProduct<Spaces...>::StaticCartesianProduct(
+    std::shared_ptr<Spaces>... _subspaces)
+  : CartesianProduct(std::vector<StateSpacePtr>{_subspaces...})
+  , mStaticSubspaces(std::move(_subspaces)...)
+{
+  // Do nothing.
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t I>
+auto StaticCartesianProduct<Spaces...>::getStaticSubspace() const
+    -> const std::shared_ptr<Subspace<I>>&
+{
+  return std::get<I>(mStaticSubspaces);
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t I>
+auto StaticCartesianProduct<Spaces...>::getStaticSubState(State* _state) const
+    -> typename Subspace<I>::State*
+{
+  return reinterpret_cast<typename Subspace<I>::State*>(
+      reinterpret_cast<char*>(_state)
+      + detail::StaticSubspaceOffset<I, Spaces...>::Bytes);
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t I>
+auto StaticCartesianProduct<Spaces...>::getStaticSubState(
+    const State* _state) const -> const typename Subspace<I>::State*
+{
+  return reinterpret_cast<const typename Subspace<I>::State*>(
+      reinterpret_cast<const char*>(_state)
+      + detail::StaticSubspaceOffset<I, Spaces...>::Bytes);
+}
+
+//==============================================================================
+template <class... Spaces>
+std::size_t StaticCartesianProduct<Spaces...>::getStateSizeInBytes() const
+{
+  return StateSizeInBytesAtCompileTime;
+}
+
+//==============================================================================
+template <class... Spaces>
+StateSpace::State* StaticCartesianProduct<Spaces...>::allocateStateInBuffer(
+    void* _buffer) const
+{
+  auto state = reinterpret_cast<State*>(_buffer);
+  allocateStateInBuffer(Indices(), state);
+  return state;
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::freeStateInBuffer(
+    StateSpace::State* _state) const
+{
+  freeStateInBuffer(Indices(), static_cast<State*>(_state));
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::compose(
+    const StateSpace::State* _state1,
+    const StateSpace::State* _state2,
+    StateSpace::State* _out) const
+{
+  // TODO: Disable this in release mode.
+  if (_state1 == _out || _state2 == _out)
+    throw std::invalid_argument("Output aliases input.");
+
+  compose(
+      Indices(),
+      static_cast<const State*>(_state1),
+      static_cast<const State*>(_state2),
+      static_cast<State*>(_out));
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::getIdentity(
+    StateSpace::State* _out) const
+{
+  getIdentity(Indices(), static_cast<State*>(_out));
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::getInverse(
+    const StateSpace::State* _in, StateSpace::State* _out) const
+{
+  // TODO: Disable this in release mode.
+  if (_out == _in)
+    throw std::invalid_argument("Output aliases input.");
+
+  getInverse(
+      Indices(), static_cast<const State*>(_in), static_cast<State*>(_out));
+}
+
+//==============================================================================
+template <class... Spaces>
+std::size_t StaticCartesianProduct<Spaces...>::getDimension() const
+{
+  return DimensionAtCompileTime;
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::copyState(
+    const StateSpace::State* _source, StateSpace::State* _destination) const
+{
+  copyState(
+      Indices(),
+      static_cast<const State*>(_source),
+      static_cast<State*>(_destination));
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::expMap(
+    const Eigen::VectorXd& _tangent, StateSpace::State* _out) const
+{
+  // TODO: Skip these checks in release mode.
+  if (static_cast<std::size_t>(_tangent.rows()) != DimensionAtCompileTime)
+  {
+    std::stringstream msg;
+    msg << "_tangent has incorrect size: expected " << DimensionAtCompileTime
+        << ", got " << _tangent.rows() << ".\n";
+    throw std::runtime_error(msg.str());
+  }
+
+  expMap(Indices(), _tangent, static_cast<State*>(_out));
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::logMap(
+    const StateSpace::State* _in, Eigen::VectorXd& _tangent) const
+{
+  if (static_cast<std::size_t>(_tangent.rows()) != DimensionAtCompileTime)
+    _tangent.resize(DimensionAtCompileTime);
+
+  logMap(Indices(), static_cast<const State*>(_in), _tangent);
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::composeBatch(
+    const StateSpace::State* _states1,
+    std::size_t _stride1,
+    const StateSpace::State* _states2,
+    std::size_t _stride2,
+    StateSpace::State* _out,
+    std::size_t _strideOut,
+    std::size_t _numStates) const
+{
+  auto states1 = reinterpret_cast<const char*>(_states1);
+  auto states2 = reinterpret_cast<const char*>(_states2);
+  auto out = reinterpret_cast<char*>(_out);
+
+  for (std::size_t i = 0; i < _numStates; ++i)
+  {
+    compose(
+        Indices(),
+        reinterpret_cast<const State*>(states1 + i * _stride1),
+        reinterpret_cast<const State*>(states2 + i * _stride2),
+        reinterpret_cast<State*>(out + i * _strideOut));
+  }
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::expMapBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+    StateSpace::State* _out,
+    std::size_t _stride) const
+{
+  // TODO: Skip these checks in release mode.
+  if (static_cast<std::size_t>(_tangents.rows()) != DimensionAtCompileTime)
+  {
+    std::stringstream msg;
+    msg << "_tangents has incorrect number of rows: expected "
+        << DimensionAtCompileTime << ", got " << _tangents.rows() << ".\n";
+    throw std::runtime_error(msg.str());
+  }
+
+  auto out = reinterpret_cast<char*>(_out);
+  for (int i = 0; i < _tangents.cols(); ++i)
+  {
+    expMap(
+        Indices(),
+        _tangents.col(i),
+        reinterpret_cast<State*>(out + i * _stride));
+  }
+}
+
+//==============================================================================
+template <class... Spaces>
+void StaticCartesianProduct<Spaces...>::logMapBatch(
+    const StateSpace::State* _in,
+    std::size_t _stride,
+    Eigen::Ref<Eigen::MatrixXd> _tangents) const
+{
+  // TODO: Skip these checks in release mode.
+  if (static_cast<std::size_t>(_tangents.rows()) != DimensionAtCompileTime)
+  {
+    std::stringstream msg;
+    msg << "_tangents has incorrect number of rows: expected "
+        << DimensionAtCompileTime << ", got " << _tangents.rows() << ".\n";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto in = reinterpret_cast<const char*>(_in);
+  for (int i = 0; i < _tangents.cols(); ++i)
+  {
+    logMap(
+        Indices(),
+        reinterpret_cast<const State*>(in + i * _stride),
+        _tangents.col(i));
+  }
+}
+
+// The helpers below apply an operation to every subspace by expanding the
+// index sequence inside of an array initializer, which guarantees that the
+// subspaces are visited in order.
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t... Is>
+void StaticCartesianProduct<Spaces...>::allocateStateInBuffer(
+    common::index_sequence<Is...>, State* _state) const
+{
+  int expand[] = {0,
+                  (detail::StaticSubspaceTraits<Subspace<Is>>::
+                       allocateStateInBuffer(
+                           *std::get<Is>(mStaticSubspaces),
+                           getStaticSubState<Is>(_state)),
+                   0)...};
+  (void)expand;
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t... Is>
+void StaticCartesianProduct<Spaces...>::freeStateInBuffer(
+    common::index_sequence<Is...>, State* _state) const
+{
+  int expand[] = {0,
+                  (detail::StaticSubspaceTraits<Subspace<Is>>::
+                       freeStateInBuffer(
+                           *std::get<Is>(mStaticSubspaces),
+                           getStaticSubState<Is>(_state)),
+                   0)...};
+  (void)expand;
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t... Is>
+void StaticCartesianProduct<Spaces...>::compose(
+    common::index_sequence<Is...>,
+    const State* _state1,
+    const State* _state2,
+    State* _out) const
+{
+  int expand[] = {0,
+                  (detail::StaticSubspaceTraits<Subspace<Is>>::compose(
+                       *std::get<Is>(mStaticSubspaces),
+                       getStaticSubState<Is>(_state1),
+                       getStaticSubState<Is>(_state2),
+                       getStaticSubState<Is>(_out)),
+                   0)...};
+  (void)expand;
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t... Is>
+void StaticCartesianProduct<Spaces...>::getIdentity(
+    common::index_sequence<Is...>, State* _out) const
+{
+  int expand[] = {0,
+                  (detail::StaticSubspaceTraits<Subspace<Is>>::getIdentity(
+                       *std::get<Is>(mStaticSubspaces),
+                       getStaticSubState<Is>(_out)),
+                   0)...};
+  (void)expand;
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t... Is>
+void StaticCartesianProduct<Spaces...>::getInverse(
+    common::index_sequence<Is...>, const State* _in, State* _out) const
+{
+  int expand[] = {0,
+                  (detail::StaticSubspaceTraits<Subspace<Is>>::getInverse(
+                       *std::get<Is>(mStaticSubspaces),
+                       getStaticSubState<Is>(_in),
+                       getStaticSubState<Is>(_out)),
+                   0)...};
+  (void)expand;
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t... Is>
+void StaticCartesianProduct<Spaces...>::copyState(
+    common::index_sequence<Is...>,
+    const State* _source,
+    State* _destination) const
+{
+  int expand[] = {0,
+                  (detail::StaticSubspaceTraits<Subspace<Is>>::copyState(
+                       *std::get<Is>(mStaticSubspaces),
+                       getStaticSubState<Is>(_source),
+                       getStaticSubState<Is>(_destination)),
+                   0)...};
+  (void)expand;
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t... Is>
+void StaticCartesianProduct<Spaces...>::expMap(
+    common::index_sequence<Is...>,
+    const Eigen::Ref<const Eigen::VectorXd>& _tangent,
+    State* _out) const
+{
+  int expand[] = {
+      0,
+      (detail::StaticSubspaceTraits<Subspace<Is>>::expMap(
+           *std::get<Is>(mStaticSubspaces),
+           _tangent.segment(
+               detail::StaticSubspaceOffset<Is, Spaces...>::Dimension,
+               detail::StaticSubspaceTraits<Subspace<Is>>::Dimension),
+           getStaticSubState<Is>(_out)),
+       0)...};
+  (void)expand;
+}
+
+//==============================================================================
+template <class... Spaces>
+template <std::size_t... Is>
+void StaticCartesianProduct<Spaces...>::logMap(
+    common::index_sequence<Is...>,
+    const State* _in,
+    Eigen::Ref<Eigen::VectorXd> _tangent) const
+{
+  int expand[] = {
+      0,
+      (detail::StaticSubspaceTraits<Subspace<Is>>::logMap(
+           *std::get<Is>(mStaticSubspaces),
+           getStaticSubState<Is>(_in),
+           _tangent.segment(
+               detail::StaticSubspaceOffset<Is, Spaces...>::Dimension,
+               detail::StaticSubspaceTraits<Subspace<Is>>::Dimension)),
+       0)...};
+  (void)expand;
+}
+
+} // namespace statespace
+} // namespace aikido
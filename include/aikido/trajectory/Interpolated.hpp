@@ -1,6 +1,9 @@
 #ifndef AIKIDO_TRAJECTORY_PIECEWISELINEAR_TRAJECTORY_HPP_
 #define AIKIDO_TRAJECTORY_PIECEWISELINEAR_TRAJECTORY_HPP_
 
+#include <atomic>
+#include <memory>
+#include <vector>
 #include "../statespace/GeodesicInterpolator.hpp"
 #include "Trajectory.hpp"
 
@@ -19,14 +22,25 @@ public:
       aikido::statespace::StateSpacePtr _sspace,
       aikido::statespace::InterpolatorPtr _interpolator);
 
-  /// Add a waypoint to the trajectory at the given time.
+  virtual ~Interpolated();
+
+  /// Add a waypoint to the trajectory at the given time. Adding a waypoint
+  /// after the last one takes amortized constant time, while adding one
+  /// before the last waypoint moves all waypoints after it.
   ///
   /// \param _t time of the waypoint
   /// \param _state state at the waypoint
   void addWaypoint(
       double _t, const aikido::statespace::StateSpace::State* _state);
 
-  /// Gets a waypoint.
+  /// Reserves storage for \c _numWaypoints waypoints, so that many waypoints
+  /// can be added without reallocating the storage.
+  ///
+  /// \param _numWaypoints number of waypoints to reserve storage for
+  void reserve(std::size_t _numWaypoints);
+
+  /// Gets a waypoint. The returned state is invalidated by \c addWaypoint and
+  /// \c reserve, since waypoints are stored in a single buffer.
   ///
   /// \param _index waypoint index
   /// \return state of the waypoint at index \c _index
@@ -68,30 +82,58 @@ public:
       int _derivative,
       Eigen::VectorXd& _tangentVector) const override;
 
-private:
-  /// Waypoint in the trajectory.
-  struct Waypoint
-  {
-    Waypoint(double _t, aikido::statespace::StateSpace::State* _state);
+  /// Interpolates all times that fall between the same pair of waypoints
+  /// with a single call to \c EdgeInterpolation::interpolateBatch.
+  void evaluateBatch(
+      const Eigen::VectorXd& _times,
+      Eigen::MatrixXd& _positions) const override;
+
+  // Documentation inherited
+  void evaluateDerivativeBatch(
+      const Eigen::VectorXd& _times,
+      int _derivative,
+      Eigen::MatrixXd& _tangentVectors) const override;
 
-    /// Comparator to allow sorting waypoints based on time
-    bool operator<(const Waypoint& rhs) const;
+private:
+  /// Get the index of the first waypoint whose time value is not smaller than
+  /// _t, or the number of waypoints if _t is larger than the time value of
+  /// the last waypoint. The waypoint found by the previous call and the one
+  /// after it are checked before searching all waypoints.
+  std::size_t getWaypointIndexAfterTime(double _t) const;
 
-    /// Comparator to allow sorting waypoints based on time
-    bool operator<(double rhs) const;
+  /// Returns whether \c getWaypointIndexAfterTime(_t) is \c _index.
+  bool isWaypointIndexAfterTime(std::size_t _index, double _t) const;
 
-    double t;
-    aikido::statespace::StateSpace::State* state;
-  };
+  /// Prepares the segments that start at the waypoint at \c _index or after
+  /// it, and resizes \c mEdges to the number of segments.
+  void prepareEdges(std::size_t _index);
 
-  /// Get the index of the first waypoint whose time value is larger than _t.
-  /// Throws std::domain_error if _t is larger than last waypoint in the
-  /// trajectory.
-  int getWaypointIndexAfterTime(double _t) const;
+  /// Gets the state of the waypoint at \c _index without bounds checking.
+  statespace::StateSpace::State* getWaypointState(std::size_t _index) const;
 
   aikido::statespace::StateSpacePtr mStateSpace;
   aikido::statespace::InterpolatorPtr mInterpolator;
-  std::vector<Waypoint> mWaypoints;
+
+  /// Times of the waypoints, in increasing order.
+  std::vector<double> mTimes;
+
+  /// States of the waypoints, stored in the same order as \c mTimes with a
+  /// stride of \c mStateStride bytes.
+  std::unique_ptr<char[]> mStates;
+
+  /// Size of a waypoint state in bytes, rounded up to preserve alignment.
+  std::size_t mStateStride;
+
+  /// Number of waypoints that fit in \c mStates.
+  std::size_t mCapacity;
+
+  /// Prepared segments between consecutive waypoints, so that evaluating a
+  /// segment does not recompute quantities that only depend on its
+  /// waypoints.
+  std::vector<statespace::EdgeInterpolationPtr> mEdges;
+
+  /// Result of the last call to \c getWaypointIndexAfterTime.
+  mutable std::atomic<std::size_t> mWaypointHint;
 };
 
 using InterpolatedPtr = std::shared_ptr<Interpolated>;
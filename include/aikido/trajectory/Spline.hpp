@@ -1,5 +1,6 @@
 #ifndef AIKIDO_TRAJECTORY_SPLINETRAJECTORY2_HPP_
 #define AIKIDO_TRAJECTORY_SPLINETRAJECTORY2_HPP_
+#include <atomic>
 #include "Trajectory.hpp"
 
 namespace aikido {
@@ -18,6 +19,10 @@ namespace trajectory {
 /// This trajectory does \b not guarantee any continuity (not even C0). It is
 /// the responsibility of the user to pass in continuous spline coefficients
 /// if continuity is desired.
+///
+/// Segments are found by binary search over their end times. The segment
+/// found by the last evaluation is remembered, so evaluating the trajectory
+/// at increasing times, e.g. from an executor, takes amortized constant time.
 class Spline : public Trajectory
 {
 public:
@@ -102,6 +107,18 @@ public:
       int _derivative,
       Eigen::VectorXd& _tangentVector) const override;
 
+  /// Evaluates the polynomials of all times that fall in the same segment
+  /// together, with batched \c expMap, \c compose, and \c logMap.
+  void evaluateBatch(
+      const Eigen::VectorXd& _times,
+      Eigen::MatrixXd& _positions) const override;
+
+  // Documentation inherited.
+  void evaluateDerivativeBatch(
+      const Eigen::VectorXd& _times,
+      int _derivative,
+      Eigen::MatrixXd& _tangentVectors) const override;
+
   /// Gets the number of waypoints.
   /// \return The number of waypoints
   std::size_t getNumWaypoints() const;
@@ -134,16 +151,44 @@ private:
     statespace::StateSpace::State* mStartState;
     Eigen::MatrixXd mCoefficients;
     double mDuration;
+
+    /// Coefficients of the derivatives of the polynomial, where element
+    /// <tt>i</tt> holds the coefficients of the <tt>(i + 1)</tt>-th
+    /// derivative in the same layout as \c mCoefficients.
+    std::vector<Eigen::MatrixXd> mDerivativeCoefficients;
   };
 
-  static Eigen::VectorXd evaluatePolynomial(
-      const Eigen::MatrixXd& _coefficients, double _t, int _derivative);
+  /// Evaluates the polynomial with coefficients \c _coefficients at time
+  /// \c _t using Horner's scheme, without allocating memory.
+  ///
+  /// \param _coefficients polynomial coefficients, as in \c addSegment
+  /// \param _t evaluation time
+  /// \param[out] _out value of the polynomial, must have as many rows as
+  /// \c _coefficients
+  static void evaluatePolynomial(
+      const Eigen::MatrixXd& _coefficients,
+      double _t,
+      Eigen::Ref<Eigen::VectorXd> _out);
 
+  /// Gets the index and the start time of the segment that contains \c _t.
+  /// Times after the end of the trajectory belong to the last segment.
   std::pair<std::size_t, double> getSegmentForTime(double _t) const;
 
+  /// Returns whether segment \c _index contains time \c _t.
+  bool segmentContainsTime(std::size_t _index, double _t) const;
+
   statespace::StateSpacePtr mStateSpace;
   double mStartTime;
   std::vector<PolynomialSegment> mSegments;
+
+  /// End time of each segment, i.e. the start time of the next one.
+  std::vector<double> mSegmentEndTimes;
+
+  /// Sum of the durations of all segments.
+  double mDuration;
+
+  /// Index of the segment found by the last call to \c getSegmentForTime.
+  mutable std::atomic<std::size_t> mSegmentHint;
 };
 
 } // namespace trajectory
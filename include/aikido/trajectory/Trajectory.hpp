@@ -66,6 +66,53 @@ public:
   /// \param[out] _tangentVector output tangent vector in the local frame
   virtual void evaluateDerivative(
       double _t, int _derivative, Eigen::VectorXd& _tangentVector) const = 0;
+
+  /// Evaluates the trajectory at each time in \c _times and stores the
+  /// \c logMap of each state in the corresponding column of \c _positions,
+  /// which is resized to (dimension) x (number of times). For a
+  /// \c MetaSkeletonStateSpace of \c R1Joint and \c SO2Joint subspaces,
+  /// the columns are joint positions.
+  ///
+  /// The default implementation calls \c evaluate once for each time.
+  /// Implementations are free to assume that \c _times is sorted in
+  /// increasing order for efficiency, but must support any order.
+  ///
+  /// \param _times time parameters
+  /// \param[out] _positions output matrix of logMaps of the states
+  virtual void evaluateBatch(
+      const Eigen::VectorXd& _times, Eigen::MatrixXd& _positions) const;
+
+  /// Batched version of \c evaluateDerivative. The derivative at the i-th
+  /// time in \c _times is stored in the i-th column of \c _tangentVectors,
+  /// which is resized to (dimension) x (number of times).
+  ///
+  /// The default implementation calls \c evaluateDerivative once for each
+  /// time.
+  ///
+  /// \param _times time parameters
+  /// \param _derivative order of derivative
+  /// \param[out] _tangentVectors output matrix of tangent vectors in the
+  /// local frame
+  virtual void evaluateDerivativeBatch(
+      const Eigen::VectorXd& _times,
+      int _derivative,
+      Eigen::MatrixXd& _tangentVectors) const;
+
+  /// Samples the trajectory from \c getStartTime() to \c getEndTime() at
+  /// steps of \c _timestep with \c evaluateBatch and
+  /// \c evaluateDerivativeBatch. The end time is always sampled, even if it
+  /// is closer than \c _timestep to the previous sample.
+  ///
+  /// \param _timestep time between consecutive samples, must be positive
+  /// \param[out] _positions logMaps of the states, one column per sample
+  /// \param[out] _velocities first derivatives, one column per sample
+  /// \param[out] _accelerations second derivatives, one column per sample
+  /// \return times of the samples
+  Eigen::VectorXd sampleUniform(
+      double _timestep,
+      Eigen::MatrixXd& _positions,
+      Eigen::MatrixXd& _velocities,
+      Eigen::MatrixXd& _accelerations) const;
 };
 
 using TrajectoryPtr = std::shared_ptr<Trajectory>;
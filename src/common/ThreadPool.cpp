@@ -0,0 +1,77 @@
+#include <aikido/common/ThreadPool.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace aikido {
+namespace common {
+
+//==============================================================================
+ThreadPool::ThreadPool(std::size_t numThreads) : mIsRunning(true)
+{
+  if (numThreads == 0u)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+  mThreads.reserve(numThreads);
+  for (std::size_t i = 0; i < numThreads; ++i)
+    mThreads.emplace_back(&ThreadPool::spin, this);
+}
+
+//==============================================================================
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsRunning = false;
+  }
+  mCondition.notify_all();
+
+  for (auto& thread : mThreads)
+    thread.join();
+}
+
+//==============================================================================
+std::size_t ThreadPool::getNumThreads() const
+{
+  return mThreads.size();
+}
+
+//==============================================================================
+void ThreadPool::enqueue(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mIsRunning)
+      throw std::runtime_error("ThreadPool is stopped.");
+
+    mTasks.emplace_back(std::move(task));
+  }
+  mCondition.notify_one();
+}
+
+//==============================================================================
+void ThreadPool::spin()
+{
+  while (true)
+  {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCondition.wait(
+          lock, [this]() { return !mIsRunning || !mTasks.empty(); });
+
+      // Remaining tasks are executed before the thread stops.
+      if (mTasks.empty())
+        return;
+
+      task = std::move(mTasks.front());
+      mTasks.pop_front();
+    }
+
+    // Exceptions are stored in the future returned by submit().
+    task();
+  }
+}
+
+} // namespace common
+} // namespace aikido
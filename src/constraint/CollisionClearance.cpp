@@ -0,0 +1,221 @@
+#include <aikido/constraint/CollisionClearance.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace aikido {
+namespace constraint {
+
+namespace {
+
+//==============================================================================
+std::unordered_set<const dart::dynamics::Skeleton*> getMovingSkeletons(
+    const statespace::dart::MetaSkeletonStateSpace& _statespace)
+{
+  const auto metaSkeleton = _statespace.getMetaSkeleton();
+
+  std::unordered_set<const dart::dynamics::Skeleton*> skeletons;
+  for (std::size_t i = 0; i < metaSkeleton->getNumDofs(); ++i)
+    skeletons.insert(metaSkeleton->getDof(i)->getSkeleton().get());
+
+  return skeletons;
+}
+
+} // namespace
+
+//==============================================================================
+CollisionClearance::CollisionClearance(
+    statespace::dart::MetaSkeletonStateSpacePtr _statespace,
+    std::shared_ptr<dart::collision::CollisionDetector> _collisionDetector,
+    double _maxDisplacementPerDistance,
+    dart::collision::DistanceOption _distanceOptions)
+  : mStatespace(std::move(_statespace))
+  , mCollisionDetector(std::move(_collisionDetector))
+  , mMaxDisplacementPerDistance(_maxDisplacementPerDistance)
+  , mDistanceOptions(std::move(_distanceOptions))
+{
+  if (!mStatespace)
+    throw std::invalid_argument("_statespace is nullptr.");
+
+  mMovingSkeletons = getMovingSkeletons(*mStatespace);
+
+  if (!mCollisionDetector)
+    throw std::invalid_argument("_collisionDetector is nullptr.");
+
+  if (!(mMaxDisplacementPerDistance > 0.))
+  {
+    throw std::invalid_argument(
+        "Maximum displacement per distance must be positive.");
+  }
+}
+
+//==============================================================================
+statespace::StateSpacePtr CollisionClearance::getStateSpace() const
+{
+  return mStatespace;
+}
+
+//==============================================================================
+double CollisionClearance::getClearance(
+    const statespace::StateSpace::State* _state) const
+{
+  const auto skelStatePtr
+      = static_cast<const statespace::dart::MetaSkeletonStateSpace::State*>(
+          _state);
+
+  if (!mSkeletonReplicaPool)
+  {
+    mStatespace->setState(skelStatePtr);
+    return computeClearance(mCollisionDetector.get(), nullptr);
+  }
+
+  auto& replica = mSkeletonReplicaPool->getReplica();
+  replica.getStateSpace(mStatespace)->setState(skelStatePtr);
+
+  return computeClearance(
+      replica.getCollisionDetector(mCollisionDetector.get()).get(), &replica);
+}
+
+//==============================================================================
+double CollisionClearance::computeClearance(
+    dart::collision::CollisionDetector* _collisionDetector,
+    statespace::dart::SkeletonReplica* _replica) const
+{
+  const auto getGroup
+      = [_replica](const std::shared_ptr<CollisionGroup>& _group) {
+          return _replica ? _replica->getCollisionGroup(_group).get()
+                          : _group.get();
+        };
+
+  // The filter of a replica maps its BodyNodes back to the original ones,
+  // which e.g. the blacklist of a BodyNodeDistanceFilter refers to.
+  dart::collision::DistanceOption replicaOptions;
+  if (_replica)
+  {
+    replicaOptions = mDistanceOptions;
+    replicaOptions.distanceFilter
+        = _replica->getDistanceFilter(mDistanceOptions.distanceFilter);
+  }
+  const auto& distanceOptions = _replica ? replicaOptions : mDistanceOptions;
+
+  double clearance = std::numeric_limits<double>::infinity();
+  for (const auto& groups : mGroupsToPairwiseCheck)
+  {
+    double distance = _collisionDetector->distance(
+        getGroup(groups.first), getGroup(groups.second), distanceOptions);
+
+    // Both groups may move towards each other by the maximum displacement.
+    // The original groups are classified, since the bodies of a replica
+    // belong to the replicated skeletons.
+    if (isMoving(*groups.first) && isMoving(*groups.second))
+      distance *= 0.5;
+
+    clearance = std::min(clearance, distance);
+
+    if (clearance <= 0.)
+      return clearance;
+  }
+
+  for (const auto& group : mGroupsToSelfCheck)
+  {
+    // Any two bodies of the group may move towards each other.
+    clearance = std::min(
+        clearance,
+        0.5 * _collisionDetector->distance(getGroup(group), distanceOptions));
+
+    if (clearance <= 0.)
+      return clearance;
+  }
+
+  return clearance;
+}
+
+//==============================================================================
+double CollisionClearance::getMaxDisplacementPerDistance() const
+{
+  return mMaxDisplacementPerDistance;
+}
+
+//==============================================================================
+bool CollisionClearance::isMoving(const CollisionGroup& _group) const
+{
+  for (std::size_t i = 0; i < _group.getNumShapeFrames(); ++i)
+  {
+    const auto shapeNode = _group.getShapeFrame(i)->asShapeNode();
+    if (shapeNode
+        && mMovingSkeletons.count(
+               shapeNode->getBodyNodePtr()->getSkeleton().get()))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+void CollisionClearance::addPairwiseCheck(
+    std::shared_ptr<dart::collision::CollisionGroup> _group1,
+    std::shared_ptr<dart::collision::CollisionGroup> _group2)
+{
+  if (!_group1 || !_group2)
+    throw std::invalid_argument("CollisionGroup is nullptr.");
+
+  if (_group2 < _group1)
+    std::swap(_group1, _group2);
+
+  mGroupsToPairwiseCheck.emplace_back(std::move(_group1), std::move(_group2));
+}
+
+//==============================================================================
+void CollisionClearance::removePairwiseCheck(
+    std::shared_ptr<dart::collision::CollisionGroup> _group1,
+    std::shared_ptr<dart::collision::CollisionGroup> _group2)
+{
+  if (_group2 < _group1)
+    std::swap(_group1, _group2);
+
+  mGroupsToPairwiseCheck.erase(
+      std::remove(
+          mGroupsToPairwiseCheck.begin(),
+          mGroupsToPairwiseCheck.end(),
+          std::make_pair(_group1, _group2)),
+      mGroupsToPairwiseCheck.end());
+}
+
+//==============================================================================
+void CollisionClearance::addSelfCheck(
+    std::shared_ptr<dart::collision::CollisionGroup> _group)
+{
+  if (!_group)
+    throw std::invalid_argument("CollisionGroup is nullptr.");
+
+  mGroupsToSelfCheck.emplace_back(std::move(_group));
+}
+
+//==============================================================================
+void CollisionClearance::removeSelfCheck(
+    std::shared_ptr<dart::collision::CollisionGroup> _group)
+{
+  mGroupsToSelfCheck.erase(
+      std::remove(
+          mGroupsToSelfCheck.begin(), mGroupsToSelfCheck.end(), _group),
+      mGroupsToSelfCheck.end());
+}
+
+//==============================================================================
+void CollisionClearance::setSkeletonReplicaPool(
+    statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool)
+{
+  mSkeletonReplicaPool = std::move(_skeletonReplicaPool);
+}
+
+//==============================================================================
+statespace::dart::SkeletonReplicaPoolPtr
+CollisionClearance::getSkeletonReplicaPool() const
+{
+  return mSkeletonReplicaPool;
+}
+
+} // namespace constraint
+} // namespace aikido
@@ -1,7 +1,39 @@
 #include <aikido/constraint/CollisionFree.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
 namespace aikido {
 namespace constraint {
+namespace {
+
+//==============================================================================
+/// Ratio of the estimated collision probability of a check to its mean
+/// evaluation time, or the collision probability alone if the check was not
+/// timed. Checks that have never been evaluated come first, so that their
+/// statistics are collected.
+double getFailFirstScore(const CollisionFree::CheckStatistics& _statistics)
+{
+  if (_statistics.mNumEvaluations == 0u)
+    return std::numeric_limits<double>::infinity();
+
+  // Laplace smoothing avoids excluding a check after a few evaluations.
+  const double collisionProbability = (_statistics.mNumCollisions + 1.)
+                                      / (_statistics.mNumEvaluations + 2.);
+  if (_statistics.mTotalTime.count() <= 0.)
+    return collisionProbability;
+
+  const double meanTime
+      = _statistics.mTotalTime.count() / _statistics.mNumEvaluations;
+
+  return collisionProbability
+         / std::max(meanTime, std::numeric_limits<double>::min());
+}
+
+} // namespace
+
+constexpr std::size_t CollisionFree::ADAPTIVE_ORDERING_PERIOD;
 
 //==============================================================================
 CollisionFree::CollisionFree(
@@ -11,6 +43,9 @@ CollisionFree::CollisionFree(
   : mStatespace(std::move(_statespace))
   , mCollisionDetector(std::move(_collisionDetector))
   , mCollisionOptions(std::move(_collisionOptions))
+  , mAdaptiveOrdering(false)
+  , mCheckTimingEnabled(false)
+  , mNumStatesSinceUpdate(0u)
 {
   if (!mStatespace)
     throw std::invalid_argument("_statespace is nullptr.");
@@ -31,29 +66,302 @@ bool CollisionFree::isSatisfied(
 {
   auto skelStatePtr = static_cast<const aikido::statespace::dart::
                                       MetaSkeletonStateSpace::State*>(_state);
-  mStatespace->setState(skelStatePtr);
 
-  bool collision = false;
+  if (mThreadPool && mChecks.size() > 1)
+  {
+    if (!mSkeletonReplicaPool)
+    {
+      throw std::logic_error(
+          "CollisionFree requires a SkeletonReplicaPool to evaluate checks "
+          "on a ThreadPool.");
+    }
+
+    return isCollisionFreeParallel(skelStatePtr);
+  }
+
+  if (!mSkeletonReplicaPool)
+  {
+    mStatespace->setState(skelStatePtr);
+    return isCollisionFree(mCollisionDetector.get(), nullptr);
+  }
+
+  auto& replica = mSkeletonReplicaPool->getReplica();
+  replica.getStateSpace(mStatespace)->setState(skelStatePtr);
+
+  return isCollisionFree(
+      replica.getCollisionDetector(mCollisionDetector.get()).get(), &replica);
+}
+
+//==============================================================================
+bool CollisionFree::isCollisionFree(
+    dart::collision::CollisionDetector* _collisionDetector,
+    statespace::dart::SkeletonReplica* _replica) const
+{
+  std::shared_ptr<const std::vector<std::size_t>> adaptiveCheckOrder;
+  const auto& checkOrder = getCheckOrder(adaptiveCheckOrder);
+
+  bool collisionFree = true;
+  for (const auto index : checkOrder)
+  {
+    if (!isCheckCollisionFree(index, _collisionDetector, _replica))
+    {
+      collisionFree = false;
+      break;
+    }
+  }
+
+  countEvaluatedState();
+  return collisionFree;
+}
+
+//==============================================================================
+bool CollisionFree::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& _states,
+    std::vector<bool>& _out,
+    bool _earlyExit) const
+{
+  using statespace::dart::MetaSkeletonStateSpace;
+
+  const auto numStates = _states.size();
+  _out.assign(numStates, false);
+
+  if (!mThreadPool || numStates < 2)
+  {
+    bool allSatisfied = true;
+    for (std::size_t i = 0; i < numStates; ++i)
+    {
+      _out[i] = isSatisfied(_states[i]);
+      if (!_out[i])
+      {
+        allSatisfied = false;
+        if (_earlyExit)
+          break;
+      }
+    }
+    return allSatisfied;
+  }
+
+  if (!mSkeletonReplicaPool)
+  {
+    throw std::logic_error(
+        "CollisionFree requires a SkeletonReplicaPool to evaluate checks on a "
+        "ThreadPool.");
+  }
+
+  // The states are distributed between the threads, each of which evaluates
+  // all checks of a state on its own replica. std::vector<bool> can not be
+  // written concurrently, so the results are collected in a vector of char.
+  std::vector<char> results(numStates, false);
+  std::atomic<std::size_t> firstUnsatisfied(numStates);
+
+  mThreadPool->parallelFor(numStates, [&](std::size_t _index, std::size_t) {
+    if (_earlyExit && _index > firstUnsatisfied.load())
+      return;
+
+    auto& replica = mSkeletonReplicaPool->getReplica();
+    replica.getStateSpace(mStatespace)
+        ->setState(
+            static_cast<const MetaSkeletonStateSpace::State*>(
+                _states[_index]));
+    results[_index] = isCollisionFree(
+        replica.getCollisionDetector(mCollisionDetector.get()).get(),
+        &replica);
+
+    if (!results[_index])
+    {
+      auto current = firstUnsatisfied.load();
+      while (_index < current
+             && !firstUnsatisfied.compare_exchange_weak(current, _index))
+      {
+        // Do nothing.
+      }
+    }
+  });
+
+  bool allSatisfied = true;
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    if (_earlyExit && i > firstUnsatisfied.load())
+      break;
+
+    _out[i] = results[i];
+    if (!_out[i])
+      allSatisfied = false;
+  }
+  return allSatisfied;
+}
+
+//==============================================================================
+bool CollisionFree::areAllSatisfied(
+    const std::vector<const statespace::StateSpace::State*>& _states) const
+{
+  using statespace::dart::MetaSkeletonStateSpace;
+
+  if (!mThreadPool || _states.size() < 2)
+  {
+    for (const auto state : _states)
+    {
+      if (!isSatisfied(state))
+        return false;
+    }
+    return true;
+  }
+
+  if (!mSkeletonReplicaPool)
+  {
+    throw std::logic_error(
+        "CollisionFree requires a SkeletonReplicaPool to evaluate checks on a "
+        "ThreadPool.");
+  }
+
+  // Any state in collision makes the result false, so the first one cancels
+  // the states that have not been started, regardless of their index.
+  std::atomic<bool> collision(false);
+
+  mThreadPool->parallelFor(
+      _states.size(), [&](std::size_t _index, std::size_t) {
+        if (collision.load())
+          return;
+
+        auto& replica = mSkeletonReplicaPool->getReplica();
+        replica.getStateSpace(mStatespace)
+            ->setState(
+                static_cast<const MetaSkeletonStateSpace::State*>(
+                    _states[_index]));
+        if (!isCollisionFree(
+                replica.getCollisionDetector(mCollisionDetector.get()).get(),
+                &replica))
+        {
+          collision = true;
+        }
+      });
+
+  return !collision.load();
+}
+
+//==============================================================================
+bool CollisionFree::isCollisionFreeParallel(
+    const statespace::dart::MetaSkeletonStateSpace::State* _state) const
+{
+  std::shared_ptr<const std::vector<std::size_t>> adaptiveCheckOrder;
+  const auto& checkOrder = getCheckOrder(adaptiveCheckOrder);
+
+  // Each worker sets the state on its replica before evaluating its first
+  // check.
+  std::vector<statespace::dart::SkeletonReplica*> replicas(
+      mThreadPool->getNumThreads() + 1, nullptr);
+  std::vector<dart::collision::CollisionDetector*> collisionDetectors(
+      replicas.size(), nullptr);
+  std::atomic<bool> collision(false);
+
+  mThreadPool->parallelFor(
+      mChecks.size(), [&](std::size_t _index, std::size_t _worker) {
+        if (collision.load())
+          return;
+
+        auto& replica = replicas[_worker];
+        auto& collisionDetector = collisionDetectors[_worker];
+        if (!replica)
+        {
+          replica = &mSkeletonReplicaPool->getReplica();
+          replica->getStateSpace(mStatespace)->setState(_state);
+          collisionDetector
+              = replica->getCollisionDetector(mCollisionDetector.get()).get();
+        }
+
+        if (!isCheckCollisionFree(
+                checkOrder[_index], collisionDetector, replica))
+        {
+          collision = true;
+        }
+      });
+
+  countEvaluatedState();
+  return !collision.load();
+}
+
+//==============================================================================
+CollisionFree::Check::Check(
+    std::shared_ptr<CollisionGroup> _group1,
+    std::shared_ptr<CollisionGroup> _group2)
+  : mGroup1(std::move(_group1))
+  , mGroup2(std::move(_group2))
+  , mNumEvaluations(0u)
+  , mNumCollisions(0u)
+  , mTotalTime(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+CollisionFree::CheckStatistics CollisionFree::getStatistics(
+    const Check& _check)
+{
+  return CheckStatistics{
+      _check.mGroup1,
+      _check.mGroup2,
+      _check.mNumEvaluations.load(std::memory_order_relaxed),
+      _check.mNumCollisions.load(std::memory_order_relaxed),
+      std::chrono::steady_clock::duration(
+          _check.mTotalTime.load(std::memory_order_relaxed))};
+}
+
+//==============================================================================
+bool CollisionFree::isCheckCollisionFree(
+    std::size_t _index,
+    dart::collision::CollisionDetector* _collisionDetector,
+    statespace::dart::SkeletonReplica* _replica) const
+{
+  const auto getGroup
+      = [_replica](const std::shared_ptr<CollisionGroup>& _group) {
+          return _replica ? _replica->getCollisionGroup(_group).get()
+                          : _group.get();
+        };
+
+  auto& check = *mChecks[_index];
+  const auto startTime = mCheckTimingEnabled
+                             ? std::chrono::steady_clock::now()
+                             : std::chrono::steady_clock::time_point();
+
+  // The filter of a replica maps its BodyNodes back to the original ones,
+  // which e.g. the blacklist of a BodyNodeCollisionFilter refers to.
+  dart::collision::CollisionOption replicaOptions;
+  if (_replica)
+  {
+    replicaOptions = mCollisionOptions;
+    replicaOptions.collisionFilter
+        = _replica->getCollisionFilter(mCollisionOptions.collisionFilter);
+  }
+  const auto& collisionOptions = _replica ? replicaOptions : mCollisionOptions;
+
+  bool collision;
   dart::collision::CollisionResult collisionResult;
-  for (auto groups : mGroupsToPairwiseCheck)
+  if (check.mGroup2)
   {
-    collision = mCollisionDetector->collide(
-        groups.first.get(),
-        groups.second.get(),
-        mCollisionOptions,
+    collision = _collisionDetector->collide(
+        getGroup(check.mGroup1),
+        getGroup(check.mGroup2),
+        collisionOptions,
         &collisionResult);
-    if (collision)
-      return false;
+  }
+  else
+  {
+    collision = _collisionDetector->collide(
+        getGroup(check.mGroup1), collisionOptions, &collisionResult);
   }
 
-  for (auto group : mGroupsToSelfCheck)
+  if (mCheckTimingEnabled)
   {
-    collision = mCollisionDetector->collide(
-        group.get(), mCollisionOptions, &collisionResult);
-    if (collision)
-      return false;
+    const auto time = std::chrono::steady_clock::now() - startTime;
+    check.mTotalTime.fetch_add(time.count(), std::memory_order_relaxed);
   }
-  return true;
+
+  // The counters are atomic, so the common case does not lock a mutex.
+  check.mNumEvaluations.fetch_add(1u, std::memory_order_relaxed);
+  if (collision)
+    check.mNumCollisions.fetch_add(1u, std::memory_order_relaxed);
+
+  return !collision;
 }
 
 //==============================================================================
@@ -61,10 +369,15 @@ void CollisionFree::addPairwiseCheck(
     std::shared_ptr<dart::collision::CollisionGroup> _group1,
     std::shared_ptr<dart::collision::CollisionGroup> _group2)
 {
-  if (_group1 < _group2)
-    mGroupsToPairwiseCheck.emplace_back(std::move(_group1), std::move(_group2));
-  else
-    mGroupsToPairwiseCheck.emplace_back(std::move(_group2), std::move(_group1));
+  if (!_group1 || !_group2)
+    throw std::invalid_argument("CollisionGroup is nullptr.");
+
+  if (_group2 < _group1)
+    std::swap(_group1, _group2);
+
+  std::lock_guard<std::mutex> lock(mStatisticsMutex);
+  mChecks.emplace_back(new Check(std::move(_group1), std::move(_group2)));
+  initializeCheckOrder();
 }
 
 //==============================================================================
@@ -72,36 +385,200 @@ void CollisionFree::removePairwiseCheck(
     std::shared_ptr<dart::collision::CollisionGroup> _group1,
     std::shared_ptr<dart::collision::CollisionGroup> _group2)
 {
-  if (_group1 < _group2)
-    mGroupsToPairwiseCheck.erase(
-        std::remove(
-            mGroupsToPairwiseCheck.begin(),
-            mGroupsToPairwiseCheck.end(),
-            std::make_pair(_group1, _group2)),
-        mGroupsToPairwiseCheck.end());
-  else
-    mGroupsToPairwiseCheck.erase(
-        std::remove(
-            mGroupsToPairwiseCheck.begin(),
-            mGroupsToPairwiseCheck.end(),
-            std::make_pair(_group2, _group1)),
-        mGroupsToPairwiseCheck.end());
+  if (_group2 < _group1)
+    std::swap(_group1, _group2);
+
+  std::lock_guard<std::mutex> lock(mStatisticsMutex);
+  mChecks.erase(
+      std::remove_if(
+          mChecks.begin(),
+          mChecks.end(),
+          [&](const std::unique_ptr<Check>& _check) {
+            return _check->mGroup1 == _group1 && _check->mGroup2 == _group2;
+          }),
+      mChecks.end());
+  initializeCheckOrder();
 }
 
 //==============================================================================
 void CollisionFree::addSelfCheck(
     std::shared_ptr<dart::collision::CollisionGroup> _group)
 {
-  mGroupsToSelfCheck.emplace_back(std::move(_group));
+  if (!_group)
+    throw std::invalid_argument("CollisionGroup is nullptr.");
+
+  std::lock_guard<std::mutex> lock(mStatisticsMutex);
+  mChecks.emplace_back(new Check(std::move(_group), nullptr));
+  initializeCheckOrder();
 }
 
 //==============================================================================
 void CollisionFree::removeSelfCheck(
     std::shared_ptr<dart::collision::CollisionGroup> _group)
 {
-  mGroupsToSelfCheck.erase(
-      std::remove(mGroupsToSelfCheck.begin(), mGroupsToSelfCheck.end(), _group),
-      mGroupsToSelfCheck.end());
+  std::lock_guard<std::mutex> lock(mStatisticsMutex);
+  mChecks.erase(
+      std::remove_if(
+          mChecks.begin(),
+          mChecks.end(),
+          [&](const std::unique_ptr<Check>& _check) {
+            return _check->mGroup1 == _group && !_check->mGroup2;
+          }),
+      mChecks.end());
+  initializeCheckOrder();
+}
+
+//==============================================================================
+void CollisionFree::setSkeletonReplicaPool(
+    statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool)
+{
+  mSkeletonReplicaPool = std::move(_skeletonReplicaPool);
+}
+
+//==============================================================================
+statespace::dart::SkeletonReplicaPoolPtr CollisionFree::getSkeletonReplicaPool()
+    const
+{
+  return mSkeletonReplicaPool;
+}
+
+//==============================================================================
+void CollisionFree::setThreadPool(common::ThreadPoolPtr _threadPool)
+{
+  mThreadPool = std::move(_threadPool);
+}
+
+//==============================================================================
+common::ThreadPoolPtr CollisionFree::getThreadPool() const
+{
+  return mThreadPool;
+}
+
+//==============================================================================
+std::vector<CollisionFree::CheckStatistics> CollisionFree::getCheckStatistics()
+    const
+{
+  std::vector<CheckStatistics> statistics;
+  statistics.reserve(mChecks.size());
+  for (const auto& check : mChecks)
+    statistics.emplace_back(getStatistics(*check));
+
+  return statistics;
+}
+
+//==============================================================================
+void CollisionFree::resetCheckStatistics()
+{
+  std::lock_guard<std::mutex> lock(mStatisticsMutex);
+  for (auto& check : mChecks)
+  {
+    check->mNumEvaluations = 0u;
+    check->mNumCollisions = 0u;
+    check->mTotalTime = 0;
+  }
+  initializeCheckOrder();
+}
+
+//==============================================================================
+void CollisionFree::setCheckTimingEnabled(bool _enabled)
+{
+  mCheckTimingEnabled = _enabled;
+}
+
+//==============================================================================
+bool CollisionFree::isCheckTimingEnabled() const
+{
+  return mCheckTimingEnabled;
+}
+
+//==============================================================================
+void CollisionFree::setAdaptiveOrdering(bool _adaptiveOrdering)
+{
+  std::lock_guard<std::mutex> lock(mStatisticsMutex);
+  mAdaptiveOrdering = _adaptiveOrdering;
+  initializeCheckOrder();
+}
+
+//==============================================================================
+bool CollisionFree::isAdaptiveOrdering() const
+{
+  return mAdaptiveOrdering;
+}
+
+//==============================================================================
+const std::vector<std::size_t>& CollisionFree::getCheckOrder(
+    std::shared_ptr<const std::vector<std::size_t>>& _adaptiveCheckOrder) const
+{
+  // mCheckOrder is only modified by the functions that register checks,
+  // which must not be called concurrently with isSatisfied.
+  if (mAdaptiveOrdering)
+    _adaptiveCheckOrder = std::atomic_load(&mAdaptiveCheckOrder);
+
+  return _adaptiveCheckOrder ? *_adaptiveCheckOrder : mCheckOrder;
+}
+
+//==============================================================================
+void CollisionFree::countEvaluatedState() const
+{
+  if (!mAdaptiveOrdering
+      || mNumStatesSinceUpdate.fetch_add(1u) + 1u < ADAPTIVE_ORDERING_PERIOD)
+  {
+    return;
+  }
+
+  // Another thread may have updated the order while this one was waiting.
+  std::lock_guard<std::mutex> lock(mStatisticsMutex);
+  if (mNumStatesSinceUpdate.load() >= ADAPTIVE_ORDERING_PERIOD)
+    updateCheckOrder();
+}
+
+//==============================================================================
+void CollisionFree::updateCheckOrder() const
+{
+  mNumStatesSinceUpdate = 0u;
+
+  std::vector<double> scores;
+  scores.reserve(mChecks.size());
+  for (const auto& check : mChecks)
+    scores.emplace_back(getFailFirstScore(getStatistics(*check)));
+
+  // Stable, so checks with equal scores keep their default order.
+  auto checkOrder = std::make_shared<std::vector<std::size_t>>(mCheckOrder);
+  std::stable_sort(
+      checkOrder->begin(),
+      checkOrder->end(),
+      [&scores](std::size_t _index1, std::size_t _index2) {
+        return scores[_index1] > scores[_index2];
+      });
+
+  std::atomic_store(
+      &mAdaptiveCheckOrder,
+      std::shared_ptr<const std::vector<std::size_t>>(std::move(checkOrder)));
+}
+
+//==============================================================================
+void CollisionFree::initializeCheckOrder()
+{
+  mCheckOrder.resize(mChecks.size());
+  for (std::size_t i = 0; i < mCheckOrder.size(); ++i)
+    mCheckOrder[i] = i;
+
+  // Pairwise checks are evaluated before self-collision checks.
+  std::stable_partition(
+      mCheckOrder.begin(), mCheckOrder.end(), [this](std::size_t _index) {
+        return mChecks[_index]->mGroup2 != nullptr;
+      });
+
+  if (mAdaptiveOrdering)
+  {
+    updateCheckOrder();
+  }
+  else
+  {
+    std::atomic_store(
+        &mAdaptiveCheckOrder,
+        std::shared_ptr<const std::vector<std::size_t>>());
+  }
 }
 
 } // namespace constraint
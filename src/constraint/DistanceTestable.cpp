@@ -0,0 +1,14 @@
+#include <aikido/constraint/DistanceTestable.hpp>
+
+namespace aikido {
+namespace constraint {
+
+//==============================================================================
+bool DistanceTestable::isSatisfied(
+    const statespace::StateSpace::State* _state) const
+{
+  return getClearance(_state) > 0.;
+}
+
+} // namespace constraint
+} // namespace aikido
@@ -56,17 +56,15 @@ std::size_t FramePairDifferentiable::getConstraintDimension() const
 void FramePairDifferentiable::getValue(
     const statespace::StateSpace::State* _s, Eigen::VectorXd& _out) const
 {
-  using State = statespace::CartesianProduct::State;
   using SE3State = statespace::SE3::State;
 
-  auto state = static_cast<const State*>(_s);
-
-  mMetaSkeletonStateSpace->setState(state);
+  const auto frames = setState(_s);
 
   // Relative transform of mJacobianNode1 w.r.t. mJacobianNode2,
   // expressed in mJacobianNode2 frame.
   SE3State relativeTransform(
-      mJacobianNode1->getTransform(mJacobianNode2, mJacobianNode2));
+      frames.mJacobianNode1->getTransform(
+          frames.mJacobianNode2, frames.mJacobianNode2));
 
   mRelPoseConstraint->getValue(&relativeTransform, _out);
 }
@@ -75,18 +73,15 @@ void FramePairDifferentiable::getValue(
 void FramePairDifferentiable::getJacobian(
     const statespace::StateSpace::State* _s, Eigen::MatrixXd& _out) const
 {
-  using State = statespace::CartesianProduct::State;
   using SE3State = statespace::SE3::State;
-  using dart::dynamics::MetaSkeletonPtr;
 
-  auto state = static_cast<const State*>(_s);
-
-  mMetaSkeletonStateSpace->setState(state);
+  const auto frames = setState(_s);
 
   // Relative transform of mJacobianNode1 w.r.t. mJacobianNode2,
   // expressed in mJacobianNode2's frame.
   SE3State relTransform(
-      mJacobianNode1->getTransform(mJacobianNode2, mJacobianNode2));
+      frames.mJacobianNode1->getTransform(
+          frames.mJacobianNode2, frames.mJacobianNode2));
 
   // m x 6 matrix, Jacobian of constraints w.r.t. SE3 pose (se3 tangent vector)
   // where the tangent vector is expressed in mJacobianNode2's frame.
@@ -96,8 +91,10 @@ void FramePairDifferentiable::getJacobian(
   // 6 x numDofs,
   // Jacobian of relative transform expressed in mJacobianNode2's Frame.
   Eigen::MatrixXd skeletonJac
-      = mMetaSkeleton->getJacobian(mJacobianNode1, mJacobianNode2)
-        - mMetaSkeleton->getJacobian(mJacobianNode2, mJacobianNode2);
+      = frames.mMetaSkeleton->getJacobian(
+            frames.mJacobianNode1, frames.mJacobianNode2)
+        - frames.mMetaSkeleton->getJacobian(
+              frames.mJacobianNode2, frames.mJacobianNode2);
 
   // m x numDofs,
   // Jacobian of relative pose constraint w.r.t generalized coordinates.
@@ -110,18 +107,15 @@ void FramePairDifferentiable::getValueAndJacobian(
     Eigen::VectorXd& _val,
     Eigen::MatrixXd& _jac) const
 {
-  using State = statespace::CartesianProduct::State;
   using SE3State = statespace::SE3::State;
-  using dart::dynamics::MetaSkeletonPtr;
 
-  auto state = static_cast<const State*>(_s);
-
-  mMetaSkeletonStateSpace->setState(state);
+  const auto frames = setState(_s);
 
   // Relative transform of mJacobianNode1 w.r.t. mJacobianNode2,
   // expressed in mJacobianNode2's frame.
   SE3State relTransform(
-      mJacobianNode1->getTransform(mJacobianNode2, mJacobianNode2));
+      frames.mJacobianNode1->getTransform(
+          frames.mJacobianNode2, frames.mJacobianNode2));
 
   mRelPoseConstraint->getValue(&relTransform, _val);
 
@@ -133,8 +127,10 @@ void FramePairDifferentiable::getValueAndJacobian(
   // 6 x numDofs,
   // Jacobian of relative transform expressed in mJacobianNode2's Frame.
   Eigen::MatrixXd skeletonJac
-      = mMetaSkeleton->getJacobian(mJacobianNode1, mJacobianNode2)
-        - mMetaSkeleton->getJacobian(mJacobianNode2, mJacobianNode2);
+      = frames.mMetaSkeleton->getJacobian(
+            frames.mJacobianNode1, frames.mJacobianNode2)
+        - frames.mMetaSkeleton->getJacobian(
+              frames.mJacobianNode2, frames.mJacobianNode2);
 
   // m x numDofs,
   // Jacobian of relative pose constraint w.r.t generalized coordinates.
@@ -153,5 +149,42 @@ statespace::StateSpacePtr FramePairDifferentiable::getStateSpace() const
   return mMetaSkeletonStateSpace;
 }
 
+//==============================================================================
+void FramePairDifferentiable::setSkeletonReplicaPool(
+    statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool)
+{
+  mSkeletonReplicaPool = std::move(_skeletonReplicaPool);
+}
+
+//==============================================================================
+statespace::dart::SkeletonReplicaPoolPtr
+FramePairDifferentiable::getSkeletonReplicaPool() const
+{
+  return mSkeletonReplicaPool;
+}
+
+//==============================================================================
+auto FramePairDifferentiable::setState(
+    const statespace::StateSpace::State* _s) const -> Frames
+{
+  using State = statespace::CartesianProduct::State;
+
+  auto state = static_cast<const State*>(_s);
+
+  if (!mSkeletonReplicaPool)
+  {
+    mMetaSkeletonStateSpace->setState(state);
+    return Frames{
+        mMetaSkeleton.get(), mJacobianNode1.get(), mJacobianNode2.get()};
+  }
+
+  auto& replica = mSkeletonReplicaPool->getReplica();
+  replica.getStateSpace(mMetaSkeletonStateSpace)->setState(state);
+
+  return Frames{replica.getMetaSkeleton(mMetaSkeleton).get(),
+                replica.getJacobianNode(mJacobianNode1.get()),
+                replica.getJacobianNode(mJacobianNode2.get())};
+}
+
 } // namespace constraint
 } // namespace aikido
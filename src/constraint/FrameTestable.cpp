@@ -1,5 +1,7 @@
 #include <aikido/constraint/FrameTestable.hpp>
 
+#include <aikido/statespace/InlineScopedState.hpp>
+
 namespace aikido {
 namespace constraint {
 
@@ -40,11 +42,22 @@ bool FrameTestable::isSatisfied(
   auto state
       = static_cast<const statespace::dart::MetaSkeletonStateSpace::State*>(
           _state);
-  mStateSpace->setState(state);
+  const dart::dynamics::JacobianNode* frame = mFrame.get();
+  if (mSkeletonReplicaPool)
+  {
+    auto& replica = mSkeletonReplicaPool->getReplica();
+    replica.getStateSpace(mStateSpace)->setState(state);
+    frame = replica.getJacobianNode(frame);
+  }
+  else
+  {
+    mStateSpace->setState(state);
+  }
 
   // Check the pose constraint
-  auto st = mPoseStateSpace->createState();
-  mPoseStateSpace->setIsometry(st, mFrame->getTransform());
+  statespace::InlineScopedState<statespace::SE3::StateHandle> st(
+      mPoseStateSpace.get());
+  mPoseStateSpace->setIsometry(st, frame->getTransform());
 
   return mPoseConstraint->isSatisfied(st);
 }
@@ -55,5 +68,19 @@ std::shared_ptr<statespace::StateSpace> FrameTestable::getStateSpace() const
   return mStateSpace;
 }
 
+//==============================================================================
+void FrameTestable::setSkeletonReplicaPool(
+    statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool)
+{
+  mSkeletonReplicaPool = std::move(_skeletonReplicaPool);
+}
+
+//==============================================================================
+statespace::dart::SkeletonReplicaPoolPtr FrameTestable::getSkeletonReplicaPool()
+    const
+{
+  return mSkeletonReplicaPool;
+}
+
 } // namespace constraint
 } // namespace aikido
@@ -1,6 +1,10 @@
 #include <aikido/constraint/InverseKinematicsSampleable.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 #include <aikido/statespace/SE3.hpp>
+#include <aikido/statespace/StatePool.hpp>
 
 namespace aikido {
 namespace constraint {
@@ -15,6 +19,8 @@ using dart::dynamics::INVALID_INDEX;
 class IkSampleGenerator : public SampleGenerator
 {
 public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   IkSampleGenerator(const IkSampleGenerator&) = delete;
   IkSampleGenerator(IkSampleGenerator&& other) = delete;
 
@@ -42,7 +48,32 @@ private:
       dart::dynamics::InverseKinematicsPtr _inverseKinematics,
       std::unique_ptr<SampleGenerator> _poseSampler,
       std::unique_ptr<SampleGenerator> _seedSampler,
-      int _maxNumTrials);
+      int _maxNumTrials,
+      statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool,
+      common::ThreadPoolPtr _threadPool,
+      InverseKinematicsSeedDatabasePtr _seedDatabase,
+      std::size_t _numSeedsPerPose);
+
+  /// Draws the next seed and pose pair, from mSeedSampler and mPoseSampler
+  /// or, if set, from mSeedDatabase and mPoseSampler.
+  /// \param _seedState state used to sample the seed
+  /// \param _poseState state used to sample the pose
+  /// \param[out] _seed positions of the seed
+  /// \param[out] _pose pose
+  /// \return false if sampling the seed or the pose failed
+  bool drawPair(
+      MetaSkeletonStateSpace::State* _seedState,
+      SE3::State* _poseState,
+      Eigen::VectorXd& _seed,
+      Eigen::Isometry3d& _pose);
+
+  /// Tries batches of seed and pose pairs concurrently on mThreadPool.
+  bool sampleParallel(MetaSkeletonStateSpace::State* _state);
+
+  /// Gets a clone of mInverseKinematics for the node of _replica. The clone
+  /// is created the first time it is requested and cached afterwards.
+  dart::dynamics::InverseKinematicsPtr getInverseKinematics(
+      statespace::dart::SkeletonReplica& _replica);
 
   statespace::dart::MetaSkeletonStateSpacePtr mStateSpace;
   std::shared_ptr<statespace::SE3> mPoseStateSpace;
@@ -50,6 +81,38 @@ private:
   std::unique_ptr<SampleGenerator> mPoseSampler;
   std::unique_ptr<SampleGenerator> mSeedSampler;
   int mMaxNumTrials;
+  statespace::StatePool mSeedStatePool;
+  statespace::StatePool mPoseStatePool;
+
+  statespace::dart::SkeletonReplicaPoolPtr mSkeletonReplicaPool;
+  common::ThreadPoolPtr mThreadPool;
+
+  InverseKinematicsSeedDatabasePtr mSeedDatabase;
+  std::size_t mNumSeedsPerPose;
+
+  /// Pose last sampled for mSeedDatabase, the entries nearest to it and the
+  /// index of the next of these entries to try.
+  Eigen::Isometry3d mDatabasePose;
+  std::vector<std::size_t> mDatabaseEntries;
+  std::size_t mNextDatabaseEntry;
+
+  /// Seed and pose of the current pair, when solving sequentially.
+  Eigen::VectorXd mSeed;
+  Eigen::Isometry3d mPose;
+
+  /// Seeds, poses and solutions of the pairs of the current batch.
+  std::vector<Eigen::VectorXd> mSeeds;
+  std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>>
+      mPoses;
+  std::vector<Eigen::VectorXd> mSolutions;
+
+  /// Clones of mInverseKinematics, one per replica.
+  std::unordered_map<const statespace::dart::SkeletonReplica*,
+                     dart::dynamics::InverseKinematicsPtr>
+      mReplicaInverseKinematics;
+
+  /// Protects mReplicaInverseKinematics.
+  std::mutex mReplicaMutex;
 
   friend class InverseKinematicsSampleable;
 };
@@ -66,6 +129,7 @@ InverseKinematicsSampleable::InverseKinematicsSampleable(
   , mSeedConstraint(std::move(_seedConstraint))
   , mInverseKinematics(std::move(_inverseKinematics))
   , mMaxNumTrials(_maxNumTrials)
+  , mNumSeedsPerPose(1)
 {
   if (!mStateSpace)
     throw std::invalid_argument("MetaSkeletonStateSpace is nullptr.");
@@ -116,13 +180,81 @@ statespace::StateSpacePtr InverseKinematicsSampleable::getStateSpace() const
 std::unique_ptr<SampleGenerator>
 InverseKinematicsSampleable::createSampleGenerator() const
 {
+  if (mThreadPool && !mSkeletonReplicaPool)
+  {
+    throw std::logic_error(
+        "InverseKinematicsSampleable requires a SkeletonReplicaPool to solve "
+        "inverse kinematics on a ThreadPool.");
+  }
+
   return std::unique_ptr<IkSampleGenerator>(
       new IkSampleGenerator(
           mStateSpace,
           mInverseKinematics,
           mPoseConstraint->createSampleGenerator(),
           mSeedConstraint->createSampleGenerator(),
-          mMaxNumTrials));
+          mMaxNumTrials,
+          mSkeletonReplicaPool,
+          mThreadPool,
+          mSeedDatabase,
+          mNumSeedsPerPose));
+}
+
+//==============================================================================
+void InverseKinematicsSampleable::setSkeletonReplicaPool(
+    statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool)
+{
+  mSkeletonReplicaPool = std::move(_skeletonReplicaPool);
+}
+
+//==============================================================================
+statespace::dart::SkeletonReplicaPoolPtr
+InverseKinematicsSampleable::getSkeletonReplicaPool() const
+{
+  return mSkeletonReplicaPool;
+}
+
+//==============================================================================
+void InverseKinematicsSampleable::setThreadPool(
+    common::ThreadPoolPtr _threadPool)
+{
+  mThreadPool = std::move(_threadPool);
+}
+
+//==============================================================================
+common::ThreadPoolPtr InverseKinematicsSampleable::getThreadPool() const
+{
+  return mThreadPool;
+}
+
+//==============================================================================
+void InverseKinematicsSampleable::setSeedDatabase(
+    InverseKinematicsSeedDatabasePtr _seedDatabase,
+    std::size_t _numSeedsPerPose)
+{
+  if (_seedDatabase
+      && _seedDatabase->getNumDofs()
+             != mStateSpace->getMetaSkeleton()->getNumDofs())
+  {
+    std::stringstream msg;
+    msg << "Seed database has configurations of " << _seedDatabase->getNumDofs()
+        << " DegreesOfFreedom, but the MetaSkeletonStateSpace has "
+        << mStateSpace->getMetaSkeleton()->getNumDofs() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  if (_numSeedsPerPose == 0)
+    throw std::invalid_argument("Number of seeds per pose must be positive.");
+
+  mSeedDatabase = std::move(_seedDatabase);
+  mNumSeedsPerPose = _numSeedsPerPose;
+}
+
+//==============================================================================
+InverseKinematicsSeedDatabasePtr InverseKinematicsSampleable::getSeedDatabase()
+    const
+{
+  return mSeedDatabase;
 }
 
 //==============================================================================
@@ -131,7 +263,11 @@ IkSampleGenerator::IkSampleGenerator(
     dart::dynamics::InverseKinematicsPtr _inverseKinematics,
     std::unique_ptr<SampleGenerator> _poseSampler,
     std::unique_ptr<SampleGenerator> _seedSampler,
-    int _maxNumTrials)
+    int _maxNumTrials,
+    statespace::dart::SkeletonReplicaPoolPtr _skeletonReplicaPool,
+    common::ThreadPoolPtr _threadPool,
+    InverseKinematicsSeedDatabasePtr _seedDatabase,
+    std::size_t _numSeedsPerPose)
   : mStateSpace(std::move(_stateSpace))
   , mPoseStateSpace(
         std::dynamic_pointer_cast<SE3>(_poseSampler->getStateSpace()))
@@ -139,6 +275,13 @@ IkSampleGenerator::IkSampleGenerator(
   , mPoseSampler(std::move(_poseSampler))
   , mSeedSampler(std::move(_seedSampler))
   , mMaxNumTrials(_maxNumTrials)
+  , mSeedStatePool(mStateSpace, 1)
+  , mPoseStatePool(mPoseStateSpace, 1)
+  , mSkeletonReplicaPool(std::move(_skeletonReplicaPool))
+  , mThreadPool(std::move(_threadPool))
+  , mSeedDatabase(std::move(_seedDatabase))
+  , mNumSeedsPerPose(_numSeedsPerPose)
+  , mNextDatabaseEntry(0)
 {
   assert(mStateSpace);
   assert(mPoseStateSpace);
@@ -147,6 +290,8 @@ IkSampleGenerator::IkSampleGenerator(
   assert(mSeedSampler);
   assert(mSeedSampler->getStateSpace() == mStateSpace);
   assert(mMaxNumTrials > 0);
+  assert(!mThreadPool || mSkeletonReplicaPool);
+  assert(mNumSeedsPerPose > 0);
 
   if (mPoseSampler->getNumSamples() != NO_LIMIT)
   {
@@ -158,7 +303,7 @@ IkSampleGenerator::IkSampleGenerator(
            << " sets of poses because they may be quickly exhausted.\n";
   }
 
-  if (mSeedSampler->getNumSamples() != NO_LIMIT)
+  if (!mSeedDatabase && mSeedSampler->getNumSamples() != NO_LIMIT)
   {
     dtwarn << "[IkSampleGenerator::constructor] IkSampleGenerator uses up to "
            << mMaxNumTrials << " seeds per pose sample. The provided seed"
@@ -178,27 +323,27 @@ statespace::StateSpacePtr IkSampleGenerator::getStateSpace() const
 //==============================================================================
 bool IkSampleGenerator::sample(statespace::StateSpace::State* _state)
 {
-  if (!mSeedSampler->canSample() || !mPoseSampler->canSample())
+  if (!canSample())
     return false;
 
-  auto seedState = mStateSpace->createState();
-  auto poseState = mPoseStateSpace->createState();
+  if (mThreadPool)
+    return sampleParallel(static_cast<MetaSkeletonStateSpace::State*>(_state));
+
+  statespace::PooledState<MetaSkeletonStateSpace::StateHandle> seedState(
+      mStateSpace.get(), &mSeedStatePool);
+  statespace::PooledState<SE3::StateHandle> poseState(
+      mPoseStateSpace.get(), &mPoseStatePool);
   auto outputState = static_cast<MetaSkeletonStateSpace::State*>(_state);
 
   for (int i = 0; i < mMaxNumTrials; ++i)
   {
-    // Sample a seed for the IK solver.
+    // Sample a seed and a goal for the IK solver.
     // TODO: What should the retry logic look like if sampling a seed fails?
-    if (!mSeedSampler->sample(seedState))
-      continue;
-
-    mStateSpace->setState(seedState);
-
-    // Sample a goal for the IK solver.
-    if (!mPoseSampler->sample(poseState))
+    if (!drawPair(seedState, poseState, mSeed, mPose))
       continue;
 
-    mInverseKinematics->getTarget()->setTransform(poseState.getIsometry());
+    mStateSpace->getMetaSkeleton()->setPositions(mSeed);
+    mInverseKinematics->getTarget()->setTransform(mPose);
 
     // Run the IK solver. If it succeeds, return the solution.
     if (mInverseKinematics->solve(true))
@@ -211,15 +356,157 @@ bool IkSampleGenerator::sample(statespace::StateSpace::State* _state)
   return false;
 }
 
+//==============================================================================
+bool IkSampleGenerator::drawPair(
+    MetaSkeletonStateSpace::State* _seedState,
+    SE3::State* _poseState,
+    Eigen::VectorXd& _seed,
+    Eigen::Isometry3d& _pose)
+{
+  if (!mSeedDatabase)
+  {
+    if (!mSeedSampler->sample(_seedState))
+      return false;
+
+    if (!mPoseSampler->sample(_poseState))
+      return false;
+
+    mStateSpace->convertStateToPositions(_seedState, _seed);
+    _pose = _poseState->getIsometry();
+    return true;
+  }
+
+  // Try the entries nearest to a pose before sampling the next pose.
+  if (mNextDatabaseEntry == mDatabaseEntries.size())
+  {
+    mDatabaseEntries.clear();
+    mNextDatabaseEntry = 0;
+
+    if (!mPoseSampler->sample(_poseState))
+      return false;
+
+    mDatabasePose = _poseState->getIsometry();
+    mDatabaseEntries
+        = mSeedDatabase->findNearest(mDatabasePose, mNumSeedsPerPose);
+
+    if (mDatabaseEntries.empty())
+      return false;
+  }
+
+  _seed = mSeedDatabase->getPositions(mDatabaseEntries[mNextDatabaseEntry]);
+  _pose = mDatabasePose;
+  ++mNextDatabaseEntry;
+  return true;
+}
+
+//==============================================================================
+bool IkSampleGenerator::sampleParallel(MetaSkeletonStateSpace::State* _state)
+{
+  statespace::PooledState<MetaSkeletonStateSpace::StateHandle> seedState(
+      mStateSpace.get(), &mSeedStatePool);
+  statespace::PooledState<SE3::StateHandle> poseState(
+      mPoseStateSpace.get(), &mPoseStatePool);
+
+  const auto batchSize = mThreadPool->getNumThreads() + 1;
+
+  int numTrials = 0;
+  while (numTrials < mMaxNumTrials)
+  {
+    // Seeds and poses are drawn on the calling thread, in the same order as
+    // without a thread pool, since the samplers are not thread-safe.
+    mSeeds.clear();
+    mPoses.clear();
+    while (mSeeds.size() < batchSize && numTrials < mMaxNumTrials)
+    {
+      ++numTrials;
+
+      if (!drawPair(seedState, poseState, mSeed, mPose))
+        continue;
+
+      mSeeds.emplace_back(mSeed);
+      mPoses.emplace_back(mPose);
+    }
+
+    const auto numPairs = mSeeds.size();
+    mSolutions.resize(numPairs);
+
+    std::atomic<std::size_t> firstSolved(numPairs);
+    mThreadPool->parallelFor(numPairs, [&](std::size_t _index, std::size_t) {
+      // Pairs after one that has converged are cancelled.
+      if (_index > firstSolved.load())
+        return;
+
+      auto& replica = mSkeletonReplicaPool->getReplica();
+      const auto metaSkeleton = replica.getMetaSkeleton(
+          mStateSpace->getMetaSkeleton());
+      const auto inverseKinematics = getInverseKinematics(replica);
+
+      metaSkeleton->setPositions(mSeeds[_index]);
+      inverseKinematics->getTarget()->setTransform(mPoses[_index]);
+
+      if (!inverseKinematics->solve(true))
+        return;
+
+      mSolutions[_index] = metaSkeleton->getPositions();
+
+      auto current = firstSolved.load();
+      while (_index < current
+             && !firstSolved.compare_exchange_weak(current, _index))
+      {
+        // Do nothing.
+      }
+    });
+
+    if (firstSolved.load() < numPairs)
+    {
+      mStateSpace->convertPositionsToState(
+          mSolutions[firstSolved.load()], _state);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+dart::dynamics::InverseKinematicsPtr IkSampleGenerator::getInverseKinematics(
+    statespace::dart::SkeletonReplica& _replica)
+{
+  std::lock_guard<std::mutex> lock(mReplicaMutex);
+
+  auto& inverseKinematics = mReplicaInverseKinematics[&_replica];
+  if (!inverseKinematics)
+  {
+    inverseKinematics = mInverseKinematics->clone(
+        _replica.getJacobianNode(mInverseKinematics->getNode()));
+
+    // The clone shares the target frame of mInverseKinematics.
+    inverseKinematics->setTarget(
+        std::make_shared<dart::dynamics::SimpleFrame>(
+            dart::dynamics::Frame::World(), "target"));
+  }
+  return inverseKinematics;
+}
+
 //==============================================================================
 bool IkSampleGenerator::canSample() const
 {
+  if (mSeedDatabase)
+  {
+    return mSeedDatabase->getNumEntries() > 0
+           && (mNextDatabaseEntry < mDatabaseEntries.size()
+               || mPoseSampler->canSample());
+  }
+
   return mSeedSampler->canSample() && mPoseSampler->canSample();
 }
 
 //==============================================================================
 int IkSampleGenerator::getNumSamples() const
 {
+  if (mSeedDatabase)
+    return mPoseSampler->getNumSamples();
+
   return std::min(mSeedSampler->getNumSamples(), mPoseSampler->getNumSamples());
 }
 
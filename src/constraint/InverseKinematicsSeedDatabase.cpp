@@ -0,0 +1,423 @@
+#include <aikido/constraint/InverseKinematicsSeedDatabase.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace aikido {
+namespace constraint {
+
+namespace {
+
+using Key = Eigen::Matrix<double, 7, 1>;
+
+constexpr char MAGIC[8] = {'A', 'I', 'K', 'I', 'D', 'O', 'I', 'K'};
+constexpr std::uint32_t VERSION = 1;
+
+/// Size of the file header in bytes, a multiple of the size of a double so
+/// that the mapped entries are aligned.
+constexpr std::size_t HEADER_SIZE = 32;
+
+/// Number of doubles that store the pose of an entry.
+constexpr std::size_t POSE_SIZE = 7;
+
+struct Header
+{
+  char mMagic[8];
+  std::uint32_t mVersion;
+  std::uint32_t mNumDofs;
+  std::uint64_t mNumEntries;
+  double mRotationWeight;
+};
+
+static_assert(sizeof(Header) == HEADER_SIZE, "Unexpected header padding.");
+
+//==============================================================================
+Key computeKey(const double* _entry, double _rotationWeight)
+{
+  Key key;
+  key.head<3>() = Eigen::Map<const Eigen::Vector3d>(_entry);
+  key.tail<4>() = _rotationWeight * Eigen::Map<const Eigen::Vector4d>(
+                                        _entry + 3);
+  return key;
+}
+
+//==============================================================================
+void sortKdTree(
+    const std::vector<Key>& _keys,
+    std::vector<std::size_t>& _order,
+    std::size_t _begin,
+    std::size_t _end,
+    std::size_t _depth)
+{
+  if (_end - _begin <= 1)
+    return;
+
+  const std::size_t middle = _begin + (_end - _begin) / 2;
+  const std::size_t dimension = _depth % POSE_SIZE;
+
+  std::nth_element(
+      _order.begin() + _begin,
+      _order.begin() + middle,
+      _order.begin() + _end,
+      [&](std::size_t _a, std::size_t _b) {
+        return _keys[_a][dimension] < _keys[_b][dimension];
+      });
+
+  sortKdTree(_keys, _order, _begin, middle, _depth + 1);
+  sortKdTree(_keys, _order, middle + 1, _end, _depth + 1);
+}
+
+} // namespace
+
+//==============================================================================
+std::shared_ptr<InverseKinematicsSeedDatabase>
+InverseKinematicsSeedDatabase::build(
+    statespace::dart::MetaSkeletonStateSpacePtr _stateSpace,
+    dart::dynamics::ConstJacobianNodePtr _node,
+    const SampleablePtr& _configurationConstraint,
+    std::size_t _numEntries,
+    double _rotationWeight)
+{
+  if (!_stateSpace)
+    throw std::invalid_argument("MetaSkeletonStateSpace is nullptr.");
+
+  if (!_node)
+    throw std::invalid_argument("JacobianNode is nullptr.");
+
+  if (!_configurationConstraint)
+    throw std::invalid_argument("Configuration Sampleable is nullptr.");
+
+  if (_configurationConstraint->getStateSpace() != _stateSpace)
+    throw std::invalid_argument(
+        "Configuration Sampleable is not for this StateSpace.");
+
+  if (_rotationWeight <= 0)
+    throw std::invalid_argument("Rotation weight must be positive.");
+
+  const auto metaSkeleton = _stateSpace->getMetaSkeleton();
+  const std::size_t numDofs = metaSkeleton->getNumDofs();
+  const std::size_t entrySize = POSE_SIZE + numDofs;
+  const Eigen::VectorXd originalPositions = metaSkeleton->getPositions();
+
+  auto generator = _configurationConstraint->createSampleGenerator();
+  auto state = _stateSpace->createState();
+
+  std::vector<double> entries;
+  entries.reserve(_numEntries * entrySize);
+
+  for (std::size_t i = 0; i < _numEntries && generator->canSample(); ++i)
+  {
+    if (!generator->sample(state))
+      continue;
+
+    _stateSpace->setState(state);
+
+    const Eigen::Isometry3d pose = _node->getWorldTransform();
+    Eigen::Quaterniond quaternion(pose.linear());
+    if (quaternion.w() < 0)
+      quaternion.coeffs() *= -1.;
+
+    const Eigen::VectorXd positions = metaSkeleton->getPositions();
+
+    entries.insert(
+        entries.end(),
+        pose.translation().data(),
+        pose.translation().data() + 3);
+    entries.push_back(quaternion.w());
+    entries.push_back(quaternion.x());
+    entries.push_back(quaternion.y());
+    entries.push_back(quaternion.z());
+    entries.insert(
+        entries.end(), positions.data(), positions.data() + numDofs);
+  }
+
+  metaSkeleton->setPositions(originalPositions);
+
+  const std::size_t numEntries = entries.size() / entrySize;
+
+  std::vector<Key> keys(numEntries);
+  std::vector<std::size_t> order(numEntries);
+  for (std::size_t i = 0; i < numEntries; ++i)
+  {
+    keys[i] = computeKey(entries.data() + i * entrySize, _rotationWeight);
+    order[i] = i;
+  }
+  sortKdTree(keys, order, 0, numEntries, 0);
+
+  std::shared_ptr<InverseKinematicsSeedDatabase> database(
+      new InverseKinematicsSeedDatabase(numDofs, numEntries, _rotationWeight));
+  database->mBuffer.resize(entries.size());
+  for (std::size_t i = 0; i < numEntries; ++i)
+  {
+    std::copy(
+        entries.begin() + order[i] * entrySize,
+        entries.begin() + (order[i] + 1) * entrySize,
+        database->mBuffer.begin() + i * entrySize);
+  }
+  database->mEntries = database->mBuffer.data();
+
+  return database;
+}
+
+//==============================================================================
+std::shared_ptr<InverseKinematicsSeedDatabase>
+InverseKinematicsSeedDatabase::load(const std::string& _path)
+{
+  const int fileDescriptor = ::open(_path.c_str(), O_RDONLY);
+  if (fileDescriptor < 0)
+    throw std::runtime_error("Failed opening '" + _path + "'.");
+
+  struct stat fileStatus;
+  if (::fstat(fileDescriptor, &fileStatus) != 0
+      || static_cast<std::size_t>(fileStatus.st_size) < HEADER_SIZE)
+  {
+    ::close(fileDescriptor);
+    throw std::runtime_error(
+        "'" + _path + "' is not an inverse kinematics seed database.");
+  }
+
+  const std::size_t fileSize = fileStatus.st_size;
+  void* mapping = ::mmap(
+      nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  ::close(fileDescriptor);
+
+  if (mapping == MAP_FAILED)
+    throw std::runtime_error("Failed mapping '" + _path + "'.");
+
+  Header header;
+  std::memcpy(&header, mapping, HEADER_SIZE);
+
+  // The number of entries is checked by division, since multiplying a
+  // corrupted one by the entry size may overflow.
+  const std::size_t entryBytes
+      = (POSE_SIZE + header.mNumDofs) * sizeof(double);
+  const std::size_t dataSize = fileSize - HEADER_SIZE;
+  if (std::memcmp(header.mMagic, MAGIC, sizeof(MAGIC)) != 0
+      || header.mVersion != VERSION || dataSize % entryBytes != 0
+      || dataSize / entryBytes != header.mNumEntries
+      || !std::isfinite(header.mRotationWeight)
+      || !(header.mRotationWeight > 0))
+  {
+    ::munmap(mapping, fileSize);
+
+    std::stringstream msg;
+    msg << "'" << _path << "' is not an inverse kinematics seed database"
+        << " of version " << VERSION << ".";
+    throw std::runtime_error(msg.str());
+  }
+
+  std::shared_ptr<InverseKinematicsSeedDatabase> database(
+      new InverseKinematicsSeedDatabase(
+          header.mNumDofs, header.mNumEntries, header.mRotationWeight));
+  database->mMapping = mapping;
+  database->mMappingSize = fileSize;
+  database->mEntries = reinterpret_cast<const double*>(
+      static_cast<const char*>(mapping) + HEADER_SIZE);
+
+  return database;
+}
+
+//==============================================================================
+void InverseKinematicsSeedDatabase::save(const std::string& _path) const
+{
+  Header header;
+  std::memcpy(header.mMagic, MAGIC, sizeof(MAGIC));
+  header.mVersion = VERSION;
+  header.mNumDofs = mNumDofs;
+  header.mNumEntries = mNumEntries;
+  header.mRotationWeight = mRotationWeight;
+
+  std::ofstream stream(_path.c_str(), std::ios::binary | std::ios::trunc);
+  stream.write(reinterpret_cast<const char*>(&header), HEADER_SIZE);
+  stream.write(
+      reinterpret_cast<const char*>(mEntries),
+      mNumEntries * getEntrySize() * sizeof(double));
+  stream.close();
+
+  if (!stream)
+    throw std::runtime_error("Failed writing '" + _path + "'.");
+}
+
+//==============================================================================
+InverseKinematicsSeedDatabase::InverseKinematicsSeedDatabase(
+    std::size_t _numDofs, std::size_t _numEntries, double _rotationWeight)
+  : mNumDofs(_numDofs)
+  , mNumEntries(_numEntries)
+  , mRotationWeight(_rotationWeight)
+  , mMapping(nullptr)
+  , mMappingSize(0)
+  , mEntries(nullptr)
+{
+  // Do nothing
+}
+
+//==============================================================================
+InverseKinematicsSeedDatabase::~InverseKinematicsSeedDatabase()
+{
+  if (mMapping)
+    ::munmap(mMapping, mMappingSize);
+}
+
+//==============================================================================
+std::size_t InverseKinematicsSeedDatabase::getNumEntries() const
+{
+  return mNumEntries;
+}
+
+//==============================================================================
+std::size_t InverseKinematicsSeedDatabase::getNumDofs() const
+{
+  return mNumDofs;
+}
+
+//==============================================================================
+double InverseKinematicsSeedDatabase::getRotationWeight() const
+{
+  return mRotationWeight;
+}
+
+//==============================================================================
+Eigen::Isometry3d InverseKinematicsSeedDatabase::getPose(
+    std::size_t _index) const
+{
+  assert(_index < mNumEntries);
+
+  const double* entry = mEntries + _index * getEntrySize();
+
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation() = Eigen::Map<const Eigen::Vector3d>(entry);
+  pose.linear() = Eigen::Quaterniond(entry[3], entry[4], entry[5], entry[6])
+                      .toRotationMatrix();
+  return pose;
+}
+
+//==============================================================================
+Eigen::Map<const Eigen::VectorXd> InverseKinematicsSeedDatabase::getPositions(
+    std::size_t _index) const
+{
+  assert(_index < mNumEntries);
+
+  return Eigen::Map<const Eigen::VectorXd>(
+      mEntries + _index * getEntrySize() + POSE_SIZE, mNumDofs);
+}
+
+//==============================================================================
+std::vector<std::size_t> InverseKinematicsSeedDatabase::findNearest(
+    const Eigen::Isometry3d& _pose, std::size_t _numNeighbors) const
+{
+  std::vector<std::size_t> indices;
+  if (_numNeighbors == 0 || mNumEntries == 0)
+    return indices;
+
+  const Eigen::Quaterniond quaternion(_pose.linear());
+
+  Key keys[2];
+  keys[0].head<3>() = _pose.translation();
+  keys[0][3] = quaternion.w();
+  keys[0].segment<3>(4) = quaternion.vec();
+  keys[0].tail<4>() *= mRotationWeight;
+  keys[1].head<3>() = keys[0].head<3>();
+  keys[1].tail<4>() = -keys[0].tail<4>();
+
+  std::vector<Neighbor> neighbors;
+  neighbors.reserve(std::min(_numNeighbors, mNumEntries) + 1);
+  findNearest(keys, _numNeighbors, 0, mNumEntries, 0, neighbors);
+
+  std::sort_heap(neighbors.begin(), neighbors.end());
+
+  indices.reserve(neighbors.size());
+  for (const auto& neighbor : neighbors)
+    indices.push_back(neighbor.second);
+  return indices;
+}
+
+//==============================================================================
+std::size_t InverseKinematicsSeedDatabase::getEntrySize() const
+{
+  return POSE_SIZE + mNumDofs;
+}
+
+//==============================================================================
+Eigen::Matrix<double, 7, 1> InverseKinematicsSeedDatabase::getKey(
+    std::size_t _index) const
+{
+  return computeKey(mEntries + _index * getEntrySize(), mRotationWeight);
+}
+
+//==============================================================================
+void InverseKinematicsSeedDatabase::findNearest(
+    const Eigen::Matrix<double, 7, 1> (&_keys)[2],
+    std::size_t _numNeighbors,
+    std::size_t _begin,
+    std::size_t _end,
+    std::size_t _depth,
+    std::vector<Neighbor>& _neighbors) const
+{
+  if (_begin >= _end)
+    return;
+
+  const std::size_t middle = _begin + (_end - _begin) / 2;
+  const std::size_t dimension = _depth % POSE_SIZE;
+  const Key key = getKey(middle);
+
+  // _neighbors is a max-heap on the distance.
+  const double distance = std::min(
+      (key - _keys[0]).squaredNorm(), (key - _keys[1]).squaredNorm());
+  if (_neighbors.size() < _numNeighbors)
+  {
+    _neighbors.emplace_back(distance, middle);
+    std::push_heap(_neighbors.begin(), _neighbors.end());
+  }
+  else if (distance < _neighbors.front().first)
+  {
+    std::pop_heap(_neighbors.begin(), _neighbors.end());
+    _neighbors.back() = Neighbor(distance, middle);
+    std::push_heap(_neighbors.begin(), _neighbors.end());
+  }
+
+  // Squared distances from the query keys to the half-spaces of the subtrees
+  // below and above the splitting entry.
+  double lowerDistance = std::numeric_limits<double>::infinity();
+  double upperDistance = std::numeric_limits<double>::infinity();
+  for (const auto& queryKey : _keys)
+  {
+    const double difference = queryKey[dimension] - key[dimension];
+    const double squaredDifference = difference * difference;
+    lowerDistance
+        = std::min(lowerDistance, difference > 0 ? squaredDifference : 0.);
+    upperDistance
+        = std::min(upperDistance, difference < 0 ? squaredDifference : 0.);
+  }
+
+  const bool isLowerFirst = lowerDistance <= upperDistance;
+  const double secondDistance = isLowerFirst ? upperDistance : lowerDistance;
+
+  if (isLowerFirst)
+    findNearest(_keys, _numNeighbors, _begin, middle, _depth + 1, _neighbors);
+  else
+    findNearest(_keys, _numNeighbors, middle + 1, _end, _depth + 1, _neighbors);
+
+  if (_neighbors.size() < _numNeighbors
+      || secondDistance < _neighbors.front().first)
+  {
+    if (isLowerFirst)
+      findNearest(
+          _keys, _numNeighbors, middle + 1, _end, _depth + 1, _neighbors);
+    else
+      findNearest(_keys, _numNeighbors, _begin, middle, _depth + 1, _neighbors);
+  }
+}
+
+} // namespace constraint
+} // namespace aikido
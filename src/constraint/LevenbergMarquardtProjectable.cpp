@@ -0,0 +1,312 @@
+#include <aikido/constraint/LevenbergMarquardtProjectable.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace aikido {
+namespace constraint {
+
+namespace {
+
+/// Sufficient decrease parameter of the Armijo condition.
+constexpr double ARMIJO_PARAMETER = 1e-4;
+
+/// Factor applied to the damping after a full step.
+constexpr double DAMPING_DECREASE = 1. / 3.;
+
+/// Factor applied to the damping after a backtracked step.
+constexpr double DAMPING_INCREASE = 2.;
+
+/// Factor applied to the damping when the line search fails.
+constexpr double DAMPING_REJECTION = 10.;
+
+/// Maximum number of step halvings in the line search.
+constexpr int MAX_BACKTRACKING_STEPS = 5;
+
+/// Bounds on the damping.
+constexpr double MIN_DAMPING = 1e-12;
+constexpr double MAX_DAMPING = 1e12;
+
+//==============================================================================
+statespace::StateSpacePtr getStateSpaceOrThrow(
+    const DifferentiablePtr& _differentiable)
+{
+  if (!_differentiable)
+    throw std::invalid_argument("_differentiable is nullptr.");
+
+  return _differentiable->getStateSpace();
+}
+
+} // namespace
+
+//==============================================================================
+LevenbergMarquardtProjectable::LevenbergMarquardtProjectable(
+    DifferentiablePtr _differentiable,
+    std::vector<double> _tolerance,
+    int _maxIteration,
+    double _minStepSize,
+    double _initialDamping,
+    bool _warmStart)
+  : mDifferentiable(std::move(_differentiable))
+  , mTolerance(std::move(_tolerance))
+  , mMaxIteration(_maxIteration)
+  , mMinStepSize(_minStepSize)
+  , mInitialDamping(_initialDamping)
+  , mWarmStart(_warmStart)
+  , mStateSpace(getStateSpaceOrThrow(mDifferentiable))
+  , mDamping(_initialDamping)
+{
+  if (mDifferentiable->getConstraintDimension() != mTolerance.size())
+  {
+    std::stringstream msg;
+    msg << "Number of tolerances does not match the number of constraints:"
+        << " expected " << mDifferentiable->getConstraintDimension() << ", got "
+        << mTolerance.size();
+    throw std::invalid_argument(msg.str());
+  }
+
+  for (double tolerance : mTolerance)
+  {
+    if (tolerance <= 0)
+      throw std::invalid_argument("Tolerance should be positive.");
+  }
+
+  if (mMaxIteration <= 0)
+    throw std::invalid_argument("_maxIteration should be positive.");
+
+  if (mMinStepSize <= 0)
+    throw std::invalid_argument("_minStepsize should be positive.");
+
+  if (mInitialDamping <= 0)
+    throw std::invalid_argument("_initialDamping should be positive.");
+
+  mConstraintTypes = mDifferentiable->getConstraintTypes();
+}
+
+//==============================================================================
+bool LevenbergMarquardtProjectable::project(
+    const statespace::StateSpace::State* _s,
+    statespace::StateSpace::State* _out) const
+{
+  double damping = mWarmStart ? mDamping.load(std::memory_order_relaxed)
+                              : mInitialDamping;
+
+  auto workspacePtr = acquireWorkspace();
+  auto& workspace = *workspacePtr;
+  auto& value = workspace.mValue;
+  auto& jacobian = workspace.mJacobian;
+  auto& residual = workspace.mResidual;
+  auto& step = workspace.mStep;
+  auto& stepState = workspace.mStepState;
+  auto& trialState = workspace.mTrialState;
+  auto& trialValue = workspace.mTrialValue;
+  auto& trialResidual = workspace.mTrialResidual;
+
+  // Initialize _out.
+  mStateSpace->copyState(_s, _out);
+  mDifferentiable->getValueAndJacobian(_out, value, jacobian);
+  computeResidual(value, residual);
+
+  // The Jacobian is only evaluated once an accepted state is known to violate
+  // the constraints.
+  bool isJacobianValid = true;
+
+  for (int iteration = 0; iteration < mMaxIteration; ++iteration)
+  {
+    if (contains(value))
+      break;
+
+    if (!isJacobianValid)
+    {
+      mDifferentiable->getJacobian(_out, jacobian);
+      isJacobianValid = true;
+    }
+
+    computeStep(damping, workspace);
+
+    // Break if tangent step is too small.
+    const double stepSize = step.lpNorm<Eigen::Infinity>();
+    if (stepSize < mMinStepSize)
+      break;
+
+    // Backtracking line search on 0.5 * |residual|^2. The step is a descent
+    // direction, so the slope is negative.
+    const double cost = 0.5 * residual.squaredNorm();
+    const double slope = workspace.mGradient.dot(step);
+
+    double alpha = 1.;
+    bool isAccepted = false;
+    for (int i = 0; i < MAX_BACKTRACKING_STEPS; ++i, alpha *= 0.5)
+    {
+      workspace.mScaledStep = alpha * step;
+      mStateSpace->expMap(workspace.mScaledStep, stepState);
+      mStateSpace->compose(_out, stepState, trialState);
+
+      mDifferentiable->getValue(trialState, trialValue);
+      computeResidual(trialValue, trialResidual);
+
+      if (0.5 * trialResidual.squaredNorm()
+          <= cost + ARMIJO_PARAMETER * alpha * slope)
+      {
+        isAccepted = true;
+        break;
+      }
+    }
+
+    if (!isAccepted)
+    {
+      // The distance functions of constraints like TSR are not smooth, so no
+      // sufficient decrease may exist near _out. Take the full step to leave
+      // such points, and damp the following steps more.
+      mStateSpace->expMap(step, stepState);
+      mStateSpace->compose(_out, stepState, trialState);
+      mDifferentiable->getValue(trialState, trialValue);
+      computeResidual(trialValue, trialResidual);
+      damping = std::min(damping * DAMPING_REJECTION, MAX_DAMPING);
+    }
+    else if (alpha == 1.)
+    {
+      damping = std::max(damping * DAMPING_DECREASE, MIN_DAMPING);
+    }
+    else
+    {
+      damping = std::min(damping * DAMPING_INCREASE, MAX_DAMPING);
+    }
+
+    mStateSpace->copyState(trialState, _out);
+    value.swap(trialValue);
+    residual.swap(trialResidual);
+    isJacobianValid = false;
+  }
+
+  mDamping.store(damping, std::memory_order_relaxed);
+
+  const bool isContained = contains(value);
+  releaseWorkspace(std::move(workspacePtr));
+
+  return isContained;
+}
+
+//==============================================================================
+statespace::StateSpacePtr LevenbergMarquardtProjectable::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+auto LevenbergMarquardtProjectable::acquireWorkspace() const
+    -> std::unique_ptr<Workspace>
+{
+  {
+    std::lock_guard<std::mutex> lock(mWorkspaceMutex);
+    if (!mWorkspaces.empty())
+    {
+      auto workspace = std::move(mWorkspaces.back());
+      mWorkspaces.pop_back();
+      return workspace;
+    }
+  }
+
+  return std::unique_ptr<Workspace>(new Workspace(mStateSpace.get()));
+}
+
+//==============================================================================
+void LevenbergMarquardtProjectable::releaseWorkspace(
+    std::unique_ptr<Workspace> _workspace) const
+{
+  std::lock_guard<std::mutex> lock(mWorkspaceMutex);
+  mWorkspaces.emplace_back(std::move(_workspace));
+}
+
+//==============================================================================
+bool LevenbergMarquardtProjectable::contains(
+    const Eigen::VectorXd& _value) const
+{
+  for (int i = 0; i < _value.size(); ++i)
+  {
+    if (mConstraintTypes[i] == ConstraintType::EQUALITY)
+    {
+      if (std::abs(_value[i]) > mTolerance[i])
+        return false;
+    }
+    else
+    {
+      // Inequality constraints are satisfied when value <= 0.
+      if (_value[i] > mTolerance[i])
+        return false;
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+void LevenbergMarquardtProjectable::computeResidual(
+    const Eigen::VectorXd& _value, Eigen::VectorXd& _residual) const
+{
+  _residual = _value;
+  for (int i = 0; i < _residual.size(); ++i)
+  {
+    if (mConstraintTypes[i] == ConstraintType::INEQUALITY
+        && _residual[i] < 0)
+    {
+      _residual[i] = 0;
+    }
+  }
+}
+
+//==============================================================================
+void LevenbergMarquardtProjectable::computeStep(
+    double _damping, Workspace& _workspace) const
+{
+  auto& jacobian = _workspace.mJacobian;
+  auto& residual = _workspace.mResidual;
+  auto& gradient = _workspace.mGradient;
+  auto& normalMatrix = _workspace.mNormalMatrix;
+  auto& solver = _workspace.mSolver;
+
+  // A satisfied inequality has no residual, so its row of the Jacobian does
+  // not contribute to the normal equations.
+  for (int i = 0; i < residual.size(); ++i)
+  {
+    if (mConstraintTypes[i] == ConstraintType::INEQUALITY
+        && _workspace.mValue[i] < 0)
+    {
+      jacobian.row(i).setZero();
+    }
+  }
+
+  gradient.noalias() = jacobian.transpose() * residual;
+
+  // Solve the smaller of the two equivalent systems:
+  //   step = -(J^T J + lambda I)^-1 J^T r = -J^T (J J^T + lambda I)^-1 r
+  if (jacobian.rows() < jacobian.cols())
+  {
+    normalMatrix.noalias() = jacobian * jacobian.transpose();
+    normalMatrix.diagonal().array() += _damping;
+    solver.compute(normalMatrix);
+    _workspace.mSolution = solver.solve(residual);
+    _workspace.mStep.noalias() = -jacobian.transpose() * _workspace.mSolution;
+  }
+  else
+  {
+    normalMatrix.noalias() = jacobian.transpose() * jacobian;
+    normalMatrix.diagonal().array() += _damping;
+    solver.compute(normalMatrix);
+    _workspace.mStep = solver.solve(gradient);
+    _workspace.mStep = -_workspace.mStep;
+  }
+}
+
+//==============================================================================
+LevenbergMarquardtProjectable::Workspace::Workspace(
+    const statespace::StateSpace* _stateSpace)
+  : mStepState(_stateSpace), mTrialState(_stateSpace)
+{
+  // Do nothing
+}
+
+} // namespace constraint
+} // namespace aikido
@@ -36,6 +36,23 @@ bool Satisfied::isSatisfied(
   return true;
 }
 
+//==============================================================================
+bool Satisfied::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& _states,
+    std::vector<bool>& _out,
+    bool /*_earlyExit*/) const
+{
+  _out.assign(_states.size(), true);
+  return true;
+}
+
+//==============================================================================
+bool Satisfied::areAllSatisfied(
+    const std::vector<const statespace::StateSpace::State*>& /*_states*/) const
+{
+  return true;
+}
+
 //==============================================================================
 bool Satisfied::project(
     const statespace::StateSpace::State* _s,
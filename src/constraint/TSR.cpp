@@ -16,6 +16,150 @@ using aikido::statespace::SE3;
 namespace aikido {
 namespace constraint {
 
+namespace {
+
+/// Tolerance on the cosine of the pitch below which the Jacobian of TSR is
+/// computed numerically.
+constexpr double GIMBAL_LOCK_TOLERANCE = 1e-6;
+
+/// Rotation angle below which Taylor series are used in getExpMapJacobians.
+constexpr double SMALL_ANGLE_TOLERANCE = 1e-3;
+
+//==============================================================================
+/// Computes the distance of a value to the interval [_lower, _upper].
+/// \param _value Value to be evaluated.
+/// \param _lower Lower bound of the interval.
+/// \param _upper Upper bound of the interval.
+/// \param[out] _derivative Derivative of the distance w.r.t. _value.
+/// \return Distance of _value to the interval.
+double getDistanceToInterval(
+    double _value, double _lower, double _upper, double& _derivative)
+{
+  if (_value < _lower)
+  {
+    _derivative = -1;
+    return std::abs(_value - _lower);
+  }
+
+  if (_value > _upper)
+  {
+    _derivative = 1;
+    return std::abs(_value - _upper);
+  }
+
+  _derivative = 0;
+  return 0;
+}
+
+//==============================================================================
+/// Computes the distance of an angle to the interval [_lower, _upper],
+/// taking into account that angles wrap around every 2*pi.
+/// \param _angle Angle in [-pi, pi] to be evaluated.
+/// \param _lower Lower bound of the interval.
+/// \param _upper Upper bound of the interval.
+/// \param[out] _derivative Derivative of the distance w.r.t. _angle.
+/// \return Distance of _angle to the interval.
+double getDistanceToAngleInterval(
+    double _angle, double _lower, double _upper, double& _derivative)
+{
+  _derivative = 0;
+
+  // Find n such that: 2*n*pi <= _lower < 2*(n+1)*pi
+  int n = _lower / (2 * M_PI);
+
+  // Map _angle to [2*n*pi, 2*(n+1)*pi)
+  double angle = M_PI * 2 * n + _angle;
+
+  // check if angle is within bound
+  if ((angle >= _lower && angle <= _upper)
+      || (angle + M_PI * 2 >= _lower && angle + M_PI * 2 <= _upper)
+      || (angle - M_PI * 2 >= _lower && angle - M_PI * 2 <= _upper))
+  {
+    return 0;
+  }
+
+  // Take min-distance between angle and either side of bound
+  if (angle < _lower)
+  {
+    const double distanceToLower = _lower - angle;
+    const double distanceToUpper = angle - (_upper - 2 * M_PI);
+    _derivative = distanceToUpper < distanceToLower ? 1 : -1;
+    return std::min(distanceToLower, distanceToUpper);
+  }
+
+  if (_upper < angle)
+  {
+    const double distanceToUpper = angle - _upper;
+    const double distanceToLower = _lower + 2 * M_PI - angle;
+    _derivative = distanceToLower < distanceToUpper ? -1 : 1;
+    return std::min(distanceToUpper, distanceToLower);
+  }
+
+  return 0;
+}
+
+//==============================================================================
+/// Computes the derivatives of the pose dart::math::expMap(_twist) w.r.t.
+/// the se(3) tangent vector _twist = [w; v].
+///
+/// The pose is R = exp([w]), p = J(w) * v, where J is the left Jacobian of
+/// SO(3), i.e. J(w) = I + b * [w] + c * [w]^2 with b = (1 - cos t) / t^2,
+/// c = (t - sin t) / t^3 and t = |w|.
+/// \param _twist se(3) tangent vector.
+/// \param[out] _rotationJacobian Angular velocity of R, expressed in the
+///   origin frame, per unit change of _twist. This is [J(w), 0].
+/// \param[out] _translationJacobian Derivative of p w.r.t. _twist.
+void getExpMapJacobians(
+    const Eigen::Vector6d& _twist,
+    Eigen::Matrix<double, 3, 6>& _rotationJacobian,
+    Eigen::Matrix<double, 3, 6>& _translationJacobian)
+{
+  const Eigen::Vector3d w = _twist.head<3>();
+  const Eigen::Vector3d v = _twist.tail<3>();
+  const double t = w.norm();
+  const double t2 = t * t;
+
+  // a = sin t / t, and the derivatives da/dt, db/dt, dc/dt divided by t.
+  double a, b, c, da, db, dc;
+  if (t < SMALL_ANGLE_TOLERANCE)
+  {
+    a = 1. - t2 / 6. + t2 * t2 / 120.;
+    b = 0.5 - t2 / 24. + t2 * t2 / 720.;
+    c = 1. / 6. - t2 / 120. + t2 * t2 / 5040.;
+    da = -1. / 3. + t2 / 30.;
+    db = -1. / 12. + t2 / 180.;
+    dc = -1. / 60. + t2 / 1260.;
+  }
+  else
+  {
+    const double sinT = std::sin(t);
+    const double cosT = std::cos(t);
+    a = sinT / t;
+    b = (1. - cosT) / t2;
+    c = (t - sinT) / (t2 * t);
+    da = (cosT - a) / t2;
+    db = (a - 2. * b) / t2;
+    dc = (b - 3. * c) / t2;
+  }
+
+  const Eigen::Matrix3d wHat = ::dart::math::makeSkewSymmetric(w);
+  const Eigen::Matrix3d J
+      = Eigen::Matrix3d::Identity() + b * wHat + c * wHat * wHat;
+  const Eigen::Vector3d wCrossV = w.cross(v);
+  const double wDotV = w.dot(v);
+
+  _rotationJacobian.leftCols<3>() = J;
+  _rotationJacobian.rightCols<3>().setZero();
+
+  _translationJacobian.leftCols<3>()
+      = (da * v + db * wCrossV + dc * wDotV * w) * w.transpose()
+        - b * ::dart::math::makeSkewSymmetric(v) + c * w * v.transpose()
+        + c * wDotV * Eigen::Matrix3d::Identity();
+  _translationJacobian.rightCols<3>() = J;
+}
+
+} // namespace
+
 class TSRSampleGenerator : public SampleGenerator
 {
 public:
@@ -268,46 +412,95 @@ void TSR::getValue(
 
   _out.resize(6);
 
+  double derivative;
   for (int i = 0; i < 3; ++i)
   {
-    if (translation(i) < mBw(i, 0))
-      _out(i) = std::abs(translation(i) - mBw(i, 0));
-
-    else if (translation(i) > mBw(i, 1))
-      _out(i) = std::abs(translation(i) - mBw(i, 1));
-
-    else
-      _out(i) = 0;
+    _out(i) = getDistanceToInterval(
+        translation(i), mBw(i, 0), mBw(i, 1), derivative);
   }
 
   for (int i = 3; i < 6; ++i)
   {
-    // Find n such that: 2*n*pi <= mBw(i, 0) < 2*(n+1)*pi
-    int n = mBw(i, 0) / (2 * M_PI);
+    _out(i) = getDistanceToAngleInterval(
+        eulerZYX(i - 3), mBw(i, 0), mBw(i, 1), derivative);
+  }
+}
 
-    // Map eulerZYX(i-3) to [2*n*pi, 2*(n+1)*pi)
-    double angle = M_PI * 2 * n + eulerZYX(i - 3);
+//==============================================================================
+void TSR::getJacobian(
+    const statespace::StateSpace::State* _s, Eigen::MatrixXd& _out) const
+{
+  using SE3 = statespace::SE3;
+  using SE3State = SE3::State;
 
-    // check if angle is within bound
-    if ((angle >= mBw(i, 0) && angle <= mBw(i, 1))
-        || (angle + M_PI * 2 >= mBw(i, 0) && angle + M_PI * 2 <= mBw(i, 1))
-        || (angle - M_PI * 2 >= mBw(i, 0) && angle - M_PI * 2 <= mBw(i, 1)))
-    {
-      _out(i) = 0;
-      continue;
-    }
+  auto se3state = static_cast<const SE3State*>(_s);
+  Eigen::Isometry3d se3 = se3state->getIsometry();
 
-    // Take min-distance between angle and either side of bound
-    if (angle < mBw(i, 0))
-      _out(i) = std::min(mBw(i, 0) - angle, angle - (mBw(i, 1) - 2 * M_PI));
+  using TransformTraits = Eigen::TransformTraits;
 
-    else if (mBw(i, 1) < angle)
-      _out(i) = std::min(angle - mBw(i, 1), mBw(i, 0) + 2 * M_PI - angle);
+  Eigen::Isometry3d T0_w_inv = mT0_w.inverse(TransformTraits::Isometry);
+  Eigen::Isometry3d Tw_e_inv = mTw_e.inverse(TransformTraits::Isometry);
+  Eigen::Isometry3d Tw_s = T0_w_inv * se3 * Tw_e_inv;
+
+  Eigen::Vector3d translation = Tw_s.translation();
+  Eigen::Vector3d eulerOrig = dart::math::matrixToEulerZYX(Tw_s.linear());
+  Eigen::Vector3d eulerZYX = eulerOrig.reverse();
+
+  // The rates of the Euler angles are singular when the pitch is +-pi/2.
+  const double cosPitch = std::cos(eulerZYX(1));
+  if (std::abs(cosPitch) < GIMBAL_LOCK_TOLERANCE)
+  {
+    getJacobianNumerically(_s, _out);
+    return;
+  }
+
+  Eigen::Matrix<double, 3, 6> rotationJacobian;
+  Eigen::Matrix<double, 3, 6> translationJacobian;
+  getExpMapJacobians(
+      ::dart::math::logMap(se3), rotationJacobian, translationJacobian);
+
+  // Angular velocity and translational velocity of Tw_s, expressed in "w",
+  // per unit change of the se(3) tangent vector of _s.
+  const Eigen::Matrix3d R0_w_inv = T0_w_inv.linear();
+  const Eigen::Vector3d offset = se3.linear() * Tw_e_inv.translation();
+  const Eigen::Matrix<double, 3, 6> angularVelocity
+      = R0_w_inv * rotationJacobian;
+  const Eigen::Matrix<double, 3, 6> linearVelocity
+      = R0_w_inv * (translationJacobian
+                    - ::dart::math::makeSkewSymmetric(offset)
+                          * rotationJacobian);
+
+  // Maps the angular velocity to the rates of (roll, pitch, yaw), where the
+  // rotation is Rz(yaw) * Ry(pitch) * Rx(roll).
+  const double cosYaw = std::cos(eulerZYX(2));
+  const double sinYaw = std::sin(eulerZYX(2));
+  const double tanPitch = std::tan(eulerZYX(1));
+  Eigen::Matrix3d eulerRates;
+  eulerRates << cosYaw / cosPitch, sinYaw / cosPitch, 0,
+      -sinYaw, cosYaw, 0,
+      cosYaw * tanPitch, sinYaw * tanPitch, 1;
+  const Eigen::Matrix<double, 3, 6> eulerJacobian
+      = eulerRates * angularVelocity;
+
+  _out.resize(6, 6);
+
+  double derivative;
+  for (int i = 0; i < 3; ++i)
+  {
+    getDistanceToInterval(translation(i), mBw(i, 0), mBw(i, 1), derivative);
+    _out.row(i) = derivative * linearVelocity.row(i);
+  }
+
+  for (int i = 3; i < 6; ++i)
+  {
+    getDistanceToAngleInterval(
+        eulerZYX(i - 3), mBw(i, 0), mBw(i, 1), derivative);
+    _out.row(i) = derivative * eulerJacobian.row(i - 3);
   }
 }
 
 //==============================================================================
-void TSR::getJacobian(
+void TSR::getJacobianNumerically(
     const statespace::StateSpace::State* _s, Eigen::MatrixXd& _out) const
 {
   using SE3 = statespace::SE3;
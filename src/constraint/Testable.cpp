@@ -0,0 +1,77 @@
+#include <aikido/constraint/Testable.hpp>
+
+#include <algorithm>
+#include <aikido/statespace/StateArray.hpp>
+
+namespace aikido {
+namespace constraint {
+
+//==============================================================================
+bool Testable::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& _states,
+    std::vector<bool>& _out,
+    bool _earlyExit) const
+{
+  _out.assign(_states.size(), false);
+
+  bool allSatisfied = true;
+  for (std::size_t i = 0; i < _states.size(); ++i)
+  {
+    _out[i] = isSatisfied(_states[i]);
+    if (!_out[i])
+    {
+      allSatisfied = false;
+      if (_earlyExit)
+        break;
+    }
+  }
+  return allSatisfied;
+}
+
+//==============================================================================
+bool Testable::areAllSatisfied(
+    const std::vector<const statespace::StateSpace::State*>& _states) const
+{
+  std::vector<bool> results;
+  return isSatisfiedBatch(_states, results, true);
+}
+
+//==============================================================================
+bool areAllSatisfied(
+    const Testable& _testable,
+    const statespace::EdgeInterpolation& _edge,
+    const std::vector<double>& _alphas)
+{
+  const auto stateSpace = _testable.getStateSpace();
+  const auto numStates = _alphas.size();
+  if (numStates == 0)
+    return true;
+
+  const auto chunkSize = std::min(
+      numStates, statespace::StateArray::getInlineCapacity(stateSpace.get()));
+  statespace::StateArray states(stateSpace.get(), chunkSize);
+
+  std::vector<const statespace::StateSpace::State*> chunk;
+  chunk.reserve(chunkSize);
+  Eigen::VectorXd alphas(chunkSize);
+
+  for (std::size_t begin = 0; begin < numStates; begin += chunkSize)
+  {
+    const auto size = std::min(chunkSize, numStates - begin);
+
+    // Only the last chunk may be smaller, so this only allocates for it.
+    alphas = Eigen::Map<const Eigen::VectorXd>(_alphas.data() + begin, size);
+    _edge.interpolateBatch(alphas, states.getState(0), states.getStride());
+
+    chunk.clear();
+    for (std::size_t i = 0; i < size; ++i)
+      chunk.emplace_back(states.getState(i));
+
+    if (!_testable.areAllSatisfied(chunk))
+      return false;
+  }
+  return true;
+}
+
+} // namespace constraint
+} // namespace aikido
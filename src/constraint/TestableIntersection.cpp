@@ -1,5 +1,6 @@
 #include <aikido/constraint/TestableIntersection.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace aikido {
@@ -30,6 +31,70 @@ bool TestableIntersection::isSatisfied(
   return true;
 }
 
+//==============================================================================
+bool TestableIntersection::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& _states,
+    std::vector<bool>& _out,
+    bool _earlyExit) const
+{
+  _out.assign(_states.size(), true);
+
+  // States that satisfy all constraints tested so far, and their indices.
+  std::vector<const statespace::StateSpace::State*> states(_states);
+  std::vector<std::size_t> indices(_states.size());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    indices[i] = i;
+
+  std::vector<bool> results;
+  for (const auto& constraint : mConstraints)
+  {
+    if (states.empty())
+      break;
+
+    if (constraint->isSatisfiedBatch(states, results, _earlyExit))
+      continue;
+
+    std::size_t numSatisfied = 0;
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+      if (results[i])
+      {
+        states[numSatisfied] = states[i];
+        indices[numSatisfied] = indices[i];
+        ++numSatisfied;
+      }
+      else
+      {
+        _out[indices[i]] = false;
+      }
+    }
+    states.resize(numSatisfied);
+    indices.resize(numSatisfied);
+  }
+
+  if (states.size() == _states.size())
+    return true;
+
+  if (_earlyExit)
+  {
+    const auto firstUnsatisfied = std::find(_out.begin(), _out.end(), false);
+    std::fill(firstUnsatisfied, _out.end(), false);
+  }
+  return false;
+}
+
+//==============================================================================
+bool TestableIntersection::areAllSatisfied(
+    const std::vector<const statespace::StateSpace::State*>& _states) const
+{
+  for (const auto& constraint : mConstraints)
+  {
+    if (!constraint->areAllSatisfied(_states))
+      return false;
+  }
+  return true;
+}
+
 //==============================================================================
 statespace::StateSpacePtr TestableIntersection::getStateSpace() const
 {
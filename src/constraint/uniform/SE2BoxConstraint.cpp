@@ -150,6 +150,51 @@ bool SE2BoxConstraint::isSatisfied(
   return true;
 }
 
+//==============================================================================
+bool SE2BoxConstraint::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& _states,
+    std::vector<bool>& _out,
+    bool _earlyExit) const
+{
+  const auto numStates = _states.size();
+  _out.assign(numStates, false);
+
+  Eigen::Matrix<double, 3, Eigen::Dynamic> tangents(3, numStates);
+  Eigen::VectorXd tangent;
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    mSpace->logMap(
+        static_cast<const statespace::SE2::State*>(_states[i]), tangent);
+    tangents.col(i) = tangent;
+  }
+
+  // Only the translational components are limited, as in isSatisfied.
+  const auto translations = tangents.bottomRows(mRnDimension);
+  const Eigen::Array<bool, 1, Eigen::Dynamic> belowLowerLimits
+      = ((translations.colwise() - mLowerLimits.tail(mRnDimension)).array()
+         < 0.)
+            .colwise()
+            .any();
+  const Eigen::Array<bool, 1, Eigen::Dynamic> aboveUpperLimits
+      = ((translations.colwise() - mUpperLimits.tail(mRnDimension)).array()
+         > 0.)
+            .colwise()
+            .any();
+
+  bool allSatisfied = true;
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    _out[i] = !belowLowerLimits[i] && !aboveUpperLimits[i];
+    if (!_out[i])
+    {
+      allSatisfied = false;
+      if (_earlyExit)
+        break;
+    }
+  }
+  return allSatisfied;
+}
+
 //==============================================================================
 bool SE2BoxConstraint::project(
     const statespace::StateSpace::State* s,
@@ -159,42 +159,6 @@ void extractJointTrajectoryPoint(
   }
 }
 
-//==============================================================================
-void extractTrajectoryPoint(
-    const std::shared_ptr<MetaSkeletonStateSpace>& space,
-    const aikido::trajectory::TrajectoryPtr& trajectory,
-    double timeFromStart,
-    trajectory_msgs::JointTrajectoryPoint& waypoint)
-{
-  const auto numDerivatives = std::min<int>(trajectory->getNumDerivatives(), 1);
-  const auto timeAbsolute = trajectory->getStartTime() + timeFromStart;
-  const int numDof = space->getDimension();
-  DART_UNUSED(numDof);
-
-  Eigen::VectorXd tangentVector;
-  auto state = space->createState();
-  trajectory->evaluate(timeAbsolute, state);
-  space->logMap(state, tangentVector);
-
-  assert(tangentVector.size() == numDof);
-
-  waypoint.time_from_start = ::ros::Duration(timeFromStart);
-  waypoint.positions.assign(
-      tangentVector.data(), tangentVector.data() + tangentVector.size());
-
-  assert(0 <= numDerivatives && numDerivatives <= 2);
-  const std::array<std::vector<double>*, 2> derivatives{
-      &waypoint.velocities, &waypoint.accelerations};
-  for (int iDerivative = 1; iDerivative <= numDerivatives; ++iDerivative)
-  {
-    trajectory->evaluateDerivative(timeAbsolute, iDerivative, tangentVector);
-    assert(tangentVector.size() == numDof);
-
-    derivatives[iDerivative - 1]->assign(
-        tangentVector.data(), tangentVector.data() + tangentVector.size());
-  }
-}
-
 //==============================================================================
 // The rows of inVector is reordered in outVector.
 void reorder(
@@ -511,15 +475,38 @@ trajectory_msgs::JointTrajectory toRosJointTrajectory(
     jointTrajectory.joint_names.emplace_back(jointName);
   }
 
-  // Evaluate trajectory at each timestep and insert it into jointTrajectory
-  jointTrajectory.points.reserve(numWaypoints);
-  for (const auto timeFromStart : timeSequence)
-  {
-    trajectory_msgs::JointTrajectoryPoint waypoint;
+  // Evaluate trajectory at all timesteps at once and insert the samples into
+  // jointTrajectory
+  Eigen::VectorXd timesFromStart(numWaypoints);
+  for (int i = 0; i < numWaypoints; ++i)
+    timesFromStart[i] = timeSequence[i];
+
+  const Eigen::VectorXd times
+      = timesFromStart.array() + trajectory->getStartTime();
+  const bool hasVelocities = trajectory->getNumDerivatives() >= 1;
+
+  Eigen::MatrixXd positions;
+  Eigen::MatrixXd velocities;
+  trajectory->evaluateBatch(times, positions);
+  if (hasVelocities)
+    trajectory->evaluateDerivativeBatch(times, 1, velocities);
 
-    extractTrajectoryPoint(space, trajectory, timeFromStart, waypoint);
+  const int numDof = space->getDimension();
+  assert(positions.rows() == numDof);
+
+  jointTrajectory.points.resize(numWaypoints);
+  for (int i = 0; i < numWaypoints; ++i)
+  {
+    auto& waypoint = jointTrajectory.points[i];
+    waypoint.time_from_start = ::ros::Duration(timesFromStart[i]);
+    waypoint.positions.assign(
+        positions.col(i).data(), positions.col(i).data() + numDof);
 
-    jointTrajectory.points.emplace_back(waypoint);
+    if (hasVelocities)
+    {
+      waypoint.velocities.assign(
+          velocities.col(i).data(), velocities.col(i).data() + numDof);
+    }
   }
 
   return jointTrajectory;
@@ -1,13 +1,62 @@
 #include <aikido/distance/CartesianProductWeighted.hpp>
 
+#include <cmath>
+#include <limits>
+#include <typeinfo>
+#include <aikido/distance/RnEuclidean.hpp>
+#include <aikido/distance/SE2Weighted.hpp>
+#include <aikido/distance/SO2Angular.hpp>
+#include <aikido/distance/SO3Angular.hpp>
+#include <aikido/statespace/SE2.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/statespace/SO3.hpp>
+
 namespace aikido {
 namespace distance {
 
+namespace {
+
+//==============================================================================
+template <int N>
+bool getEuclideanDimension(
+    const DistanceMetric& _metric, std::size_t& _dimension)
+{
+  if (typeid(_metric) != typeid(REuclidean<N>))
+    return false;
+
+  _dimension = _metric.getStateSpace()->getDimension();
+  return true;
+}
+
+//==============================================================================
+bool getEuclideanDimension(
+    const DistanceMetric& _metric, std::size_t& _dimension)
+{
+  return getEuclideanDimension<0>(_metric, _dimension)
+         || getEuclideanDimension<1>(_metric, _dimension)
+         || getEuclideanDimension<2>(_metric, _dimension)
+         || getEuclideanDimension<3>(_metric, _dimension)
+         || getEuclideanDimension<6>(_metric, _dimension)
+         || getEuclideanDimension<Eigen::Dynamic>(_metric, _dimension);
+}
+
+//==============================================================================
+/// Shortest difference between two angles, as computed by SO2Angular.
+double computeAngularDistance(double _angle1, double _angle2)
+{
+  double diff = std::fmod(std::fabs(_angle1 - _angle2), 2.0 * M_PI);
+  if (diff > M_PI)
+    diff -= 2.0 * M_PI;
+  return std::fabs(diff);
+}
+
+} // namespace
+
 //==============================================================================
 CartesianProductWeighted::CartesianProductWeighted(
     std::shared_ptr<statespace::CartesianProduct> _space,
     std::vector<DistanceMetricPtr> _metrics)
-  : mStateSpace(std::move(_space))
+  : mStateSpace(std::move(_space)), mIsCompiled(false)
 {
   if (mStateSpace == nullptr)
   {
@@ -43,13 +92,17 @@ CartesianProductWeighted::CartesianProductWeighted(
     }
     mMetrics.emplace_back(std::move(_metrics[i]), 1);
   }
+
+  compile();
 }
 
 //==============================================================================
 CartesianProductWeighted::CartesianProductWeighted(
     std::shared_ptr<statespace::CartesianProduct> _space,
     std::vector<std::pair<DistanceMetricPtr, double>> _metrics)
-  : mStateSpace(std::move(_space)), mMetrics(std::move(_metrics))
+  : mStateSpace(std::move(_space))
+  , mMetrics(std::move(_metrics))
+  , mIsCompiled(false)
 {
   if (mStateSpace == nullptr)
   {
@@ -89,6 +142,8 @@ CartesianProductWeighted::CartesianProductWeighted(
       throw std::invalid_argument(msg.str());
     }
   }
+
+  compile();
 }
 
 //==============================================================================
@@ -102,6 +157,14 @@ double CartesianProductWeighted::distance(
     const aikido::statespace::StateSpace::State* _state1,
     const aikido::statespace::StateSpace::State* _state2) const
 {
+  if (mIsCompiled)
+  {
+    return computeCompiledDistance(
+        reinterpret_cast<const unsigned char*>(_state1),
+        reinterpret_cast<const unsigned char*>(_state2),
+        std::numeric_limits<double>::infinity());
+  }
+
   auto state1
       = static_cast<const statespace::CartesianProduct::State*>(_state1);
   auto state2
@@ -118,5 +181,285 @@ double CartesianProductWeighted::distance(
   return dist;
 }
 
+//==============================================================================
+double CartesianProductWeighted::distanceBounded(
+    const aikido::statespace::StateSpace::State* _state1,
+    const aikido::statespace::StateSpace::State* _state2,
+    double _bound) const
+{
+  if (mIsCompiled)
+  {
+    return computeCompiledDistance(
+        reinterpret_cast<const unsigned char*>(_state1),
+        reinterpret_cast<const unsigned char*>(_state2),
+        _bound);
+  }
+
+  auto state1
+      = static_cast<const statespace::CartesianProduct::State*>(_state1);
+  auto state2
+      = static_cast<const statespace::CartesianProduct::State*>(_state2);
+
+  double dist = 0.0;
+  for (std::size_t i = 0; i < mMetrics.size(); ++i)
+  {
+    const double weight = mMetrics[i].second;
+    if (weight == 0.0)
+      continue;
+
+    dist += weight
+            * mMetrics[i].first->distanceBounded(
+                  mStateSpace->getSubState<>(state1, i),
+                  mStateSpace->getSubState<>(state2, i),
+                  (_bound - dist) / weight);
+    if (dist > _bound)
+      return dist;
+  }
+  return dist;
+}
+
+//==============================================================================
+const std::vector<std::pair<DistanceMetricPtr, double>>&
+CartesianProductWeighted::getMetrics() const
+{
+  return mMetrics;
+}
+
+//==============================================================================
+void CartesianProductWeighted::distanceBatch(
+    const statespace::StateSpace::State* _state,
+    const std::vector<const statespace::StateSpace::State*>& _states,
+    std::vector<double>& _distances) const
+{
+  if (!mIsCompiled)
+  {
+    DistanceMetric::distanceBatch(_state, _states, _distances);
+    return;
+  }
+
+  const auto state = reinterpret_cast<const unsigned char*>(_state);
+
+  _distances.resize(_states.size());
+  for (std::size_t i = 0; i < _states.size(); ++i)
+  {
+    _distances[i] = computeCompiledDistance(
+        state,
+        reinterpret_cast<const unsigned char*>(_states[i]),
+        std::numeric_limits<double>::infinity());
+  }
+}
+
+//==============================================================================
+bool CartesianProductWeighted::isCompiled() const
+{
+  return mIsCompiled;
+}
+
+//==============================================================================
+void CartesianProductWeighted::compile()
+{
+  mIsCompiled = true;
+  for (std::size_t i = 0; i < mMetrics.size(); ++i)
+  {
+    if (!compile(
+            *mMetrics[i].first,
+            mStateSpace->getSubStateOffset(i),
+            mMetrics[i].second))
+    {
+      mIsCompiled = false;
+      break;
+    }
+  }
+
+  if (!mIsCompiled)
+  {
+    mScalarOffsets.clear();
+    mScalarWeights.clear();
+    mAngleOffsets.clear();
+    mAngleWeights.clear();
+    mVectorTerms.clear();
+    mSO3Terms.clear();
+    mSE2Terms.clear();
+  }
+}
+
+//==============================================================================
+bool CartesianProductWeighted::compile(
+    const DistanceMetric& _metric, std::size_t _offset, double _weight)
+{
+  // Only exact types are compiled, since a derived metric may override
+  // distance().
+  const auto& type = typeid(_metric);
+
+  if (type == typeid(CartesianProductWeighted))
+  {
+    const auto& product = static_cast<const CartesianProductWeighted&>(_metric);
+    if (!product.mIsCompiled)
+      return false;
+
+    for (std::size_t i = 0; i < product.mScalarOffsets.size(); ++i)
+    {
+      mScalarOffsets.push_back(_offset + product.mScalarOffsets[i]);
+      mScalarWeights.push_back(_weight * product.mScalarWeights[i]);
+    }
+
+    for (std::size_t i = 0; i < product.mAngleOffsets.size(); ++i)
+    {
+      mAngleOffsets.push_back(_offset + product.mAngleOffsets[i]);
+      mAngleWeights.push_back(_weight * product.mAngleWeights[i]);
+    }
+
+    const auto appendTerms
+        = [=](const std::vector<Term>& _terms, std::vector<Term>& _out) {
+            for (Term term : _terms)
+            {
+              term.mOffset += _offset;
+              term.mWeight *= _weight;
+              term.mTranslationWeight *= _weight;
+              _out.push_back(term);
+            }
+          };
+    appendTerms(product.mVectorTerms, mVectorTerms);
+    appendTerms(product.mSO3Terms, mSO3Terms);
+    appendTerms(product.mSE2Terms, mSE2Terms);
+    return true;
+  }
+
+  if (type == typeid(SO2Angular))
+  {
+    mAngleOffsets.push_back(_offset);
+    mAngleWeights.push_back(_weight);
+    return true;
+  }
+
+  if (type == typeid(SO3Angular))
+  {
+    mSO3Terms.push_back(Term{_offset, 3, _weight, 0.});
+    return true;
+  }
+
+  if (type == typeid(SE2Weighted))
+  {
+    const auto& weights = static_cast<const SE2Weighted&>(_metric).getWeights();
+    mSE2Terms.push_back(
+        Term{_offset, 3, _weight * weights[0], _weight * weights[1]});
+    return true;
+  }
+
+  std::size_t dimension;
+  if (!getEuclideanDimension(_metric, dimension))
+    return false;
+
+  if (dimension == 1)
+  {
+    mScalarOffsets.push_back(_offset);
+    mScalarWeights.push_back(_weight);
+  }
+  else if (dimension > 1)
+  {
+    mVectorTerms.push_back(Term{_offset, dimension, _weight, 0.});
+  }
+  return true;
+}
+
+//==============================================================================
+double CartesianProductWeighted::computeCompiledDistance(
+    const unsigned char* _state1,
+    const unsigned char* _state2,
+    double _bound) const
+{
+  double dist = 0.0;
+
+  // R<N> stores its values as doubles at the start of its state.
+  for (std::size_t i = 0; i < mScalarOffsets.size(); ++i)
+  {
+    const auto value1
+        = *reinterpret_cast<const double*>(_state1 + mScalarOffsets[i]);
+    const auto value2
+        = *reinterpret_cast<const double*>(_state2 + mScalarOffsets[i]);
+    dist += mScalarWeights[i] * std::fabs(value2 - value1);
+  }
+  if (dist > _bound)
+    return dist;
+
+  for (std::size_t i = 0; i < mAngleOffsets.size(); ++i)
+  {
+    const auto state1 = reinterpret_cast<const statespace::SO2::State*>(
+        _state1 + mAngleOffsets[i]);
+    const auto state2 = reinterpret_cast<const statespace::SO2::State*>(
+        _state2 + mAngleOffsets[i]);
+    dist += mAngleWeights[i]
+            * computeAngularDistance(state1->getAngle(), state2->getAngle());
+  }
+  if (dist > _bound)
+    return dist;
+
+  for (const auto& term : mVectorTerms)
+  {
+    const auto values1
+        = reinterpret_cast<const double*>(_state1 + term.mOffset);
+    const auto values2
+        = reinterpret_cast<const double*>(_state2 + term.mOffset);
+
+    double squaredNorm = 0.0;
+    for (std::size_t j = 0; j < term.mDimension; ++j)
+    {
+      const double diff = values2[j] - values1[j];
+      squaredNorm += diff * diff;
+    }
+
+    // Compare squared values to skip the square root past the bound.
+    const double remaining = (_bound - dist) / term.mWeight;
+    if (term.mWeight > 0.0 && squaredNorm > remaining * remaining)
+      return std::numeric_limits<double>::infinity();
+
+    dist += term.mWeight * std::sqrt(squaredNorm);
+    if (dist > _bound)
+      return dist;
+  }
+
+  for (const auto& term : mSO3Terms)
+  {
+    const auto state1 = reinterpret_cast<const statespace::SO3::State*>(
+        _state1 + term.mOffset);
+    const auto state2 = reinterpret_cast<const statespace::SO3::State*>(
+        _state2 + term.mOffset);
+    dist += term.mWeight
+            * state1->getQuaternion().angularDistance(state2->getQuaternion());
+    if (dist > _bound)
+      return dist;
+  }
+
+  for (const auto& term : mSE2Terms)
+  {
+    const auto& transform1 = reinterpret_cast<const statespace::SE2::State*>(
+                                 _state1 + term.mOffset)
+                                 ->getIsometry();
+    const auto& transform2 = reinterpret_cast<const statespace::SE2::State*>(
+                                 _state2 + term.mOffset)
+                                 ->getIsometry();
+
+    // Same as SE2Weighted, which compares the log maps of the states.
+    Eigen::Rotation2Dd rotation1 = Eigen::Rotation2Dd::Identity();
+    rotation1.fromRotationMatrix(transform1.rotation());
+    Eigen::Rotation2Dd rotation2 = Eigen::Rotation2Dd::Identity();
+    rotation2.fromRotationMatrix(transform2.rotation());
+
+    double angularDistance = rotation2.angle() - rotation1.angle();
+    angularDistance = std::fmod(std::abs(angularDistance), 2.0 * M_PI);
+    if (angularDistance > M_PI)
+      angularDistance = 2 * M_PI - angularDistance;
+
+    dist += term.mWeight * angularDistance
+            + term.mTranslationWeight
+                  * (transform2.translation() - transform1.translation())
+                        .norm();
+    if (dist > _bound)
+      return dist;
+  }
+
+  return dist;
+}
+
 } // namespace distance
 } // namespace aikido
@@ -0,0 +1,27 @@
+#include <aikido/distance/DistanceMetric.hpp>
+
+namespace aikido {
+namespace distance {
+
+//==============================================================================
+double DistanceMetric::distanceBounded(
+    const statespace::StateSpace::State* _state1,
+    const statespace::StateSpace::State* _state2,
+    double /*_bound*/) const
+{
+  return distance(_state1, _state2);
+}
+
+//==============================================================================
+void DistanceMetric::distanceBatch(
+    const statespace::StateSpace::State* _state,
+    const std::vector<const statespace::StateSpace::State*>& _states,
+    std::vector<double>& _distances) const
+{
+  _distances.resize(_states.size());
+  for (std::size_t i = 0; i < _states.size(); ++i)
+    _distances[i] = distance(_state, _states[i]);
+}
+
+} // namespace distance
+} // namespace aikido
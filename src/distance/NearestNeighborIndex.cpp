@@ -0,0 +1,623 @@
+#include <aikido/distance/NearestNeighborIndex.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <typeinfo>
+#include <aikido/distance/CartesianProductWeighted.hpp>
+#include <aikido/distance/RnEuclidean.hpp>
+#include <aikido/distance/SO2Angular.hpp>
+
+namespace aikido {
+namespace distance {
+
+namespace {
+
+using statespace::StateSpace;
+
+using GetState
+    = std::function<const StateSpace::State*(const StateSpace::State*)>;
+
+//==============================================================================
+double normalizeAngle(double _angle)
+{
+  double angle = std::fmod(_angle + M_PI, 2. * M_PI);
+  if (angle < 0.)
+    angle += 2. * M_PI;
+  return angle - M_PI;
+}
+
+//==============================================================================
+template <int N>
+bool isEuclidean(const DistanceMetric& _metric)
+{
+  return typeid(_metric) == typeid(REuclidean<N>);
+}
+
+//==============================================================================
+bool isEuclidean(const DistanceMetric& _metric)
+{
+  return isEuclidean<0>(_metric) || isEuclidean<1>(_metric)
+         || isEuclidean<2>(_metric) || isEuclidean<3>(_metric)
+         || isEuclidean<6>(_metric) || isEuclidean<Eigen::Dynamic>(_metric);
+}
+
+//==============================================================================
+template <int N>
+bool getEuclideanCoordinates(
+    const DistanceMetric& _metric,
+    const GetState& _getState,
+    std::size_t& _dimension,
+    std::function<void(const StateSpace::State*, double*)>& _function)
+{
+  if (typeid(_metric) != typeid(REuclidean<N>))
+    return false;
+
+  const auto space
+      = std::dynamic_pointer_cast<statespace::R<N>>(_metric.getStateSpace());
+  _dimension = space->getDimension();
+  _function = [=](const StateSpace::State* _state, double* _coordinates) {
+    const auto value = space->getValue(
+        static_cast<const typename statespace::R<N>::State*>(
+            _getState(_state)));
+    std::copy(value.data(), value.data() + value.size(), _coordinates);
+  };
+  return true;
+}
+
+} // namespace
+
+//==============================================================================
+struct NearestNeighborIndex::Search
+{
+  Search(
+      const NearestNeighborIndex& _index,
+      const StateSpace::State* _state,
+      std::size_t _k,
+      double _radius);
+
+  std::vector<double> mQuery;
+
+  /// Cell of the current node and the offsets from the query to it.
+  std::vector<double> mLower;
+  std::vector<double> mUpper;
+  std::vector<double> mOffsets;
+  std::vector<double> mSquaredGroupOffsets;
+
+  /// Number of neighbors for a k-nearest query, or zero for a radius query.
+  std::size_t mK;
+  double mRadius;
+
+  /// Neighbors found so far as pairs of distance and index. This is a
+  /// max-heap on the distance for k-nearest queries.
+  std::vector<std::pair<double, std::size_t>> mNeighbors;
+};
+
+//==============================================================================
+NearestNeighborIndex::Search::Search(
+    const NearestNeighborIndex& _index,
+    const StateSpace::State* _state,
+    std::size_t _k,
+    double _radius)
+  : mQuery(_index.mNumCoordinates)
+  , mLower(_index.mNumCoordinates)
+  , mUpper(_index.mNumCoordinates)
+  , mOffsets(_index.mNumCoordinates, 0.)
+  , mSquaredGroupOffsets(_index.mGroups.size(), 0.)
+  , mK(_k)
+  , mRadius(_radius)
+{
+  _index.computeCoordinates(_state, mQuery.data());
+
+  // The cell of the root is unbounded, except for angles.
+  for (std::size_t i = 0; i < mQuery.size(); ++i)
+  {
+    const bool isAngular
+        = _index.mGroups[_index.mCoordinateGroups[i]].mIsAngular;
+    mLower[i] = isAngular ? -M_PI : -std::numeric_limits<double>::infinity();
+    mUpper[i] = isAngular ? M_PI : std::numeric_limits<double>::infinity();
+  }
+
+  if (mK > 0)
+    mNeighbors.reserve(mK + 1);
+}
+
+//==============================================================================
+bool NearestNeighborIndex::isSupported(const DistanceMetric& _metric)
+{
+  // Metrics are matched by their exact type, since a derived metric may
+  // override distance().
+  if (typeid(_metric) == typeid(CartesianProductWeighted))
+  {
+    const auto cartesianProduct
+        = static_cast<const CartesianProductWeighted*>(&_metric);
+    for (const auto& metric : cartesianProduct->getMetrics())
+    {
+      if (!isSupported(*metric.first))
+        return false;
+    }
+    return true;
+  }
+
+  return typeid(_metric) == typeid(SO2Angular) || isEuclidean(_metric);
+}
+
+//==============================================================================
+NearestNeighborIndex::NearestNeighborIndex(
+    DistanceMetricPtr _metric, std::size_t _bucketSize)
+  : mMetric(std::move(_metric))
+  , mBucketSize(_bucketSize)
+  , mApproximationFactor(0.)
+  , mNumCoordinates(0)
+  , mNumRemoved(0)
+{
+  if (!mMetric)
+    throw std::invalid_argument("DistanceMetric is nullptr.");
+
+  if (mBucketSize == 0)
+    throw std::invalid_argument("Bucket size must be positive.");
+
+  if (!isSupported(*mMetric))
+  {
+    throw std::invalid_argument(
+        "NearestNeighborIndex only supports REuclidean, SO2Angular and "
+        "CartesianProductWeighted metrics.");
+  }
+
+  addGroups(mMetric, 1., [](const StateSpace::State* _state) {
+    return _state;
+  });
+}
+
+//==============================================================================
+const DistanceMetricPtr& NearestNeighborIndex::getMetric() const
+{
+  return mMetric;
+}
+
+//==============================================================================
+void NearestNeighborIndex::setApproximationFactor(double _epsilon)
+{
+  if (_epsilon < 0.)
+    throw std::invalid_argument("Approximation factor must be non-negative.");
+
+  mApproximationFactor = _epsilon;
+}
+
+//==============================================================================
+double NearestNeighborIndex::getApproximationFactor() const
+{
+  return mApproximationFactor;
+}
+
+//==============================================================================
+std::size_t NearestNeighborIndex::add(const StateSpace::State* _state)
+{
+  const std::size_t index = mRemoved.size();
+  mCoordinates.resize(mCoordinates.size() + mNumCoordinates);
+  computeCoordinates(_state, mCoordinates.data() + index * mNumCoordinates);
+  mRemoved.push_back(false);
+
+  if (mNodes.empty())
+  {
+    mNodes.emplace_back();
+    mNodes.back().mSplitCoordinate = -1;
+  }
+
+  const double* coordinates = mCoordinates.data() + index * mNumCoordinates;
+
+  std::size_t node = 0;
+  while (mNodes[node].mSplitCoordinate >= 0)
+  {
+    const Node& parent = mNodes[node];
+    const bool isUpper
+        = coordinates[parent.mSplitCoordinate] >= parent.mSplitValue;
+    node = parent.mChildren[isUpper];
+  }
+
+  mNodes[node].mBucket.push_back(index);
+  if (mNodes[node].mBucket.size() > mBucketSize)
+    split(node);
+
+  return index;
+}
+
+//==============================================================================
+bool NearestNeighborIndex::remove(std::size_t _index)
+{
+  if (_index >= mRemoved.size() || mRemoved[_index])
+    return false;
+
+  mRemoved[_index] = true;
+  ++mNumRemoved;
+  return true;
+}
+
+//==============================================================================
+void NearestNeighborIndex::clear()
+{
+  mCoordinates.clear();
+  mRemoved.clear();
+  mNumRemoved = 0;
+  mNodes.clear();
+}
+
+//==============================================================================
+std::size_t NearestNeighborIndex::size() const
+{
+  return mRemoved.size() - mNumRemoved;
+}
+
+//==============================================================================
+void NearestNeighborIndex::nearestK(
+    const StateSpace::State* _state,
+    std::size_t _k,
+    std::vector<std::size_t>& _indices) const
+{
+  _indices.clear();
+  if (_k == 0 || mNodes.empty())
+    return;
+
+  Search query(*this, _state, _k, std::numeric_limits<double>::infinity());
+  search(query, 0, 0.);
+
+  std::sort_heap(query.mNeighbors.begin(), query.mNeighbors.end());
+
+  _indices.reserve(query.mNeighbors.size());
+  for (const auto& neighbor : query.mNeighbors)
+    _indices.push_back(neighbor.second);
+}
+
+//==============================================================================
+void NearestNeighborIndex::nearestR(
+    const StateSpace::State* _state,
+    double _radius,
+    std::vector<std::size_t>& _indices) const
+{
+  _indices.clear();
+  if (mNodes.empty())
+    return;
+
+  Search query(*this, _state, 0, _radius);
+  search(query, 0, 0.);
+
+  std::sort(query.mNeighbors.begin(), query.mNeighbors.end());
+
+  _indices.reserve(query.mNeighbors.size());
+  for (const auto& neighbor : query.mNeighbors)
+    _indices.push_back(neighbor.second);
+}
+
+//==============================================================================
+void NearestNeighborIndex::computeDistances(
+    const StateSpace::State* _state,
+    const std::vector<std::size_t>& _indices,
+    std::vector<double>& _distances) const
+{
+  std::vector<double> query(mNumCoordinates);
+  computeCoordinates(_state, query.data());
+
+  _distances.resize(_indices.size());
+  for (std::size_t i = 0; i < _indices.size(); ++i)
+  {
+    assert(_indices[i] < mRemoved.size());
+    _distances[i] = computeDistance(
+        query.data(), mCoordinates.data() + _indices[i] * mNumCoordinates);
+  }
+}
+
+//==============================================================================
+bool NearestNeighborIndex::addGroups(
+    const DistanceMetricPtr& _metric, double _weight, const GetState& _getState)
+{
+  const auto& type = typeid(*_metric);
+
+  if (type == typeid(CartesianProductWeighted))
+  {
+    const auto cartesianProduct
+        = static_cast<const CartesianProductWeighted*>(_metric.get());
+    const auto space = std::dynamic_pointer_cast<statespace::CartesianProduct>(
+        cartesianProduct->getStateSpace());
+    const auto& metrics = cartesianProduct->getMetrics();
+
+    for (std::size_t i = 0; i < metrics.size(); ++i)
+    {
+      const auto getSubState = [=](const StateSpace::State* _state) {
+        return space->getSubState<>(
+            static_cast<const statespace::CartesianProduct::State*>(
+                _getState(_state)),
+            i);
+      };
+
+      const double weight = _weight * metrics[i].second;
+      if (!addGroups(metrics[i].first, weight, getSubState))
+        return false;
+    }
+    return true;
+  }
+
+  Group group;
+  group.mOffset = mNumCoordinates;
+  group.mWeight = _weight;
+  group.mIsAngular = false;
+
+  CoordinateFunction function;
+
+  if (type == typeid(SO2Angular))
+  {
+    const auto space
+        = std::dynamic_pointer_cast<statespace::SO2>(_metric->getStateSpace());
+
+    group.mSize = 1;
+    group.mIsAngular = true;
+    function = [=](const StateSpace::State* _state, double* _coordinates) {
+      _coordinates[0] = normalizeAngle(
+          space->getAngle(
+              static_cast<const statespace::SO2::State*>(_getState(_state))));
+    };
+  }
+  else if (!getEuclideanCoordinates<0>(
+               *_metric, _getState, group.mSize, function)
+           && !getEuclideanCoordinates<1>(
+                  *_metric, _getState, group.mSize, function)
+           && !getEuclideanCoordinates<2>(
+                  *_metric, _getState, group.mSize, function)
+           && !getEuclideanCoordinates<3>(
+                  *_metric, _getState, group.mSize, function)
+           && !getEuclideanCoordinates<6>(
+                  *_metric, _getState, group.mSize, function)
+           && !getEuclideanCoordinates<Eigen::Dynamic>(
+                  *_metric, _getState, group.mSize, function))
+  {
+    return false;
+  }
+
+  if (group.mSize == 0)
+    return true;
+
+  mGroups.push_back(group);
+  mCoordinateFunctions.push_back(function);
+  mCoordinateGroups.insert(
+      mCoordinateGroups.end(), group.mSize, mGroups.size() - 1);
+  mNumCoordinates += group.mSize;
+  return true;
+}
+
+//==============================================================================
+void NearestNeighborIndex::computeCoordinates(
+    const StateSpace::State* _state, double* _coordinates) const
+{
+  for (std::size_t i = 0; i < mGroups.size(); ++i)
+    mCoordinateFunctions[i](_state, _coordinates + mGroups[i].mOffset);
+}
+
+//==============================================================================
+double NearestNeighborIndex::computeDistance(
+    const double* _a, const double* _b, double _bound) const
+{
+  double distance = 0.;
+  for (const auto& group : mGroups)
+  {
+    const double* a = _a + group.mOffset;
+    const double* b = _b + group.mOffset;
+
+    if (group.mIsAngular)
+    {
+      double difference = std::fabs(a[0] - b[0]);
+      if (difference > M_PI)
+        difference = 2. * M_PI - difference;
+      distance += group.mWeight * difference;
+    }
+    else if (group.mSize == 1)
+    {
+      distance += group.mWeight * std::fabs(a[0] - b[0]);
+    }
+    else
+    {
+      double squaredNorm = 0.;
+      for (std::size_t i = 0; i < group.mSize; ++i)
+        squaredNorm += (a[i] - b[i]) * (a[i] - b[i]);
+
+      // Compare squared values to skip the square root past the bound.
+      const double remaining = (_bound - distance) / group.mWeight;
+      if (group.mWeight > 0. && squaredNorm > remaining * remaining)
+        return std::numeric_limits<double>::infinity();
+
+      distance += group.mWeight * std::sqrt(squaredNorm);
+    }
+
+    if (distance > _bound)
+      return distance;
+  }
+  return distance;
+}
+
+//==============================================================================
+void NearestNeighborIndex::split(std::size_t _node)
+{
+  const auto& bucket = mNodes[_node].mBucket;
+
+  // Split the coordinate with the largest weighted spread.
+  int splitCoordinate = -1;
+  double maxSpread = 0.;
+  double splitMin = 0.;
+  double splitMax = 0.;
+  for (std::size_t i = 0; i < mNumCoordinates; ++i)
+  {
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    for (const std::size_t index : bucket)
+    {
+      const double value = mCoordinates[index * mNumCoordinates + i];
+      min = std::min(min, value);
+      max = std::max(max, value);
+    }
+
+    const double spread = mGroups[mCoordinateGroups[i]].mWeight * (max - min);
+    if (spread > maxSpread)
+    {
+      splitCoordinate = i;
+      maxSpread = spread;
+      splitMin = min;
+      splitMax = max;
+    }
+  }
+
+  // All states in the bucket are equal.
+  if (splitCoordinate < 0)
+    return;
+
+  std::vector<double> values;
+  values.reserve(bucket.size());
+  for (const std::size_t index : bucket)
+    values.push_back(mCoordinates[index * mNumCoordinates + splitCoordinate]);
+
+  const auto median = values.begin() + values.size() / 2;
+  std::nth_element(values.begin(), median, values.end());
+
+  // The lower child contains the values below the split value, so it must be
+  // greater than the minimum.
+  double splitValue = *median;
+  if (splitValue <= splitMin)
+    splitValue = 0.5 * (splitMin + splitMax);
+
+  Node children[2];
+  for (auto& child : children)
+    child.mSplitCoordinate = -1;
+
+  for (const std::size_t index : bucket)
+  {
+    const double value
+        = mCoordinates[index * mNumCoordinates + splitCoordinate];
+    children[value >= splitValue].mBucket.push_back(index);
+  }
+
+  const std::size_t firstChild = mNodes.size();
+  mNodes.push_back(std::move(children[0]));
+  mNodes.push_back(std::move(children[1]));
+
+  Node& node = mNodes[_node];
+  node.mSplitCoordinate = splitCoordinate;
+  node.mSplitValue = splitValue;
+  node.mChildren[0] = firstChild;
+  node.mChildren[1] = firstChild + 1;
+  node.mBucket.clear();
+  node.mBucket.shrink_to_fit();
+}
+
+//==============================================================================
+double NearestNeighborIndex::computeOffset(
+    std::size_t _coordinate, double _value, double _lower, double _upper) const
+{
+  if (_value >= _lower && _value <= _upper)
+    return 0.;
+
+  if (!mGroups[mCoordinateGroups[_coordinate]].mIsAngular)
+    return _value < _lower ? _lower - _value : _value - _upper;
+
+  // Angles are in [-pi, pi), so the interval may also be reached by wrapping
+  // around.
+  if (_value < _lower)
+    return std::min(_lower - _value, _value + 2. * M_PI - _upper);
+  return std::min(_value - _upper, _lower + 2. * M_PI - _value);
+}
+
+//==============================================================================
+void NearestNeighborIndex::search(
+    Search& _search, std::size_t _node, double _bound) const
+{
+  const double approximationScale = 1. + mApproximationFactor;
+  auto& neighbors = _search.mNeighbors;
+  const auto isPruned = [&](double _distance) {
+    if (_search.mK == 0)
+      return _distance > _search.mRadius;
+    return neighbors.size() == _search.mK
+           && _distance * approximationScale >= neighbors.front().first;
+  };
+
+  const Node& node = mNodes[_node];
+
+  if (node.mSplitCoordinate < 0)
+  {
+    for (const std::size_t index : node.mBucket)
+    {
+      if (mRemoved[index])
+        continue;
+
+      // Only distances below the current k-th neighbor or the radius matter.
+      const double bound = _search.mK == 0
+                               ? _search.mRadius
+                               : neighbors.size() < _search.mK
+                                     ? std::numeric_limits<double>::infinity()
+                                     : neighbors.front().first;
+      const double distance = computeDistance(
+          _search.mQuery.data(),
+          mCoordinates.data() + index * mNumCoordinates,
+          bound);
+
+      if (_search.mK == 0)
+      {
+        if (distance <= _search.mRadius)
+          neighbors.emplace_back(distance, index);
+      }
+      else if (neighbors.size() < _search.mK)
+      {
+        neighbors.emplace_back(distance, index);
+        std::push_heap(neighbors.begin(), neighbors.end());
+      }
+      else if (distance < neighbors.front().first)
+      {
+        std::pop_heap(neighbors.begin(), neighbors.end());
+        neighbors.back() = std::make_pair(distance, index);
+        std::push_heap(neighbors.begin(), neighbors.end());
+      }
+    }
+    return;
+  }
+
+  const std::size_t coordinate = node.mSplitCoordinate;
+  const std::size_t groupIndex = mCoordinateGroups[coordinate];
+  const double weight = mGroups[groupIndex].mWeight;
+  const double value = _search.mQuery[coordinate];
+
+  const double lower = _search.mLower[coordinate];
+  const double upper = _search.mUpper[coordinate];
+  const double offset = _search.mOffsets[coordinate];
+  const double squaredGroupOffset = _search.mSquaredGroupOffsets[groupIndex];
+
+  // Visit the child that contains the query first.
+  const int first = value >= node.mSplitValue;
+  for (const int side : {first, 1 - first})
+  {
+    const double childLower = side ? node.mSplitValue : lower;
+    const double childUpper = side ? upper : node.mSplitValue;
+    const double childOffset
+        = computeOffset(coordinate, value, childLower, childUpper);
+    const double childSquaredGroupOffset = std::max(
+        squaredGroupOffset - offset * offset + childOffset * childOffset, 0.);
+    const double childBound = _bound
+                              + weight
+                                    * (std::sqrt(childSquaredGroupOffset)
+                                       - std::sqrt(squaredGroupOffset));
+
+    if (isPruned(childBound))
+      continue;
+
+    _search.mLower[coordinate] = childLower;
+    _search.mUpper[coordinate] = childUpper;
+    _search.mOffsets[coordinate] = childOffset;
+    _search.mSquaredGroupOffsets[groupIndex] = childSquaredGroupOffset;
+
+    search(_search, node.mChildren[side], childBound);
+  }
+
+  _search.mLower[coordinate] = lower;
+  _search.mUpper[coordinate] = upper;
+  _search.mOffsets[coordinate] = offset;
+  _search.mSquaredGroupOffsets[groupIndex] = squaredGroupOffset;
+}
+
+} // namespace distance
+} // namespace aikido
@@ -66,5 +66,11 @@ double SE2Weighted::distance(
   return mWeights[0] * angularDistance + mWeights[1] * (linearDistance.norm());
 }
 
+//==============================================================================
+const Eigen::Vector2d& SE2Weighted::getWeights() const
+{
+  return mWeights;
+}
+
 } // namespace distance
 } // namespace aikido
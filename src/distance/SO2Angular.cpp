@@ -1,5 +1,8 @@
 #include <aikido/distance/SO2Angular.hpp>
 
+#include <cmath>
+#include <limits>
+
 namespace aikido {
 namespace distance {
 
@@ -23,6 +26,26 @@ statespace::StateSpacePtr SO2Angular::getStateSpace() const
 double SO2Angular::distance(
     const aikido::statespace::StateSpace::State* _state1,
     const aikido::statespace::StateSpace::State* _state2) const
+{
+  return computeDistance(_state1, _state2);
+}
+
+//==============================================================================
+double SO2Angular::distanceBounded(
+    const aikido::statespace::StateSpace::State* _state1,
+    const aikido::statespace::StateSpace::State* _state2,
+    double _bound) const
+{
+  const double angle = computeDistance(_state1, _state2);
+  if (angle > _bound)
+    return std::numeric_limits<double>::infinity();
+  return angle;
+}
+
+//==============================================================================
+double SO2Angular::computeDistance(
+    const aikido::statespace::StateSpace::State* _state1,
+    const aikido::statespace::StateSpace::State* _state2) const
 {
   // Difference between angles
   double diff = mStateSpace->getAngle(
@@ -1,5 +1,8 @@
 #include <aikido/distance/SO3Angular.hpp>
 
+#include <cmath>
+#include <limits>
+
 namespace aikido {
 namespace distance {
 
@@ -30,5 +33,27 @@ double SO3Angular::distance(
       mStateSpace->getQuaternion(state2));
 }
 
+//==============================================================================
+double SO3Angular::distanceBounded(
+    const aikido::statespace::StateSpace::State* _state1,
+    const aikido::statespace::StateSpace::State* _state2,
+    double _bound) const
+{
+  auto state1 = static_cast<const statespace::SO3::State*>(_state1);
+  auto state2 = static_cast<const statespace::SO3::State*>(_state2);
+  const auto& quaternion1 = mStateSpace->getQuaternion(state1);
+  const auto& quaternion2 = mStateSpace->getQuaternion(state2);
+
+  // The angle is 2 acos(|q1.q2|), which is greater than the bound if the dot
+  // product is smaller than cos(bound / 2). The margin accounts for rounding.
+  if (_bound >= 0. && _bound < M_PI)
+  {
+    const double dot = std::fabs(quaternion1.dot(quaternion2));
+    if (dot < std::cos(0.5 * _bound) - 1e-9)
+      return std::numeric_limits<double>::infinity();
+  }
+  return quaternion1.angularDistance(quaternion2);
+}
+
 } // namespace distance
 } // namespace aikido
@@ -1,3 +1,5 @@
+#include <memory>
+#include <vector>
 #include <aikido/common/VanDerCorput.hpp>
 #include <aikido/constraint/Testable.hpp>
 #include <aikido/planner/PlanningResult.hpp>
@@ -25,16 +27,21 @@ trajectory::InterpolatedPtr planSnap(
   aikido::common::VanDerCorput vdc{1, true, true, 0.02}; // TODO junk resolution
   auto returnTraj
       = std::make_shared<trajectory::Interpolated>(stateSpace, interpolator);
-  auto testState = stateSpace->createState();
 
+  std::vector<double> alphas;
   for (const auto alpha : vdc)
+    alphas.emplace_back(alpha);
+
+  // Only the validity of the whole motion matters, so a parallel constraint
+  // may stop at the first state in collision found by any of its workers.
+  const auto edge = interpolator->prepare(startState, goalState);
+  const bool isSatisfied
+      = aikido::constraint::areAllSatisfied(*constraint, *edge, alphas);
+
+  if (!isSatisfied)
   {
-    interpolator->interpolate(startState, goalState, alpha, testState);
-    if (!constraint->isSatisfied(testState))
-    {
-      planningResult.message = "Collision detected";
-      return nullptr;
-    }
+    planningResult.message = "Collision detected";
+    return nullptr;
   }
 
   returnTraj->addWaypoint(0, startState);
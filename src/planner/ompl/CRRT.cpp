@@ -3,6 +3,7 @@
 #include <ompl/tools/config/SelfConfig.h>
 #include <aikido/planner/ompl/CRRT.hpp>
 #include <aikido/planner/ompl/GeometricStateSpace.hpp>
+#include <aikido/planner/ompl/NearestNeighborsKdTree.hpp>
 
 namespace aikido {
 namespace planner {
@@ -168,15 +169,42 @@ void CRRT::setup()
   ::ompl::tools::SelfConfig sc(si_, getName());
   sc.configurePlannerRange(mMaxDistance);
 
-  if (!mStartTree)
-    mStartTree.reset(new ::ompl::NearestNeighborsGNAT<Motion*>);
+  setupTree(mStartTree);
+}
+
+//==============================================================================
+void CRRT::setupTree(TreeData& tree)
+{
+  auto metric = ompl_static_pointer_cast<GeometricStateSpace>(
+                    si_->getStateSpace())
+                    ->getAikidoDistanceMetric();
+  const bool isSupported
+      = distance::NearestNeighborIndex::isSupported(*metric);
+
+  if (!tree)
+  {
+    if (isSupported)
+      tree.reset(new NearestNeighborsKdTree<Motion*>);
+    else
+      tree.reset(new ::ompl::NearestNeighborsGNAT<Motion*>);
+  }
 
-  mStartTree->setDistanceFunction(
+  tree->setDistanceFunction(
       ompl_bind(
           &CRRT::distanceFunction,
           this,
           OMPL_PLACEHOLDER(_1),
           OMPL_PLACEHOLDER(_2)));
+
+  // The kd tree computes distances on the wrapped aikido states directly.
+  auto kdTree = dynamic_cast<NearestNeighborsKdTree<Motion*>*>(tree.get());
+  if (kdTree && isSupported)
+  {
+    kdTree->setMetric(metric, [](Motion* const& motion) {
+      return static_cast<const GeometricStateSpace::StateType*>(motion->state)
+          ->mState;
+    });
+  }
 }
 
 //==============================================================================
@@ -319,6 +347,8 @@ CRRT::Motion* CRRT::constrainedExtend(
     bool& foundgoal)
 {
 
+  const auto space = si_->getStateSpace()->as<GeometricStateSpace>();
+
   // Set up the current parent motion
   Motion* cmotion = nmotion;
   dist = std::numeric_limits<double>::infinity();
@@ -390,8 +420,11 @@ CRRT::Motion* CRRT::constrainedExtend(
       // Extension failed validity check
       break;
     }
+    // The extension stops unless the distance decreases by at least
+    // mMinStepsize, so it is only needed up to that bound.
     prevDistToTarget = distToTarget;
-    distToTarget = si_->distance(cmotion->state, gstate);
+    distToTarget = space->distanceBounded(
+        cmotion->state, gstate, prevDistToTarget - mMinStepsize);
   }
 
   return bestmotion;
@@ -37,23 +37,8 @@ void CRRTConnect::setup()
   ::ompl::tools::SelfConfig sc(si_, getName());
   sc.configurePlannerRange(mMaxDistance);
 
-  if (!mStartTree)
-    mStartTree.reset(new ::ompl::NearestNeighborsGNAT<Motion*>);
-  if (!mGoalTree)
-    mGoalTree.reset(new ::ompl::NearestNeighborsGNAT<Motion*>);
-
-  mStartTree->setDistanceFunction(
-      ompl_bind(
-          &CRRTConnect::distanceFunction,
-          this,
-          OMPL_PLACEHOLDER(_1),
-          OMPL_PLACEHOLDER(_2)));
-  mGoalTree->setDistanceFunction(
-      ompl_bind(
-          &CRRTConnect::distanceFunction,
-          this,
-          OMPL_PLACEHOLDER(_1),
-          OMPL_PLACEHOLDER(_2)));
+  setupTree(mStartTree);
+  setupTree(mGoalTree);
 }
 
 //==============================================================================
@@ -207,7 +192,9 @@ double CRRTConnect::getConnectionRadius() const
     Motion* startMotion = startTree ? newmotion : lastmotion;
     Motion* goalMotion = startTree ? lastmotion : newmotion;
 
-    double treedist = si_->distance(newmotion->state, lastmotion->state);
+    double treedist
+        = si_->getStateSpace()->as<GeometricStateSpace>()->distanceBounded(
+            newmotion->state, lastmotion->state, mConnectionRadius);
     if (treedist <= mConnectionRadius)
     {
       if (treedist < 1e-6)
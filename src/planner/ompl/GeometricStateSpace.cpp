@@ -1,8 +1,10 @@
+#include <limits>
 #include <dart/common/StlHelpers.hpp>
 #include <aikido/constraint/Sampleable.hpp>
 #include <aikido/planner/ompl/BackwardCompatibility.hpp>
 #include <aikido/planner/ompl/GeometricStateSpace.hpp>
 #include <aikido/planner/ompl/StateSampler.hpp>
+#include <aikido/statespace/InlineScopedState.hpp>
 
 using dart::common::make_unique;
 
@@ -115,7 +117,8 @@ void GeometricStateSpace::enforceBounds(::ompl::base::State* _state) const
   if (!state->mValid)
     throw std::invalid_argument("enforceBounds called with invalid state");
 
-  auto temporaryState = mStateSpace->createState();
+  statespace::InlineScopedState<statespace::StateSpace::StateHandle>
+      temporaryState(mStateSpace.get());
   mBoundsProjection->project(state->mState, temporaryState);
   mStateSpace->copyState(temporaryState, state->mState);
 }
@@ -151,6 +154,16 @@ void GeometricStateSpace::copyState(
 double GeometricStateSpace::distance(
     const ::ompl::base::State* _state1,
     const ::ompl::base::State* _state2) const
+{
+  return distanceBounded(
+      _state1, _state2, std::numeric_limits<double>::infinity());
+}
+
+//==============================================================================
+double GeometricStateSpace::distanceBounded(
+    const ::ompl::base::State* _state1,
+    const ::ompl::base::State* _state2,
+    double _bound) const
 {
   auto state1 = static_cast<const StateType*>(_state1);
   auto state2 = static_cast<const StateType*>(_state2);
@@ -164,7 +177,7 @@ double GeometricStateSpace::distance(
   if (!state2->mValid)
     throw std::invalid_argument("distance called with invaid state2");
 
-  return mDistance->distance(state1->mState, state2->mState);
+  return mDistance->distanceBounded(state1->mState, state2->mState, _bound);
 }
 
 //==============================================================================
@@ -177,7 +190,7 @@ bool GeometricStateSpace::equalStates(
   if (state1->mValid != state2->mValid)
     return false;
 
-  double dist = distance(_state1, _state2);
+  double dist = distanceBounded(_state1, _state2, EQUALITY_EPSILON);
   return dist < EQUALITY_EPSILON;
 }
 
@@ -205,6 +218,24 @@ void GeometricStateSpace::interpolate(
   mInterpolator->interpolate(from->mState, to->mState, _t, state->mState);
 }
 
+//==============================================================================
+statespace::EdgeInterpolationPtr GeometricStateSpace::prepareInterpolation(
+    const ::ompl::base::State* _from, const ::ompl::base::State* _to) const
+{
+  auto from = static_cast<const StateType*>(_from);
+  if (from == nullptr || from->mState == nullptr)
+    throw std::invalid_argument("interpolate called with null from state");
+  auto to = static_cast<const StateType*>(_to);
+  if (to == nullptr || to->mState == nullptr)
+    throw std::invalid_argument("interpolate called with null to state");
+  if (!from->mValid)
+    throw std::invalid_argument("interpolate called with invalid from state");
+  if (!to->mValid)
+    throw std::invalid_argument("interpolate called with invalid to state");
+
+  return mInterpolator->prepare(from->mState, to->mState);
+}
+
 //==============================================================================
 ::ompl::base::StateSamplerPtr GeometricStateSpace::allocDefaultStateSampler()
     const
@@ -251,6 +282,12 @@ statespace::StateSpacePtr GeometricStateSpace::getAikidoStateSpace() const
 {
   return mStateSpace;
 }
+
+//==============================================================================
+distance::DistanceMetricPtr GeometricStateSpace::getAikidoDistanceMetric() const
+{
+  return mDistance;
+}
 }
 }
 }
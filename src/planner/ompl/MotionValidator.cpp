@@ -1,17 +1,36 @@
 #include <aikido/planner/ompl/MotionValidator.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <ompl/base/SpaceInformation.h>
 #include <aikido/common/StepSequence.hpp>
 #include <aikido/common/VanDerCorput.hpp>
+#include <aikido/planner/ompl/GeometricStateSpace.hpp>
+#include <aikido/planner/ompl/StateValidityChecker.hpp>
 
 namespace aikido {
 namespace planner {
 namespace ompl {
+namespace {
+
+/// Maximum number of states of a segment that are interpolated and tested
+/// together. Times are usually in VanDerCorput order, so the first chunk
+/// already covers the whole segment coarsely.
+constexpr std::size_t MAX_CHUNK_SIZE = 32;
+
+} // namespace
+
 MotionValidator::MotionValidator(
     const ::ompl::base::SpaceInformationPtr& _si,
     double _maxDistBtwValidityChecks)
   : ::ompl::base::MotionValidator(_si)
   , mSequenceResolution(_maxDistBtwValidityChecks)
+  , mCacheCapacity(0)
+  , mCacheResolution(0.0)
+  , mEnvironmentVersion(0)
+  , mNumCacheHits(0)
+  , mNumCacheMisses(0)
 {
   if (_si == nullptr)
   {
@@ -28,67 +47,468 @@ MotionValidator::MotionValidator(
 bool MotionValidator::checkMotion(
     const ::ompl::base::State* _s1, const ::ompl::base::State* _s2) const
 {
-  double dist = si_->distance(_s1, _s2);
-  aikido::common::VanDerCorput vdc{1,
-                                   true,
-                                   true, // include endpoints
-                                   mSequenceResolution / dist};
+  CacheKey key;
+  const auto environmentVersion = mEnvironmentVersion.load();
+  if (mCacheCapacity > 0)
+  {
+    key = computeCacheKey(_s1, _s2);
+
+    CacheEntry entry;
+    if (findCacheEntry(key, false, entry))
+      return entry.mValid;
+  }
+
+  bool valid;
+  double lastValidTime;
+  if (mClearanceConstraint)
+  {
+    valid = checkMotionConservatively(_s1, _s2, lastValidTime);
+  }
+  else
+  {
+    double dist = si_->distance(_s1, _s2);
+    aikido::common::VanDerCorput vdc{1,
+                                     true,
+                                     true, // include endpoints
+                                     mSequenceResolution / dist};
+
+    std::vector<double> times;
+    for (double t : vdc)
+      times.emplace_back(t);
+
+    valid = areAllStatesValid(_s1, _s2, times);
+    lastValidTime = valid ? 1.0 : -1.0;
+  }
+
+  if (mCacheCapacity > 0)
+  {
+    insertCacheEntry(
+        std::move(key),
+        CacheEntry{valid, lastValidTime},
+        environmentVersion);
+  }
+
+  return valid;
+}
+
+bool MotionValidator::checkMotion(
+    const ::ompl::base::State* _s1,
+    const ::ompl::base::State* _s2,
+    std::pair<::ompl::base::State*, double>& _lastValid) const
+{
+  CacheKey key;
+  const auto environmentVersion = mEnvironmentVersion.load();
+  if (mCacheCapacity > 0)
+  {
+    key = computeCacheKey(_s1, _s2);
+
+    CacheEntry entry;
+    if (findCacheEntry(key, true, entry))
+    {
+      _lastValid.second = entry.mLastValidTime;
+      if (_lastValid.first)
+      {
+        si_->getStateSpace()->interpolate(
+            _s1, _s2, _lastValid.second, _lastValid.first);
+      }
+      return entry.mValid;
+    }
+  }
+
+  bool valid;
+  double lastValidTime;
+  if (mClearanceConstraint)
+  {
+    valid = checkMotionConservatively(_s1, _s2, lastValidTime);
+  }
+  else
+  {
+    double dist = si_->distance(_s1, _s2);
+
+    // Allocate a sequence that steps from 0 to 1 by a stepsize that ensures
+    // no more than mSequenceResolution of distance between successive points
+    aikido::common::StepSequence seq(
+        mSequenceResolution / dist,
+        true); // include endpoints
+
+    std::vector<double> times;
+    for (double t : seq)
+      times.emplace_back(t);
+
+    const auto firstInvalid = findFirstInvalidState(_s1, _s2, times);
+    valid = firstInvalid == times.size();
+    lastValidTime = firstInvalid > 0 ? times[firstInvalid - 1] : 0.0;
+  }
+
+  if (mCacheCapacity > 0)
+  {
+    insertCacheEntry(
+        std::move(key),
+        CacheEntry{valid, lastValidTime},
+        environmentVersion);
+  }
+
+  // Copy the last valid time and value into the return value
+  _lastValid.second = lastValidTime;
+  if (_lastValid.first)
+  {
+    si_->getStateSpace()->interpolate(
+        _s1, _s2, _lastValid.second, _lastValid.first);
+  }
+
+  return valid;
+}
+
+void MotionValidator::setCache(std::size_t _capacity, double _resolution)
+{
+  if (_capacity > 0)
+  {
+    if (!dynamic_cast<const GeometricStateSpace*>(si_->getStateSpace().get()))
+    {
+      throw std::invalid_argument(
+          "Segment cache requires a GeometricStateSpace.");
+    }
+
+    if (_resolution <= 0)
+    {
+      throw std::invalid_argument("Cache resolution must be positive.");
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mCacheMutex);
+  mCacheCapacity = _capacity;
+  mCacheResolution = _resolution;
+  mCacheList.clear();
+  mCacheIndex.clear();
+  mNumCacheHits = 0;
+  mNumCacheMisses = 0;
+}
+
+std::size_t MotionValidator::getCacheCapacity() const
+{
+  return mCacheCapacity;
+}
+
+void MotionValidator::clearCache()
+{
+  std::lock_guard<std::mutex> lock(mCacheMutex);
+  mCacheList.clear();
+  mCacheIndex.clear();
+}
+
+void MotionValidator::setEnvironmentVersion(std::uint64_t _version)
+{
+  std::lock_guard<std::mutex> lock(mCacheMutex);
+  if (_version == mEnvironmentVersion)
+    return;
+
+  mEnvironmentVersion = _version;
+  mCacheList.clear();
+  mCacheIndex.clear();
+}
+
+std::uint64_t MotionValidator::getEnvironmentVersion() const
+{
+  return mEnvironmentVersion;
+}
+
+void MotionValidator::setClearanceConstraint(
+    constraint::DistanceTestablePtr _constraint)
+{
+  if (_constraint)
+  {
+    auto space
+        = dynamic_cast<const GeometricStateSpace*>(si_->getStateSpace().get());
+    if (!space)
+    {
+      throw std::invalid_argument(
+          "Conservative advancement requires a GeometricStateSpace.");
+    }
+
+    if (_constraint->getStateSpace() != space->getAikidoStateSpace())
+    {
+      throw std::invalid_argument(
+          "Clearance constraint does not match StateSpace");
+    }
+
+    if (!(_constraint->getMaxDisplacementPerDistance() > 0))
+    {
+      throw std::invalid_argument(
+          "Maximum displacement per distance must be positive.");
+    }
+  }
+
+  mClearanceConstraint = std::move(_constraint);
+  clearCache();
+}
+
+constraint::DistanceTestablePtr MotionValidator::getClearanceConstraint() const
+{
+  return mClearanceConstraint;
+}
+
+std::size_t MotionValidator::getNumCacheHits() const
+{
+  std::lock_guard<std::mutex> lock(mCacheMutex);
+  return mNumCacheHits;
+}
+
+std::size_t MotionValidator::getNumCacheMisses() const
+{
+  std::lock_guard<std::mutex> lock(mCacheMutex);
+  return mNumCacheMisses;
+}
+
+std::size_t MotionValidator::CacheKeyHash::operator()(
+    const CacheKey& _key) const
+{
+  std::size_t seed = _key.size();
+  for (const auto value : _key)
+  {
+    seed ^= std::hash<std::int64_t>()(value) + 0x9e3779b9 + (seed << 6)
+            + (seed >> 2);
+  }
+  return seed;
+}
+
+auto MotionValidator::computeCacheKey(
+    const ::ompl::base::State* _s1, const ::ompl::base::State* _s2) const
+    -> CacheKey
+{
+  const auto stateSpace
+      = si_->getStateSpace()->as<GeometricStateSpace>()->getAikidoStateSpace();
+
+  CacheKey key;
+  key.reserve(2 * stateSpace->getDimension());
+
+  const double resolution = mCacheResolution;
+  Eigen::VectorXd tangent;
+  for (const auto state : {_s1, _s2})
+  {
+    stateSpace->logMap(
+        state->as<GeometricStateSpace::StateType>()->mState, tangent);
+    for (int i = 0; i < tangent.size(); ++i)
+      key.emplace_back(std::llround(tangent[i] / resolution));
+  }
+  return key;
+}
+
+bool MotionValidator::findCacheEntry(
+    const CacheKey& _key, bool _needsLastValidTime, CacheEntry& _entry) const
+{
+  std::lock_guard<std::mutex> lock(mCacheMutex);
+
+  const auto it = mCacheIndex.find(_key);
+  if (it == mCacheIndex.end()
+      || (_needsLastValidTime && it->second->second.mLastValidTime < 0))
+  {
+    ++mNumCacheMisses;
+    return false;
+  }
+
+  mCacheList.splice(mCacheList.begin(), mCacheList, it->second);
+  _entry = it->second->second;
+  ++mNumCacheHits;
+  return true;
+}
+
+void MotionValidator::insertCacheEntry(
+    CacheKey _key,
+    const CacheEntry& _entry,
+    std::uint64_t _environmentVersion) const
+{
+  std::lock_guard<std::mutex> lock(mCacheMutex);
+
+  // The cache may have been disabled, or the environment may have changed,
+  // while the segment was checked.
+  if (mCacheCapacity == 0 || _environmentVersion != mEnvironmentVersion)
+    return;
+
+  const auto it = mCacheIndex.find(_key);
+  if (it != mCacheIndex.end())
+  {
+    it->second->second = _entry;
+    mCacheList.splice(mCacheList.begin(), mCacheList, it->second);
+    return;
+  }
+
+  if (mCacheList.size() >= mCacheCapacity)
+  {
+    mCacheIndex.erase(mCacheList.back().first);
+    mCacheList.pop_back();
+  }
 
+  mCacheList.emplace_front(std::move(_key), _entry);
+  mCacheIndex.emplace(mCacheList.front().first, mCacheList.begin());
+}
+
+bool MotionValidator::checkMotionConservatively(
+    const ::ompl::base::State* _s1,
+    const ::ompl::base::State* _s2,
+    double& _lastValidTime) const
+{
   auto stateSpace = si_->getStateSpace();
-  auto iState = stateSpace->allocState();
+  const auto segment = prepareSegment(_s1, _s2);
+  const double dist = si_->distance(_s1, _s2);
+  const double maxDisplacement
+      = mClearanceConstraint->getMaxDisplacementPerDistance();
 
+  // All states within the clearance of a state, divided by the maximum
+  // displacement, are valid. Close to obstacles, the step falls back to the
+  // resolution of the sampled check so the advancement does not stall.
+  auto iState = stateSpace->allocState();
   bool valid = true;
-  for (double t : vdc)
+  _lastValidTime = 0.0;
+  for (double t = 0.0; t < 1.0;)
   {
-    stateSpace->interpolate(_s1, _s2, t, iState);
-    if (!si_->isValid(iState))
+    segment(t, iState);
+    const double clearance = mClearanceConstraint->getClearance(
+        iState->as<GeometricStateSpace::StateType>()->mState);
+    if (!(clearance > 0))
     {
       valid = false;
       break;
     }
+
+    _lastValidTime = t;
+    t += std::max(clearance / maxDisplacement, mSequenceResolution) / dist;
   }
   stateSpace->freeState(iState);
+
+  // The validity checker may test constraints other than the clearance.
+  if (valid && !si_->isValid(_s2))
+    valid = false;
+
+  if (valid)
+    _lastValidTime = 1.0;
   return valid;
 }
 
-bool MotionValidator::checkMotion(
+std::size_t MotionValidator::findFirstInvalidState(
     const ::ompl::base::State* _s1,
     const ::ompl::base::State* _s2,
-    std::pair<::ompl::base::State*, double>& _lastValid) const
+    const std::vector<double>& _times) const
+{
+  auto stateSpace = si_->getStateSpace();
+  auto checker = std::dynamic_pointer_cast<StateValidityChecker>(
+      si_->getStateValidityChecker());
+
+  if (!checker)
+  {
+    const auto segment = prepareSegment(_s1, _s2);
+    auto iState = stateSpace->allocState();
+
+    std::size_t i = 0;
+    for (; i < _times.size(); ++i)
+    {
+      segment(_times[i], iState);
+      if (!si_->isValid(iState))
+        break;
+    }
+    stateSpace->freeState(iState);
+    return i;
+  }
+
+  // Each chunk is tested with a single call, so the constraint amortizes its
+  // per-state overhead without interpolating the states after a collision.
+  std::vector<bool> valid;
+  return testStatesInChunks(
+      _s1,
+      _s2,
+      _times,
+      [&](const std::vector<const ::ompl::base::State*>& _states) {
+        checker->isValidBatch(_states, valid, true);
+        return static_cast<std::size_t>(
+            std::find(valid.begin(), valid.end(), false) - valid.begin());
+      });
+}
+
+bool MotionValidator::areAllStatesValid(
+    const ::ompl::base::State* _s1,
+    const ::ompl::base::State* _s2,
+    const std::vector<double>& _times) const
 {
-  double dist = si_->distance(_s1, _s2);
+  auto checker = std::dynamic_pointer_cast<StateValidityChecker>(
+      si_->getStateValidityChecker());
 
-  // Allocate a sequence that steps from 0 to 1 by a stepsize that ensures no
-  // more than mSequenceResolution of distance between successive points
-  aikido::common::StepSequence seq(
-      mSequenceResolution / dist,
-      true); // include endpoints
+  if (!checker)
+    return findFirstInvalidState(_s1, _s2, _times) == _times.size();
 
+  const auto firstInvalid = testStatesInChunks(
+      _s1,
+      _s2,
+      _times,
+      [&](const std::vector<const ::ompl::base::State*>& _states) {
+        return checker->areAllValid(_states) ? _states.size() : 0u;
+      });
+  return firstInvalid == _times.size();
+}
+
+std::size_t MotionValidator::testStatesInChunks(
+    const ::ompl::base::State* _s1,
+    const ::ompl::base::State* _s2,
+    const std::vector<double>& _times,
+    const std::function<
+        std::size_t(const std::vector<const ::ompl::base::State*>&)>&
+        _testChunk) const
+{
   auto stateSpace = si_->getStateSpace();
-  auto iState = stateSpace->allocState();
+  const auto segment = prepareSegment(_s1, _s2);
 
-  bool valid = true;
-  double lastValidTime = 0.0;
-  for (double t : seq)
+  const auto chunkSize = std::min(_times.size(), MAX_CHUNK_SIZE);
+  std::vector<::ompl::base::State*> buffer(chunkSize);
+  for (auto& state : buffer)
+    state = stateSpace->allocState();
+
+  std::vector<const ::ompl::base::State*> states;
+  states.reserve(chunkSize);
+
+  std::size_t firstInvalid = _times.size();
+  for (std::size_t begin = 0; begin < _times.size(); begin += chunkSize)
   {
-    stateSpace->interpolate(_s1, _s2, t, iState);
-    if (!si_->isValid(iState))
+    const auto end = std::min(begin + chunkSize, _times.size());
+
+    states.clear();
+    for (std::size_t i = begin; i < end; ++i)
     {
-      valid = false;
+      segment(_times[i], buffer[i - begin]);
+      states.emplace_back(buffer[i - begin]);
+    }
+
+    const auto firstInvalidInChunk = _testChunk(states);
+    if (firstInvalidInChunk < states.size())
+    {
+      firstInvalid = begin + firstInvalidInChunk;
       break;
     }
-    lastValidTime = t;
   }
-  stateSpace->freeState(iState);
 
-  // Copy the last valid time and value into the return value
-  _lastValid.second = lastValidTime;
-  if (_lastValid.first)
+  for (const auto state : buffer)
+    stateSpace->freeState(state);
+
+  return firstInvalid;
+}
+
+std::function<void(double, ::ompl::base::State*)>
+MotionValidator::prepareSegment(
+    const ::ompl::base::State* _s1, const ::ompl::base::State* _s2) const
+{
+  auto stateSpace = si_->getStateSpace();
+  auto geometricSpace
+      = dynamic_cast<const GeometricStateSpace*>(stateSpace.get());
+  if (!geometricSpace)
   {
-    stateSpace->interpolate(_s1, _s2, _lastValid.second, _lastValid.first);
+    return [stateSpace, _s1, _s2](double _t, ::ompl::base::State* _state) {
+      stateSpace->interpolate(_s1, _s2, _t, _state);
+    };
   }
 
-  return valid;
+  std::shared_ptr<statespace::EdgeInterpolation> edge
+      = geometricSpace->prepareInterpolation(_s1, _s2);
+  return [edge](double _t, ::ompl::base::State* _state) {
+    edge->interpolate(
+        _t, _state->as<GeometricStateSpace::StateType>()->mState);
+  };
 }
 }
 }
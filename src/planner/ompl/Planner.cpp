@@ -187,6 +187,7 @@ trajectory::InterpolatedPtr planOMPL(
           "Trajectory");
     }
 
+    returnTraj->reserve(path->getStateCount());
     for (std::size_t idx = 0; idx < path->getStateCount(); ++idx)
     {
       const auto* st
@@ -479,6 +480,7 @@ std::unique_ptr<trajectory::Interpolated> toInterpolatedTrajectory(
   auto returnInterpolated = dart::common::make_unique<trajectory::Interpolated>(
       _interpolator->getStateSpace(), std::move(_interpolator));
 
+  returnInterpolated->reserve(_path.getStateCount());
   for (std::size_t idx = 0; idx < _path.getStateCount(); ++idx)
   {
     // Note that following static_cast is guaranteed to be safe because
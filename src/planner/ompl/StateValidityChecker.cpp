@@ -35,6 +35,73 @@ bool StateValidityChecker::isValid(const ::ompl::base::State* _state) const
   return mConstraint->isSatisfied(st->mState);
 }
 
+//==============================================================================
+bool StateValidityChecker::isValidBatch(
+    const std::vector<const ::ompl::base::State*>& _states,
+    std::vector<bool>& _out,
+    bool _earlyExit) const
+{
+  _out.assign(_states.size(), false);
+
+  // States that are not wrapping a valid aikido state are invalid without
+  // testing the constraint. With _earlyExit, only the states before the
+  // first of them are tested.
+  std::vector<const statespace::StateSpace::State*> states;
+  std::vector<std::size_t> indices;
+  states.reserve(_states.size());
+  indices.reserve(_states.size());
+
+  bool allValid = true;
+  for (std::size_t i = 0; i < _states.size(); ++i)
+  {
+    auto st = static_cast<const GeometricStateSpace::StateType*>(_states[i]);
+    if (st == nullptr || st->mState == nullptr || !st->mValid)
+    {
+      allValid = false;
+      if (_earlyExit)
+        break;
+      continue;
+    }
+
+    states.emplace_back(st->mState);
+    indices.emplace_back(i);
+  }
+
+  std::vector<bool> results;
+  if (!mConstraint->isSatisfiedBatch(states, results, _earlyExit))
+    allValid = false;
+
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    // With _earlyExit, all states after the first invalid one stay false.
+    if (_earlyExit && !results[i])
+      break;
+
+    _out[indices[i]] = results[i];
+  }
+
+  return allValid;
+}
+
+//==============================================================================
+bool StateValidityChecker::areAllValid(
+    const std::vector<const ::ompl::base::State*>& _states) const
+{
+  std::vector<const statespace::StateSpace::State*> states;
+  states.reserve(_states.size());
+
+  for (const auto state : _states)
+  {
+    auto st = static_cast<const GeometricStateSpace::StateType*>(state);
+    if (st == nullptr || st->mState == nullptr || !st->mValid)
+      return false;
+
+    states.emplace_back(st->mState);
+  }
+
+  return mConstraint->areAllSatisfied(states);
+}
+
 } // namespace ompl
 } // namespace planner
 } // namespace aikido
@@ -1,6 +1,8 @@
 #include "HauserParabolicSmootherHelpers.hpp"
 #include <chrono>
 #include <cmath>
+#include <memory>
+#include <vector>
 #include <aikido/common/VanDerCorput.hpp>
 #include "Config.h"
 #include "HauserMath.h"
@@ -41,7 +43,6 @@ public:
     Eigen::VectorXd eigA = toEigen(a);
     Eigen::VectorXd eigB = toEigen(b);
 
-    auto testState = mStateSpace->createState();
     auto startState = mStateSpace->createState();
     auto goalState = mStateSpace->createState();
     mStateSpace->expMap(eigA, startState);
@@ -52,15 +53,15 @@ public:
     // thus it is no longer needed to check in SegmentFeasible()
     aikido::common::VanDerCorput vdc{1, false, false, mCheckResolution};
 
+    std::vector<double> alphas;
     for (const auto alpha : vdc)
-    {
-      mInterpolator.interpolate(startState, goalState, alpha, testState);
-      if (!mTestable->isSatisfied(testState))
-      {
-        return false;
-      }
-    }
-    return true;
+      alphas.emplace_back(alpha);
+
+    const auto edge = mInterpolator.prepare(startState, goalState);
+    const bool feasible
+        = aikido::constraint::areAllSatisfied(*mTestable, *edge, alphas);
+
+    return feasible;
   }
 
 private:
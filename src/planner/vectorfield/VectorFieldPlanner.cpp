@@ -120,6 +120,11 @@ std::unique_ptr<aikido::trajectory::Spline> planPathByVectorField(
   Eigen::VectorXd dq(numDof);
   assert(static_cast<std::size_t>(q.size()) == numDof);
 
+  // Reuse the same states for every step to avoid allocating in the loop.
+  auto currentState = _stateSpace->createState();
+  auto deltaState = _stateSpace->createState();
+  auto nextState = _stateSpace->createState();
+
   do
   {
     // Evaluate the vector field.
@@ -174,11 +179,8 @@ std::unique_ptr<aikido::trajectory::Spline> planPathByVectorField(
       knots.push_back(knot);
 
       // Take a step.
-      auto currentState = _stateSpace->createState();
       _stateSpace->convertPositionsToState(q, currentState);
-      auto deltaState = _stateSpace->createState();
       _stateSpace->convertPositionsToState(_dt * dq, deltaState);
-      auto nextState = _stateSpace->createState();
       _stateSpace->compose(currentState, deltaState, nextState);
       _stateSpace->convertStateToPositions(nextState, q);
 
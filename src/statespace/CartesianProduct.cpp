@@ -37,6 +37,12 @@ std::size_t CartesianProduct::getNumSubspaces() const
   return mSubspaces.size();
 }
 
+//==============================================================================
+std::size_t CartesianProduct::getSubStateOffset(std::size_t _index) const
+{
+  return mOffsets[_index];
+}
+
 //==============================================================================
 std::size_t CartesianProduct::getStateSizeInBytes() const
 {
@@ -190,6 +196,97 @@ void CartesianProduct::logMap(
   }
 }
 
+//==============================================================================
+void CartesianProduct::composeBatch(
+    const StateSpace::State* _states1,
+    std::size_t _stride1,
+    const StateSpace::State* _states2,
+    std::size_t _stride2,
+    StateSpace::State* _out,
+    std::size_t _strideOut,
+    std::size_t _numStates) const
+{
+  auto states1 = reinterpret_cast<const char*>(_states1);
+  auto states2 = reinterpret_cast<const char*>(_states2);
+  auto out = reinterpret_cast<char*>(_out);
+
+  // Each substate is at the same offset in every state of the array, so the
+  // substates form arrays with the same strides.
+  for (std::size_t i = 0; i < mSubspaces.size(); ++i)
+  {
+    mSubspaces[i]->composeBatch(
+        reinterpret_cast<const StateSpace::State*>(states1 + mOffsets[i]),
+        _stride1,
+        reinterpret_cast<const StateSpace::State*>(states2 + mOffsets[i]),
+        _stride2,
+        reinterpret_cast<StateSpace::State*>(out + mOffsets[i]),
+        _strideOut,
+        _numStates);
+  }
+}
+
+//==============================================================================
+void CartesianProduct::expMapBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+    StateSpace::State* _out,
+    std::size_t _stride) const
+{
+  auto dimension = getDimension();
+
+  // TODO: Skip these checks in release mode.
+  if (static_cast<std::size_t>(_tangents.rows()) != dimension)
+  {
+    std::stringstream msg;
+    msg << "_tangents has incorrect number of rows: expected " << dimension
+        << ", got " << _tangents.rows() << ".\n";
+    throw std::runtime_error(msg.str());
+  }
+
+  auto out = reinterpret_cast<char*>(_out);
+
+  int index = 0;
+  for (std::size_t i = 0; i < mSubspaces.size(); ++i)
+  {
+    auto dim = mSubspaces[i]->getDimension();
+    mSubspaces[i]->expMapBatch(
+        _tangents.middleRows(index, dim),
+        reinterpret_cast<StateSpace::State*>(out + mOffsets[i]),
+        _stride);
+    index += dim;
+  }
+}
+
+//==============================================================================
+void CartesianProduct::logMapBatch(
+    const StateSpace::State* _in,
+    std::size_t _stride,
+    Eigen::Ref<Eigen::MatrixXd> _tangents) const
+{
+  auto dimension = getDimension();
+
+  // TODO: Skip these checks in release mode.
+  if (static_cast<std::size_t>(_tangents.rows()) != dimension)
+  {
+    std::stringstream msg;
+    msg << "_tangents has incorrect number of rows: expected " << dimension
+        << ", got " << _tangents.rows() << ".\n";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto in = reinterpret_cast<const char*>(_in);
+
+  int index = 0;
+  for (std::size_t i = 0; i < mSubspaces.size(); ++i)
+  {
+    auto dim = mSubspaces[i]->getDimension();
+    mSubspaces[i]->logMapBatch(
+        reinterpret_cast<const StateSpace::State*>(in + mOffsets[i]),
+        _stride,
+        _tangents.middleRows(index, dim));
+    index += dim;
+  }
+}
+
 //==============================================================================
 void CartesianProduct::print(
     const StateSpace::State* _state, std::ostream& _os) const
@@ -0,0 +1,23 @@
+#include <aikido/statespace/EdgeInterpolation.hpp>
+
+namespace aikido {
+namespace statespace {
+
+//==============================================================================
+void EdgeInterpolation::interpolateBatch(
+    const Eigen::VectorXd& _alphas,
+    statespace::StateSpace::State* _out,
+    std::size_t _stride) const
+{
+  auto out = reinterpret_cast<char*>(_out);
+
+  for (int i = 0; i < _alphas.size(); ++i)
+  {
+    interpolate(
+        _alphas[i],
+        reinterpret_cast<statespace::StateSpace::State*>(out + i * _stride));
+  }
+}
+
+} // namespace statespace
+} // namespace aikido
@@ -1,7 +1,141 @@
 #include <aikido/statespace/GeodesicInterpolator.hpp>
 
+#include <algorithm>
+#include <aikido/statespace/InlineScopedState.hpp>
+#include <aikido/statespace/StateArray.hpp>
+
 namespace aikido {
 namespace statespace {
+namespace {
+
+/// Maximum state space dimension for which \c GeodesicEdgeInterpolation
+/// scales its tangent vector in a stack buffer instead of on the heap.
+constexpr int MAX_INLINE_DIMENSION = 32;
+
+/// Maximum number of coefficients in the tangent vectors that
+/// \c GeodesicEdgeInterpolation::interpolateBatch stores in a stack buffer.
+constexpr std::size_t MAX_INLINE_TANGENTS_SIZE = 256;
+
+/// Geodesic whose tangent vector is computed once, when it is prepared.
+class GeodesicEdgeInterpolation : public EdgeInterpolation
+{
+public:
+  GeodesicEdgeInterpolation(
+      const StateSpace* _stateSpace,
+      const StateSpace::State* _from,
+      Eigen::VectorXd _tangentVector)
+    : mStateSpace(_stateSpace)
+    , mFrom(_from)
+    , mTangentVector(std::move(_tangentVector))
+  {
+    // Do nothing
+  }
+
+  // Documentation inherited.
+  void interpolate(double _alpha, StateSpace::State* _state) const override
+  {
+    // Scale the tangent vector in a stack buffer whenever it fits.
+    // expMapBatch accepts a map of that buffer, while expMap would require a
+    // heap-allocated Eigen::VectorXd.
+    const auto dimension = mTangentVector.size();
+    double inlineTangent[MAX_INLINE_DIMENSION];
+    Eigen::VectorXd heapTangent;
+    if (dimension > MAX_INLINE_DIMENSION)
+      heapTangent.resize(dimension);
+
+    Eigen::Map<Eigen::VectorXd> tangentVector(
+        dimension > MAX_INLINE_DIMENSION ? heapTangent.data() : inlineTangent,
+        dimension);
+    tangentVector = _alpha * mTangentVector;
+
+    // This is the hot path of Interpolated::evaluate. The relative state is
+    // created on the stack, so concurrent evaluations do not contend for a
+    // shared pool of temporary states.
+    InlineScopedState<StateSpace::StateHandle> relativeState(mStateSpace);
+    mStateSpace->expMapBatch(tangentVector, relativeState, 0);
+
+    mStateSpace->compose(mFrom, relativeState, _state);
+  }
+
+  // Documentation inherited.
+  void interpolateBatch(
+      const Eigen::VectorXd& _alphas,
+      StateSpace::State* _out,
+      std::size_t _stride) const override
+  {
+    const std::size_t numStates = _alphas.size();
+    if (numStates == 0)
+      return;
+
+    // Interpolate chunks of states whose relative states and tangent vectors
+    // fit in stack buffers, so no memory is allocated unless the state space
+    // is very large.
+    const std::size_t dimension = mTangentVector.size();
+    auto chunkSize = StateArray::getInlineCapacity(mStateSpace);
+    if (dimension > 0)
+    {
+      chunkSize = std::min(
+          chunkSize,
+          std::max<std::size_t>(MAX_INLINE_TANGENTS_SIZE / dimension, 1u));
+    }
+    chunkSize = std::min(chunkSize, numStates);
+
+    StateArray relativeStates(mStateSpace, chunkSize);
+
+    double inlineTangents[MAX_INLINE_TANGENTS_SIZE];
+    Eigen::VectorXd heapTangents;
+    if (chunkSize * dimension > MAX_INLINE_TANGENTS_SIZE)
+      heapTangents.resize(chunkSize * dimension);
+    const auto tangentsData = heapTangents.size() > 0 ? heapTangents.data()
+                                                      : inlineTangents;
+
+    for (std::size_t begin = 0; begin < numStates; begin += chunkSize)
+    {
+      const auto numChunkStates = std::min(chunkSize, numStates - begin);
+
+      Eigen::Map<Eigen::MatrixXd> tangents(
+          tangentsData, dimension, numChunkStates);
+      tangents.noalias()
+          = mTangentVector * _alphas.segment(begin, numChunkStates).transpose();
+
+      mStateSpace->expMapBatch(
+          tangents, relativeStates.getState(0), relativeStates.getStride());
+      mStateSpace->composeBatch(
+          mFrom,
+          0,
+          relativeStates.getState(0),
+          relativeStates.getStride(),
+          reinterpret_cast<StateSpace::State*>(
+              reinterpret_cast<char*>(_out) + begin * _stride),
+          _stride,
+          numChunkStates);
+    }
+  }
+
+  // Documentation inherited.
+  void getDerivative(
+      std::size_t _derivative,
+      double /*_alpha*/,
+      Eigen::VectorXd& _tangentVector) const override
+  {
+    if (_derivative == 0)
+      throw std::invalid_argument("Derivative must be greater than zero.");
+    else if (_derivative == 1)
+      _tangentVector = mTangentVector;
+    else
+    {
+      _tangentVector.resize(mStateSpace->getDimension());
+      _tangentVector.setZero();
+    }
+  }
+
+private:
+  const StateSpace* mStateSpace;
+  const StateSpace::State* mFrom;
+  Eigen::VectorXd mTangentVector;
+};
+
+} // namespace
 
 //==============================================================================
 GeodesicInterpolator::GeodesicInterpolator(
@@ -29,10 +163,10 @@ Eigen::VectorXd GeodesicInterpolator::getTangentVector(
     const statespace::StateSpace::State* _from,
     const statespace::StateSpace::State* _to) const
 {
-  const auto fromInverse = mStateSpace->createState();
+  InlineScopedState<StateSpace::StateHandle> fromInverse(mStateSpace.get());
   mStateSpace->getInverse(_from, fromInverse);
 
-  const auto toMinusFrom = mStateSpace->createState();
+  InlineScopedState<StateSpace::StateHandle> toMinusFrom(mStateSpace.get());
   mStateSpace->compose(fromInverse, _to, toMinusFrom);
 
   Eigen::VectorXd tangentVector;
@@ -48,14 +182,31 @@ void GeodesicInterpolator::interpolate(
     double _alpha,
     statespace::StateSpace::State* _out) const
 {
-  const auto tangentVector = getTangentVector(_from, _to);
+  auto tangentVector = getTangentVector(_from, _to);
+  tangentVector *= _alpha;
 
-  auto relativeState = mStateSpace->createState();
-  mStateSpace->expMap(_alpha * tangentVector, relativeState);
+  InlineScopedState<StateSpace::StateHandle> relativeState(mStateSpace.get());
+  mStateSpace->expMap(tangentVector, relativeState);
 
   mStateSpace->compose(_from, relativeState, _out);
 }
 
+//==============================================================================
+void GeodesicInterpolator::interpolateBatch(
+    const statespace::StateSpace::State* _from,
+    const statespace::StateSpace::State* _to,
+    const Eigen::VectorXd& _alphas,
+    statespace::StateSpace::State* _out,
+    std::size_t _stride) const
+{
+  if (_alphas.size() == 0)
+    return;
+
+  GeodesicEdgeInterpolation(
+      mStateSpace.get(), _from, getTangentVector(_from, _to))
+      .interpolateBatch(_alphas, _out, _stride);
+}
+
 //==============================================================================
 void GeodesicInterpolator::getDerivative(
     const statespace::StateSpace::State* _from,
@@ -75,5 +226,15 @@ void GeodesicInterpolator::getDerivative(
   }
 }
 
+//==============================================================================
+EdgeInterpolationPtr GeodesicInterpolator::prepare(
+    const statespace::StateSpace::State* _from,
+    const statespace::StateSpace::State* _to) const
+{
+  return EdgeInterpolationPtr(
+      new GeodesicEdgeInterpolation(
+          mStateSpace.get(), _from, getTangentVector(_from, _to)));
+}
+
 } // namespace statespace
 } // namespace aikido
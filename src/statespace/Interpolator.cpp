@@ -0,0 +1,84 @@
+#include <aikido/statespace/Interpolator.hpp>
+
+namespace aikido {
+namespace statespace {
+namespace {
+
+/// Path that forwards to the interpolator it was prepared by.
+class DefaultEdgeInterpolation : public EdgeInterpolation
+{
+public:
+  DefaultEdgeInterpolation(
+      const Interpolator* _interpolator,
+      const statespace::StateSpace::State* _from,
+      const statespace::StateSpace::State* _to)
+    : mInterpolator(_interpolator), mFrom(_from), mTo(_to)
+  {
+    // Do nothing
+  }
+
+  // Documentation inherited.
+  void interpolate(
+      double _alpha, statespace::StateSpace::State* _state) const override
+  {
+    mInterpolator->interpolate(mFrom, mTo, _alpha, _state);
+  }
+
+  // Documentation inherited.
+  void interpolateBatch(
+      const Eigen::VectorXd& _alphas,
+      statespace::StateSpace::State* _out,
+      std::size_t _stride) const override
+  {
+    mInterpolator->interpolateBatch(mFrom, mTo, _alphas, _out, _stride);
+  }
+
+  // Documentation inherited.
+  void getDerivative(
+      std::size_t _derivative,
+      double _alpha,
+      Eigen::VectorXd& _tangentVector) const override
+  {
+    mInterpolator->getDerivative(
+        mFrom, mTo, _derivative, _alpha, _tangentVector);
+  }
+
+private:
+  const Interpolator* mInterpolator;
+  const statespace::StateSpace::State* mFrom;
+  const statespace::StateSpace::State* mTo;
+};
+
+} // namespace
+
+//==============================================================================
+void Interpolator::interpolateBatch(
+    const statespace::StateSpace::State* _from,
+    const statespace::StateSpace::State* _to,
+    const Eigen::VectorXd& _alphas,
+    statespace::StateSpace::State* _out,
+    std::size_t _stride) const
+{
+  auto out = reinterpret_cast<char*>(_out);
+
+  for (int i = 0; i < _alphas.size(); ++i)
+  {
+    interpolate(
+        _from,
+        _to,
+        _alphas[i],
+        reinterpret_cast<statespace::StateSpace::State*>(out + i * _stride));
+  }
+}
+
+//==============================================================================
+EdgeInterpolationPtr Interpolator::prepare(
+    const statespace::StateSpace::State* _from,
+    const statespace::StateSpace::State* _to) const
+{
+  return EdgeInterpolationPtr(
+      new DefaultEdgeInterpolation(this, _from, _to));
+}
+
+} // namespace statespace
+} // namespace aikido
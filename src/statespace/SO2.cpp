@@ -167,6 +167,71 @@ void SO2::logMap(const StateSpace::State* _in, Eigen::VectorXd& _tangent) const
   _tangent(0) = getAngle(in);
 }
 
+//==============================================================================
+void SO2::composeBatch(
+    const StateSpace::State* _states1,
+    std::size_t _stride1,
+    const StateSpace::State* _states2,
+    std::size_t _stride2,
+    StateSpace::State* _out,
+    std::size_t _strideOut,
+    std::size_t _numStates) const
+{
+  auto states1 = reinterpret_cast<const char*>(_states1);
+  auto states2 = reinterpret_cast<const char*>(_states2);
+  auto out = reinterpret_cast<char*>(_out);
+
+  for (std::size_t i = 0; i < _numStates; ++i)
+  {
+    auto state1 = reinterpret_cast<const State*>(states1 + i * _stride1);
+    auto state2 = reinterpret_cast<const State*>(states2 + i * _stride2);
+    auto outState = reinterpret_cast<State*>(out + i * _strideOut);
+    outState->mAngle = state1->mAngle + state2->mAngle;
+  }
+}
+
+//==============================================================================
+void SO2::expMapBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+    StateSpace::State* _out,
+    std::size_t _stride) const
+{
+  // TODO: Skip these checks in release mode.
+  if (_tangents.rows() != 1)
+  {
+    std::stringstream msg;
+    msg << "_tangents has incorrect number of rows: expected 1"
+        << ", got " << _tangents.rows() << ".\n";
+    throw std::runtime_error(msg.str());
+  }
+
+  auto out = reinterpret_cast<char*>(_out);
+
+  for (int i = 0; i < _tangents.cols(); ++i)
+    reinterpret_cast<State*>(out + i * _stride)->mAngle = _tangents(0, i);
+}
+
+//==============================================================================
+void SO2::logMapBatch(
+    const StateSpace::State* _in,
+    std::size_t _stride,
+    Eigen::Ref<Eigen::MatrixXd> _tangents) const
+{
+  // TODO: Skip these checks in release mode.
+  if (_tangents.rows() != 1)
+  {
+    std::stringstream msg;
+    msg << "_tangents has incorrect number of rows: expected 1"
+        << ", got " << _tangents.rows() << ".\n";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto in = reinterpret_cast<const char*>(_in);
+
+  for (int i = 0; i < _tangents.cols(); ++i)
+    _tangents(0, i) = reinterpret_cast<const State*>(in + i * _stride)->mAngle;
+}
+
 //==============================================================================
 void SO2::print(const StateSpace::State* _state, std::ostream& _os) const
 {
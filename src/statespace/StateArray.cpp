@@ -0,0 +1,64 @@
+#include <aikido/statespace/StateArray.hpp>
+
+#include <algorithm>
+
+namespace aikido {
+namespace statespace {
+
+//==============================================================================
+StateArray::StateArray(const StateSpace* _stateSpace, std::size_t _size)
+  : mStateSpace(_stateSpace)
+  , mSize(_size)
+  , mStride(_stateSpace->getStateStrideInBytes())
+  , mBuffer(reinterpret_cast<char*>(&mInlineBuffer))
+{
+  if (mSize * mStride > STATE_ARRAY_BUFFER_SIZE)
+  {
+    mHeapBuffer.reset(new char[mSize * mStride]);
+    mBuffer = mHeapBuffer.get();
+  }
+
+  for (std::size_t i = 0; i < mSize; ++i)
+    mStateSpace->allocateStateInBuffer(mBuffer + i * mStride);
+}
+
+//==============================================================================
+StateArray::~StateArray()
+{
+  for (std::size_t i = mSize; i > 0; --i)
+    mStateSpace->freeStateInBuffer(getState(i - 1));
+}
+
+//==============================================================================
+std::size_t StateArray::getInlineCapacity(const StateSpace* _stateSpace)
+{
+  return std::max<std::size_t>(
+      STATE_ARRAY_BUFFER_SIZE / _stateSpace->getStateStrideInBytes(), 1u);
+}
+
+//==============================================================================
+std::size_t StateArray::getSize() const
+{
+  return mSize;
+}
+
+//==============================================================================
+std::size_t StateArray::getStride() const
+{
+  return mStride;
+}
+
+//==============================================================================
+bool StateArray::isInline() const
+{
+  return mHeapBuffer == nullptr;
+}
+
+//==============================================================================
+StateSpace::State* StateArray::getState(std::size_t _index) const
+{
+  return reinterpret_cast<StateSpace::State*>(mBuffer + _index * mStride);
+}
+
+} // namespace statespace
+} // namespace aikido
@@ -0,0 +1,101 @@
+#include <aikido/statespace/StatePool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace aikido {
+namespace statespace {
+
+//==============================================================================
+StatePool::StatePool(StateSpacePtr _stateSpace, std::size_t _blockSize)
+  : mStateSpace(std::move(_stateSpace))
+  , mBlockSize(_blockSize)
+  , mStride(0u)
+  , mCapacity(0u)
+{
+  if (!mStateSpace)
+    throw std::invalid_argument("StateSpace is null.");
+
+  if (mBlockSize == 0)
+    throw std::invalid_argument("Block size must be positive.");
+
+  mStride = mStateSpace->getStateStrideInBytes();
+}
+
+//==============================================================================
+const StateSpacePtr& StatePool::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+StateSpace::State* StatePool::acquireState()
+{
+  char* buffer;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Grow geometrically so the number of blocks stays logarithmic in the
+    // peak number of states.
+    if (mFreeBuffers.empty())
+      addBlock(std::max(mBlockSize, mCapacity));
+
+    buffer = mFreeBuffers.back();
+    mFreeBuffers.pop_back();
+  }
+
+  return mStateSpace->allocateStateInBuffer(buffer);
+}
+
+//==============================================================================
+void StatePool::releaseState(StateSpace::State* _state)
+{
+  mStateSpace->freeStateInBuffer(_state);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  mFreeBuffers.push_back(reinterpret_cast<char*>(_state));
+}
+
+//==============================================================================
+void StatePool::reserve(std::size_t _numStates)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  if (_numStates > mCapacity)
+    addBlock(_numStates - mCapacity);
+}
+
+//==============================================================================
+std::size_t StatePool::getCapacity() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mCapacity;
+}
+
+//==============================================================================
+std::size_t StatePool::getNumAvailableStates() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mFreeBuffers.size();
+}
+
+//==============================================================================
+void StatePool::addBlock(std::size_t _numStates)
+{
+  std::unique_ptr<char[]> block(new char[_numStates * mStride]);
+
+  mCapacity += _numStates;
+
+  // Reserve enough space for every state to be released at once, so that
+  // releaseState never allocates.
+  mFreeBuffers.reserve(mCapacity);
+
+  // Push in reverse order so that states are handed out in address order.
+  for (std::size_t i = _numStates; i > 0; --i)
+    mFreeBuffers.push_back(block.get() + (i - 1) * mStride);
+
+  mBlocks.emplace_back(std::move(block));
+}
+
+} // namespace statespace
+} // namespace aikido
@@ -1,18 +1,68 @@
 #include <aikido/statespace/StateSpace.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <aikido/statespace/InlineScopedState.hpp>
+
 namespace aikido {
 namespace statespace {
 
+namespace {
+
+/// Tangent vector borrowed from a buffer of the calling thread, so the default
+/// batch operations do not allocate once the buffer has the dimension of the
+/// state space. A nested batch operation finds the buffer borrowed and uses
+/// a vector of its own.
+class BorrowedTangent
+{
+public:
+  explicit BorrowedTangent(int _dimension)
+  {
+    mTangent.swap(getBuffer());
+    mTangent.resize(_dimension);
+  }
+
+  ~BorrowedTangent()
+  {
+    getBuffer().swap(mTangent);
+  }
+
+  Eigen::VectorXd& get()
+  {
+    return mTangent;
+  }
+
+private:
+  static Eigen::VectorXd& getBuffer()
+  {
+    static thread_local Eigen::VectorXd buffer;
+    return buffer;
+  }
+
+  Eigen::VectorXd mTangent;
+};
+
+} // namespace
+
 //==============================================================================
 auto StateSpace::createState() const -> ScopedState
 {
   return ScopedState(this);
 }
 
+//==============================================================================
+std::size_t StateSpace::getStateStrideInBytes() const
+{
+  constexpr std::size_t alignment = alignof(std::max_align_t);
+  const auto stateSize = std::max<std::size_t>(getStateSizeInBytes(), 1u);
+  return ((stateSize + alignment - 1) / alignment) * alignment;
+}
+
 //==============================================================================
 void StateSpace::compose(State* _state1, const State* _state2)
 {
-  auto tempState = createState();
+  InlineScopedState<StateHandle> tempState(this);
   compose(_state1, _state2, tempState);
   copyState(tempState, _state1);
 }
@@ -20,11 +70,77 @@ void StateSpace::compose(State* _state1, const State* _state2)
 //==============================================================================
 void StateSpace::getInverse(State* _state) const
 {
-  auto tempState = createState();
+  InlineScopedState<StateHandle> tempState(this);
   getInverse(_state, tempState);
   copyState(tempState, _state);
 }
 
+//==============================================================================
+void StateSpace::composeBatch(
+    const State* _states1,
+    std::size_t _stride1,
+    const State* _states2,
+    std::size_t _stride2,
+    State* _out,
+    std::size_t _strideOut,
+    std::size_t _numStates) const
+{
+  auto states1 = reinterpret_cast<const char*>(_states1);
+  auto states2 = reinterpret_cast<const char*>(_states2);
+  auto out = reinterpret_cast<char*>(_out);
+
+  for (std::size_t i = 0; i < _numStates; ++i)
+  {
+    compose(
+        reinterpret_cast<const State*>(states1 + i * _stride1),
+        reinterpret_cast<const State*>(states2 + i * _stride2),
+        reinterpret_cast<State*>(out + i * _strideOut));
+  }
+}
+
+//==============================================================================
+void StateSpace::expMapBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& _tangents,
+    State* _out,
+    std::size_t _stride) const
+{
+  auto out = reinterpret_cast<char*>(_out);
+
+  BorrowedTangent borrowedTangent(_tangents.rows());
+  auto& tangent = borrowedTangent.get();
+  for (int i = 0; i < _tangents.cols(); ++i)
+  {
+    tangent = _tangents.col(i);
+    expMap(tangent, reinterpret_cast<State*>(out + i * _stride));
+  }
+}
+
+//==============================================================================
+void StateSpace::logMapBatch(
+    const State* _in,
+    std::size_t _stride,
+    Eigen::Ref<Eigen::MatrixXd> _tangents) const
+{
+  // TODO: Skip this check in release mode.
+  if (static_cast<std::size_t>(_tangents.rows()) != getDimension())
+  {
+    std::stringstream msg;
+    msg << "_tangents has incorrect number of rows: expected "
+        << getDimension() << ", got " << _tangents.rows() << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  auto in = reinterpret_cast<const char*>(_in);
+
+  BorrowedTangent borrowedTangent(_tangents.rows());
+  auto& tangent = borrowedTangent.get();
+  for (int i = 0; i < _tangents.cols(); ++i)
+  {
+    logMap(reinterpret_cast<const State*>(in + i * _stride), tangent);
+    _tangents.col(i) = tangent;
+  }
+}
+
 //==============================================================================
 auto StateSpace::allocateState() const -> State*
 {
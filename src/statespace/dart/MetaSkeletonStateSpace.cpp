@@ -84,6 +84,26 @@ std::vector<std::shared_ptr<JointStateSpace>> createStateSpace(
   return spaces;
 }
 
+//==============================================================================
+bool isFlatJointStateSpace(const JointStateSpace& _space)
+{
+  // These subspaces store one double per DegreeOfFreedom and convert between
+  // states and positions by copying them.
+  const auto space = &_space;
+  const bool isFlatType
+      = dynamic_cast<const SO2Joint*>(space)
+        || dynamic_cast<const R0Joint*>(space)
+        || dynamic_cast<const R1Joint*>(space)
+        || dynamic_cast<const R2Joint*>(space)
+        || dynamic_cast<const R3Joint*>(space)
+        || dynamic_cast<const R6Joint*>(space)
+        || dynamic_cast<const statespace::dart::WeldJoint*>(space);
+
+  return isFlatType
+         && _space.getStateSizeInBytes()
+                == _space.getJoint()->getNumDofs() * sizeof(double);
+}
+
 } // namespace
 
 //==============================================================================
@@ -92,7 +112,33 @@ MetaSkeletonStateSpace::MetaSkeletonStateSpace(MetaSkeletonPtr _metaskeleton)
         convertVectorType<JointStateSpacePtr, StateSpacePtr>(
             createStateSpace(*_metaskeleton)))
   , mMetaSkeleton(std::move(_metaskeleton))
+  , mHasFlatLayout(true)
+  , mHasIdentityDofOrder(true)
 {
+  mDofIndices.reserve(mMetaSkeleton->getNumDofs());
+
+  for (std::size_t isubspace = 0; isubspace < getNumSubspaces(); ++isubspace)
+  {
+    const auto subspace = getSubspace<JointStateSpace>(isubspace);
+    const auto joint = subspace->getJoint();
+
+    // createStateSpace verified that every DegreeOfFreedom is present.
+    for (std::size_t idof = 0; idof < joint->getNumDofs(); ++idof)
+    {
+      const auto dofIndex
+          = mMetaSkeleton->getIndexOf(joint->getDof(idof), false);
+      if (dofIndex != mDofIndices.size())
+        mHasIdentityDofOrder = false;
+
+      mDofIndices.emplace_back(dofIndex);
+    }
+
+    if (!isFlatJointStateSpace(*subspace))
+      mHasFlatLayout = false;
+  }
+
+  if (mDofIndices.size() != mMetaSkeleton->getNumDofs())
+    mHasIdentityDofOrder = false;
 }
 
 //==============================================================================
@@ -101,6 +147,40 @@ MetaSkeletonPtr MetaSkeletonStateSpace::getMetaSkeleton() const
   return mMetaSkeleton;
 }
 
+//==============================================================================
+bool MetaSkeletonStateSpace::hasFlatLayout() const
+{
+  return mHasFlatLayout;
+}
+
+//==============================================================================
+Eigen::Map<Eigen::VectorXd> MetaSkeletonStateSpace::getFlatValues(
+    State* _state) const
+{
+  if (!mHasFlatLayout)
+    throw std::logic_error("State is not a flat array of positions.");
+
+  return Eigen::Map<Eigen::VectorXd>(
+      reinterpret_cast<double*>(_state), mDofIndices.size());
+}
+
+//==============================================================================
+Eigen::Map<const Eigen::VectorXd> MetaSkeletonStateSpace::getFlatValues(
+    const State* _state) const
+{
+  if (!mHasFlatLayout)
+    throw std::logic_error("State is not a flat array of positions.");
+
+  return Eigen::Map<const Eigen::VectorXd>(
+      reinterpret_cast<const double*>(_state), mDofIndices.size());
+}
+
+//==============================================================================
+const std::vector<std::size_t>& MetaSkeletonStateSpace::getDofIndices() const
+{
+  return mDofIndices;
+}
+
 //==============================================================================
 void MetaSkeletonStateSpace::convertPositionsToState(
     const Eigen::VectorXd& _positions, State* _state) const
@@ -109,26 +189,31 @@ void MetaSkeletonStateSpace::convertPositionsToState(
       != mMetaSkeleton->getNumDofs())
     throw std::invalid_argument("Incorrect number of positions.");
 
+  if (mHasFlatLayout)
+  {
+    auto values = getFlatValues(_state);
+
+    if (mHasIdentityDofOrder)
+    {
+      values = _positions;
+    }
+    else
+    {
+      for (std::size_t i = 0; i < mDofIndices.size(); ++i)
+        values[i] = _positions[mDofIndices[i]];
+    }
+    return;
+  }
+
+  std::size_t index = 0;
   for (std::size_t isubspace = 0; isubspace < getNumSubspaces(); ++isubspace)
   {
     const auto subspace = getSubspace<JointStateSpace>(isubspace);
-    const auto joint = subspace->getJoint();
+    const auto numJointDofs = subspace->getJoint()->getNumDofs();
 
-    // TODO: Find a more efficient way to do this mapping.
-    const auto numJointDofs = joint->getNumDofs();
     Eigen::VectorXd jointPositions(numJointDofs);
-
     for (std::size_t idof = 0; idof < numJointDofs; ++idof)
-    {
-      const auto dof = joint->getDof(idof);
-      const auto dofIndex = mMetaSkeleton->getIndexOf(dof, false);
-      if (dofIndex == INVALID_INDEX)
-        throw std::logic_error(
-            "DegreeOfFreedom is not in MetaSkeleton. This should never "
-            "happen.");
-
-      jointPositions[idof] = _positions[dofIndex];
-    }
+      jointPositions[idof] = _positions[mDofIndices[index++]];
 
     const auto substate = getSubState<>(_state, isubspace);
     subspace->convertPositionsToState(jointPositions, substate);
@@ -141,28 +226,36 @@ void MetaSkeletonStateSpace::convertStateToPositions(
 {
   _positions.resize(mMetaSkeleton->getNumDofs());
 
+  if (mHasFlatLayout)
+  {
+    const auto values = getFlatValues(_state);
+
+    if (mHasIdentityDofOrder)
+    {
+      _positions = values;
+    }
+    else
+    {
+      for (std::size_t i = 0; i < mDofIndices.size(); ++i)
+        _positions[mDofIndices[i]] = values[i];
+    }
+    return;
+  }
+
+  std::size_t index = 0;
   for (std::size_t isubspace = 0; isubspace < getNumSubspaces(); ++isubspace)
   {
     const auto subspace = getSubspace<JointStateSpace>(isubspace);
-    const auto joint = subspace->getJoint();
     const auto substate = getSubState<>(_state, isubspace);
 
     Eigen::VectorXd jointPositions;
     subspace->convertStateToPositions(substate, jointPositions);
 
-    // TODO: Find a more efficient way to do this mapping.
     for (std::size_t idof = 0;
          idof < static_cast<std::size_t>(jointPositions.size());
          ++idof)
     {
-      const auto dof = joint->getDof(idof);
-      const auto dofIndex = mMetaSkeleton->getIndexOf(dof, false);
-      if (dofIndex == INVALID_INDEX)
-        throw std::logic_error(
-            "DegreeOfFreedom is not in MetaSkeleton. This should never "
-            "happen.");
-
-      _positions[dofIndex] = jointPositions[idof];
+      _positions[mDofIndices[index++]] = jointPositions[idof];
     }
   }
 }
@@ -170,6 +263,15 @@ void MetaSkeletonStateSpace::convertStateToPositions(
 //==============================================================================
 void MetaSkeletonStateSpace::getState(State* _state) const
 {
+  if (mHasFlatLayout)
+  {
+    // Gather the positions directly to avoid a temporary vector.
+    auto values = getFlatValues(_state);
+    for (std::size_t i = 0; i < mDofIndices.size(); ++i)
+      values[i] = mMetaSkeleton->getPosition(mDofIndices[i]);
+    return;
+  }
+
   convertPositionsToState(mMetaSkeleton->getPositions(), _state);
 }
 
@@ -186,6 +288,15 @@ auto MetaSkeletonStateSpace::getScopedStateFromMetaSkeleton() const
 //==============================================================================
 void MetaSkeletonStateSpace::setState(const State* _state)
 {
+  if (mHasFlatLayout)
+  {
+    // Scatter the positions directly to avoid a temporary vector.
+    const auto values = getFlatValues(_state);
+    for (std::size_t i = 0; i < mDofIndices.size(); ++i)
+      mMetaSkeleton->setPosition(mDofIndices[i], values[i]);
+    return;
+  }
+
   Eigen::VectorXd positions;
   convertStateToPositions(_state, positions);
   mMetaSkeleton->setPositions(positions);
@@ -0,0 +1,515 @@
+#include <aikido/statespace/dart/SkeletonReplicaPool.hpp>
+
+#include <atomic>
+#include <dart/config.hpp>
+
+using ::dart::collision::CollisionDetector;
+using ::dart::collision::CollisionFilter;
+using ::dart::collision::CollisionGroup;
+using ::dart::collision::CollisionObject;
+using ::dart::collision::DistanceFilter;
+using ::dart::dynamics::BodyNode;
+using ::dart::dynamics::EndEffector;
+using ::dart::dynamics::Group;
+using ::dart::dynamics::JacobianNode;
+using ::dart::dynamics::MetaSkeletonPtr;
+using ::dart::dynamics::ShapeFrame;
+using ::dart::dynamics::Skeleton;
+using ::dart::dynamics::SkeletonPtr;
+
+namespace aikido {
+namespace statespace {
+namespace dart {
+namespace detail {
+
+//==============================================================================
+struct SkeletonReplicaStorage
+{
+  std::mutex mMutex;
+  std::vector<std::unique_ptr<SkeletonReplica>> mReplicas;
+  std::vector<SkeletonReplica*> mAvailableReplicas;
+};
+
+} // namespace detail
+
+namespace {
+
+//==============================================================================
+std::size_t createPoolId()
+{
+  static std::atomic<std::size_t> nextId(0u);
+  return nextId++;
+}
+
+//==============================================================================
+/// Replicas bound to a thread, indexed by the id of their pool. They are
+/// returned to their pools when the thread exits.
+struct ThreadReplicas
+{
+  ~ThreadReplicas()
+  {
+    for (const auto& entry : mReplicas)
+    {
+      const auto storage = entry.second.first.lock();
+      if (!storage)
+        continue;
+
+      std::lock_guard<std::mutex> lock(storage->mMutex);
+      storage->mAvailableReplicas.emplace_back(entry.second.second);
+    }
+  }
+
+  std::unordered_map<std::size_t,
+                     std::pair<std::weak_ptr<detail::SkeletonReplicaStorage>,
+                               SkeletonReplica*>>
+      mReplicas;
+};
+
+//==============================================================================
+/// Collision object of a source \c ShapeFrame. It is only passed to filters,
+/// so it has no collision engine data.
+class SourceCollisionObject : public CollisionObject
+{
+public:
+  SourceCollisionObject(
+      CollisionDetector* _collisionDetector, const ShapeFrame* _shapeFrame)
+    : CollisionObject(_collisionDetector, _shapeFrame)
+  {
+    // Do nothing.
+  }
+
+protected:
+  void updateEngineData() override
+  {
+    // Do nothing.
+  }
+};
+
+//==============================================================================
+/// Collision filter of a replica that consults the filter of the source
+/// skeletons.
+class ReplicaCollisionFilter : public CollisionFilter
+{
+public:
+  ReplicaCollisionFilter(
+      SkeletonReplica* _replica, std::shared_ptr<CollisionFilter> _sourceFilter)
+    : mReplica(_replica), mSourceFilter(std::move(_sourceFilter))
+  {
+    // Do nothing.
+  }
+
+#if DART_VERSION_AT_LEAST(6, 3, 0)
+  bool ignoresCollision(
+      const CollisionObject* _object1,
+      const CollisionObject* _object2) const override
+  {
+    return mSourceFilter->ignoresCollision(
+        mReplica->getSourceCollisionObject(_object1),
+        mReplica->getSourceCollisionObject(_object2));
+  }
+#else
+  bool needCollision(
+      const CollisionObject* _object1,
+      const CollisionObject* _object2) const override
+  {
+    return mSourceFilter->needCollision(
+        mReplica->getSourceCollisionObject(_object1),
+        mReplica->getSourceCollisionObject(_object2));
+  }
+#endif
+
+private:
+  SkeletonReplica* mReplica;
+  std::shared_ptr<CollisionFilter> mSourceFilter;
+};
+
+//==============================================================================
+/// Distance filter of a replica that consults the filter of the source
+/// skeletons.
+class ReplicaDistanceFilter : public DistanceFilter
+{
+public:
+  ReplicaDistanceFilter(
+      SkeletonReplica* _replica, std::shared_ptr<DistanceFilter> _sourceFilter)
+    : mReplica(_replica), mSourceFilter(std::move(_sourceFilter))
+  {
+    // Do nothing.
+  }
+
+  bool needDistance(
+      const CollisionObject* _object1,
+      const CollisionObject* _object2) const override
+  {
+    return mSourceFilter->needDistance(
+        mReplica->getSourceCollisionObject(_object1),
+        mReplica->getSourceCollisionObject(_object2));
+  }
+
+private:
+  SkeletonReplica* mReplica;
+  std::shared_ptr<DistanceFilter> mSourceFilter;
+};
+
+} // namespace
+
+//==============================================================================
+SkeletonReplica::SkeletonReplica(
+    const std::vector<SkeletonPtr>& _sourceSkeletons,
+    const std::vector<SkeletonPtr>& _skeletons,
+    std::mutex& _mutex)
+  : mMutex(_mutex)
+{
+  if (_sourceSkeletons.size() != _skeletons.size())
+    throw std::invalid_argument("Number of skeletons does not match.");
+
+  for (std::size_t i = 0; i < _skeletons.size(); ++i)
+  {
+    mSkeletons.emplace(_sourceSkeletons[i].get(), _skeletons[i]);
+    mSourceSkeletons.emplace(_skeletons[i].get(), _sourceSkeletons[i]);
+  }
+}
+
+//==============================================================================
+SkeletonPtr SkeletonReplica::getSkeleton(const Skeleton* _sourceSkeleton) const
+{
+  const auto it = mSkeletons.find(_sourceSkeleton);
+  if (it == mSkeletons.end())
+    throw std::invalid_argument("Skeleton is not replicated.");
+
+  return it->second;
+}
+
+//==============================================================================
+MetaSkeletonPtr SkeletonReplica::getMetaSkeleton(
+    const MetaSkeletonPtr& _sourceMetaSkeleton)
+{
+  if (!_sourceMetaSkeleton)
+    throw std::invalid_argument("MetaSkeleton is nullptr.");
+
+  const auto it = mMetaSkeletons.find(_sourceMetaSkeleton.get());
+  if (it != mMetaSkeletons.end())
+    return it->second.second;
+
+  MetaSkeletonPtr metaSkeleton;
+
+  const auto skeleton
+      = dynamic_cast<const Skeleton*>(_sourceMetaSkeleton.get());
+  if (skeleton && mSkeletons.count(skeleton))
+  {
+    metaSkeleton = getSkeleton(skeleton);
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Add each component separately to preserve the order of the Joints and
+    // DegreesOfFreedom, which determines the layout of the state space.
+    auto group = Group::create(_sourceMetaSkeleton->getName());
+
+    for (const auto bodyNode : _sourceMetaSkeleton->getBodyNodes())
+      group->addBodyNode(getBodyNode(bodyNode), false);
+
+    for (std::size_t i = 0; i < _sourceMetaSkeleton->getNumJoints(); ++i)
+    {
+      const auto joint = _sourceMetaSkeleton->getJoint(i);
+      group->addJoint(
+          getSkeleton(joint->getSkeleton().get())
+              ->getJoint(joint->getJointIndexInSkeleton()),
+          false,
+          false);
+    }
+
+    for (const auto dof : _sourceMetaSkeleton->getDofs())
+    {
+      group->addDof(
+          getSkeleton(dof->getSkeleton().get())
+              ->getDof(dof->getIndexInSkeleton()),
+          false,
+          false);
+    }
+
+    metaSkeleton = group;
+  }
+
+  mMetaSkeletons.emplace(
+      _sourceMetaSkeleton.get(),
+      std::make_pair(_sourceMetaSkeleton, metaSkeleton));
+  return metaSkeleton;
+}
+
+//==============================================================================
+MetaSkeletonStateSpacePtr SkeletonReplica::getStateSpace(
+    const MetaSkeletonStateSpacePtr& _sourceStateSpace)
+{
+  if (!_sourceStateSpace)
+    throw std::invalid_argument("StateSpace is nullptr.");
+
+  const auto it = mStateSpaces.find(_sourceStateSpace.get());
+  if (it != mStateSpaces.end())
+    return it->second.second;
+
+  auto stateSpace = std::make_shared<MetaSkeletonStateSpace>(
+      getMetaSkeleton(_sourceStateSpace->getMetaSkeleton()));
+
+  if (stateSpace->getStateSizeInBytes()
+      != _sourceStateSpace->getStateSizeInBytes())
+  {
+    throw std::logic_error(
+        "Replicated StateSpace has a different layout. This should never "
+        "happen.");
+  }
+
+  mStateSpaces.emplace(
+      _sourceStateSpace.get(), std::make_pair(_sourceStateSpace, stateSpace));
+  return stateSpace;
+}
+
+//==============================================================================
+BodyNode* SkeletonReplica::getBodyNode(const BodyNode* _sourceBodyNode) const
+{
+  if (!_sourceBodyNode)
+    throw std::invalid_argument("BodyNode is nullptr.");
+
+  return getSkeleton(_sourceBodyNode->getSkeleton().get())
+      ->getBodyNode(_sourceBodyNode->getIndexInSkeleton());
+}
+
+//==============================================================================
+JacobianNode* SkeletonReplica::getJacobianNode(
+    const JacobianNode* _sourceNode) const
+{
+  if (const auto bodyNode = dynamic_cast<const BodyNode*>(_sourceNode))
+    return getBodyNode(bodyNode);
+
+  if (const auto endEffector = dynamic_cast<const EndEffector*>(_sourceNode))
+  {
+    return getBodyNode(endEffector->getBodyNodePtr().get())
+        ->getEndEffector(endEffector->getIndexInBodyNode());
+  }
+
+  throw std::invalid_argument(
+      "JacobianNode must be a BodyNode or an EndEffector.");
+}
+
+//==============================================================================
+const ShapeFrame* SkeletonReplica::getShapeFrame(
+    const ShapeFrame* _sourceFrame) const
+{
+  const auto shapeNode = _sourceFrame->asShapeNode();
+  if (!shapeNode)
+    return _sourceFrame;
+
+  const auto bodyNode = shapeNode->getBodyNodePtr().get();
+  if (!mSkeletons.count(bodyNode->getSkeleton().get()))
+    return _sourceFrame;
+
+  return getBodyNode(bodyNode)->getShapeNode(shapeNode->getIndexInBodyNode());
+}
+
+//==============================================================================
+std::shared_ptr<CollisionDetector> SkeletonReplica::getCollisionDetector(
+    CollisionDetector* _sourceDetector)
+{
+  if (!_sourceDetector)
+    throw std::invalid_argument("CollisionDetector is nullptr.");
+
+  const auto it = mCollisionDetectors.find(_sourceDetector);
+  if (it != mCollisionDetectors.end())
+    return it->second;
+
+  std::shared_ptr<CollisionDetector> detector;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    detector = _sourceDetector->cloneWithoutCollisionObjects();
+  }
+
+  mCollisionDetectors.emplace(_sourceDetector, detector);
+  return detector;
+}
+
+//==============================================================================
+std::shared_ptr<CollisionGroup> SkeletonReplica::getCollisionGroup(
+    const std::shared_ptr<CollisionGroup>& _sourceGroup)
+{
+  if (!_sourceGroup)
+    throw std::invalid_argument("CollisionGroup is nullptr.");
+
+  const auto it = mCollisionGroups.find(_sourceGroup.get());
+  if (it != mCollisionGroups.end())
+    return it->second.second;
+
+  const auto detector
+      = getCollisionDetector(_sourceGroup->getCollisionDetector());
+
+  std::shared_ptr<CollisionGroup> group;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    group = detector->createCollisionGroup();
+    for (std::size_t i = 0; i < _sourceGroup->getNumShapeFrames(); ++i)
+      group->addShapeFrame(getShapeFrame(_sourceGroup->getShapeFrame(i)));
+  }
+
+  mCollisionGroups.emplace(
+      _sourceGroup.get(), std::make_pair(_sourceGroup, group));
+  return group;
+}
+
+//==============================================================================
+const ShapeFrame* SkeletonReplica::getSourceShapeFrame(
+    const ShapeFrame* _frame) const
+{
+  const auto shapeNode = _frame->asShapeNode();
+  if (!shapeNode)
+    return _frame;
+
+  const auto bodyNode = shapeNode->getBodyNodePtr().get();
+  const auto it = mSourceSkeletons.find(bodyNode->getSkeleton().get());
+  if (it == mSourceSkeletons.end())
+    return _frame;
+
+  return it->second->getBodyNode(bodyNode->getIndexInSkeleton())
+      ->getShapeNode(shapeNode->getIndexInBodyNode());
+}
+
+//==============================================================================
+std::shared_ptr<CollisionFilter> SkeletonReplica::getCollisionFilter(
+    const std::shared_ptr<CollisionFilter>& _sourceFilter)
+{
+  if (!_sourceFilter)
+    return nullptr;
+
+  const auto it = mCollisionFilters.find(_sourceFilter.get());
+  if (it != mCollisionFilters.end())
+    return it->second.second;
+
+  const auto filter
+      = std::make_shared<ReplicaCollisionFilter>(this, _sourceFilter);
+  mCollisionFilters.emplace(
+      _sourceFilter.get(), std::make_pair(_sourceFilter, filter));
+  return filter;
+}
+
+//==============================================================================
+std::shared_ptr<DistanceFilter> SkeletonReplica::getDistanceFilter(
+    const std::shared_ptr<DistanceFilter>& _sourceFilter)
+{
+  if (!_sourceFilter)
+    return nullptr;
+
+  const auto it = mDistanceFilters.find(_sourceFilter.get());
+  if (it != mDistanceFilters.end())
+    return it->second.second;
+
+  const auto filter
+      = std::make_shared<ReplicaDistanceFilter>(this, _sourceFilter);
+  mDistanceFilters.emplace(
+      _sourceFilter.get(), std::make_pair(_sourceFilter, filter));
+  return filter;
+}
+
+//==============================================================================
+const CollisionObject* SkeletonReplica::getSourceCollisionObject(
+    const CollisionObject* _object)
+{
+  const auto frame = _object->getShapeFrame();
+  const auto sourceFrame = getSourceShapeFrame(frame);
+  if (sourceFrame == frame)
+    return _object;
+
+  auto& sourceObject = mSourceCollisionObjects[sourceFrame];
+  if (!sourceObject)
+  {
+    sourceObject.reset(new SourceCollisionObject(
+        const_cast<CollisionObject*>(_object)->getCollisionDetector(),
+        sourceFrame));
+  }
+
+  return sourceObject.get();
+}
+
+//==============================================================================
+SkeletonReplicaPool::SkeletonReplicaPool(SkeletonPtr _skeleton)
+  : SkeletonReplicaPool(std::vector<SkeletonPtr>{std::move(_skeleton)})
+{
+  // Do nothing.
+}
+
+//==============================================================================
+SkeletonReplicaPool::SkeletonReplicaPool(std::vector<SkeletonPtr> _skeletons)
+  : mId(createPoolId())
+  , mSkeletons(std::move(_skeletons))
+  , mStorage(std::make_shared<detail::SkeletonReplicaStorage>())
+{
+  mPrototypes.reserve(mSkeletons.size());
+
+  for (const auto& skeleton : mSkeletons)
+  {
+    if (!skeleton)
+      throw std::invalid_argument("Skeleton is nullptr.");
+
+    auto prototype = skeleton->clone();
+    prototype->setPositions(skeleton->getPositions());
+    mPrototypes.emplace_back(std::move(prototype));
+  }
+}
+
+//==============================================================================
+const std::vector<SkeletonPtr>& SkeletonReplicaPool::getSkeletons() const
+{
+  return mSkeletons;
+}
+
+//==============================================================================
+SkeletonReplica& SkeletonReplicaPool::getReplica()
+{
+  static thread_local ThreadReplicas threadReplicas;
+
+  const auto it = threadReplicas.mReplicas.find(mId);
+  if (it != threadReplicas.mReplicas.end())
+    return *it->second.second;
+
+  SkeletonReplica* replica;
+  {
+    std::lock_guard<std::mutex> lock(mStorage->mMutex);
+
+    if (!mStorage->mAvailableReplicas.empty())
+    {
+      replica = mStorage->mAvailableReplicas.back();
+      mStorage->mAvailableReplicas.pop_back();
+    }
+    else
+    {
+      std::vector<SkeletonPtr> skeletons;
+      skeletons.reserve(mPrototypes.size());
+
+      for (const auto& prototype : mPrototypes)
+      {
+        auto skeleton = prototype->clone();
+        skeleton->setPositions(prototype->getPositions());
+        skeletons.emplace_back(std::move(skeleton));
+      }
+
+      mStorage->mReplicas.emplace_back(
+          new SkeletonReplica(mSkeletons, skeletons, mStorage->mMutex));
+      replica = mStorage->mReplicas.back().get();
+    }
+  }
+
+  threadReplicas.mReplicas.emplace(
+      mId,
+      std::make_pair(
+          std::weak_ptr<detail::SkeletonReplicaStorage>(mStorage), replica));
+  return *replica;
+}
+
+//==============================================================================
+std::size_t SkeletonReplicaPool::getNumReplicas() const
+{
+  std::lock_guard<std::mutex> lock(mStorage->mMutex);
+  return mStorage->mReplicas.size();
+}
+
+} // namespace dart
+} // namespace statespace
+} // namespace aikido
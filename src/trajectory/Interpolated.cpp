@@ -1,5 +1,11 @@
 #include <aikido/trajectory/Interpolated.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <aikido/statespace/StateArray.hpp>
+
 using aikido::statespace::GeodesicInterpolator;
 
 namespace aikido {
@@ -11,9 +17,23 @@ using State = aikido::statespace::StateSpace::State;
 Interpolated::Interpolated(
     aikido::statespace::StateSpacePtr _sspace,
     aikido::statespace::InterpolatorPtr _interpolator)
-  : mStateSpace(std::move(_sspace)), mInterpolator(std::move(_interpolator))
+  : mStateSpace(std::move(_sspace))
+  , mInterpolator(std::move(_interpolator))
+  , mStateStride(0u)
+  , mCapacity(0u)
+  , mWaypointHint(0)
+{
+  if (!mStateSpace)
+    throw std::invalid_argument("StateSpace is null.");
+
+  mStateStride = mStateSpace->getStateStrideInBytes();
+}
+
+//==============================================================================
+Interpolated::~Interpolated()
 {
-  // Do nothing
+  for (std::size_t i = mTimes.size(); i > 0; --i)
+    mStateSpace->freeStateInBuffer(getWaypointState(i - 1));
 }
 
 //==============================================================================
@@ -37,25 +57,25 @@ std::size_t Interpolated::getNumDerivatives() const
 //==============================================================================
 double Interpolated::getStartTime() const
 {
-  if (mWaypoints.empty())
+  if (mTimes.empty())
     throw std::domain_error("Requested getEndTime on empty trajectory.");
 
-  return mWaypoints.front().t;
+  return mTimes.front();
 }
 
 //==============================================================================
 double Interpolated::getEndTime() const
 {
-  if (mWaypoints.empty())
+  if (mTimes.empty())
     throw std::domain_error("Requested getEndTime on empty trajectory.");
 
-  return mWaypoints.back().t;
+  return mTimes.back();
 }
 
 //==============================================================================
 double Interpolated::getDuration() const
 {
-  if (!mWaypoints.empty())
+  if (!mTimes.empty())
     return getEndTime() - getStartTime();
   else
     return 0.;
@@ -64,33 +84,25 @@ double Interpolated::getDuration() const
 //==============================================================================
 void Interpolated::evaluate(double _t, State* _state) const
 {
-  if (mWaypoints.empty())
+  if (mTimes.empty())
     throw std::invalid_argument(
         "Requested trajectory point from an empty trajectory");
 
-  try
+  const auto idx = getWaypointIndexAfterTime(_t);
+  if (idx == 0)
   {
-    int idx = getWaypointIndexAfterTime(_t);
-    if (idx == 0)
-    {
-      // Time before beginning of trajectory - return first waypoint
-      mStateSpace->copyState(mWaypoints[0].state, _state);
-    }
-    else
-    {
-      Waypoint currentWpt = mWaypoints[idx];
-      Waypoint prevWpt = mWaypoints[idx - 1];
-      mInterpolator->interpolate(
-          prevWpt.state,
-          currentWpt.state,
-          (_t - prevWpt.t) / (currentWpt.t - prevWpt.t),
-          _state);
-    }
+    // Time before beginning of trajectory - return first waypoint
+    mStateSpace->copyState(getWaypointState(0), _state);
   }
-  catch (const std::domain_error& e)
+  else if (idx == mTimes.size())
   {
     // Time past end of trajectory - return last waypoint
-    mStateSpace->copyState(mWaypoints.back().state, _state);
+    mStateSpace->copyState(getWaypointState(mTimes.size() - 1), _state);
+  }
+  else
+  {
+    mEdges[idx - 1]->interpolate(
+        (_t - mTimes[idx - 1]) / (mTimes[idx] - mTimes[idx - 1]), _state);
   }
 }
 
@@ -102,63 +114,223 @@ void Interpolated::evaluateDerivative(
     throw std::invalid_argument(
         "0th derivative not available. Use evaluate(t, state).");
 
+  if (mTimes.empty())
+    throw std::invalid_argument(
+        "Requested trajectory point from an empty trajectory");
+
+  const auto idx = getWaypointIndexAfterTime(_t);
+
+  // Time before beginning or past end of trajectory - return zero
   if (static_cast<std::size_t>(_derivative)
-      > mInterpolator->getNumDerivatives())
+          > mInterpolator->getNumDerivatives()
+      || idx == 0
+      || idx == mTimes.size())
   {
     _tangentVector.resize(mStateSpace->getDimension());
     _tangentVector.setZero();
+    return;
   }
 
-  // Compute the interpolated state at time t
-  auto iPt = mStateSpace->createState();
-  evaluate(_t, iPt);
+  const auto segmentTime = mTimes[idx] - mTimes[idx - 1];
+  const auto alpha = (_t - mTimes[idx - 1]) / segmentTime;
+
+  mEdges[idx - 1]->getDerivative(_derivative, alpha, _tangentVector);
 
-  // Compute the endpoint of the segment
-  try
+  _tangentVector /= segmentTime;
+}
+
+//==============================================================================
+void Interpolated::evaluateBatch(
+    const Eigen::VectorXd& _times, Eigen::MatrixXd& _positions) const
+{
+  if (mTimes.empty())
+    throw std::invalid_argument(
+        "Requested trajectory point from an empty trajectory");
+
+  const std::size_t numStates = _times.size();
+  _positions.resize(mStateSpace->getDimension(), numStates);
+  if (numStates == 0)
+    return;
+
+  // Times are processed in chunks of times between the same pair of
+  // waypoints, so the temporary states fit in a small array that is reused.
+  statespace::StateArray states(
+      mStateSpace.get(),
+      std::min(
+          numStates,
+          statespace::StateArray::getInlineCapacity(mStateSpace.get())));
+  const auto batchSize = states.getSize();
+  const auto stride = states.getStride();
+
+  Eigen::VectorXd alphas;
+  for (std::size_t i = 0; i < numStates;)
   {
-    int idx = getWaypointIndexAfterTime(_t);
+    const auto idx = getWaypointIndexAfterTime(_times[i]);
 
-    // Time before beginning of trajectory - return 0
-    if (idx == 0)
-      throw std::domain_error("Time is before the trajectory starts.");
+    std::size_t end = i + 1;
+    if (idx == 0 || idx == mTimes.size())
+    {
+      // Time before beginning or past end of trajectory - return the first or
+      // last waypoint
+      mStateSpace->copyState(
+          idx == 0 ? getWaypointState(0) : getWaypointState(mTimes.size() - 1),
+          states.getState(0));
+    }
+    else
+    {
+      const auto prevTime = mTimes[idx - 1];
+      const auto currentTime = mTimes[idx];
 
-    const auto segmentTime = mWaypoints[idx].t - mWaypoints[idx - 1].t;
-    const auto alpha = (_t - mWaypoints[idx - 1].t) / segmentTime;
+      while (end < numStates && end - i < batchSize
+             && _times[end] > prevTime && _times[end] <= currentTime)
+        ++end;
 
-    mInterpolator->getDerivative(
-        mWaypoints[idx - 1].state,
-        mWaypoints[idx].state,
-        _derivative,
-        alpha,
-        _tangentVector);
+      alphas = (_times.segment(i, end - i).array() - prevTime)
+               / (currentTime - prevTime);
+      mEdges[idx - 1]->interpolateBatch(alphas, states.getState(0), stride);
+    }
 
-    _tangentVector /= segmentTime;
+    mStateSpace->logMapBatch(
+        states.getState(0), stride, _positions.middleCols(i, end - i));
+    i = end;
   }
-  // Time past end of trajectory - return zero
-  catch (const std::domain_error& e)
+}
+
+//==============================================================================
+void Interpolated::evaluateDerivativeBatch(
+    const Eigen::VectorXd& _times,
+    int _derivative,
+    Eigen::MatrixXd& _tangentVectors) const
+{
+  if (_derivative == 0)
+    throw std::invalid_argument(
+        "0th derivative not available. Use evaluateBatch(times, positions).");
+
+  if (mTimes.empty())
+    throw std::invalid_argument(
+        "Requested trajectory point from an empty trajectory");
+
+  _tangentVectors.resize(mStateSpace->getDimension(), _times.size());
+  if (static_cast<std::size_t>(_derivative)
+      > mInterpolator->getNumDerivatives())
   {
-    _tangentVector.resize(mStateSpace->getDimension());
-    _tangentVector.setZero();
+    _tangentVectors.setZero();
+    return;
+  }
+
+  Eigen::VectorXd tangentVector;
+  for (int i = 0; i < _times.size(); ++i)
+  {
+    const auto idx = getWaypointIndexAfterTime(_times[i]);
+
+    // Time before beginning or past end of trajectory - return zero
+    if (idx == 0 || idx == mTimes.size())
+    {
+      _tangentVectors.col(i).setZero();
+      continue;
+    }
+
+    const auto segmentTime = mTimes[idx] - mTimes[idx - 1];
+    const auto alpha = (_times[i] - mTimes[idx - 1]) / segmentTime;
+
+    mEdges[idx - 1]->getDerivative(_derivative, alpha, tangentVector);
+    _tangentVectors.col(i) = tangentVector / segmentTime;
   }
 }
 
 //==============================================================================
 void Interpolated::addWaypoint(double _t, const State* _state)
 {
-  State* state = mStateSpace->allocateState();
-  mStateSpace->copyState(_state, state);
+  const std::size_t numWaypoints = mTimes.size();
+
+  // _state may be a waypoint of this trajectory, which may be moved below, so
+  // add a copy of it instead.
+  const std::less<const char*> isBefore;
+  const auto stateBuffer = reinterpret_cast<const char*>(_state);
+  if (!isBefore(stateBuffer, mStates.get())
+      && isBefore(stateBuffer, mStates.get() + numWaypoints * mStateStride))
+  {
+    const auto state = mStateSpace->createState();
+    mStateSpace->copyState(_state, state);
+    addWaypoint(_t, state);
+    return;
+  }
 
-  // Maintain a sorted list of waypoints
-  auto it = std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t);
-  mWaypoints.insert(it, Waypoint(_t, state));
+  // Maintain a sorted list of waypoints. Waypoints added in increasing order
+  // of time are appended without moving any other waypoint.
+  std::size_t idx = numWaypoints;
+  if (numWaypoints > 0 && _t <= mTimes.back())
+  {
+    idx = std::distance(
+        mTimes.begin(), std::lower_bound(mTimes.begin(), mTimes.end(), _t));
+  }
+
+  if (numWaypoints == mCapacity)
+    reserve(std::max<std::size_t>(2 * mCapacity, 1u));
+
+  // Shift the waypoints after the new one by one slot.
+  mStateSpace->allocateStateInBuffer(getWaypointState(numWaypoints));
+  for (std::size_t i = numWaypoints; i > idx; --i)
+    mStateSpace->copyState(getWaypointState(i - 1), getWaypointState(i));
+
+  mStateSpace->copyState(_state, getWaypointState(idx));
+  mTimes.insert(mTimes.begin() + idx, _t);
+
+  // Prepare the segments that start or end at a waypoint that changed.
+  prepareEdges(idx > 0 ? idx - 1 : 0);
+}
+
+//==============================================================================
+void Interpolated::reserve(std::size_t _numWaypoints)
+{
+  if (_numWaypoints <= mCapacity)
+    return;
+
+  const std::size_t numWaypoints = mTimes.size();
+  std::unique_ptr<char[]> states(new char[_numWaypoints * mStateStride]);
+  for (std::size_t i = 0; i < numWaypoints; ++i)
+  {
+    mStateSpace->copyState(
+        getWaypointState(i),
+        mStateSpace->allocateStateInBuffer(states.get() + i * mStateStride));
+  }
+
+  for (std::size_t i = numWaypoints; i > 0; --i)
+    mStateSpace->freeStateInBuffer(getWaypointState(i - 1));
+
+  mStates = std::move(states);
+  mCapacity = _numWaypoints;
+  mTimes.reserve(_numWaypoints);
+
+  // The segments refer to the waypoints that were moved.
+  prepareEdges(0);
+}
+
+//==============================================================================
+void Interpolated::prepareEdges(std::size_t _index)
+{
+  const std::size_t numEdges = mTimes.size() > 0 ? mTimes.size() - 1 : 0;
+  mEdges.resize(numEdges);
+
+  for (std::size_t i = _index; i < numEdges; ++i)
+  {
+    mEdges[i]
+        = mInterpolator->prepare(getWaypointState(i), getWaypointState(i + 1));
+  }
+}
+
+//==============================================================================
+State* Interpolated::getWaypointState(std::size_t _index) const
+{
+  return reinterpret_cast<State*>(mStates.get() + _index * mStateStride);
 }
 
 //==============================================================================
 const statespace::StateSpace::State* Interpolated::getWaypoint(
     std::size_t _index) const
 {
-  if (_index < mWaypoints.size())
-    return mWaypoints[_index].state;
+  if (_index < mTimes.size())
+    return getWaypointState(_index);
   else
     throw std::domain_error("Waypoint index is out of bounds.");
 }
@@ -166,8 +338,8 @@ const statespace::StateSpace::State* Interpolated::getWaypoint(
 //==============================================================================
 double Interpolated::getWaypointTime(std::size_t _index) const
 {
-  if (_index < mWaypoints.size())
-    return mWaypoints[_index].t;
+  if (_index < mTimes.size())
+    return mTimes[_index];
   else
     throw std::domain_error("Waypoint index is out of bounds.");
 }
@@ -175,39 +347,37 @@ double Interpolated::getWaypointTime(std::size_t _index) const
 //==============================================================================
 std::size_t Interpolated::getNumWaypoints() const
 {
-  return mWaypoints.size();
+  return mTimes.size();
 }
 
 //==============================================================================
-int Interpolated::getWaypointIndexAfterTime(double _t) const
+std::size_t Interpolated::getWaypointIndexAfterTime(double _t) const
 {
-  auto it = std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t);
-  if (it == mWaypoints.end())
+  // Consecutive queries usually fall in the same segment or in the next one.
+  auto idx = mWaypointHint.load(std::memory_order_relaxed);
+
+  if (!isWaypointIndexAfterTime(idx, _t)
+      && !isWaypointIndexAfterTime(++idx, _t))
   {
-    throw std::domain_error(
-        "_t is larger than the time value on the last waypoint.");
+    idx = std::distance(
+        mTimes.begin(), std::lower_bound(mTimes.begin(), mTimes.end(), _t));
   }
 
-  return std::distance(mWaypoints.begin(), it);
+  mWaypointHint.store(idx, std::memory_order_relaxed);
+  return idx;
 }
 
 //==============================================================================
-Interpolated::Waypoint::Waypoint(
-    double _t, aikido::statespace::StateSpace::State* _state)
-  : t(_t), state(_state)
+bool Interpolated::isWaypointIndexAfterTime(std::size_t _index, double _t) const
 {
-}
+  const auto numWaypoints = mTimes.size();
+  if (_index > numWaypoints)
+    return false;
 
-//==============================================================================
-bool Interpolated::Waypoint::operator<(const Waypoint& rhs) const
-{
-  return t < rhs.t;
-}
+  if (_index < numWaypoints && _t > mTimes[_index])
+    return false;
 
-//==============================================================================
-bool Interpolated::Waypoint::operator<(double rhs) const
-{
-  return t < rhs;
+  return _index == 0 || _t > mTimes[_index - 1];
 }
 
 } // namespace trajectory
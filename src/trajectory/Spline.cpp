@@ -1,13 +1,26 @@
 #include <aikido/trajectory/Spline.hpp>
 
-#include <aikido/common/Spline.hpp>
+#include <algorithm>
+#include <memory>
+#include <aikido/statespace/InlineScopedState.hpp>
+#include <aikido/statespace/StateArray.hpp>
 
 namespace aikido {
 namespace trajectory {
+namespace {
+
+/// Maximum state space dimension for which \c Spline::evaluate computes the
+/// tangent vector in a stack buffer instead of on the heap.
+constexpr int MAX_INLINE_DIMENSION = 32;
+
+} // namespace
 
 //==============================================================================
 Spline::Spline(statespace::StateSpacePtr _stateSpace, double _startTime)
-  : mStateSpace(std::move(_stateSpace)), mStartTime(_startTime)
+  : mStateSpace(std::move(_stateSpace))
+  , mStartTime(_startTime)
+  , mDuration(0.)
+  , mSegmentHint(0)
 {
   if (mStateSpace == nullptr)
     throw std::invalid_argument("StateSpace is null.");
@@ -42,7 +55,25 @@ void Spline::addSegment(
   segment.mStartState = mStateSpace->allocateState();
   mStateSpace->copyState(_startState, segment.mStartState);
 
+  // The coefficient on t^j of the (d + 1)-th derivative is (j + 1) times the
+  // coefficient on t^(j + 1) of the d-th derivative.
+  const Eigen::MatrixXd* derivative = &segment.mCoefficients;
+  segment.mDerivativeCoefficients.reserve(_coefficients.cols() - 1);
+  for (auto numCoeffs = _coefficients.cols() - 1; numCoeffs > 0; --numCoeffs)
+  {
+    Eigen::MatrixXd nextDerivative(_coefficients.rows(), numCoeffs);
+    for (int icoeff = 0; icoeff < numCoeffs; ++icoeff)
+      nextDerivative.col(icoeff) = (icoeff + 1.) * derivative->col(icoeff + 1);
+
+    segment.mDerivativeCoefficients.emplace_back(std::move(nextDerivative));
+    derivative = &segment.mDerivativeCoefficients.back();
+  }
+
   mSegments.emplace_back(std::move(segment));
+  mSegmentEndTimes.emplace_back(
+      (mSegmentEndTimes.empty() ? mStartTime : mSegmentEndTimes.back())
+      + _duration);
+  mDuration += _duration;
 }
 
 //==============================================================================
@@ -102,12 +133,7 @@ double Spline::getEndTime() const
 //==============================================================================
 double Spline::getDuration() const
 {
-  double duration = 0.;
-
-  for (const auto& segment : mSegments)
-    duration += segment.mDuration;
-
-  return duration;
+  return mDuration;
 }
 
 //==============================================================================
@@ -119,15 +145,27 @@ void Spline::evaluate(double _t, statespace::StateSpace::State* _out) const
   const auto targetSegmentInfo = getSegmentForTime(_t);
   const auto& targetSegment = mSegments[targetSegmentInfo.first];
 
-  mStateSpace->copyState(targetSegment.mStartState, _out);
-
   const auto evaluationTime = _t - targetSegmentInfo.second;
-  const auto tangentVector
-      = evaluatePolynomial(targetSegment.mCoefficients, evaluationTime, 0);
 
-  const auto relativeState = mStateSpace->createState();
-  mStateSpace->expMap(tangentVector, relativeState);
-  mStateSpace->compose(_out, relativeState);
+  // Evaluate the polynomial into a stack buffer whenever the tangent vector
+  // fits. expMapBatch accepts a map of that buffer, while expMap would
+  // require a heap-allocated Eigen::VectorXd.
+  const auto dimension = targetSegment.mCoefficients.rows();
+  double inlineTangent[MAX_INLINE_DIMENSION];
+  Eigen::VectorXd heapTangent;
+  if (dimension > MAX_INLINE_DIMENSION)
+    heapTangent.resize(dimension);
+
+  Eigen::Map<Eigen::VectorXd> tangentVector(
+      dimension > MAX_INLINE_DIMENSION ? heapTangent.data() : inlineTangent,
+      dimension);
+  evaluatePolynomial(
+      targetSegment.mCoefficients, evaluationTime, tangentVector);
+
+  statespace::InlineScopedState<statespace::StateSpace::StateHandle>
+      relativeState(mStateSpace.get());
+  mStateSpace->expMapBatch(tangentVector, relativeState, 0);
+  mStateSpace->compose(targetSegment.mStartState, relativeState, _out);
 }
 
 //==============================================================================
@@ -143,63 +181,163 @@ void Spline::evaluateDerivative(
   const auto& targetSegment = mSegments[targetSegmentInfo.first];
   const auto evaluationTime = _t - targetSegmentInfo.second;
 
+  _tangentVector.resize(mStateSpace->getDimension());
+
   // Return zero for higher-order derivatives.
   if (_derivative < targetSegment.mCoefficients.cols())
   {
     // TODO: We should transform this into the body frame using the adjoint
     // transformation.
-    _tangentVector = evaluatePolynomial(
-        targetSegment.mCoefficients, evaluationTime, _derivative);
+    evaluatePolynomial(
+        targetSegment.mDerivativeCoefficients[_derivative - 1],
+        evaluationTime,
+        _tangentVector);
   }
   else
   {
-    _tangentVector.resize(mStateSpace->getDimension());
     _tangentVector.setZero();
   }
 }
 
 //==============================================================================
-std::pair<std::size_t, double> Spline::getSegmentForTime(double _t) const
+void Spline::evaluateBatch(
+    const Eigen::VectorXd& _times, Eigen::MatrixXd& _positions) const
 {
-  auto segmentStartTime = mStartTime;
+  if (mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
 
-  for (std::size_t isegment = 0; isegment < mSegments.size(); ++isegment)
+  const std::size_t numStates = _times.size();
+  _positions.resize(mStateSpace->getDimension(), numStates);
+  if (numStates == 0)
+    return;
+
+  // Times are processed in chunks of times in the same segment, so the
+  // temporary states fit in small arrays that are reused.
+  const auto batchSize = std::min(
+      numStates, statespace::StateArray::getInlineCapacity(mStateSpace.get()));
+  statespace::StateArray relativeStates(mStateSpace.get(), batchSize);
+  statespace::StateArray states(mStateSpace.get(), batchSize);
+  const auto stride = states.getStride();
+
+  // The tangent vectors are evaluated into _positions, which is overwritten
+  // by the logMaps of the composed states.
+  const auto composeStates = [&](std::size_t _segment,
+                                 std::size_t _begin,
+                                 std::size_t _end) {
+    auto positions = _positions.middleCols(_begin, _end - _begin);
+    mStateSpace->expMapBatch(positions, relativeStates.getState(0), stride);
+    mStateSpace->composeBatch(
+        mSegments[_segment].mStartState,
+        0,
+        relativeStates.getState(0),
+        stride,
+        states.getState(0),
+        stride,
+        _end - _begin);
+    mStateSpace->logMapBatch(states.getState(0), stride, positions);
+  };
+
+  std::size_t runBegin = 0;
+  std::size_t runSegment = 0;
+  for (std::size_t i = 0; i < numStates; ++i)
   {
-    const auto& segment = mSegments[isegment];
-    const auto nextSegmentStartTime = segmentStartTime + segment.mDuration;
+    const auto targetSegmentInfo = getSegmentForTime(_times[i]);
+    if (i > 0
+        && (targetSegmentInfo.first != runSegment || i - runBegin == batchSize))
+    {
+      composeStates(runSegment, runBegin, i);
+      runBegin = i;
+    }
+    runSegment = targetSegmentInfo.first;
+
+    evaluatePolynomial(
+        mSegments[runSegment].mCoefficients,
+        _times[i] - targetSegmentInfo.second,
+        _positions.col(i));
+  }
+  composeStates(runSegment, runBegin, numStates);
+}
 
-    if (_t <= nextSegmentStartTime)
-      return std::make_pair(isegment, segmentStartTime);
+//==============================================================================
+void Spline::evaluateDerivativeBatch(
+    const Eigen::VectorXd& _times,
+    int _derivative,
+    Eigen::MatrixXd& _tangentVectors) const
+{
+  if (mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+  if (_derivative < 1)
+    throw std::logic_error("Derivative must be positive.");
+
+  _tangentVectors.resize(mStateSpace->getDimension(), _times.size());
 
-    segmentStartTime = nextSegmentStartTime;
+  for (int i = 0; i < _times.size(); ++i)
+  {
+    const auto targetSegmentInfo = getSegmentForTime(_times[i]);
+    const auto& targetSegment = mSegments[targetSegmentInfo.first];
+
+    // Return zero for higher-order derivatives.
+    if (_derivative < targetSegment.mCoefficients.cols())
+    {
+      evaluatePolynomial(
+          targetSegment.mDerivativeCoefficients[_derivative - 1],
+          _times[i] - targetSegmentInfo.second,
+          _tangentVectors.col(i));
+    }
+    else
+    {
+      _tangentVectors.col(i).setZero();
+    }
   }
+}
 
-  // After the end of the last segment.
-  return std::make_pair(
-      mSegments.size() - 1, segmentStartTime - mSegments.back().mDuration);
+//==============================================================================
+std::pair<std::size_t, double> Spline::getSegmentForTime(double _t) const
+{
+  // Consecutive queries usually fall in the same segment or in the next one.
+  auto isegment = mSegmentHint.load(std::memory_order_relaxed);
+
+  if (!segmentContainsTime(isegment, _t)
+      && !segmentContainsTime(++isegment, _t))
+  {
+    // Times after the end of the last segment belong to the last segment.
+    const auto it = std::lower_bound(
+        mSegmentEndTimes.begin(), mSegmentEndTimes.end(), _t);
+    isegment = std::min<std::size_t>(
+        it - mSegmentEndTimes.begin(), mSegments.size() - 1);
+  }
+
+  mSegmentHint.store(isegment, std::memory_order_relaxed);
+
+  const auto segmentStartTime
+      = isegment == 0 ? mStartTime : mSegmentEndTimes[isegment - 1];
+  return std::make_pair(isegment, segmentStartTime);
 }
 
 //==============================================================================
-Eigen::VectorXd Spline::evaluatePolynomial(
-    const Eigen::MatrixXd& _coefficients, double _t, int _derivative)
+bool Spline::segmentContainsTime(std::size_t _index, double _t) const
 {
-  const auto numOutputs = _coefficients.rows();
-  const auto numCoeffs = _coefficients.cols();
+  const auto numSegments = mSegments.size();
+  if (_index >= numSegments)
+    return false;
 
-  const auto timeVector
-      = common::SplineProblem<>::createTimeVector(_t, _derivative, numCoeffs);
-  const auto derivativeMatrix
-      = common::SplineProblem<>::createCoefficientMatrix(numCoeffs);
-  const auto derivativeVector = derivativeMatrix.row(_derivative);
-  const auto evaluationVector
-      = derivativeVector.cwiseProduct(timeVector.transpose());
+  if (_index + 1 < numSegments && _t > mSegmentEndTimes[_index])
+    return false;
 
-  Eigen::VectorXd outputVector(numOutputs);
+  return _index == 0 || _t > mSegmentEndTimes[_index - 1];
+}
 
-  for (int ioutput = 0; ioutput < numOutputs; ++ioutput)
-    outputVector[ioutput] = _coefficients.row(ioutput).dot(evaluationVector);
+//==============================================================================
+void Spline::evaluatePolynomial(
+    const Eigen::MatrixXd& _coefficients,
+    double _t,
+    Eigen::Ref<Eigen::VectorXd> _out)
+{
+  auto icoeff = _coefficients.cols() - 1;
+  _out = _coefficients.col(icoeff);
 
-  return outputVector;
+  while (icoeff-- > 0)
+    _out = _t * _out + _coefficients.col(icoeff);
 }
 
 //==============================================================================
@@ -211,15 +349,10 @@ std::size_t Spline::getNumWaypoints() const
 //==============================================================================
 double Spline::getWaypointTime(std::size_t _index) const
 {
-  double waypointTime = mStartTime;
-
   if (_index >= getNumWaypoints())
     throw std::domain_error("Waypoint index is out of bounds.");
 
-  for (std::size_t i = 0; i < _index; ++i)
-    waypointTime += mSegments[i].mDuration;
-
-  return waypointTime;
+  return _index == 0 ? mStartTime : mSegmentEndTimes[_index - 1];
 }
 
 //==============================================================================
@@ -0,0 +1,84 @@
+#include <aikido/trajectory/Trajectory.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <aikido/common/StepSequence.hpp>
+#include <aikido/statespace/StateArray.hpp>
+
+namespace aikido {
+namespace trajectory {
+
+//==============================================================================
+void Trajectory::evaluateBatch(
+    const Eigen::VectorXd& _times, Eigen::MatrixXd& _positions) const
+{
+  const auto stateSpace = getStateSpace();
+  const std::size_t numStates = _times.size();
+  _positions.resize(stateSpace->getDimension(), numStates);
+  if (numStates == 0)
+    return;
+
+  // Evaluate chunks of states into a reused array, so each chunk is mapped to
+  // the tangent space with one call to logMapBatch.
+  statespace::StateArray states(
+      stateSpace.get(),
+      std::min(
+          numStates,
+          statespace::StateArray::getInlineCapacity(stateSpace.get())));
+  const auto chunkSize = states.getSize();
+
+  for (std::size_t begin = 0; begin < numStates; begin += chunkSize)
+  {
+    const auto numChunkStates = std::min(chunkSize, numStates - begin);
+    for (std::size_t i = 0; i < numChunkStates; ++i)
+      evaluate(_times[begin + i], states.getState(i));
+
+    stateSpace->logMapBatch(
+        states.getState(0),
+        states.getStride(),
+        _positions.middleCols(begin, numChunkStates));
+  }
+}
+
+//==============================================================================
+void Trajectory::evaluateDerivativeBatch(
+    const Eigen::VectorXd& _times,
+    int _derivative,
+    Eigen::MatrixXd& _tangentVectors) const
+{
+  _tangentVectors.resize(getStateSpace()->getDimension(), _times.size());
+
+  Eigen::VectorXd tangentVector;
+  for (int i = 0; i < _times.size(); ++i)
+  {
+    evaluateDerivative(_times[i], _derivative, tangentVector);
+    _tangentVectors.col(i) = tangentVector;
+  }
+}
+
+//==============================================================================
+Eigen::VectorXd Trajectory::sampleUniform(
+    double _timestep,
+    Eigen::MatrixXd& _positions,
+    Eigen::MatrixXd& _velocities,
+    Eigen::MatrixXd& _accelerations) const
+{
+  if (_timestep <= 0.)
+    throw std::invalid_argument("Timestep must be positive.");
+
+  common::StepSequence timeSequence(
+      _timestep, true, getStartTime(), getEndTime());
+
+  Eigen::VectorXd times(timeSequence.getMaxSteps());
+  for (int i = 0; i < times.size(); ++i)
+    times[i] = timeSequence[i];
+
+  evaluateBatch(times, _positions);
+  evaluateDerivativeBatch(times, 1, _velocities);
+  evaluateDerivativeBatch(times, 2, _accelerations);
+
+  return times;
+}
+
+} // namespace trajectory
+} // namespace aikido
@@ -0,0 +1,112 @@
+#include <atomic>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <aikido/common/ThreadPool.hpp>
+
+using aikido::common::ThreadPool;
+
+//==============================================================================
+TEST(ThreadPool, NumThreads)
+{
+  ThreadPool pool(3u);
+  EXPECT_EQ(3u, pool.getNumThreads());
+
+  ThreadPool defaultPool;
+  EXPECT_LE(1u, defaultPool.getNumThreads());
+}
+
+//==============================================================================
+TEST(ThreadPool, ReturnsResults)
+{
+  ThreadPool pool(4u);
+
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 100; ++i)
+    futures.emplace_back(pool.submit([i]() { return i * i; }));
+
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i * i, futures[i].get());
+}
+
+//==============================================================================
+TEST(ThreadPool, PropagatesExceptions)
+{
+  ThreadPool pool(1u);
+
+  auto future = pool.submit([]() { throw std::runtime_error("error"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+
+  // The worker thread keeps running after a task throws.
+  EXPECT_EQ(1, pool.submit([]() { return 1; }).get());
+}
+
+//==============================================================================
+TEST(ThreadPool, DestructorFinishesTasks)
+{
+  std::atomic<int> counter(0);
+  {
+    ThreadPool pool(2u);
+    for (int i = 0; i < 50; ++i)
+      pool.submit([&counter]() { ++counter; });
+  }
+  EXPECT_EQ(50, counter.load());
+}
+
+//==============================================================================
+TEST(ThreadPool, ParallelFor)
+{
+  ThreadPool pool(3u);
+
+  std::vector<int> values(1000, 0);
+  std::vector<int> numIndicesPerWorker(pool.getNumThreads() + 1, 0);
+  pool.parallelFor(
+      values.size(), [&](std::size_t index, std::size_t worker) {
+        values[index] = static_cast<int>(index);
+        ++numIndicesPerWorker[worker];
+      });
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    EXPECT_EQ(static_cast<int>(i), values[i]);
+
+  int numIndices = 0;
+  for (const auto count : numIndicesPerWorker)
+    numIndices += count;
+  EXPECT_EQ(1000, numIndices);
+}
+
+//==============================================================================
+TEST(ThreadPool, ParallelForFromTask)
+{
+  // Every worker thread is busy with a task that calls parallelFor, which
+  // must not wait for another worker thread to become available.
+  ThreadPool pool(2u);
+
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 2; ++i)
+  {
+    futures.emplace_back(pool.submit([&pool]() {
+      std::atomic<int> sum(0);
+      pool.parallelFor(
+          10u, [&sum](std::size_t index, std::size_t) { sum += index; });
+      return sum.load();
+    }));
+  }
+
+  for (auto& future : futures)
+    EXPECT_EQ(45, future.get());
+}
+
+//==============================================================================
+TEST(ThreadPool, ParallelForPropagatesExceptions)
+{
+  ThreadPool pool(2u);
+
+  EXPECT_THROW(
+      pool.parallelFor(
+          100u,
+          [](std::size_t index, std::size_t) {
+            if (index == 10u)
+              throw std::runtime_error("error");
+          }),
+      std::runtime_error);
+}
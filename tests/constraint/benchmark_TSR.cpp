@@ -0,0 +1,186 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <dart/common/Memory.hpp>
+#include <dart/dynamics/dynamics.hpp>
+#include <dart/math/Geometry.hpp>
+#include <aikido/constraint/FramePairDifferentiable.hpp>
+#include <aikido/constraint/LevenbergMarquardtProjectable.hpp>
+#include <aikido/constraint/NewtonsMethodProjectable.hpp>
+#include <aikido/constraint/TSR.hpp>
+#include <aikido/statespace/SE3.hpp>
+#include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
+
+// Compares the closed-form Jacobian of TSR against central finite
+// differences, both on its own and inside the projection of a pair of free
+// bodies onto a TSR with FramePairDifferentiable. The projection is timed for
+// NewtonsMethodProjectable and LevenbergMarquardtProjectable.
+
+using aikido::constraint::FramePairDifferentiable;
+using aikido::constraint::LevenbergMarquardtProjectable;
+using aikido::constraint::NewtonsMethodProjectable;
+using aikido::constraint::Projectable;
+using aikido::constraint::TSR;
+using aikido::constraint::TSRPtr;
+using aikido::statespace::SE3;
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+using dart::dynamics::BodyNode;
+using dart::dynamics::FreeJoint;
+using dart::dynamics::Skeleton;
+
+static const int NUM_JACOBIAN_ITERATIONS = 100000;
+static const int NUM_PROJECTION_ITERATIONS = 1000;
+
+//==============================================================================
+/// TSR with the finite-difference Jacobian that getJacobian used to compute.
+class NumericalTSR : public TSR
+{
+public:
+  explicit NumericalTSR(const TSR& _tsr) : TSR(_tsr)
+  {
+    // Do nothing
+  }
+
+  void getJacobian(
+      const aikido::statespace::StateSpace::State* _s,
+      Eigen::MatrixXd& _out) const override
+  {
+    static constexpr double eps = 1e-5;
+
+    const Eigen::Vector6d twist = dart::math::logMap(
+        static_cast<const SE3::State*>(_s)->getIsometry());
+    auto state = getSE3()->createState();
+
+    _out.resize(6, 6);
+    for (int i = 0; i < 6; ++i)
+    {
+      Eigen::Vector6d perturbation(Eigen::Vector6d::Zero());
+      perturbation(i) = eps;
+
+      Eigen::VectorXd positValue, negatValue;
+      state.setIsometry(dart::math::expMap(twist + perturbation));
+      getValue(state, positValue);
+      state.setIsometry(dart::math::expMap(twist - perturbation));
+      getValue(state, negatValue);
+
+      _out.col(i) = (positValue - negatValue) / (2 * eps);
+    }
+  }
+};
+
+//==============================================================================
+template <class Function>
+static double timeNanoseconds(int _numIterations, Function _function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _numIterations; ++i)
+    _function(i);
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count()
+         / _numIterations;
+}
+
+//==============================================================================
+static Eigen::Isometry3d sampleIsometry(std::default_random_engine& _engine)
+{
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+
+  Eigen::Vector6d twist;
+  for (int i = 0; i < 6; ++i)
+    twist(i) = distribution(_engine);
+
+  return dart::math::expMap(twist);
+}
+
+//==============================================================================
+static void benchmark(const std::string& _name, const TSRPtr& _tsr)
+{
+  std::default_random_engine engine(0);
+
+  // getJacobian on poses outside of the TSR.
+  auto pose = _tsr->getSE3()->createState();
+  pose.setIsometry(sampleIsometry(engine));
+
+  Eigen::MatrixXd jacobian;
+  const double jacobianTime
+      = timeNanoseconds(NUM_JACOBIAN_ITERATIONS, [&](int) {
+          _tsr->getJacobian(pose, jacobian);
+        });
+
+  // Projection of the relative pose of two free bodies onto the TSR.
+  auto skeleton = Skeleton::create("bodies");
+
+  BodyNode* bodyNodes[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    FreeJoint::Properties jointProperties;
+    jointProperties.mName = "joint" + std::to_string(i);
+
+    BodyNode::Properties bodyProperties;
+    bodyProperties.mName = "body" + std::to_string(i);
+
+    bodyNodes[i] = skeleton
+                       ->createJointAndBodyNodePair<FreeJoint>(
+                           nullptr, jointProperties, bodyProperties)
+                       .second;
+  }
+
+  auto space = std::make_shared<MetaSkeletonStateSpace>(skeleton);
+  auto differentiable = std::make_shared<FramePairDifferentiable>(
+      space, bodyNodes[0], bodyNodes[1], _tsr);
+  NewtonsMethodProjectable newtonsMethod(
+      differentiable, std::vector<double>(6, 1e-4));
+  LevenbergMarquardtProjectable levenbergMarquardt(
+      differentiable, std::vector<double>(6, 1e-4));
+
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  std::vector<Eigen::VectorXd> seeds(NUM_PROJECTION_ITERATIONS);
+  for (auto& seed : seeds)
+  {
+    seed.resize(skeleton->getNumDofs());
+    for (int i = 0; i < seed.size(); ++i)
+      seed[i] = distribution(engine);
+  }
+
+  auto seed = space->createState();
+  auto out = space->createState();
+  const auto benchmarkProjection = [&](
+      const std::string& _projectableName, const Projectable& _projectable) {
+    int numProjected = 0;
+    const double projectionTime
+        = timeNanoseconds(NUM_PROJECTION_ITERATIONS, [&](int i) {
+            space->convertPositionsToState(seeds[i], seed);
+            if (_projectable.project(seed, out))
+              ++numProjected;
+          });
+
+    std::cout << "  project (" << _projectableName << "): " << projectionTime
+              << " ns (" << numProjected << "/" << NUM_PROJECTION_ITERATIONS
+              << " projected)\n";
+  };
+
+  std::cout << _name << ":\n"
+            << "  getJacobian: " << jacobianTime << " ns\n";
+  benchmarkProjection("Newton", newtonsMethod);
+  benchmarkProjection("Levenberg-Marquardt", levenbergMarquardt);
+}
+
+//==============================================================================
+int main()
+{
+  auto tsr = dart::common::make_aligned_shared<TSR>();
+  for (int i = 0; i < 6; ++i)
+  {
+    tsr->mBw(i, 0) = -0.1;
+    tsr->mBw(i, 1) = 0.1;
+  }
+  tsr->mTw_e.translation() = Eigen::Vector3d(0., 0., 0.2);
+
+  benchmark(
+      "Finite differences",
+      dart::common::make_aligned_shared<NumericalTSR>(*tsr));
+  benchmark("Closed form", tsr);
+
+  return 0;
+}
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <dart/dart.hpp>
+#include <gtest/gtest.h>
+#include <aikido/constraint/CollisionClearance.hpp>
+#include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
+#include <aikido/statespace/dart/SkeletonReplicaPool.hpp>
+
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+using aikido::statespace::dart::MetaSkeletonStateSpacePtr;
+using aikido::statespace::dart::SkeletonReplicaPool;
+using aikido::constraint::CollisionClearance;
+
+using namespace dart::dynamics;
+using namespace dart::collision;
+
+class CollisionClearanceTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Manipulator with 1 joint
+    mManipulator = Skeleton::create("Manipulator");
+
+    RevoluteJoint::Properties properties;
+    properties.mAxis = Eigen::Vector3d::UnitY();
+    properties.mName = "Joint1";
+    auto bn1
+        = mManipulator
+              ->createJointAndBodyNodePair<RevoluteJoint>(nullptr, properties)
+              .second;
+    bn1->createShapeNodeWith<VisualAspect, CollisionAspect, DynamicsAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d(0.2, 0.2, 0.7)));
+
+    // Box
+    mBox = Skeleton::create("Box");
+    auto boxNode = mBox->createJointAndBodyNodePair<FreeJoint>().second;
+    boxNode->createShapeNodeWith<VisualAspect, CollisionAspect, DynamicsAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d(0.5, 0.5, 0.5)));
+
+    mCollisionDetector = FCLCollisionDetector::create();
+    mCollisionGroup1 = mCollisionDetector->createCollisionGroup(bn1);
+    mCollisionGroup2 = mCollisionDetector->createCollisionGroup(boxNode);
+
+    GroupPtr group = Group::create();
+    group->addBodyNode(bn1);
+    group->addBodyNode(boxNode);
+    group->addDofs(mManipulator->getDofs());
+    group->addDofs(mBox->getDofs());
+
+    mStateSpace = std::make_shared<MetaSkeletonStateSpace>(group);
+  }
+
+public:
+  SkeletonPtr mManipulator, mBox;
+  CollisionDetectorPtr mCollisionDetector;
+  std::shared_ptr<CollisionGroup> mCollisionGroup1;
+  std::shared_ptr<CollisionGroup> mCollisionGroup2;
+  MetaSkeletonStateSpacePtr mStateSpace;
+};
+
+TEST_F(CollisionClearanceTest, ConstructorThrowsOnInvalidArguments)
+{
+  EXPECT_THROW(
+      CollisionClearance(nullptr, mCollisionDetector, 1.),
+      std::invalid_argument);
+  EXPECT_THROW(
+      CollisionClearance(mStateSpace, nullptr, 1.), std::invalid_argument);
+  EXPECT_THROW(
+      CollisionClearance(mStateSpace, mCollisionDetector, 0.),
+      std::invalid_argument);
+}
+
+TEST_F(CollisionClearanceTest, EmptyCollisionGroup_IsSatisfiedReturnsTrue)
+{
+  CollisionClearance constraint(mStateSpace, mCollisionDetector, 1.);
+  EXPECT_EQ(mStateSpace, constraint.getStateSpace());
+  EXPECT_DOUBLE_EQ(1., constraint.getMaxDisplacementPerDistance());
+
+  auto state = mStateSpace->getScopedStateFromMetaSkeleton();
+  EXPECT_TRUE(std::isinf(constraint.getClearance(state)));
+  EXPECT_TRUE(constraint.isSatisfied(state));
+}
+
+TEST_F(CollisionClearanceTest, PairwiseCheck_GetClearance)
+{
+  CollisionClearance constraint(mStateSpace, mCollisionDetector, 1.);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+
+  auto state = mStateSpace->getScopedStateFromMetaSkeleton();
+
+  // The box is moved 5 along x, away from the manipulator. Both groups move
+  // with the state, so the clearance is half of their distance.
+  Eigen::VectorXd position(Eigen::VectorXd::Zero(7));
+  position(4) = 5;
+  mStateSpace->convertPositionsToState(position, state);
+  EXPECT_NEAR((5. - 0.25 - 0.1) / 2., constraint.getClearance(state), 1e-3);
+  EXPECT_TRUE(constraint.isSatisfied(state));
+
+  mStateSpace->convertPositionsToState(Eigen::VectorXd::Zero(7), state);
+  EXPECT_LE(constraint.getClearance(state), 0.);
+  EXPECT_FALSE(constraint.isSatisfied(state));
+
+  constraint.removePairwiseCheck(mCollisionGroup2, mCollisionGroup1);
+  EXPECT_TRUE(constraint.isSatisfied(state));
+}
+
+TEST_F(CollisionClearanceTest, PairwiseCheckWithStaticGroup_GetClearance)
+{
+  // Only the manipulator moves with the state, so the clearance is the full
+  // distance to the box.
+  auto stateSpace = std::make_shared<MetaSkeletonStateSpace>(mManipulator);
+  CollisionClearance constraint(stateSpace, mCollisionDetector, 1.);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+
+  mBox->setPosition(3, 5.);
+  auto state = stateSpace->getScopedStateFromMetaSkeleton();
+  EXPECT_NEAR(5. - 0.25 - 0.1, constraint.getClearance(state), 1e-3);
+}
+
+TEST_F(CollisionClearanceTest, SelfCheck_ClearanceBoundsMotionOfBothBodies)
+{
+  CollisionClearance constraint(mStateSpace, mCollisionDetector, 1.);
+  constraint.addSelfCheck(mCollisionDetector->createCollisionGroup(
+      mManipulator.get(), mBox.get()));
+
+  auto state = mStateSpace->getScopedStateFromMetaSkeleton();
+  Eigen::VectorXd position(Eigen::VectorXd::Zero(7));
+  position(4) = 5;
+  mStateSpace->convertPositionsToState(position, state);
+
+  const double clearance = constraint.getClearance(state);
+  EXPECT_NEAR((5. - 0.25 - 0.1) / 2., clearance, 1e-3);
+
+  // Rotate the manipulator towards the box while moving the box towards the
+  // manipulator, such that the state space distance is the clearance. Had
+  // the clearance been the full distance of 4.65, this state would be in
+  // collision.
+  Eigen::VectorXd otherPosition(position);
+  otherPosition(0) = 1.;
+  otherPosition(4) -= std::sqrt(clearance * clearance - 1.);
+  ASSERT_NEAR(
+      clearance / constraint.getMaxDisplacementPerDistance(),
+      (otherPosition - position).norm(),
+      1e-9);
+
+  auto otherState = mStateSpace->getScopedStateFromMetaSkeleton();
+  mStateSpace->convertPositionsToState(otherPosition, otherState);
+  EXPECT_TRUE(constraint.isSatisfied(otherState));
+}
+
+TEST_F(CollisionClearanceTest, SkeletonReplicaPool_GetClearanceConcurrently)
+{
+  CollisionClearance constraint(mStateSpace, mCollisionDetector, 1.);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  constraint.setSkeletonReplicaPool(
+      std::make_shared<SkeletonReplicaPool>(
+          std::vector<SkeletonPtr>{mManipulator, mBox}));
+
+  auto collisionState = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(
+      Eigen::VectorXd::Zero(7), collisionState);
+
+  auto freeState = mStateSpace->createState();
+  Eigen::VectorXd position(Eigen::VectorXd::Zero(7));
+  position(4) = 5;
+  mStateSpace->convertPositionsToState(position, freeState);
+
+  const Eigen::VectorXd initialPositions = mBox->getPositions();
+
+  double maxCollisionClearance = -std::numeric_limits<double>::infinity();
+  double minFreeClearance = std::numeric_limits<double>::infinity();
+  std::thread collisionThread([&]() {
+    for (int i = 0; i < 100; ++i)
+    {
+      maxCollisionClearance = std::max(
+          maxCollisionClearance, constraint.getClearance(collisionState));
+    }
+  });
+  std::thread freeThread([&]() {
+    for (int i = 0; i < 100; ++i)
+    {
+      minFreeClearance
+          = std::min(minFreeClearance, constraint.getClearance(freeState));
+    }
+  });
+  collisionThread.join();
+  freeThread.join();
+
+  EXPECT_LE(maxCollisionClearance, 0.);
+  EXPECT_NEAR((5. - 0.25 - 0.1) / 2., minFreeClearance, 1e-3);
+  EXPECT_TRUE(initialPositions.isApprox(mBox->getPositions()));
+}
+
+TEST_F(CollisionClearanceTest, SkeletonReplicaPool_KeepsBlacklist)
+{
+  auto filter = std::make_shared<BodyNodeDistanceFilter>();
+  filter->addBodyNodePairToBlackList(
+      mManipulator->getBodyNode(0), mBox->getBodyNode(0));
+  DistanceOption options(false, 0., filter);
+
+  CollisionClearance serialConstraint(
+      mStateSpace, mCollisionDetector, 1., options);
+  serialConstraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+
+  CollisionClearance replicaConstraint(
+      mStateSpace, mCollisionDetector, 1., options);
+  replicaConstraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  replicaConstraint.setSkeletonReplicaPool(
+      std::make_shared<SkeletonReplicaPool>(
+          std::vector<SkeletonPtr>{mManipulator, mBox}));
+
+  // The only pair of BodyNodes is blacklisted, so neither constraint
+  // computes the distance of the colliding bodies.
+  auto state = mStateSpace->getScopedStateFromMetaSkeleton();
+  mStateSpace->convertPositionsToState(Eigen::VectorXd::Zero(7), state);
+  EXPECT_EQ(
+      serialConstraint.getClearance(state),
+      replicaConstraint.getClearance(state));
+}
@@ -1,3 +1,4 @@
+#include <thread>
 #include <dart/dart.hpp>
 #include <gtest/gtest.h>
 #include <aikido/constraint/CollisionFree.hpp>
@@ -8,6 +9,8 @@
 
 using aikido::statespace::dart::MetaSkeletonStateSpace;
 using aikido::statespace::dart::MetaSkeletonStateSpacePtr;
+using aikido::statespace::dart::SkeletonReplicaPool;
+using aikido::common::ThreadPool;
 using aikido::constraint::CollisionFree;
 using aikido::statespace::SO2;
 using aikido::statespace::SE3;
@@ -182,3 +185,250 @@ TEST_F(CollisionFreeTest, AddAndRemoveSelfCheckFails_IsSatisfied)
   constraint.removeSelfCheck(mCollisionGroup3);
   EXPECT_TRUE(constraint.isSatisfied(state));
 }
+
+TEST_F(CollisionFreeTest, SkeletonReplicaPool_IsSatisfiedConcurrently)
+{
+  CollisionFree constraint(mStateSpace, mCollisionDetector);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  constraint.setSkeletonReplicaPool(
+      std::make_shared<SkeletonReplicaPool>(
+          std::vector<SkeletonPtr>{mManipulator, mBox}));
+
+  auto collisionState = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(
+      Eigen::VectorXd::Zero(7), collisionState);
+
+  auto freeState = mStateSpace->createState();
+  Eigen::VectorXd position(Eigen::VectorXd::Zero(7));
+  position(4) = 5;
+  mStateSpace->convertPositionsToState(position, freeState);
+
+  const Eigen::VectorXd initialPositions = mBox->getPositions();
+
+  bool collisionResults = false;
+  bool freeResults = true;
+  std::thread collisionThread([&]() {
+    for (int i = 0; i < 100; ++i)
+      collisionResults |= constraint.isSatisfied(collisionState);
+  });
+  std::thread freeThread([&]() {
+    for (int i = 0; i < 100; ++i)
+      freeResults &= constraint.isSatisfied(freeState);
+  });
+  collisionThread.join();
+  freeThread.join();
+
+  EXPECT_FALSE(collisionResults);
+  EXPECT_TRUE(freeResults);
+  EXPECT_TRUE(initialPositions.isApprox(mBox->getPositions()));
+}
+
+TEST_F(CollisionFreeTest, ThreadPool_IsSatisfied)
+{
+  CollisionFree constraint(mStateSpace, mCollisionDetector);
+  constraint.addSelfCheck(mCollisionGroup1);
+  constraint.addSelfCheck(mCollisionGroup2);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  constraint.setSkeletonReplicaPool(
+      std::make_shared<SkeletonReplicaPool>(
+          std::vector<SkeletonPtr>{mManipulator, mBox}));
+  constraint.setThreadPool(std::make_shared<ThreadPool>(2u));
+
+  auto state = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(Eigen::VectorXd::Zero(7), state);
+  EXPECT_FALSE(constraint.isSatisfied(state));
+
+  Eigen::VectorXd position(Eigen::VectorXd::Zero(7));
+  position(4) = 5;
+  mStateSpace->convertPositionsToState(position, state);
+  EXPECT_TRUE(constraint.isSatisfied(state));
+}
+
+TEST_F(CollisionFreeTest, SkeletonReplicaPool_KeepsBlacklist)
+{
+  auto filter = std::make_shared<BodyNodeCollisionFilter>();
+  CollisionOption options(false, 1u, filter);
+
+  CollisionFree serialConstraint(mStateSpace, mCollisionDetector, options);
+  serialConstraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  serialConstraint.addSelfCheck(mCollisionGroup3);
+
+  CollisionFree replicaConstraint(mStateSpace, mCollisionDetector, options);
+  replicaConstraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  replicaConstraint.addSelfCheck(mCollisionGroup3);
+  replicaConstraint.setSkeletonReplicaPool(
+      std::make_shared<SkeletonReplicaPool>(
+          std::vector<SkeletonPtr>{mManipulator, mBox}));
+
+  auto state = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(Eigen::VectorXd::Zero(7), state);
+  EXPECT_FALSE(serialConstraint.isSatisfied(state));
+  EXPECT_FALSE(replicaConstraint.isSatisfied(state));
+
+  // The replicas of the blacklisted BodyNodes are ignored as well.
+  filter->addBodyNodePairToBlackList(
+      mManipulator->getBodyNode(0), mBox->getBodyNode(0));
+  EXPECT_TRUE(serialConstraint.isSatisfied(state));
+  EXPECT_TRUE(replicaConstraint.isSatisfied(state));
+}
+
+TEST_F(CollisionFreeTest, ThreadPoolWithoutSkeletonReplicaPool_Throws)
+{
+  CollisionFree constraint(mStateSpace, mCollisionDetector);
+  constraint.addSelfCheck(mCollisionGroup1);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+  constraint.setThreadPool(std::make_shared<ThreadPool>(2u));
+
+  auto state = mStateSpace->getScopedStateFromMetaSkeleton();
+  EXPECT_THROW(constraint.isSatisfied(state), std::logic_error);
+}
+
+TEST_F(CollisionFreeTest, CheckStatistics)
+{
+  CollisionFree constraint(mStateSpace, mCollisionDetector);
+  constraint.addSelfCheck(mCollisionGroup1);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup3);
+  EXPECT_FALSE(constraint.isCheckTimingEnabled());
+
+  auto state = mStateSpace->getScopedStateFromMetaSkeleton();
+  EXPECT_FALSE(constraint.isSatisfied(state));
+  EXPECT_FALSE(constraint.isSatisfied(state));
+
+  // The self-check is never evaluated since pairwise checks are evaluated
+  // first, and the pairwise check fails.
+  auto statistics = constraint.getCheckStatistics();
+  ASSERT_EQ(2u, statistics.size());
+  EXPECT_EQ(mCollisionGroup1, statistics[0].mGroup1);
+  EXPECT_EQ(nullptr, statistics[0].mGroup2);
+  EXPECT_EQ(0u, statistics[0].mNumEvaluations);
+  EXPECT_EQ(2u, statistics[1].mNumEvaluations);
+  EXPECT_EQ(2u, statistics[1].mNumCollisions);
+  EXPECT_EQ(0., statistics[1].mTotalTime.count());
+
+  constraint.setCheckTimingEnabled(true);
+  EXPECT_TRUE(constraint.isCheckTimingEnabled());
+  EXPECT_FALSE(constraint.isSatisfied(state));
+  statistics = constraint.getCheckStatistics();
+  EXPECT_EQ(3u, statistics[1].mNumEvaluations);
+  EXPECT_LT(0., statistics[1].mTotalTime.count());
+
+  constraint.resetCheckStatistics();
+  statistics = constraint.getCheckStatistics();
+  EXPECT_EQ(0u, statistics[1].mNumEvaluations);
+  EXPECT_EQ(0u, statistics[1].mNumCollisions);
+  EXPECT_EQ(0., statistics[1].mTotalTime.count());
+}
+
+TEST_F(CollisionFreeTest, AddCheck_NullGroup_Throws)
+{
+  CollisionFree constraint(mStateSpace, mCollisionDetector);
+  EXPECT_THROW(
+      constraint.addPairwiseCheck(mCollisionGroup1, nullptr),
+      std::invalid_argument);
+  EXPECT_THROW(constraint.addSelfCheck(nullptr), std::invalid_argument);
+}
+
+TEST_F(CollisionFreeTest, AdaptiveOrdering_RunsFailingCheckFirst)
+{
+  // The pairwise check with an empty group never fails, while the self-check
+  // always fails.
+  std::shared_ptr<CollisionGroup> emptyGroup
+      = mCollisionDetector->createCollisionGroup();
+  CollisionFree constraint(mStateSpace, mCollisionDetector);
+  constraint.addSelfCheck(mCollisionGroup3);
+  constraint.addPairwiseCheck(mCollisionGroup1, emptyGroup);
+
+  EXPECT_FALSE(constraint.isAdaptiveOrdering());
+  constraint.setAdaptiveOrdering(true);
+  EXPECT_TRUE(constraint.isAdaptiveOrdering());
+
+  // Both checks are evaluated in the default order until the first update of
+  // the adaptive order. Since the pairwise check never fails, it is then
+  // moved after the self-check and is no longer evaluated.
+  const auto numStates = 2 * CollisionFree::ADAPTIVE_ORDERING_PERIOD + 8;
+  auto state = mStateSpace->getScopedStateFromMetaSkeleton();
+  for (std::size_t i = 0; i < numStates; ++i)
+    EXPECT_FALSE(constraint.isSatisfied(state));
+
+  auto statistics = constraint.getCheckStatistics();
+  ASSERT_EQ(2u, statistics.size());
+  EXPECT_EQ(numStates, statistics[0].mNumEvaluations);
+  EXPECT_EQ(numStates, statistics[0].mNumCollisions);
+  EXPECT_EQ(
+      CollisionFree::ADAPTIVE_ORDERING_PERIOD, statistics[1].mNumEvaluations);
+  EXPECT_EQ(0u, statistics[1].mNumCollisions);
+
+  // Resetting the statistics restores the default order.
+  constraint.resetCheckStatistics();
+  EXPECT_FALSE(constraint.isSatisfied(state));
+  statistics = constraint.getCheckStatistics();
+  EXPECT_EQ(1u, statistics[0].mNumEvaluations);
+  EXPECT_EQ(1u, statistics[1].mNumEvaluations);
+}
+
+TEST_F(CollisionFreeTest, IsSatisfiedBatch)
+{
+  CollisionFree constraint(mStateSpace, mCollisionDetector);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+
+  auto collisionState = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(
+      Eigen::VectorXd::Zero(7), collisionState);
+
+  auto freeState = mStateSpace->createState();
+  Eigen::VectorXd position(Eigen::VectorXd::Zero(7));
+  position(4) = 5;
+  mStateSpace->convertPositionsToState(position, freeState);
+
+  const std::vector<const aikido::statespace::StateSpace::State*> states{
+      freeState, freeState, collisionState, freeState};
+  const std::vector<bool> expected{true, true, false, true};
+  const std::vector<bool> expectedEarlyExit{true, true, false, false};
+
+  std::vector<bool> results;
+  EXPECT_FALSE(constraint.isSatisfiedBatch(states, results, false));
+  EXPECT_EQ(expected, results);
+  EXPECT_FALSE(constraint.isSatisfiedBatch(states, results, true));
+  EXPECT_EQ(expectedEarlyExit, results);
+
+  constraint.setSkeletonReplicaPool(
+      std::make_shared<SkeletonReplicaPool>(
+          std::vector<SkeletonPtr>{mManipulator, mBox}));
+  constraint.setThreadPool(std::make_shared<ThreadPool>(2u));
+
+  EXPECT_FALSE(constraint.isSatisfiedBatch(states, results, false));
+  EXPECT_EQ(expected, results);
+  EXPECT_FALSE(constraint.isSatisfiedBatch(states, results, true));
+  EXPECT_EQ(expectedEarlyExit, results);
+}
+
+TEST_F(CollisionFreeTest, AreAllSatisfied)
+{
+  CollisionFree constraint(mStateSpace, mCollisionDetector);
+  constraint.addPairwiseCheck(mCollisionGroup1, mCollisionGroup2);
+
+  auto collisionState = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(
+      Eigen::VectorXd::Zero(7), collisionState);
+
+  auto freeState = mStateSpace->createState();
+  Eigen::VectorXd position(Eigen::VectorXd::Zero(7));
+  position(4) = 5;
+  mStateSpace->convertPositionsToState(position, freeState);
+
+  const std::vector<const aikido::statespace::StateSpace::State*> freeStates(
+      16, freeState);
+  auto states = freeStates;
+  states[11] = collisionState;
+
+  EXPECT_TRUE(constraint.areAllSatisfied(freeStates));
+  EXPECT_FALSE(constraint.areAllSatisfied(states));
+
+  constraint.setSkeletonReplicaPool(
+      std::make_shared<SkeletonReplicaPool>(
+          std::vector<SkeletonPtr>{mManipulator, mBox}));
+  constraint.setThreadPool(std::make_shared<ThreadPool>(2u));
+
+  EXPECT_TRUE(constraint.areAllSatisfied(freeStates));
+  EXPECT_FALSE(constraint.areAllSatisfied(states));
+}
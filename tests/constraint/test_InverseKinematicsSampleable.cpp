@@ -2,9 +2,11 @@
 #include <Eigen/Dense>
 #include <gtest/gtest.h>
 #include <aikido/common/RNG.hpp>
+#include <aikido/common/ThreadPool.hpp>
 #include <aikido/constraint/CyclicSampleable.hpp>
 #include <aikido/constraint/FiniteSampleable.hpp>
 #include <aikido/constraint/InverseKinematicsSampleable.hpp>
+#include <aikido/constraint/InverseKinematicsSeedDatabase.hpp>
 #include <aikido/constraint/TSR.hpp>
 #include <aikido/statespace/Rn.hpp>
 #include <aikido/statespace/SE3.hpp>
@@ -15,6 +17,7 @@
 using aikido::statespace::R2;
 using aikido::constraint::FiniteSampleable;
 using aikido::constraint::InverseKinematicsSampleable;
+using aikido::constraint::InverseKinematicsSeedDatabase;
 using aikido::constraint::CyclicSampleable;
 using aikido::statespace::SE3;
 using aikido::statespace::SO2;
@@ -25,6 +28,8 @@ using aikido::common::RNGWrapper;
 using aikido::common::RNG;
 using aikido::statespace::dart::MetaSkeletonStateSpace;
 using aikido::statespace::dart::MetaSkeletonStateSpacePtr;
+using aikido::statespace::dart::SkeletonReplicaPool;
+using aikido::common::ThreadPool;
 using dart::dynamics::Skeleton;
 using dart::dynamics::SkeletonPtr;
 using dart::dynamics::BodyNode;
@@ -361,3 +366,166 @@ TEST_F(InverseKinematicsSampleableTest, SampleGeneratorIkInfeasible)
   auto state = mStateSpace1->getScopedStateFromMetaSkeleton();
   ASSERT_FALSE(generator->sample(state));
 }
+
+TEST_F(InverseKinematicsSampleableTest, ThreadPool_CyclicSampleGenerator)
+{
+  // Set mTSR to be a pointTSR that generates
+  //  the only feasible solution for mInverseKinematics1.
+  Eigen::Isometry3d T0_w(Eigen::Isometry3d::Identity());
+  T0_w.translation() = Eigen::Vector3d(0, 0, 1);
+  mTsr->mT0_w = T0_w;
+
+  // Set CyclicSampleable to alternate between two seeds close to the actual
+  // solution.
+  auto seedState1 = mStateSpace1->getScopedStateFromMetaSkeleton();
+  seedState1.getSubStateHandle<SO2>(0).setAngle(0.1);
+  seedState1.getSubStateHandle<SO2>(1).setAngle(0.1);
+
+  auto seedState2 = mStateSpace1->getScopedStateFromMetaSkeleton();
+  seedState2.getSubStateHandle<SO2>(0).setAngle(-0.1);
+  seedState2.getSubStateHandle<SO2>(1).setAngle(0.2);
+
+  std::vector<const aikido::statespace::StateSpace::State*> seeds{seedState1,
+                                                                  seedState2};
+  std::shared_ptr<CyclicSampleable> seedConstraint(
+      new CyclicSampleable(
+          std::make_shared<FiniteSampleable>(mStateSpace1, seeds)));
+
+  InverseKinematicsSampleable ikConstraint(
+      mStateSpace1, mTsr, seedConstraint, mInverseKinematics1, 4);
+  ikConstraint.setSkeletonReplicaPool(
+      std::make_shared<SkeletonReplicaPool>(mManipulator1));
+  ikConstraint.setThreadPool(std::make_shared<ThreadPool>(3));
+
+  const Eigen::VectorXd positions = mManipulator1->getPositions();
+
+  auto generator = ikConstraint.createSampleGenerator();
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(generator->canSample());
+
+    auto state = mStateSpace1->createState();
+    ASSERT_TRUE(generator->sample(state));
+    EXPECT_NEAR(state.getSubStateHandle<SO2>(0).getAngle(), 0, 1e-5);
+    EXPECT_NEAR(state.getSubStateHandle<SO2>(1).getAngle(), 0, 1e-5);
+  }
+
+  // IK is solved on the replicas only.
+  EXPECT_TRUE(mManipulator1->getPositions().isApprox(positions));
+}
+
+TEST_F(InverseKinematicsSampleableTest, ThreadPool_SampleGeneratorIkInfeasible)
+{
+  // Tests that generator returns false when IK is infeasible.
+
+  bn1->getParentJoint()->setPosition(0, M_PI / 4);
+  mTsr->mT0_w = bn2->getTransform();
+
+  /// Set first joint to be a fixed joint.
+  bn1->getParentJoint()->setPositionLowerLimit(0, 0);
+  bn1->getParentJoint()->setPositionUpperLimit(0, 0);
+
+  auto seedState = mStateSpace1->getScopedStateFromMetaSkeleton();
+  seedState.getSubStateHandle<SO2>(0).setAngle(0);
+  seedState.getSubStateHandle<SO2>(1).setAngle(0.1);
+
+  std::shared_ptr<CyclicSampleable> seedConstraint(
+      new CyclicSampleable(
+          std::make_shared<FiniteSampleable>(mStateSpace1, seedState)));
+
+  InverseKinematicsSampleable ikConstraint(
+      mStateSpace1, mTsr, seedConstraint, mInverseKinematics1, 5);
+  ikConstraint.setSkeletonReplicaPool(
+      std::make_shared<SkeletonReplicaPool>(mManipulator1));
+  ikConstraint.setThreadPool(std::make_shared<ThreadPool>(2));
+
+  auto generator = ikConstraint.createSampleGenerator();
+
+  ASSERT_TRUE(generator->canSample());
+
+  auto state = mStateSpace1->getScopedStateFromMetaSkeleton();
+  ASSERT_FALSE(generator->sample(state));
+}
+
+TEST_F(
+    InverseKinematicsSampleableTest,
+    ThreadPoolWithoutSkeletonReplicaPool_Throws)
+{
+  InverseKinematicsSampleable ikConstraint(
+      mStateSpace1, mTsr, seedConstraint, mInverseKinematics1, 1);
+  ikConstraint.setThreadPool(std::make_shared<ThreadPool>(2));
+
+  EXPECT_THROW(ikConstraint.createSampleGenerator(), std::logic_error);
+}
+
+TEST_F(
+    InverseKinematicsSampleableTest, SetSeedDatabaseThrowsOnInvalidArguments)
+{
+  auto databaseSeedState = mStateSpace2->getScopedStateFromMetaSkeleton();
+  auto database = InverseKinematicsSeedDatabase::build(
+      mStateSpace2,
+      bn4,
+      std::make_shared<FiniteSampleable>(mStateSpace2, databaseSeedState),
+      1);
+
+  InverseKinematicsSampleable ikConstraint(
+      mStateSpace1, mTsr, seedConstraint, mInverseKinematics1, 1);
+
+  // The database is for a MetaSkeleton with 7 DegreesOfFreedom.
+  EXPECT_THROW(ikConstraint.setSeedDatabase(database), std::invalid_argument);
+
+  database = InverseKinematicsSeedDatabase::build(
+      mStateSpace1, bn2, seedConstraint, 1);
+  EXPECT_THROW(
+      ikConstraint.setSeedDatabase(database, 0), std::invalid_argument);
+  EXPECT_FALSE(ikConstraint.getSeedDatabase());
+
+  ikConstraint.setSeedDatabase(database);
+  EXPECT_EQ(database, ikConstraint.getSeedDatabase());
+}
+
+TEST_F(InverseKinematicsSampleableTest, SeedDatabase_SampleGenerator)
+{
+  // Set mTSR to be a pointTSR that generates
+  //  the only feasible solution for mInverseKinematics1.
+  Eigen::Isometry3d T0_w(Eigen::Isometry3d::Identity());
+  T0_w.translation() = Eigen::Vector3d(0, 0, 1);
+  mTsr->mT0_w = T0_w;
+
+  // The database contains a configuration close to the solution and one far
+  // away from it. Only the nearest configuration is used as a seed.
+  auto databaseSeedState1 = mStateSpace1->getScopedStateFromMetaSkeleton();
+  databaseSeedState1.getSubStateHandle<SO2>(0).setAngle(0.1);
+  databaseSeedState1.getSubStateHandle<SO2>(1).setAngle(-0.1);
+
+  auto databaseSeedState2 = mStateSpace1->getScopedStateFromMetaSkeleton();
+  databaseSeedState2.getSubStateHandle<SO2>(0).setAngle(2.5);
+  databaseSeedState2.getSubStateHandle<SO2>(1).setAngle(-2.);
+
+  std::vector<const aikido::statespace::StateSpace::State*> databaseSeeds{
+      databaseSeedState1, databaseSeedState2};
+  auto database = InverseKinematicsSeedDatabase::build(
+      mStateSpace1,
+      bn2,
+      std::make_shared<FiniteSampleable>(mStateSpace1, databaseSeeds),
+      2);
+  ASSERT_EQ(2u, database->getNumEntries());
+
+  // The seed constraint is not used with a seed database.
+  InverseKinematicsSampleable ikConstraint(
+      mStateSpace1, mTsr, seedConstraint, mInverseKinematics1, 1);
+  ikConstraint.setSeedDatabase(database);
+
+  auto generator = ikConstraint.createSampleGenerator();
+  ASSERT_EQ(generator->getNumSamples(), SampleGenerator::NO_LIMIT);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(generator->canSample());
+
+    auto state = mStateSpace1->createState();
+    ASSERT_TRUE(generator->sample(state));
+    EXPECT_NEAR(state.getSubStateHandle<SO2>(0).getAngle(), 0, 1e-5);
+    EXPECT_NEAR(state.getSubStateHandle<SO2>(1).getAngle(), 0, 1e-5);
+  }
+}
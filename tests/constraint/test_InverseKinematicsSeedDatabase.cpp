@@ -0,0 +1,256 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+#include <aikido/constraint/FiniteSampleable.hpp>
+#include <aikido/constraint/InverseKinematicsSeedDatabase.hpp>
+
+using aikido::constraint::FiniteSampleable;
+using aikido::constraint::InverseKinematicsSeedDatabase;
+using aikido::statespace::StateSpace;
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+using aikido::statespace::dart::MetaSkeletonStateSpacePtr;
+using dart::dynamics::BodyNode;
+using dart::dynamics::BodyNodePtr;
+using dart::dynamics::RevoluteJoint;
+using dart::dynamics::Skeleton;
+using dart::dynamics::SkeletonPtr;
+
+class InverseKinematicsSeedDatabaseTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Manipulator with 2 revolute joints.
+    mManipulator = Skeleton::create("Manipulator");
+
+    RevoluteJoint::Properties properties1;
+    properties1.mAxis = Eigen::Vector3d::UnitY();
+    properties1.mName = "Joint1";
+
+    BodyNode::Properties bodyProperties1;
+    bodyProperties1.mName = "root_body";
+
+    mBodyNode1 = mManipulator
+                     ->createJointAndBodyNodePair<RevoluteJoint>(
+                         nullptr, properties1, bodyProperties1)
+                     .second;
+
+    RevoluteJoint::Properties properties2;
+    properties2.mAxis = Eigen::Vector3d::UnitY();
+    properties2.mName = "Joint2";
+    properties2.mT_ParentBodyToJoint.translation() = Eigen::Vector3d(0, 0, 1);
+
+    BodyNode::Properties bodyProperties2;
+    bodyProperties2.mName = "second_body";
+
+    mBodyNode2 = mManipulator
+                     ->createJointAndBodyNodePair<RevoluteJoint>(
+                         mBodyNode1, properties2, bodyProperties2)
+                     .second;
+
+    mStateSpace = std::make_shared<MetaSkeletonStateSpace>(mManipulator);
+
+    // Configurations on a grid.
+    for (int i = -5; i <= 5; ++i)
+    {
+      for (int j = -5; j <= 5; ++j)
+        mConfigurations.emplace_back(Eigen::Vector2d(0.3 * i, 0.3 * j));
+    }
+
+    std::vector<const StateSpace::State*> configurations;
+    for (const auto& positions : mConfigurations)
+    {
+      auto state = mStateSpace->allocateState();
+      mStateSpace->convertPositionsToState(positions, state);
+      configurations.emplace_back(state);
+    }
+
+    mConfigurationConstraint
+        = std::make_shared<FiniteSampleable>(mStateSpace, configurations);
+
+    for (const auto state : configurations)
+      mStateSpace->freeState(const_cast<StateSpace::State*>(state));
+  }
+
+  SkeletonPtr mManipulator;
+  BodyNodePtr mBodyNode1;
+  BodyNodePtr mBodyNode2;
+  MetaSkeletonStateSpacePtr mStateSpace;
+  std::vector<Eigen::VectorXd> mConfigurations;
+  std::shared_ptr<FiniteSampleable> mConfigurationConstraint;
+};
+
+TEST_F(InverseKinematicsSeedDatabaseTest, BuildThrowsOnNullArguments)
+{
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::build(
+          nullptr, mBodyNode2, mConfigurationConstraint, 10),
+      std::invalid_argument);
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::build(
+          mStateSpace, nullptr, mConfigurationConstraint, 10),
+      std::invalid_argument);
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::build(
+          mStateSpace, mBodyNode2, nullptr, 10),
+      std::invalid_argument);
+}
+
+TEST_F(InverseKinematicsSeedDatabaseTest, BuildThrowsOnInvalidRotationWeight)
+{
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::build(
+          mStateSpace, mBodyNode2, mConfigurationConstraint, 10, 0.),
+      std::invalid_argument);
+}
+
+TEST_F(InverseKinematicsSeedDatabaseTest, Build)
+{
+  const Eigen::VectorXd positions = mManipulator->getPositions();
+
+  auto database = InverseKinematicsSeedDatabase::build(
+      mStateSpace, mBodyNode2, mConfigurationConstraint, 1000);
+
+  // The FiniteSampleable is exhausted before 1000 entries.
+  EXPECT_EQ(mConfigurations.size(), database->getNumEntries());
+  EXPECT_EQ(2u, database->getNumDofs());
+  EXPECT_TRUE(mManipulator->getPositions().isApprox(positions));
+
+  // Each entry stores the pose of its configuration.
+  for (std::size_t i = 0; i < database->getNumEntries(); ++i)
+  {
+    mManipulator->setPositions(database->getPositions(i));
+    EXPECT_TRUE(
+        mBodyNode2->getWorldTransform().isApprox(database->getPose(i), 1e-9));
+  }
+}
+
+TEST_F(InverseKinematicsSeedDatabaseTest, FindNearest)
+{
+  auto database = InverseKinematicsSeedDatabase::build(
+      mStateSpace, mBodyNode2, mConfigurationConstraint, 1000);
+
+  EXPECT_TRUE(
+      database->findNearest(Eigen::Isometry3d::Identity(), 0).empty());
+  EXPECT_EQ(
+      database->getNumEntries(),
+      database->findNearest(Eigen::Isometry3d::Identity(), 1000).size());
+
+  for (const auto& positions : mConfigurations)
+  {
+    mManipulator->setPositions(positions);
+    const Eigen::Isometry3d target = mBodyNode2->getWorldTransform();
+
+    const auto nearest = database->findNearest(target, 3);
+    ASSERT_EQ(3u, nearest.size());
+    EXPECT_TRUE(database->getPose(nearest[0]).isApprox(target, 1e-9));
+
+    // Neighbors are sorted by distance.
+    const auto distance = [&](std::size_t _index) {
+      const Eigen::Isometry3d pose = database->getPose(_index);
+      const Eigen::Quaterniond rotation(pose.linear());
+      const Eigen::Quaterniond targetRotation(target.linear());
+      return (pose.translation() - target.translation()).squaredNorm()
+             + std::min(
+                   (rotation.coeffs() - targetRotation.coeffs()).squaredNorm(),
+                   (rotation.coeffs() + targetRotation.coeffs())
+                       .squaredNorm());
+    };
+    EXPECT_LE(distance(nearest[0]), distance(nearest[1]) + 1e-12);
+    EXPECT_LE(distance(nearest[1]), distance(nearest[2]) + 1e-12);
+  }
+}
+
+TEST_F(InverseKinematicsSeedDatabaseTest, SaveAndLoad)
+{
+  const std::string path = "test_InverseKinematicsSeedDatabase.bin";
+
+  auto database = InverseKinematicsSeedDatabase::build(
+      mStateSpace, mBodyNode2, mConfigurationConstraint, 1000, 0.5);
+  database->save(path);
+
+  auto loaded = InverseKinematicsSeedDatabase::load(path);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(database->getNumEntries(), loaded->getNumEntries());
+  EXPECT_EQ(database->getNumDofs(), loaded->getNumDofs());
+  EXPECT_EQ(database->getRotationWeight(), loaded->getRotationWeight());
+
+  for (std::size_t i = 0; i < database->getNumEntries(); ++i)
+  {
+    EXPECT_TRUE(database->getPose(i).isApprox(loaded->getPose(i)));
+    EXPECT_TRUE(database->getPositions(i).isApprox(loaded->getPositions(i)));
+  }
+
+  const Eigen::Isometry3d target = database->getPose(7);
+  EXPECT_EQ(database->findNearest(target, 5), loaded->findNearest(target, 5));
+}
+
+TEST_F(InverseKinematicsSeedDatabaseTest, LoadThrowsOnInvalidFile)
+{
+  const std::string path = "test_InverseKinematicsSeedDatabase.txt";
+
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::load(path), std::runtime_error);
+
+  {
+    std::ofstream stream(path.c_str());
+    stream << "This is not an inverse kinematics seed database.";
+  }
+
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::load(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST_F(InverseKinematicsSeedDatabaseTest, LoadThrowsOnInvalidHeader)
+{
+  const std::string path = "test_InverseKinematicsSeedDatabase.bin";
+
+  // Writes a database of one degree of freedom, i.e. 8 doubles per entry,
+  // that contains a single entry.
+  const auto writeDatabase
+      = [&path](std::uint64_t _numEntries, double _rotationWeight) {
+          const char magic[8] = {'A', 'I', 'K', 'I', 'D', 'O', 'I', 'K'};
+          const std::uint32_t version = 1;
+          const std::uint32_t numDofs = 1;
+          const double entry[8] = {0., 0., 0., 1., 0., 0., 0., 0.};
+
+          std::ofstream stream(path.c_str(), std::ios::binary);
+          stream.write(magic, sizeof(magic));
+          stream.write(reinterpret_cast<const char*>(&version), 4);
+          stream.write(reinterpret_cast<const char*>(&numDofs), 4);
+          stream.write(reinterpret_cast<const char*>(&_numEntries), 8);
+          stream.write(reinterpret_cast<const char*>(&_rotationWeight), 8);
+          stream.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+        };
+
+  writeDatabase(1u, 0.5);
+  EXPECT_EQ(1u, InverseKinematicsSeedDatabase::load(path)->getNumEntries());
+
+  // 2^58 + 1 entries of 64 bytes overflow to the size of a single entry.
+  writeDatabase((std::uint64_t(1) << 58) + 1u, 0.5);
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::load(path), std::runtime_error);
+
+  writeDatabase(2u, 0.5);
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::load(path), std::runtime_error);
+
+  writeDatabase(1u, -0.5);
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::load(path), std::runtime_error);
+
+  writeDatabase(1u, std::numeric_limits<double>::quiet_NaN());
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::load(path), std::runtime_error);
+
+  writeDatabase(1u, std::numeric_limits<double>::infinity());
+  EXPECT_THROW(
+      InverseKinematicsSeedDatabase::load(path), std::runtime_error);
+
+  std::remove(path.c_str());
+}
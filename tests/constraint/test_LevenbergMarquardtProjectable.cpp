@@ -0,0 +1,329 @@
+#include <aikido/constraint/LevenbergMarquardtProjectable.hpp>
+#include <aikido/constraint/NewtonsMethodProjectable.hpp>
+#include <aikido/constraint/Satisfied.hpp>
+#include <aikido/constraint/TSR.hpp>
+#include "PolynomialConstraint.hpp"
+
+#include <aikido/statespace/Rn.hpp>
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <Eigen/Dense>
+#include <dart/math/Geometry.hpp>
+#include <gtest/gtest.h>
+
+using aikido::constraint::ConstraintType;
+using aikido::constraint::Differentiable;
+using aikido::constraint::DifferentiablePtr;
+using aikido::constraint::LevenbergMarquardtProjectable;
+using aikido::constraint::NewtonsMethodProjectable;
+using aikido::constraint::Satisfied;
+using aikido::constraint::TSR;
+using aikido::statespace::R1;
+using aikido::statespace::R3;
+using aikido::statespace::StateSpace;
+using aikido::statespace::StateSpacePtr;
+
+/// Differentiable that counts the number of Jacobian evaluations.
+class JacobianCounter : public Differentiable
+{
+public:
+  explicit JacobianCounter(DifferentiablePtr _differentiable)
+    : mDifferentiable(std::move(_differentiable)), mNumJacobians(0)
+  {
+    // Do nothing
+  }
+
+  StateSpacePtr getStateSpace() const override
+  {
+    return mDifferentiable->getStateSpace();
+  }
+
+  std::size_t getConstraintDimension() const override
+  {
+    return mDifferentiable->getConstraintDimension();
+  }
+
+  std::vector<ConstraintType> getConstraintTypes() const override
+  {
+    return mDifferentiable->getConstraintTypes();
+  }
+
+  void getValue(
+      const StateSpace::State* _s, Eigen::VectorXd& _out) const override
+  {
+    mDifferentiable->getValue(_s, _out);
+  }
+
+  void getJacobian(
+      const StateSpace::State* _s, Eigen::MatrixXd& _out) const override
+  {
+    ++mNumJacobians;
+    mDifferentiable->getJacobian(_s, _out);
+  }
+
+  DifferentiablePtr mDifferentiable;
+  mutable int mNumJacobians;
+};
+
+TEST(LevenbergMarquardtProjectableTest, ConstructorThrowsOnNullDifferentiable)
+{
+  EXPECT_THROW(
+      LevenbergMarquardtProjectable(nullptr, std::vector<double>{}, 1, 1),
+      std::invalid_argument);
+}
+
+TEST(LevenbergMarquardtProjectableTest, ConstructorThrowsOnBadToleranceSize)
+{
+  auto ss = std::make_shared<R3>();
+  auto constraint = std::make_shared<Satisfied>(ss); // dimension = 0
+  EXPECT_THROW(
+      LevenbergMarquardtProjectable(
+          constraint, std::vector<double>({0.1}), 1, 1e-4),
+      std::invalid_argument);
+}
+
+TEST(LevenbergMarquardtProjectableTest, ConstructorThrowsOnNegativeTolerance)
+{
+  auto constraint
+      = std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(1, 2, 3));
+  EXPECT_THROW(
+      LevenbergMarquardtProjectable(
+          constraint, std::vector<double>({-0.1}), 1, 1e-4),
+      std::invalid_argument);
+}
+
+TEST(LevenbergMarquardtProjectableTest, ConstructorThrowsOnNegativeIteration)
+{
+  auto ss = std::make_shared<R3>();
+  auto constraint = std::make_shared<Satisfied>(ss); // dimension = 0
+  EXPECT_THROW(
+      LevenbergMarquardtProjectable(constraint, std::vector<double>(), 0, 1e-4),
+      std::invalid_argument);
+  EXPECT_THROW(
+      LevenbergMarquardtProjectable(
+          constraint, std::vector<double>(), -1, 1e-4),
+      std::invalid_argument);
+}
+
+TEST(LevenbergMarquardtProjectableTest, ConstructorThrowsOnNegativeStepsize)
+{
+  auto ss = std::make_shared<R3>();
+  auto constraint = std::make_shared<Satisfied>(ss); // dimension = 0
+  EXPECT_THROW(
+      LevenbergMarquardtProjectable(constraint, std::vector<double>(), 1, 0),
+      std::invalid_argument);
+  EXPECT_THROW(
+      LevenbergMarquardtProjectable(
+          constraint, std::vector<double>(), 1, -0.1),
+      std::invalid_argument);
+}
+
+TEST(LevenbergMarquardtProjectableTest, ConstructorThrowsOnNegativeDamping)
+{
+  auto ss = std::make_shared<R3>();
+  auto constraint = std::make_shared<Satisfied>(ss); // dimension = 0
+  EXPECT_THROW(
+      LevenbergMarquardtProjectable(
+          constraint, std::vector<double>(), 1, 1e-4, 0),
+      std::invalid_argument);
+}
+
+TEST(LevenbergMarquardtProjectable, ProjectPolynomialSecondOrder)
+{
+  // Constraint: x^2 - 1 = 0.
+  LevenbergMarquardtProjectable projector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({1e-6}),
+      20,
+      1e-8);
+
+  R1 rvss;
+  auto seedState = rvss.createState();
+  auto out = rvss.createState();
+
+  // Project x = -2. Should get -1 as projected solution.
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(-2.));
+  EXPECT_TRUE(projector.project(seedState, out));
+  EXPECT_NEAR(-1, rvss.getValue(out)[0], 1e-5);
+
+  // Project x = 1.5. Should get 1 as projected solution.
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(1.5));
+  EXPECT_TRUE(projector.project(seedState, out));
+  EXPECT_NEAR(1, rvss.getValue(out)[0], 1e-5);
+
+  // Project x = 1. Should get 1 as projected solution.
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(1.));
+  EXPECT_TRUE(projector.project(seedState, out));
+  EXPECT_NEAR(1, rvss.getValue(out)[0], 1e-5);
+}
+
+TEST(LevenbergMarquardtProjectable, ReusedWorkspace_DoesNotChangeResult)
+{
+  // Constraint: x^2 - 1 = 0, without warm starting.
+  LevenbergMarquardtProjectable projector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({1e-6}),
+      20,
+      1e-8,
+      1e-3,
+      false);
+
+  R1 rvss;
+  auto seedState = rvss.createState();
+  auto out = rvss.createState();
+
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(1.5));
+  ASSERT_TRUE(projector.project(seedState, out));
+  const double firstResult = rvss.getValue(out)[0];
+
+  // Later projections reuse the workspace of the first one.
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(-2.));
+  ASSERT_TRUE(projector.project(seedState, out));
+
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(1.5));
+  ASSERT_TRUE(projector.project(seedState, out));
+  EXPECT_EQ(firstResult, rvss.getValue(out)[0]);
+}
+
+TEST(LevenbergMarquardtProjectable, ProjectConcurrently)
+{
+  // Constraint: x^2 - 1 = 0.
+  LevenbergMarquardtProjectable projector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({1e-6}),
+      20,
+      1e-8);
+
+  R1 rvss;
+  std::atomic<int> numFailures(0);
+  std::vector<std::thread> threads;
+  for (int ithread = 0; ithread < 4; ++ithread)
+  {
+    threads.emplace_back([&, ithread]() {
+      auto seedState = rvss.createState();
+      auto out = rvss.createState();
+
+      // Each thread projects onto a different root.
+      const double seed = ithread % 2 == 0 ? -2. : 1.5;
+      const double expected = ithread % 2 == 0 ? -1. : 1.;
+      seedState.setValue(Eigen::Matrix<double, 1, 1>(seed));
+
+      for (int i = 0; i < 200; ++i)
+      {
+        if (!projector.project(seedState, out)
+            || std::abs(rvss.getValue(out)[0] - expected) > 1e-5)
+        {
+          ++numFailures;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(0, numFailures.load());
+}
+
+TEST(LevenbergMarquardtProjectable, ProjectTSRTranslation)
+{
+  std::shared_ptr<TSR> tsr = std::make_shared<TSR>();
+
+  // non-trivial translation bounds
+  Eigen::MatrixXd Bw = Eigen::Matrix<double, 6, 2>::Zero();
+  Bw(0, 0) = 1;
+  Bw(0, 1) = 2;
+
+  tsr->mBw = Bw;
+
+  auto space = tsr->getSE3();
+
+  auto seedState = space->createState();
+
+  Eigen::Isometry3d isometry = Eigen::Isometry3d::Identity();
+  isometry.translation() = Eigen::Vector3d(-1, 0, 1);
+  seedState.setIsometry(isometry);
+
+  LevenbergMarquardtProjectable projector(tsr, std::vector<double>(6, 1e-4));
+
+  auto out = space->createState();
+  EXPECT_TRUE(projector.project(seedState, out));
+  auto projected = space->getIsometry(out);
+
+  Eigen::Isometry3d expected = Eigen::Isometry3d::Identity();
+  expected.translation() = Eigen::Vector3d(1, 0, 0);
+
+  EXPECT_TRUE(expected.isApprox(projected, 5e-4));
+}
+
+TEST(LevenbergMarquardtProjectable, ProjectTSRRotation)
+{
+  std::shared_ptr<TSR> tsr = std::make_shared<TSR>();
+
+  // non-trivial rotation bounds
+  Eigen::MatrixXd Bw = Eigen::Matrix<double, 6, 2>::Zero();
+  Bw(3, 0) = M_PI_4;
+  Bw(3, 1) = M_PI_2;
+
+  tsr->mBw = Bw;
+
+  auto space = tsr->getSE3();
+  auto seedState = space->createState();
+
+  LevenbergMarquardtProjectable projector(tsr, std::vector<double>(6, 1e-4));
+
+  auto out = space->createState();
+  EXPECT_TRUE(projector.project(seedState, out));
+  auto projected = space->getIsometry(out);
+
+  Eigen::Isometry3d expected = Eigen::Isometry3d::Identity();
+  expected.linear()
+      = Eigen::AngleAxisd(M_PI_4, Eigen::Vector3d::UnitX()).toRotationMatrix();
+
+  EXPECT_TRUE(expected.isApprox(projected, 5e-4));
+}
+
+TEST(LevenbergMarquardtProjectable, ProjectTSRWithFewerJacobians)
+{
+  std::shared_ptr<TSR> tsr = std::make_shared<TSR>();
+  for (int i = 0; i < 6; ++i)
+  {
+    tsr->mBw(i, 0) = -0.1;
+    tsr->mBw(i, 1) = 0.1;
+  }
+  tsr->mTw_e.translation() = Eigen::Vector3d(0, 0, 0.2);
+
+  auto space = tsr->getSE3();
+  auto seedState = space->createState();
+  auto out = space->createState();
+
+  auto newtonCounter = std::make_shared<JacobianCounter>(tsr);
+  NewtonsMethodProjectable newton(
+      newtonCounter, std::vector<double>(6, 1e-4), 1000, 1e-8);
+
+  auto counter = std::make_shared<JacobianCounter>(tsr);
+  LevenbergMarquardtProjectable projector(
+      counter, std::vector<double>(6, 1e-4));
+
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> distribution(-2., 2.);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    Eigen::Vector6d twist;
+    for (int j = 0; j < 6; ++j)
+      twist[j] = distribution(engine);
+    seedState.setIsometry(dart::math::expMap(twist));
+
+    newton.project(seedState, out);
+    EXPECT_TRUE(projector.project(seedState, out));
+
+    Eigen::VectorXd value;
+    tsr->getValue(out, value);
+    EXPECT_LE(value.maxCoeff(), 1e-4);
+  }
+
+  EXPECT_LT(counter->mNumJacobians, newtonCounter->mNumJacobians);
+}
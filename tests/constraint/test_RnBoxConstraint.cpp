@@ -275,6 +275,70 @@ TEST_F(
   }
 }
 
+//==============================================================================
+TEST_F(RnBoxConstraintTests, R2_isSatisfiedBatch_MatchesIsSatisfied)
+{
+  R2BoxConstraint constraint(
+      mR2StateSpace, mRng->clone(), mLowerLimits, mUpperLimits);
+
+  std::vector<R2::ScopedState> states;
+  for (std::size_t i = 0; i < mBadValues.size(); ++i)
+  {
+    states.emplace_back(mR2StateSpace->createState());
+    states.back().setValue(mGoodValues[i % mGoodValues.size()]);
+    states.emplace_back(mR2StateSpace->createState());
+    states.back().setValue(mBadValues[i]);
+  }
+
+  std::vector<const aikido::statespace::StateSpace::State*> statePtrs;
+  for (const auto& state : states)
+    statePtrs.emplace_back(state);
+
+  std::vector<bool> results;
+  EXPECT_FALSE(constraint.isSatisfiedBatch(statePtrs, results, false));
+  ASSERT_EQ(states.size(), results.size());
+  for (std::size_t i = 0; i < states.size(); ++i)
+    EXPECT_EQ(constraint.isSatisfied(states[i]), results[i]);
+
+  // The results after the first bad value are false.
+  EXPECT_FALSE(constraint.isSatisfiedBatch(statePtrs, results, true));
+  EXPECT_TRUE(results[0]);
+  for (std::size_t i = 1; i < states.size(); ++i)
+    EXPECT_FALSE(results[i]);
+
+  statePtrs.resize(1);
+  EXPECT_TRUE(constraint.isSatisfiedBatch(statePtrs, results, true));
+}
+
+//==============================================================================
+TEST_F(RnBoxConstraintTests, Rx_isSatisfiedBatch_MatchesIsSatisfied)
+{
+  RnBoxConstraint constraint(
+      mRxStateSpace, mRng->clone(), mLowerLimits, mUpperLimits);
+
+  std::vector<aikido::statespace::Rn::ScopedState> states;
+  for (const auto& value : mBadValues)
+  {
+    states.emplace_back(mRxStateSpace->createState());
+    states.back().setValue(value);
+  }
+  for (const auto& value : mGoodValues)
+  {
+    states.emplace_back(mRxStateSpace->createState());
+    states.back().setValue(value);
+  }
+
+  std::vector<const aikido::statespace::StateSpace::State*> statePtrs;
+  for (const auto& state : states)
+    statePtrs.emplace_back(state);
+
+  std::vector<bool> results;
+  EXPECT_FALSE(constraint.isSatisfiedBatch(statePtrs, results, false));
+  ASSERT_EQ(states.size(), results.size());
+  for (std::size_t i = 0; i < states.size(); ++i)
+    EXPECT_EQ(constraint.isSatisfied(states[i]), results[i]);
+}
+
 //==============================================================================
 TEST_F(RnBoxConstraintTests, R2_project_SatisfiesConstraint_DoesNothing)
 {
@@ -168,6 +168,38 @@ TEST_F(SE2BoxConstraintTests, isSatisfiedFalse)
   }
 }
 
+//==============================================================================
+TEST_F(SE2BoxConstraintTests, isSatisfiedBatchMatchesIsSatisfied)
+{
+  SE2BoxConstraint constraint(
+      mSE2StateSpace, mRng->clone(), mLowerLimits, mUpperLimits);
+
+  std::vector<SE2::ScopedState> states;
+  for (const auto& values : {mGoodValues, mBadValues})
+  {
+    for (const auto& value : values)
+    {
+      Isometry2d pose = Eigen::Isometry2d::Identity();
+      pose = pose.translate(Vector2d(value[1], value[2])).rotate(value[0]);
+      states.emplace_back(mSE2StateSpace->createState());
+      states.back().setIsometry(pose);
+    }
+  }
+
+  std::vector<const aikido::statespace::StateSpace::State*> statePtrs;
+  for (const auto& state : states)
+    statePtrs.emplace_back(state);
+
+  std::vector<bool> results;
+  EXPECT_FALSE(constraint.isSatisfiedBatch(statePtrs, results, false));
+  ASSERT_EQ(states.size(), results.size());
+  for (std::size_t i = 0; i < states.size(); ++i)
+    EXPECT_EQ(constraint.isSatisfied(states[i]), results[i]);
+
+  statePtrs.resize(mGoodValues.size());
+  EXPECT_TRUE(constraint.isSatisfiedBatch(statePtrs, results, true));
+}
+
 //==============================================================================
 TEST_F(SE2BoxConstraintTests, projectSatisfiedConstraintDoesNothing)
 {
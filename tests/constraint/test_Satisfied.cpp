@@ -45,6 +45,17 @@ TEST_F(SatisfiedTests, isSatisfied_ReturnTrue)
   EXPECT_TRUE(constraint.isSatisfied(state));
 }
 
+TEST_F(SatisfiedTests, isSatisfiedBatch_ReturnTrue)
+{
+  Satisfied constraint(mStateSpace);
+  auto state = mStateSpace->createState();
+
+  std::vector<bool> results;
+  EXPECT_TRUE(constraint.isSatisfiedBatch({state, state}, results, true));
+  EXPECT_EQ(std::vector<bool>({true, true}), results);
+  EXPECT_TRUE(constraint.areAllSatisfied({state, state}));
+}
+
 TEST_F(SatisfiedTests, project_DoesNothing)
 {
   Satisfied constraint(mStateSpace);
@@ -361,6 +361,88 @@ TEST(TSR, GetJacobian)
   EXPECT_TRUE(jacobian.isApprox(expected, 1e-3));
 }
 
+//==============================================================================
+static Eigen::Isometry3d sampleIsometry(std::default_random_engine& _engine)
+{
+  std::uniform_real_distribution<double> distribution(-2., 2.);
+
+  Eigen::Vector6d twist;
+  for (int i = 0; i < 6; ++i)
+    twist(i) = distribution(_engine);
+
+  return dart::math::expMap(twist);
+}
+
+//==============================================================================
+static Eigen::MatrixXd getNumericalJacobian(
+    const TSR& _tsr, const Eigen::Isometry3d& _isometry, double _eps)
+{
+  const Eigen::Vector6d twist = dart::math::logMap(_isometry);
+  auto state = _tsr.getSE3()->createState();
+
+  Eigen::MatrixXd jacobian(6, 6);
+  for (int i = 0; i < 6; ++i)
+  {
+    Eigen::Vector6d perturbation(Eigen::Vector6d::Zero());
+    perturbation(i) = _eps;
+
+    Eigen::VectorXd positValue, negatValue;
+    state.setIsometry(dart::math::expMap(twist + perturbation));
+    _tsr.getValue(state, positValue);
+    state.setIsometry(dart::math::expMap(twist - perturbation));
+    _tsr.getValue(state, negatValue);
+
+    jacobian.col(i) = (positValue - negatValue) / (2 * _eps);
+  }
+  return jacobian;
+}
+
+//==============================================================================
+TEST(TSR, GetJacobianMatchesFiniteDifferences)
+{
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> distribution(-M_PI, M_PI);
+
+  const int numSamples = 200;
+  int numCompared = 0;
+
+  for (int sample = 0; sample < numSamples; ++sample)
+  {
+    TSR tsr;
+    tsr.mT0_w = sampleIsometry(engine);
+    tsr.mTw_e = sampleIsometry(engine);
+    for (int i = 0; i < 6; ++i)
+    {
+      const double a = distribution(engine);
+      const double b = distribution(engine);
+      tsr.mBw(i, 0) = std::min(a, b);
+      tsr.mBw(i, 1) = std::max(a, b);
+    }
+
+    const Eigen::Isometry3d isometry = sampleIsometry(engine);
+    auto state = tsr.getSE3()->createState();
+    state.setIsometry(isometry);
+
+    // The value of TSR is not differentiable where it reaches a bound. Skip
+    // samples where finite differences with different step sizes disagree.
+    const Eigen::MatrixXd expected = getNumericalJacobian(tsr, isometry, 1e-5);
+    const Eigen::MatrixXd coarse = getNumericalJacobian(tsr, isometry, 1e-4);
+    if (!expected.isApprox(coarse, 1e-4))
+      continue;
+
+    Eigen::MatrixXd jacobian;
+    tsr.getJacobian(state, jacobian);
+
+    ASSERT_EQ(6, jacobian.rows());
+    ASSERT_EQ(6, jacobian.cols());
+    EXPECT_TRUE(jacobian.isApprox(expected, 1e-5))
+        << "Analytic:\n" << jacobian << "\nFinite differences:\n" << expected;
+    ++numCompared;
+  }
+
+  EXPECT_GT(numCompared, numSamples / 2);
+}
+
 TEST(TSR, GetValueAndJacobian)
 {
   TSR tsr;
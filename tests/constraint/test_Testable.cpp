@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <aikido/constraint/Testable.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/StateArray.hpp>
+
+using aikido::constraint::Testable;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::R1;
+using aikido::statespace::StateArray;
+using aikido::statespace::StateSpace;
+using aikido::statespace::StateSpacePtr;
+
+namespace {
+
+/// Constraint on R1 that is satisfied by values up to a threshold, and
+/// records how many states it tested.
+class ThresholdConstraint : public Testable
+{
+public:
+  ThresholdConstraint(std::shared_ptr<R1> _stateSpace, double _threshold)
+    : mStateSpace(std::move(_stateSpace))
+    , mThreshold(_threshold)
+    , mNumTestedStates(0)
+  {
+    // Do nothing
+  }
+
+  bool isSatisfied(const StateSpace::State* _state) const override
+  {
+    ++mNumTestedStates;
+    return mStateSpace->getValue(static_cast<const R1::State*>(_state))[0]
+           <= mThreshold;
+  }
+
+  StateSpacePtr getStateSpace() const override
+  {
+    return mStateSpace;
+  }
+
+  std::shared_ptr<R1> mStateSpace;
+  double mThreshold;
+  mutable std::size_t mNumTestedStates;
+};
+
+} // namespace
+
+class TestableEdgeTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<R1>();
+    mInterpolator = std::make_shared<GeodesicInterpolator>(mStateSpace);
+
+    mStartState = static_cast<R1::State*>(mStateSpace->allocateState());
+    mGoalState = static_cast<R1::State*>(mStateSpace->allocateState());
+    mStateSpace->setValue(mStartState, Eigen::Matrix<double, 1, 1>(0.));
+    mStateSpace->setValue(mGoalState, Eigen::Matrix<double, 1, 1>(1.));
+
+    // More states than fit in a single chunk.
+    const auto numStates
+        = 3 * StateArray::getInlineCapacity(mStateSpace.get()) + 1;
+    for (std::size_t i = 0; i < numStates; ++i)
+      mAlphas.emplace_back(i / (numStates - 1.));
+  }
+
+  void TearDown() override
+  {
+    mStateSpace->freeState(mGoalState);
+    mStateSpace->freeState(mStartState);
+  }
+
+  std::shared_ptr<R1> mStateSpace;
+  std::shared_ptr<GeodesicInterpolator> mInterpolator;
+  R1::State* mStartState;
+  R1::State* mGoalState;
+  std::vector<double> mAlphas;
+};
+
+TEST_F(TestableEdgeTest, AreAllSatisfied_AllStatesValid_TestsAllStates)
+{
+  ThresholdConstraint constraint(mStateSpace, 1.);
+  const auto edge = mInterpolator->prepare(mStartState, mGoalState);
+
+  EXPECT_TRUE(
+      aikido::constraint::areAllSatisfied(constraint, *edge, mAlphas));
+  EXPECT_EQ(mAlphas.size(), constraint.mNumTestedStates);
+}
+
+TEST_F(TestableEdgeTest, AreAllSatisfied_InvalidState_StopsAfterChunk)
+{
+  // Only the last state is invalid with respect to the first constraint, and
+  // the first state is invalid with respect to the second one.
+  const auto chunkSize = StateArray::getInlineCapacity(mStateSpace.get());
+  const auto edge = mInterpolator->prepare(mStartState, mGoalState);
+
+  ThresholdConstraint lastInvalid(mStateSpace, 0.999);
+  EXPECT_FALSE(
+      aikido::constraint::areAllSatisfied(lastInvalid, *edge, mAlphas));
+  EXPECT_EQ(mAlphas.size(), lastInvalid.mNumTestedStates);
+
+  ThresholdConstraint firstInvalid(mStateSpace, -1.);
+  EXPECT_FALSE(
+      aikido::constraint::areAllSatisfied(firstInvalid, *edge, mAlphas));
+  EXPECT_LE(firstInvalid.mNumTestedStates, chunkSize);
+}
+
+TEST_F(TestableEdgeTest, AreAllSatisfied_NoAlphas_ReturnsTrue)
+{
+  ThresholdConstraint constraint(mStateSpace, -1.);
+  const auto edge = mInterpolator->prepare(mStartState, mGoalState);
+
+  EXPECT_TRUE(aikido::constraint::areAllSatisfied(
+      constraint, *edge, std::vector<double>()));
+  EXPECT_EQ(0u, constraint.mNumTestedStates);
+}
@@ -1,13 +1,16 @@
 #include <stdexcept>
 #include <gtest/gtest.h>
 #include <aikido/constraint/TestableIntersection.hpp>
+#include <aikido/constraint/uniform/RnBoxConstraint.hpp>
 #include <aikido/statespace/Rn.hpp>
 #include <aikido/statespace/SO2.hpp>
 #include "MockConstraints.hpp"
 
 using aikido::constraint::TestableIntersection;
 using aikido::constraint::Testable;
+using aikido::constraint::R1BoxConstraint;
 using aikido::statespace::R0;
+using aikido::statespace::R1;
 
 TEST(ConjuntionConstraintTest, ThrowOnNullStateSpace)
 {
@@ -98,3 +101,41 @@ TEST(TestableIntersectionTest, ThrowIfDifferentStateSpaceConstraintAdded)
   TestableIntersection cc{ss1};
   EXPECT_THROW(cc.addConstraint(ss2C), std::invalid_argument);
 }
+
+TEST(TestableIntersectionTest, IsSatisfiedBatchMatchesIsSatisfied)
+{
+  using Vector1d = Eigen::Matrix<double, 1, 1>;
+
+  auto ss = std::make_shared<R1>();
+  auto lower = std::make_shared<R1BoxConstraint>(
+      ss, nullptr, Vector1d(0.), Vector1d(10.));
+  auto upper = std::make_shared<R1BoxConstraint>(
+      ss, nullptr, Vector1d(-10.), Vector1d(5.));
+  TestableIntersection constraint{
+      ss, std::vector<std::shared_ptr<Testable>>({lower, upper})};
+
+  std::vector<R1::ScopedState> states;
+  for (const double value : {1., -1., 2., 6., 3.})
+  {
+    states.emplace_back(ss->createState());
+    states.back().setValue(Vector1d(value));
+  }
+
+  std::vector<const aikido::statespace::StateSpace::State*> statePtrs;
+  for (const auto& state : states)
+    statePtrs.emplace_back(state);
+
+  std::vector<bool> results;
+  EXPECT_FALSE(constraint.isSatisfiedBatch(statePtrs, results, false));
+  EXPECT_EQ(std::vector<bool>({true, false, true, false, true}), results);
+
+  EXPECT_FALSE(constraint.isSatisfiedBatch(statePtrs, results, true));
+  EXPECT_EQ(std::vector<bool>({true, false, false, false, false}), results);
+
+  EXPECT_FALSE(constraint.areAllSatisfied(statePtrs));
+
+  statePtrs = {states[0], states[2], states[4]};
+  EXPECT_TRUE(constraint.isSatisfiedBatch(statePtrs, results, true));
+  EXPECT_EQ(std::vector<bool>({true, true, true}), results);
+  EXPECT_TRUE(constraint.areAllSatisfied(statePtrs));
+}
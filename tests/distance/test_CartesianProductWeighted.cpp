@@ -1,9 +1,12 @@
 #include <aikido/distance/CartesianProductWeighted.hpp>
 #include <aikido/distance/RnEuclidean.hpp>
+#include <aikido/distance/SE2Weighted.hpp>
 #include <aikido/distance/SO2Angular.hpp>
 #include <aikido/distance/SO3Angular.hpp>
 #include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/SE2.hpp>
 
+#include <random>
 #include <gtest/gtest.h>
 
 using namespace aikido::distance;
@@ -210,3 +213,212 @@ TEST(CartesianProductWeightedDistance, DistanceCustomWeights)
   EXPECT_DOUBLE_EQ(
       2 * 0.5 + 4 * 0.5 + 3 * vdiff.norm(), dmetric.distance(state1, state2));
 }
+
+namespace {
+
+/// Metric that is not compiled, since it may override distance().
+class DerivedSO2Angular : public SO2Angular
+{
+public:
+  using SO2Angular::SO2Angular;
+};
+
+} // namespace
+
+TEST(CartesianProductWeightedDistance, CompiledMatchesComponents)
+{
+  auto so2 = std::make_shared<SO2>();
+  auto r1 = std::make_shared<R1>();
+  auto rx = std::make_shared<Rn>(4);
+  auto so3 = std::make_shared<SO3>();
+  auto se2 = std::make_shared<SE2>();
+
+  auto inner = std::make_shared<CartesianProduct>(
+      std::vector<StateSpacePtr>{r1, so2, se2});
+  auto innerMetric = std::make_shared<CartesianProductWeighted>(
+      inner,
+      std::vector<std::pair<DistanceMetricPtr, double>>{
+          std::make_pair(std::make_shared<R1Euclidean>(r1), 0.5),
+          std::make_pair(std::make_shared<SO2Angular>(so2), 1.5),
+          std::make_pair(
+              std::make_shared<SE2Weighted>(se2, Eigen::Vector2d(2., 3.)),
+              1.)});
+  EXPECT_TRUE(innerMetric->isCompiled());
+
+  auto space = std::make_shared<CartesianProduct>(
+      std::vector<StateSpacePtr>{so2, inner, rx, so3});
+  std::vector<std::pair<DistanceMetricPtr, double>> metrics{
+      std::make_pair(std::make_shared<SO2Angular>(so2), 2.),
+      std::make_pair(innerMetric, 3.),
+      std::make_pair(std::make_shared<RnEuclidean>(rx), 0.25),
+      std::make_pair(std::make_shared<SO3Angular>(so3), 4.)};
+  CartesianProductWeighted dmetric(space, metrics);
+  EXPECT_TRUE(dmetric.isCompiled());
+
+  std::default_random_engine engine;
+  std::uniform_real_distribution<double> distribution(-4., 4.);
+
+  std::vector<CartesianProduct::State*> states;
+  for (int i = 0; i < 20; ++i)
+  {
+    auto state = static_cast<CartesianProduct::State*>(space->allocateState());
+    auto handle = CartesianProduct::StateHandle(space.get(), state);
+    handle.getSubStateHandle<SO2>(0).setAngle(distribution(engine));
+
+    auto innerHandle = CartesianProduct::StateHandle(
+        inner.get(), handle.getSubState<CartesianProduct>(1));
+    innerHandle.getSubStateHandle<R1>(0).setValue(
+        Eigen::Matrix<double, 1, 1>(distribution(engine)));
+    innerHandle.getSubStateHandle<SO2>(1).setAngle(distribution(engine));
+    SE2::Isometry2d transform = SE2::Isometry2d::Identity();
+    transform.rotate(Eigen::Rotation2Dd(distribution(engine)));
+    transform.pretranslate(
+        Eigen::Vector2d(distribution(engine), distribution(engine)));
+    innerHandle.getSubStateHandle<SE2>(2).setIsometry(transform);
+
+    handle.getSubStateHandle<Rn>(2).setValue(
+        Eigen::Vector4d(
+            distribution(engine),
+            distribution(engine),
+            distribution(engine),
+            distribution(engine)));
+    handle.getSubStateHandle<SO3>(3).setQuaternion(
+        Eigen::Quaterniond(
+            Eigen::AngleAxisd(
+                distribution(engine),
+                Eigen::Vector3d(
+                    distribution(engine),
+                    distribution(engine),
+                    distribution(engine))
+                    .normalized())));
+    states.push_back(state);
+  }
+
+  // Weighted sum of the distances of the component metrics.
+  const auto expectedDistance
+      = [&](const CartesianProduct::State* _state1,
+            const CartesianProduct::State* _state2) {
+          double distance = 0.;
+          for (std::size_t i = 0; i < metrics.size(); ++i)
+          {
+            const auto state1 = space->getSubState<>(_state1, i);
+            const auto state2 = space->getSubState<>(_state2, i);
+
+            if (i == 1)
+            {
+              const auto& innerMetrics = innerMetric->getMetrics();
+              for (std::size_t j = 0; j < innerMetrics.size(); ++j)
+              {
+                distance
+                    += metrics[i].second * innerMetrics[j].second
+                       * innerMetrics[j].first->distance(
+                             inner->getSubState<>(
+                                 static_cast<const CartesianProduct::State*>(
+                                     state1),
+                                 j),
+                             inner->getSubState<>(
+                                 static_cast<const CartesianProduct::State*>(
+                                     state2),
+                                 j));
+              }
+            }
+            else
+            {
+              distance += metrics[i].second
+                          * metrics[i].first->distance(state1, state2);
+            }
+          }
+          return distance;
+        };
+
+  std::vector<const StateSpace::State*> batch(states.begin(), states.end());
+  std::vector<double> distances;
+  dmetric.distanceBatch(states[0], batch, distances);
+  ASSERT_EQ(states.size(), distances.size());
+
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    EXPECT_NEAR(
+        expectedDistance(states[0], states[i]), distances[i], 1e-9);
+
+    for (std::size_t j = 0; j < states.size(); ++j)
+    {
+      EXPECT_NEAR(
+          expectedDistance(states[i], states[j]),
+          dmetric.distance(states[i], states[j]),
+          1e-9);
+    }
+  }
+
+  for (const auto state : states)
+    space->freeState(state);
+}
+
+TEST(CartesianProductWeightedDistance, NotCompiledWithDerivedMetric)
+{
+  auto so2 = std::make_shared<SO2>();
+  auto rv3 = std::make_shared<R3>();
+  auto space = std::make_shared<CartesianProduct>(
+      std::vector<StateSpacePtr>{so2, rv3});
+
+  CartesianProductWeighted dmetric(
+      space,
+      {std::make_shared<DerivedSO2Angular>(so2),
+       std::make_shared<R3Euclidean>(rv3)});
+  EXPECT_FALSE(dmetric.isCompiled());
+
+  auto state1 = space->createState();
+  auto state2 = space->createState();
+  state1.getSubStateHandle<SO2>(0).setAngle(M_PI - 0.25);
+  state2.getSubStateHandle<SO2>(0).setAngle(-M_PI + 0.25);
+  state2.getSubStateHandle<R3>(1).setValue(Eigen::Vector3d(0., 3., 4.));
+
+  std::vector<double> distances;
+  dmetric.distanceBatch(state1, {state1, state2}, distances);
+  ASSERT_EQ(2u, distances.size());
+  EXPECT_DOUBLE_EQ(0., distances[0]);
+  EXPECT_DOUBLE_EQ(0.5 + 5., distances[1]);
+  EXPECT_DOUBLE_EQ(0.5 + 5., dmetric.distance(state1, state2));
+}
+
+TEST(CartesianProductWeightedDistance, DistanceBounded)
+{
+  auto so2 = std::make_shared<SO2>();
+  auto rv3 = std::make_shared<R3>();
+  auto so3 = std::make_shared<SO3>();
+  auto space = std::make_shared<CartesianProduct>(
+      std::vector<StateSpacePtr>{so2, rv3, so3});
+
+  auto state1 = space->createState();
+  auto state2 = space->createState();
+  state1.getSubStateHandle<SO2>(0).setAngle(M_PI);
+  state1.getSubStateHandle<R3>(1).setValue(Eigen::Vector3d(3, 4, 5));
+  state2.getSubStateHandle<SO2>(0).setAngle(0.5 + M_PI);
+  state2.getSubStateHandle<R3>(1).setValue(Eigen::Vector3d(1, 2, 3));
+  state2.getSubStateHandle<SO3>(2).setQuaternion(
+      Eigen::Quaterniond(Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitZ())));
+
+  // The compiled metric and the metric with a derived component, which is
+  // evaluated component by component.
+  const std::vector<std::pair<DistanceMetricPtr, double>> metrics{
+      std::make_pair(std::make_shared<SO2Angular>(so2), 2.),
+      std::make_pair(std::make_shared<R3Euclidean>(rv3), 3.),
+      std::make_pair(std::make_shared<SO3Angular>(so3), 4.)};
+  auto derivedMetrics = metrics;
+  derivedMetrics[0].first = std::make_shared<DerivedSO2Angular>(so2);
+
+  const double distance
+      = 2 * 0.5 + 3 * Eigen::Vector3d(2, 2, 2).norm() + 4 * 0.5;
+
+  for (const auto& componentMetrics : {metrics, derivedMetrics})
+  {
+    CartesianProductWeighted dmetric(space, componentMetrics);
+
+    EXPECT_NEAR(distance, dmetric.distanceBounded(state1, state2, 20.), 1e-9);
+    EXPECT_NEAR(
+        distance, dmetric.distanceBounded(state1, state2, distance), 1e-9);
+
+    for (const double bound : {-1., 0., 0.5, 1.5, 5., 13.})
+      EXPECT_GT(dmetric.distanceBounded(state1, state2, bound), bound);
+  }
+}
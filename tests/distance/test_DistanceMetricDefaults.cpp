@@ -4,6 +4,7 @@
 #include <aikido/distance/SO3Angular.hpp>
 #include <aikido/distance/defaults.hpp>
 #include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/StaticCartesianProduct.hpp>
 
 #include <gtest/gtest.h>
 
@@ -72,3 +73,27 @@ TEST(Defaults, CreateDistanceMetric)
   auto cmetric = dynamic_cast<CartesianProductWeighted*>(dmetric.get());
   EXPECT_TRUE(cmetric != nullptr);
 }
+
+TEST(Defaults, CreateDistanceMetricForStaticCartesianProduct)
+{
+  auto space = std::make_shared<StaticCartesianProduct<SO2, R3, SO3>>();
+  auto dmetric = createDistanceMetric(space);
+  auto cmetric = dynamic_cast<CartesianProductWeighted*>(dmetric.get());
+  ASSERT_TRUE(cmetric != nullptr);
+  EXPECT_EQ(space, cmetric->getStateSpace());
+
+  std::vector<StateSpacePtr> spaces;
+  for (std::size_t i = 0; i < space->getNumSubspaces(); ++i)
+    spaces.emplace_back(space->getSubspace<>(i));
+  auto dynamicSpace = std::make_shared<CartesianProduct>(spaces);
+  auto dynamicMetric = createDistanceMetric(dynamicSpace);
+
+  auto s1 = space->createState();
+  auto s2 = space->createState();
+  space->expMap(Eigen::VectorXd::Random(space->getDimension()), s1);
+  space->expMap(Eigen::VectorXd::Random(space->getDimension()), s2);
+
+  EXPECT_DOUBLE_EQ(
+      dynamicMetric->distance(s1, s2), dmetric->distance(s1, s2));
+  EXPECT_NEAR(0., dmetric->distance(s1, s1), 1e-12);
+}
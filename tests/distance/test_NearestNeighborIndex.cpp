@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include <aikido/distance/CartesianProductWeighted.hpp>
+#include <aikido/distance/NearestNeighborIndex.hpp>
+#include <aikido/distance/RnEuclidean.hpp>
+#include <aikido/distance/SO2Angular.hpp>
+#include <aikido/distance/SO3Angular.hpp>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/statespace/SO3.hpp>
+
+using aikido::distance::CartesianProductWeighted;
+using aikido::distance::DistanceMetricPtr;
+using aikido::distance::NearestNeighborIndex;
+using aikido::distance::R1Euclidean;
+using aikido::distance::R3Euclidean;
+using aikido::distance::SO2Angular;
+using aikido::distance::SO3Angular;
+using aikido::statespace::CartesianProduct;
+using aikido::statespace::R1;
+using aikido::statespace::R3;
+using aikido::statespace::SO2;
+using aikido::statespace::SO3;
+using aikido::statespace::StateSpace;
+using aikido::statespace::StateSpacePtr;
+
+/// SO2Angular that scales the distance, which the index can not reproduce.
+class ScaledSO2Angular : public SO2Angular
+{
+public:
+  using SO2Angular::SO2Angular;
+
+  double distance(
+      const StateSpace::State* _state1,
+      const StateSpace::State* _state2) const override
+  {
+    return 2. * SO2Angular::distance(_state1, _state2);
+  }
+};
+
+class NearestNeighborIndexTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    auto so2 = std::make_shared<SO2>();
+    auto r1 = std::make_shared<R1>();
+    auto r3 = std::make_shared<R3>();
+    mSpace = std::make_shared<CartesianProduct>(
+        std::vector<StateSpacePtr>{so2, r1, r3, so2});
+
+    mMetric = std::make_shared<CartesianProductWeighted>(
+        mSpace,
+        std::vector<std::pair<DistanceMetricPtr, double>>{
+            std::make_pair(std::make_shared<SO2Angular>(so2), 2.),
+            std::make_pair(std::make_shared<R1Euclidean>(r1), 1.),
+            std::make_pair(std::make_shared<R3Euclidean>(r3), 0.5),
+            std::make_pair(std::make_shared<SO2Angular>(so2), 1.)});
+
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> position(-1., 1.);
+    for (int i = 0; i < 2000; ++i)
+    {
+      auto state = mSpace->allocateState();
+      auto handle = CartesianProduct::StateHandle(
+          mSpace.get(), static_cast<CartesianProduct::State*>(state));
+      handle.getSubStateHandle<SO2>(0).setAngle(angle(mEngine));
+      handle.getSubStateHandle<R1>(1).setValue(
+          Eigen::Matrix<double, 1, 1>(position(mEngine)));
+      handle.getSubStateHandle<R3>(2).setValue(
+          Eigen::Vector3d(position(mEngine), 0., position(mEngine)));
+      handle.getSubStateHandle<SO2>(3).setAngle(angle(mEngine));
+      mStates.push_back(state);
+    }
+  }
+
+  void TearDown() override
+  {
+    for (const auto state : mStates)
+      mSpace->freeState(state);
+  }
+
+  /// Returns the distances and indices of the states that are not removed,
+  /// sorted by distance to mStates[_query], by brute force.
+  std::vector<std::pair<double, std::size_t>> findNearest(
+      std::size_t _query, const std::vector<bool>& _removed)
+  {
+    std::vector<std::pair<double, std::size_t>> neighbors;
+    for (std::size_t i = 0; i < mStates.size(); ++i)
+    {
+      if (!_removed[i])
+        neighbors.emplace_back(
+            mMetric->distance(mStates[_query], mStates[i]), i);
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+  }
+
+  std::default_random_engine mEngine;
+  std::shared_ptr<CartesianProduct> mSpace;
+  DistanceMetricPtr mMetric;
+  std::vector<StateSpace::State*> mStates;
+};
+
+TEST_F(NearestNeighborIndexTest, ConstructorThrowsOnUnsupportedMetric)
+{
+  EXPECT_THROW(NearestNeighborIndex(nullptr), std::invalid_argument);
+
+  auto so3Metric = std::make_shared<SO3Angular>(std::make_shared<SO3>());
+  EXPECT_FALSE(NearestNeighborIndex::isSupported(*so3Metric));
+  EXPECT_THROW(NearestNeighborIndex{so3Metric}, std::invalid_argument);
+
+  EXPECT_TRUE(NearestNeighborIndex::isSupported(*mMetric));
+  EXPECT_THROW(NearestNeighborIndex(mMetric, 0), std::invalid_argument);
+}
+
+TEST_F(NearestNeighborIndexTest, DerivedMetricIsNotSupported)
+{
+  auto so2 = std::make_shared<SO2>();
+  auto derivedMetric = std::make_shared<ScaledSO2Angular>(so2);
+  EXPECT_FALSE(NearestNeighborIndex::isSupported(*derivedMetric));
+  EXPECT_THROW(NearestNeighborIndex{derivedMetric}, std::invalid_argument);
+
+  // A CartesianProductWeighted of a derived metric falls back to the default
+  // nearest neighbor structure as well.
+  auto r1 = std::make_shared<R1>();
+  auto space = std::make_shared<CartesianProduct>(
+      std::vector<StateSpacePtr>{so2, r1});
+  auto metric = std::make_shared<CartesianProductWeighted>(
+      space,
+      std::vector<std::pair<DistanceMetricPtr, double>>{
+          std::make_pair(derivedMetric, 1.),
+          std::make_pair(std::make_shared<R1Euclidean>(r1), 1.)});
+  EXPECT_FALSE(NearestNeighborIndex::isSupported(*metric));
+  EXPECT_THROW(NearestNeighborIndex{metric}, std::invalid_argument);
+}
+
+TEST_F(NearestNeighborIndexTest, ComputeDistancesMatchesMetric)
+{
+  NearestNeighborIndex index(mMetric);
+  std::vector<std::size_t> indices;
+  for (const auto state : mStates)
+    indices.push_back(index.add(state));
+
+  std::vector<double> distances;
+  index.computeDistances(mStates[0], indices, distances);
+  ASSERT_EQ(mStates.size(), distances.size());
+
+  for (std::size_t i = 0; i < mStates.size(); ++i)
+    EXPECT_NEAR(mMetric->distance(mStates[0], mStates[i]), distances[i], 1e-9);
+}
+
+TEST_F(NearestNeighborIndexTest, NearestMatchesBruteForce)
+{
+  NearestNeighborIndex index(mMetric, 4);
+  for (std::size_t i = 0; i < mStates.size(); ++i)
+    EXPECT_EQ(i, index.add(mStates[i]));
+  EXPECT_EQ(mStates.size(), index.size());
+
+  // Remove every tenth state.
+  std::vector<bool> removed(mStates.size(), false);
+  for (std::size_t i = 0; i < mStates.size(); i += 10)
+  {
+    EXPECT_TRUE(index.remove(i));
+    EXPECT_FALSE(index.remove(i));
+    removed[i] = true;
+  }
+  EXPECT_EQ(mStates.size() - 200, index.size());
+
+  std::vector<std::size_t> indices;
+  for (std::size_t query = 0; query < mStates.size(); query += 7)
+  {
+    const auto expected = findNearest(query, removed);
+
+    index.nearestK(mStates[query], 5, indices);
+    ASSERT_EQ(5u, indices.size());
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+      EXPECT_FALSE(removed[indices[i]]);
+      EXPECT_NEAR(
+          expected[i].first,
+          mMetric->distance(mStates[query], mStates[indices[i]]),
+          1e-9);
+    }
+
+    const double radius = 0.8;
+    index.nearestR(mStates[query], radius, indices);
+    const auto numWithinRadius = std::count_if(
+        expected.begin(),
+        expected.end(),
+        [&](const std::pair<double, std::size_t>& _neighbor) {
+          return _neighbor.first <= radius;
+        });
+    EXPECT_EQ(static_cast<std::size_t>(numWithinRadius), indices.size());
+  }
+}
+
+TEST_F(NearestNeighborIndexTest, ApproximateNearest)
+{
+  NearestNeighborIndex index(mMetric);
+  index.setApproximationFactor(0.5);
+  EXPECT_DOUBLE_EQ(0.5, index.getApproximationFactor());
+  EXPECT_THROW(index.setApproximationFactor(-1.), std::invalid_argument);
+
+  for (const auto state : mStates)
+    index.add(state);
+
+  const std::vector<bool> removed(mStates.size(), false);
+  std::vector<std::size_t> indices;
+  for (std::size_t query = 0; query < mStates.size(); query += 7)
+  {
+    const auto expected = findNearest(query, removed);
+
+    index.nearestK(mStates[query], 3, indices);
+    ASSERT_EQ(3u, indices.size());
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+      EXPECT_LE(
+          mMetric->distance(mStates[query], mStates[indices[i]]),
+          1.5 * expected[i].first + 1e-9);
+    }
+  }
+}
+
+TEST(NearestNeighborIndex, SO2Wraparound)
+{
+  auto so2 = std::make_shared<SO2>();
+  NearestNeighborIndex index(std::make_shared<SO2Angular>(so2), 1);
+
+  auto state = so2->createState();
+  for (const double angle : {-2., -1., 0., 1., 2., M_PI - 0.01})
+  {
+    state.setAngle(angle);
+    index.add(state);
+  }
+
+  std::vector<std::size_t> indices;
+
+  // The nearest state to -pi + 0.01 is across the wraparound.
+  state.setAngle(-M_PI + 0.01);
+  index.nearestK(state, 1, indices);
+  ASSERT_EQ(1u, indices.size());
+  EXPECT_EQ(5u, indices[0]);
+
+  // Angles outside of [-pi, pi) are wrapped as well.
+  state.setAngle(3. * M_PI - 0.02);
+  index.nearestR(state, 0.1, indices);
+  ASSERT_EQ(1u, indices.size());
+  EXPECT_EQ(5u, indices[0]);
+
+  index.clear();
+  EXPECT_EQ(0u, index.size());
+  index.nearestK(state, 1, indices);
+  EXPECT_TRUE(indices.empty());
+}
@@ -64,3 +64,20 @@ TEST(REuclidean, DistanceRx)
   RnEuclidean dmetric(rvss);
   EXPECT_DOUBLE_EQ(std::sqrt(84), dmetric.distance(state1, state2));
 }
+
+//==============================================================================
+TEST(REuclidean, DistanceBounded)
+{
+  auto rvss = std::make_shared<Rn>(4);
+  auto state1 = rvss->createState();
+  auto state2 = rvss->createState();
+
+  state1.setValue(Eigen::Vector4d(0, 1, 2, 3));
+  state2.setValue(Eigen::Vector4d(-1, -2, -3, -4));
+
+  RnEuclidean dmetric(rvss);
+  EXPECT_DOUBLE_EQ(std::sqrt(84), dmetric.distanceBounded(state1, state2, 10));
+  EXPECT_DOUBLE_EQ(
+      std::sqrt(84), dmetric.distanceBounded(state1, state2, std::sqrt(84)));
+  EXPECT_GT(dmetric.distanceBounded(state1, state2, 9), 9);
+}
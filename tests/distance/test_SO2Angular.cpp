@@ -35,3 +35,23 @@ TEST(SO2Angular, Distance)
       2. * M_PI - state2.getAngle() + state1.getAngle(),
       dmetric.distance(state1, state2));
 }
+
+TEST(SO2Angular, DistanceBounded)
+{
+  auto so2 = std::make_shared<SO2>();
+  SO2Angular dmetric(so2);
+
+  auto state1 = so2->createState();
+  auto state2 = so2->createState();
+  state1.setAngle(0.1);
+  state2.setAngle(2. * M_PI - 0.2);
+
+  // The distance wraps around, so it is 0.3 rather than 2 pi - 0.3.
+  EXPECT_DOUBLE_EQ(
+      dmetric.distance(state1, state2),
+      dmetric.distanceBounded(state1, state2, 0.4));
+  EXPECT_DOUBLE_EQ(
+      dmetric.distance(state1, state2),
+      dmetric.distanceBounded(state1, state2, 10.));
+  EXPECT_GT(dmetric.distanceBounded(state1, state2, 0.2), 0.2);
+}
@@ -36,3 +36,25 @@ TEST(GeodesicDistance, Distance)
   state2.setQuaternion(quat2);
   EXPECT_NEAR(0.5, dmetric.distance(state1, state2), 1e-6);
 }
+
+TEST(GeodesicDistance, DistanceBounded)
+{
+  auto so3 = std::make_shared<SO3>();
+  SO3Angular dmetric(so3);
+  auto state1 = so3->createState();
+  auto state2 = so3->createState();
+
+  state1.setQuaternion(
+      Eigen::Quaterniond(Eigen::AngleAxisd(M_PI, Eigen::Vector3d::UnitY())));
+  state2.setQuaternion(
+      Eigen::Quaterniond(
+          Eigen::AngleAxisd(0.5 + M_PI, Eigen::Vector3d::UnitY())));
+
+  EXPECT_DOUBLE_EQ(
+      dmetric.distance(state1, state2),
+      dmetric.distanceBounded(state1, state2, 0.6));
+  EXPECT_DOUBLE_EQ(
+      dmetric.distance(state1, state2),
+      dmetric.distanceBounded(state1, state2, 10.));
+  EXPECT_GT(dmetric.distanceBounded(state1, state2, 0.4), 0.4);
+}
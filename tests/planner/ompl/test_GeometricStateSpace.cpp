@@ -1,4 +1,11 @@
+#include <aikido/constraint/CartesianProductProjectable.hpp>
+#include <aikido/constraint/CartesianProductSampleable.hpp>
+#include <aikido/constraint/CartesianProductTestable.hpp>
+#include <aikido/constraint/Satisfied.hpp>
+#include <aikido/constraint/uniform/RnBoxConstraint.hpp>
+#include <aikido/constraint/uniform/SO2UniformSampler.hpp>
 #include <aikido/planner/ompl/GeometricStateSpace.hpp>
+#include <aikido/statespace/StaticCartesianProduct.hpp>
 #include "OMPLTestHelpers.hpp"
 
 using aikido::planner::ompl::GeometricStateSpace;
@@ -549,3 +556,76 @@ TEST_F(GeometricStateSpaceTest, DallocNullState)
   constructStateSpace();
   gSpace->freeState(nullptr);
 }
+
+TEST(GeometricStateSpace, StaticCartesianProduct)
+{
+  using aikido::constraint::CartesianProductProjectable;
+  using aikido::constraint::CartesianProductSampleable;
+  using aikido::constraint::CartesianProductTestable;
+  using aikido::constraint::Satisfied;
+  using aikido::constraint::uniform::R2BoxConstraint;
+  using aikido::constraint::uniform::SO2UniformSampler;
+  using aikido::statespace::R2;
+  using aikido::statespace::SO2;
+  using Space = aikido::statespace::StaticCartesianProduct<R2, SO2>;
+
+  auto space = std::make_shared<Space>();
+  auto r2 = space->getStaticSubspace<0>();
+  auto so2 = space->getStaticSubspace<1>();
+
+  auto box = std::make_shared<R2BoxConstraint>(
+      r2, make_rng(), Eigen::Vector2d(-5., -5.), Eigen::Vector2d(5., 5.));
+  auto so2Satisfied = std::make_shared<Satisfied>(so2);
+  auto so2Sampler = std::make_shared<SO2UniformSampler>(so2, make_rng());
+
+  auto gSpace = std::make_shared<GeometricStateSpace>(
+      space,
+      std::make_shared<aikido::statespace::GeodesicInterpolator>(space),
+      aikido::distance::createDistanceMetric(space),
+      std::make_shared<CartesianProductSampleable>(
+          space,
+          std::vector<aikido::constraint::SampleablePtr>{box, so2Sampler}),
+      std::make_shared<CartesianProductTestable>(
+          space,
+          std::vector<aikido::constraint::TestablePtr>{box, so2Satisfied}),
+      std::make_shared<CartesianProductProjectable>(
+          space,
+          std::vector<aikido::constraint::ProjectablePtr>{box, so2Satisfied}));
+  EXPECT_EQ(3u, gSpace->getDimension());
+
+  auto s1 = gSpace->allocState()->as<GeometricStateSpace::StateType>();
+  auto s2 = gSpace->allocState()->as<GeometricStateSpace::StateType>();
+  auto s3 = gSpace->allocState()->as<GeometricStateSpace::StateType>();
+
+  Space::StateHandle h1(space.get(), static_cast<Space::State*>(s1->mState));
+  h1.getSubStateHandle<R2>(0).setValue(Eigen::Vector2d(-2., 3.));
+  h1.getSubStateHandle<SO2>(1).setAngle(0.);
+
+  Space::StateHandle h2(space.get(), static_cast<Space::State*>(s2->mState));
+  h2.getSubStateHandle<R2>(0).setValue(Eigen::Vector2d(4., 1.));
+  h2.getSubStateHandle<SO2>(1).setAngle(M_PI_2);
+
+  EXPECT_DOUBLE_EQ(
+      Eigen::Vector2d(6., -2.).norm() + M_PI_2, gSpace->distance(s1, s2));
+
+  gSpace->interpolate(s1, s2, 0.5, s3);
+  Space::StateHandle h3(space.get(), static_cast<Space::State*>(s3->mState));
+  EXPECT_TRUE(h3.getSubStateHandle<R2>(0).getValue().isApprox(
+      Eigen::Vector2d(1., 2.)));
+  EXPECT_DOUBLE_EQ(M_PI_4, h3.getSubStateHandle<SO2>(1).getAngle());
+
+  h3.getSubStateHandle<R2>(0).setValue(Eigen::Vector2d(-6., 16.));
+  EXPECT_FALSE(gSpace->satisfiesBounds(s3));
+  gSpace->enforceBounds(s3);
+  EXPECT_TRUE(gSpace->satisfiesBounds(s3));
+  EXPECT_TRUE(h3.getSubStateHandle<R2>(0).getValue().isApprox(
+      Eigen::Vector2d(-5., 5.)));
+
+  auto sampler = gSpace->allocDefaultStateSampler();
+  sampler->sampleUniform(s3);
+  EXPECT_TRUE(gSpace->satisfiesBounds(s3));
+
+  gSpace->freeState(s1);
+  gSpace->freeState(s2);
+  gSpace->freeState(s3);
+}
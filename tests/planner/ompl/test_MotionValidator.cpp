@@ -1,5 +1,6 @@
 #include <boost/make_shared.hpp>
 #include <gtest/gtest.h>
+#include <aikido/constraint/DistanceTestable.hpp>
 #include <aikido/planner/ompl/GeometricStateSpace.hpp>
 #include <aikido/planner/ompl/MotionValidator.hpp>
 #include <aikido/planner/ompl/StateValidityChecker.hpp>
@@ -11,6 +12,45 @@ using aikido::statespace::dart::MetaSkeletonStateSpace;
 using aikido::planner::ompl::MotionValidator;
 using aikido::planner::ompl::ompl_make_shared;
 
+/// Clearance of the translational robot, modeled as a point, from a .2x.2x.2
+/// block obstacle at the origin
+class BoxClearance : public aikido::constraint::DistanceTestable
+{
+public:
+  explicit BoxClearance(
+      aikido::statespace::dart::MetaSkeletonStateSpacePtr _stateSpace)
+    : mStateSpace(std::move(_stateSpace)), mNumQueries(0)
+  {
+  }
+
+  // Documentation inherited
+  double getClearance(
+      const aikido::statespace::StateSpace::State* _state) const override
+  {
+    ++mNumQueries;
+
+    auto cst = static_cast<const CartesianProduct::State*>(_state);
+    Eigen::Vector3d value
+        = mStateSpace->getSubStateHandle<R3>(cst, 0).getValue();
+    return (value.cwiseAbs().array() - 0.1).max(0.).matrix().norm();
+  }
+
+  // Documentation inherited
+  double getMaxDisplacementPerDistance() const override
+  {
+    return 1.0;
+  }
+
+  // Documentation inherited
+  std::shared_ptr<aikido::statespace::StateSpace> getStateSpace() const override
+  {
+    return mStateSpace;
+  }
+
+  aikido::statespace::dart::MetaSkeletonStateSpacePtr mStateSpace;
+  mutable std::size_t mNumQueries;
+};
+
 /// This test creates a world with a translational robot
 /// and a .2x.2x.2 block obstacle at the origin
 class MotionValidatorTest : public ::testing::Test
@@ -130,3 +170,92 @@ TEST_F(MotionValidatorTest, BadValidationSmallResolution)
       = std::make_shared<aikido::planner::ompl::MotionValidator>(si, 0.5);
   EXPECT_TRUE(validator1->checkMotion(state1, state2));
 }
+
+TEST_F(MotionValidatorTest, SetCacheThrowsOnInvalidResolution)
+{
+  EXPECT_THROW(validator->setCache(10, 0.0), std::invalid_argument);
+  EXPECT_NO_THROW(validator->setCache(0, 0.0));
+  EXPECT_EQ(0u, validator->getCacheCapacity());
+}
+
+TEST_F(MotionValidatorTest, CachedValidation)
+{
+  validator->setCache(2);
+  EXPECT_EQ(2u, validator->getCacheCapacity());
+
+  setTranslationalState(Eigen::Vector3d(0, -5, 0), stateSpace, state1);
+  setTranslationalState(Eigen::Vector3d(0, 5, 0), stateSpace, state2);
+
+  EXPECT_FALSE(validator->checkMotion(state1, state2));
+  EXPECT_FALSE(validator->checkMotion(state1, state2));
+  EXPECT_EQ(1u, validator->getNumCacheHits());
+  EXPECT_EQ(1u, validator->getNumCacheMisses());
+
+  // The first check did not compute the last valid state.
+  std::pair<::ompl::base::State*, double> lastValid;
+  lastValid.first = si->allocState();
+  EXPECT_FALSE(validator->checkMotion(state1, state2, lastValid));
+  EXPECT_EQ(2u, validator->getNumCacheMisses());
+
+  EXPECT_FALSE(validator->checkMotion(state1, state2, lastValid));
+  EXPECT_EQ(2u, validator->getNumCacheHits());
+  EXPECT_DOUBLE_EQ((5 - 0.2) / 10, lastValid.second);
+  EXPECT_TRUE(
+      getTranslationalState(stateSpace, lastValid.first)
+          .isApprox(Eigen::Vector3d(0, -0.2, 0.)));
+  si->freeState(lastValid.first);
+
+  // The least recently used segment is evicted.
+  auto state3 = si->allocState();
+  setTranslationalState(Eigen::Vector3d(-5, -5, 0), stateSpace, state3);
+  EXPECT_TRUE(validator->checkMotion(state3, state1));
+  EXPECT_TRUE(validator->checkMotion(state3, state2));
+  EXPECT_EQ(4u, validator->getNumCacheMisses());
+
+  EXPECT_FALSE(validator->checkMotion(state1, state2));
+  EXPECT_EQ(5u, validator->getNumCacheMisses());
+  EXPECT_TRUE(validator->checkMotion(state3, state2));
+  EXPECT_EQ(3u, validator->getNumCacheHits());
+  si->freeState(state3);
+
+  // Changing the environment version discards the cached segments.
+  validator->setEnvironmentVersion(1);
+  EXPECT_EQ(1u, validator->getEnvironmentVersion());
+  EXPECT_FALSE(validator->checkMotion(state1, state2));
+  EXPECT_EQ(6u, validator->getNumCacheMisses());
+}
+
+TEST_F(MotionValidatorTest, SetClearanceConstraintThrowsOnWrongStateSpace)
+{
+  auto otherStateSpace
+      = std::make_shared<MetaSkeletonStateSpace>(createTranslationalRobot());
+  EXPECT_THROW(
+      validator->setClearanceConstraint(
+          std::make_shared<BoxClearance>(otherStateSpace)),
+      std::invalid_argument);
+  EXPECT_NO_THROW(validator->setClearanceConstraint(nullptr));
+}
+
+TEST_F(MotionValidatorTest, ConservativeAdvancement)
+{
+  auto clearance = std::make_shared<BoxClearance>(stateSpace);
+  validator->setClearanceConstraint(clearance);
+  EXPECT_EQ(clearance, validator->getClearanceConstraint());
+
+  // Far from the obstacle, two queries cover the whole segment.
+  setTranslationalState(Eigen::Vector3d(-5, -5, 0), stateSpace, state1);
+  setTranslationalState(Eigen::Vector3d(5, -5, 0), stateSpace, state2);
+  EXPECT_TRUE(validator->checkMotion(state1, state2));
+  EXPECT_EQ(2u, clearance->mNumQueries);
+
+  setTranslationalState(Eigen::Vector3d(0, -5, 0), stateSpace, state1);
+  setTranslationalState(Eigen::Vector3d(0, 5, 0), stateSpace, state2);
+
+  std::pair<::ompl::base::State*, double> lastValid;
+  lastValid.first = si->allocState();
+  EXPECT_FALSE(validator->checkMotion(state1, state2, lastValid));
+  EXPECT_GE(lastValid.second, 0.0);
+  EXPECT_LE(lastValid.second, 0.49 + 1e-9);
+  EXPECT_LE(getTranslationalState(stateSpace, lastValid.first)[1], -0.1 + 1e-9);
+  si->freeState(lastValid.first);
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include <aikido/distance/RnEuclidean.hpp>
+#include <aikido/planner/ompl/NearestNeighborsKdTree.hpp>
+#include <aikido/statespace/Rn.hpp>
+
+using aikido::distance::R2Euclidean;
+using aikido::planner::ompl::NearestNeighborsKdTree;
+using aikido::statespace::R2;
+using aikido::statespace::StateSpace;
+
+class NearestNeighborsKdTreeTest : public ::testing::Test
+{
+public:
+  using Element = const StateSpace::State*;
+
+  void SetUp() override
+  {
+    mSpace = std::make_shared<R2>();
+    mMetric = std::make_shared<R2Euclidean>(mSpace);
+
+    std::default_random_engine engine;
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    for (int i = 0; i < 500; ++i)
+    {
+      auto state = static_cast<R2::State*>(mSpace->allocateState());
+      mSpace->setValue(
+          state,
+          Eigen::Vector2d(distribution(engine), distribution(engine)));
+      mStates.push_back(state);
+    }
+
+    mTree.setDistanceFunction(
+        [this](const Element& _a, const Element& _b) {
+          return mMetric->distance(_a, _b);
+        });
+  }
+
+  void TearDown() override
+  {
+    for (const auto state : mStates)
+      mSpace->freeState(const_cast<StateSpace::State*>(state));
+  }
+
+  void setMetric()
+  {
+    mTree.setMetric(mMetric, [](const Element& _element) {
+      return _element;
+    });
+  }
+
+  /// Checks mTree against a linear scan over all states but the removed ones.
+  void expectNearest(const std::vector<bool>& _removed)
+  {
+    std::vector<Element> nbh;
+    for (std::size_t query = 0; query < mStates.size(); query += 11)
+    {
+      std::vector<double> distances;
+      for (std::size_t i = 0; i < mStates.size(); ++i)
+      {
+        if (!_removed[i])
+          distances.push_back(mMetric->distance(mStates[query], mStates[i]));
+      }
+      std::sort(distances.begin(), distances.end());
+
+      mTree.nearestK(mStates[query], 4, nbh);
+      ASSERT_EQ(4u, nbh.size());
+      for (std::size_t i = 0; i < nbh.size(); ++i)
+      {
+        EXPECT_NEAR(
+            distances[i], mMetric->distance(mStates[query], nbh[i]), 1e-9);
+      }
+
+      EXPECT_EQ(
+          mMetric->distance(mStates[query], nbh[0]),
+          mMetric->distance(mStates[query], mTree.nearest(mStates[query])));
+
+      mTree.nearestR(mStates[query], 0.2, nbh);
+      EXPECT_EQ(
+          static_cast<std::size_t>(
+              std::upper_bound(distances.begin(), distances.end(), 0.2)
+              - distances.begin()),
+          nbh.size());
+    }
+  }
+
+  std::shared_ptr<R2> mSpace;
+  std::shared_ptr<R2Euclidean> mMetric;
+  std::vector<Element> mStates;
+  NearestNeighborsKdTree<Element> mTree;
+};
+
+TEST_F(NearestNeighborsKdTreeTest, ThrowsOnInvalidArguments)
+{
+  EXPECT_THROW(mTree.setMetric(nullptr, nullptr), std::invalid_argument);
+  EXPECT_THROW(mTree.setApproximationFactor(-1.), std::invalid_argument);
+}
+
+TEST_F(NearestNeighborsKdTreeTest, NearestWithoutMetric)
+{
+  mTree.add(mStates);
+  EXPECT_EQ(mStates.size(), mTree.size());
+  EXPECT_TRUE(mTree.reportsSortedResults());
+
+  expectNearest(std::vector<bool>(mStates.size(), false));
+}
+
+TEST_F(NearestNeighborsKdTreeTest, NearestWithMetric)
+{
+  // Data that was added before the metric is indexed as well.
+  std::vector<bool> removed(mStates.size(), false);
+  for (std::size_t i = 0; i < mStates.size() / 2; ++i)
+    mTree.add(mStates[i]);
+  EXPECT_TRUE(mTree.remove(mStates[0]));
+  EXPECT_FALSE(mTree.remove(mStates[0]));
+  removed[0] = true;
+
+  setMetric();
+
+  for (std::size_t i = mStates.size() / 2; i < mStates.size(); ++i)
+    mTree.add(mStates[i]);
+  EXPECT_TRUE(mTree.remove(mStates[1]));
+  removed[1] = true;
+  EXPECT_EQ(mStates.size() - 2, mTree.size());
+
+  expectNearest(removed);
+
+  std::vector<Element> data;
+  mTree.list(data);
+  EXPECT_EQ(mStates.size() - 2, data.size());
+
+  mTree.clear();
+  EXPECT_EQ(0u, mTree.size());
+  mTree.nearestK(mStates[0], 1, data);
+  EXPECT_TRUE(data.empty());
+}
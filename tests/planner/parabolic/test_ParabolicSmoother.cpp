@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <limits>
+#include <dart/dart.hpp>
 #include <gtest/gtest.h>
 #include <aikido/common/StepSequence.hpp>
+#include <aikido/common/ThreadPool.hpp>
+#include <aikido/constraint/CollisionFree.hpp>
 #include <aikido/constraint/Satisfied.hpp>
 #include <aikido/planner/parabolic/ParabolicSmoother.hpp>
 #include <aikido/planner/parabolic/ParabolicTimer.hpp>
@@ -8,6 +13,8 @@
 #include <aikido/statespace/Rn.hpp>
 #include <aikido/statespace/SO2.hpp>
 #include <aikido/statespace/SO3.hpp>
+#include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
+#include <aikido/statespace/dart/SkeletonReplicaPool.hpp>
 #include "eigen_tests.hpp"
 
 using Eigen::Vector2d;
@@ -19,7 +26,10 @@ using aikido::statespace::CartesianProduct;
 using aikido::statespace::SO2;
 using aikido::statespace::SO3;
 using aikido::statespace::StateSpacePtr;
+using aikido::constraint::CollisionFree;
 using aikido::constraint::Satisfied;
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+using aikido::statespace::dart::SkeletonReplicaPool;
 using aikido::planner::parabolic::computeParabolicTiming;
 using aikido::planner::parabolic::convertToSpline;
 using aikido::planner::parabolic::doShortcut;
@@ -321,3 +331,170 @@ TEST_F(ParabolicSmootherTests, doShortcutAndBlend)
   double shortenTime = smoothedTrajectory->getDuration();
   EXPECT_TRUE(shortenTime < originTime);
 }
+
+class ParabolicSmootherCollisionTests : public ::testing::Test
+{
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+protected:
+  void SetUp() override
+  {
+    using namespace dart::dynamics;
+
+    mRng = aikido::common::RNGWrapper<std::mt19937>(0);
+
+    // A box that translates in the xy-plane.
+    mRobot = Skeleton::create("robot");
+    PrismaticJoint::Properties xProperties;
+    xProperties.mAxis = Eigen::Vector3d::UnitX();
+    auto xPair = mRobot->createJointAndBodyNodePair<PrismaticJoint>(
+        nullptr, xProperties);
+    PrismaticJoint::Properties yProperties;
+    yProperties.mAxis = Eigen::Vector3d::UnitY();
+    auto yPair = mRobot->createJointAndBodyNodePair<PrismaticJoint>(
+        xPair.second, yProperties);
+    mRobotBody = yPair.second;
+    mRobotBody->createShapeNodeWith<CollisionAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d(0.1, 0.1, 0.1)));
+
+    mObstacle = Skeleton::create("obstacle");
+    mObstacleBody
+        = mObstacle->createJointAndBodyNodePair<FreeJoint>().second;
+    mObstacleBody->createShapeNodeWith<CollisionAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d(1., 1., 1.)));
+
+    mStateSpace = std::make_shared<MetaSkeletonStateSpace>(mRobot);
+    mInterpolator = std::make_shared<GeodesicInterpolator>(mStateSpace);
+    mMaxVelocity = Eigen::Vector2d(20., 20.);
+    mMaxAcceleration = Eigen::Vector2d(10., 10.);
+
+    // Detour around the obstacle when it sits at (1, 0).
+    mDetour = std::make_shared<Interpolated>(mStateSpace, mInterpolator);
+    auto state = mStateSpace->createState();
+    Vector2d p1(0., 0.), p2(0., 1.), p3(2., 1.), p4(2., 0.);
+    mStateSpace->convertPositionsToState(p1, state);
+    mDetour->addWaypoint(0., state);
+    mStateSpace->convertPositionsToState(p2, state);
+    mDetour->addWaypoint(1., state);
+    mStateSpace->convertPositionsToState(p3, state);
+    mDetour->addWaypoint(2., state);
+    mStateSpace->convertPositionsToState(p4, state);
+    mDetour->addWaypoint(3., state);
+  }
+
+  /// Places the obstacle at \c _position in the xy-plane and returns a
+  /// constraint that checks the robot against it on a thread pool.
+  std::shared_ptr<CollisionFree> createCollisionFreeOnThreadPool(
+      const Vector2d& _position)
+  {
+    Eigen::Vector6d obstaclePositions(Eigen::Vector6d::Zero());
+    obstaclePositions.segment<2>(3) = _position;
+    mObstacle->setPositions(obstaclePositions);
+
+    auto collisionDetector = dart::collision::FCLCollisionDetector::create();
+    auto constraint
+        = std::make_shared<CollisionFree>(mStateSpace, collisionDetector);
+    constraint->addPairwiseCheck(
+        collisionDetector->createCollisionGroup(mRobotBody),
+        collisionDetector->createCollisionGroup(mObstacleBody));
+    constraint->setSkeletonReplicaPool(
+        std::make_shared<SkeletonReplicaPool>(mRobot));
+    constraint->setThreadPool(std::make_shared<aikido::common::ThreadPool>(2u));
+    return constraint;
+  }
+
+  /// Returns the largest y-coordinate the robot visits, after checking that
+  /// every sampled state of \c _trajectory satisfies \c _constraint.
+  double checkTrajectory(
+      const aikido::trajectory::Spline& _trajectory,
+      const CollisionFree& _constraint)
+  {
+    auto state = mStateSpace->createState();
+    Eigen::VectorXd positions;
+    double maxY = -std::numeric_limits<double>::infinity();
+
+    aikido::common::StepSequence sequence(
+        1e-2, true, _trajectory.getStartTime(), _trajectory.getEndTime());
+    for (double t : sequence)
+    {
+      _trajectory.evaluate(t, state);
+      EXPECT_TRUE(_constraint.isSatisfied(state)) << "t = " << t;
+
+      mStateSpace->convertStateToPositions(state, positions);
+      maxY = std::max(maxY, positions[1]);
+    }
+
+    _trajectory.evaluate(_trajectory.getStartTime(), state);
+    mStateSpace->convertStateToPositions(state, positions);
+    EXPECT_EIGEN_EQUAL(Vector2d(0., 0.), positions, mTolerance);
+
+    _trajectory.evaluate(_trajectory.getEndTime(), state);
+    mStateSpace->convertStateToPositions(state, positions);
+    EXPECT_EIGEN_EQUAL(Vector2d(2., 0.), positions, mTolerance);
+
+    return maxY;
+  }
+
+  aikido::common::RNGWrapper<std::mt19937> mRng;
+  dart::dynamics::SkeletonPtr mRobot;
+  dart::dynamics::BodyNodePtr mRobotBody;
+  dart::dynamics::SkeletonPtr mObstacle;
+  dart::dynamics::BodyNodePtr mObstacleBody;
+  std::shared_ptr<MetaSkeletonStateSpace> mStateSpace;
+  std::shared_ptr<GeodesicInterpolator> mInterpolator;
+  std::shared_ptr<Interpolated> mDetour;
+  Eigen::Vector2d mMaxVelocity;
+  Eigen::Vector2d mMaxAcceleration;
+  double mTimelimit = 1.0;
+  double mCheckResolution = 1e-2;
+  const double mTolerance = 1e-3;
+};
+
+TEST_F(
+    ParabolicSmootherCollisionTests,
+    doShortcut_ThreadPoolCollisionFree_RejectsShortcutThroughObstacle)
+{
+  auto constraint = createCollisionFreeOnThreadPool(Vector2d(1., 0.));
+
+  auto splineTrajectory
+      = computeParabolicTiming(*mDetour, mMaxVelocity, mMaxAcceleration);
+  auto smoothedTrajectory = doShortcut(
+      *splineTrajectory,
+      constraint,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng,
+      mTimelimit,
+      mCheckResolution,
+      mTolerance);
+  ASSERT_NE(nullptr, smoothedTrajectory);
+
+  // The straight segment from (0, 0) to (2, 0) crosses the obstacle, so the
+  // robot still has to pass above it.
+  double maxY = checkTrajectory(*smoothedTrajectory, *constraint);
+  EXPECT_GT(maxY, 0.5);
+}
+
+TEST_F(
+    ParabolicSmootherCollisionTests,
+    doShortcut_ThreadPoolCollisionFree_AcceptsFreeShortcut)
+{
+  auto constraint = createCollisionFreeOnThreadPool(Vector2d(10., 10.));
+
+  auto splineTrajectory
+      = computeParabolicTiming(*mDetour, mMaxVelocity, mMaxAcceleration);
+  auto smoothedTrajectory = doShortcut(
+      *splineTrajectory,
+      constraint,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng,
+      mTimelimit,
+      mCheckResolution,
+      mTolerance);
+  ASSERT_NE(nullptr, smoothedTrajectory);
+
+  checkTrajectory(*smoothedTrajectory, *constraint);
+  EXPECT_LT(
+      smoothedTrajectory->getDuration(), splineTrajectory->getDuration());
+}
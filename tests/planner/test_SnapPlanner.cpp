@@ -1,6 +1,7 @@
 #include <tuple>
 #include <dart/dart.hpp>
 #include <gtest/gtest.h>
+#include <aikido/common/ThreadPool.hpp>
 #include <aikido/constraint/CollisionFree.hpp>
 #include <aikido/constraint/Testable.hpp>
 #include <aikido/distance/defaults.hpp>
@@ -9,6 +10,7 @@
 #include <aikido/statespace/GeodesicInterpolator.hpp>
 #include <aikido/statespace/SO2.hpp>
 #include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
+#include <aikido/statespace/dart/SkeletonReplicaPool.hpp>
 #include "../constraint/MockConstraints.hpp"
 
 using std::shared_ptr;
@@ -43,9 +45,41 @@ public:
   {
   }
 
+  /// Gives the arm a link of length 1 along x and places a box on the y axis,
+  /// which the link hits at an angle of pi / 2. Returns a constraint that
+  /// checks collision between them on a thread pool.
+  shared_ptr<CollisionFree> createCollisionFreeOnThreadPool()
+  {
+    using namespace dart::dynamics;
+
+    auto link = jn_bn.second->createShapeNodeWith<CollisionAspect>(
+        make_shared<BoxShape>(Eigen::Vector3d(1., 0.1, 0.1)));
+    link->setRelativeTranslation(Eigen::Vector3d(0.5, 0., 0.));
+
+    obstacle = Skeleton::create("obstacle");
+    auto obstacleBody
+        = obstacle->createJointAndBodyNodePair<FreeJoint>().second;
+    obstacleBody->createShapeNodeWith<CollisionAspect>(
+        make_shared<BoxShape>(Eigen::Vector3d(0.2, 0.2, 0.2)));
+    Eigen::Vector6d obstaclePositions(Eigen::Vector6d::Zero());
+    obstaclePositions(4) = 0.7;
+    obstacle->setPositions(obstaclePositions);
+
+    auto collisionDetector = FCLCollisionDetector::create();
+    auto constraint = make_shared<CollisionFree>(stateSpace, collisionDetector);
+    constraint->addPairwiseCheck(
+        collisionDetector->createCollisionGroup(jn_bn.second),
+        collisionDetector->createCollisionGroup(obstacleBody));
+    constraint->setSkeletonReplicaPool(
+        make_shared<aikido::statespace::dart::SkeletonReplicaPool>(skel));
+    constraint->setThreadPool(make_shared<aikido::common::ThreadPool>(2u));
+    return constraint;
+  }
+
   // DART setup
   SkeletonPtr skel;
   std::pair<JointPtr, BodyNodePtr> jn_bn;
+  SkeletonPtr obstacle;
 
   // Arguments for planner
   shared_ptr<MetaSkeletonStateSpace> stateSpace;
@@ -119,3 +153,42 @@ TEST_F(SnapPlannerTest, FailIfConstraintNotSatisfied)
       planningResult);
   EXPECT_EQ(nullptr, traj);
 }
+
+TEST_F(SnapPlannerTest, ThreadPoolCollisionFree_RejectsEdgeThroughObstacle)
+{
+  auto constraint = createCollisionFreeOnThreadPool();
+
+  // Both ends are free, but the arm hits the obstacle at pi / 2.
+  startState->getSubStateHandle<SO2>(0).setAngle(0.);
+  goalState->getSubStateHandle<SO2>(0).setAngle(2.5);
+  ASSERT_TRUE(constraint->isSatisfied(*startState));
+  ASSERT_TRUE(constraint->isSatisfied(*goalState));
+
+  auto traj = planSnap(
+      stateSpace,
+      *startState,
+      *goalState,
+      interpolator,
+      constraint,
+      planningResult);
+  EXPECT_EQ(nullptr, traj);
+}
+
+TEST_F(SnapPlannerTest, ThreadPoolCollisionFree_AcceptsFreeEdge)
+{
+  auto constraint = createCollisionFreeOnThreadPool();
+
+  // The arm turns away from the obstacle.
+  startState->getSubStateHandle<SO2>(0).setAngle(0.);
+  goalState->getSubStateHandle<SO2>(0).setAngle(-2.5);
+
+  auto traj = planSnap(
+      stateSpace,
+      *startState,
+      *goalState,
+      interpolator,
+      constraint,
+      planningResult);
+  ASSERT_NE(nullptr, traj);
+  EXPECT_EQ(2, traj->getNumWaypoints());
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <iostream>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/statespace/StaticCartesianProduct.hpp>
+
+// Compares the throughput of StaticCartesianProduct against an equivalent
+// CartesianProduct for the joint layout of a six degree-of-freedom arm with a
+// continuous wrist, i.e. R<6> x SO2.
+
+using aikido::statespace::CartesianProduct;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::R6;
+using aikido::statespace::SO2;
+using aikido::statespace::StateSpacePtr;
+using aikido::statespace::StaticCartesianProduct;
+
+static const int NUM_ITERATIONS = 1000000;
+
+//==============================================================================
+template <class Function>
+static double timeNanoseconds(Function _function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_ITERATIONS; ++i)
+    _function(i);
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count()
+         / NUM_ITERATIONS;
+}
+
+//==============================================================================
+static void benchmark(const std::string& _name, const StateSpacePtr& _space)
+{
+  GeodesicInterpolator interpolator(_space);
+
+  auto s1 = _space->createState();
+  auto s2 = _space->createState();
+  auto out = _space->createState();
+
+  Eigen::VectorXd tangent = Eigen::VectorXd::Random(_space->getDimension());
+  _space->expMap(tangent, s1);
+  _space->expMap(-tangent, s2);
+
+  const double composeTime = timeNanoseconds([&](int) {
+    _space->compose(s1, s2, out);
+  });
+  const double expMapTime = timeNanoseconds([&](int i) {
+    tangent[0] = i;
+    _space->expMap(tangent, out);
+  });
+  const double logMapTime = timeNanoseconds([&](int) {
+    _space->logMap(s1, tangent);
+  });
+  const double interpolateTime = timeNanoseconds([&](int i) {
+    const double alpha = static_cast<double>(i) / NUM_ITERATIONS;
+    interpolator.interpolate(s1, s2, alpha, out);
+  });
+
+  std::cout << _name << ":\n"
+            << "  compose:     " << composeTime << " ns\n"
+            << "  expMap:      " << expMapTime << " ns\n"
+            << "  logMap:      " << logMapTime << " ns\n"
+            << "  interpolate: " << interpolateTime << " ns\n";
+}
+
+//==============================================================================
+int main()
+{
+  auto staticSpace = std::make_shared<StaticCartesianProduct<R6, SO2>>();
+  auto dynamicSpace = std::make_shared<CartesianProduct>(
+      std::vector<StateSpacePtr>{staticSpace->getStaticSubspace<0>(),
+                                 staticSpace->getStaticSubspace<1>()});
+
+  benchmark("CartesianProduct", dynamicSpace);
+  benchmark("StaticCartesianProduct<R6, SO2>", staticSpace);
+
+  return 0;
+}
@@ -179,3 +179,109 @@ TEST(MetaSkeletonStateSpace, MultipleJoints_CreatesCartesianProduct)
   EXPECT_EQ(5., substate1.getAngle());
   EXPECT_TRUE(value2.isApprox(substate2.getValue()));
 }
+
+TEST(MetaSkeletonStateSpace, RnAndSO2Joints_HaveFlatLayout)
+{
+  auto skeleton = Skeleton::create();
+  auto joint1 = skeleton->createJointAndBodyNodePair<RevoluteJoint>().first;
+  skeleton->createJointAndBodyNodePair<TranslationalJoint>(
+      joint1->getChildBodyNode());
+
+  MetaSkeletonStateSpace space(skeleton);
+  ASSERT_TRUE(space.hasFlatLayout());
+  EXPECT_EQ(
+      std::vector<std::size_t>({0u, 1u, 2u, 3u}), space.getDofIndices());
+
+  auto state = space.createState();
+  const Eigen::Vector4d positions(1., 2., 3., 4.);
+  space.convertPositionsToState(positions, state);
+  EXPECT_TRUE(positions.isApprox(space.getFlatValues(state)));
+  EXPECT_DOUBLE_EQ(1., state.getSubStateHandle<SO2>(0).getAngle());
+  EXPECT_TRUE(
+      Vector3d(2., 3., 4.).isApprox(state.getSubStateHandle<R3>(1).getValue()));
+
+  space.getFlatValues(state)[3] = 5.;
+  space.setState(state);
+  EXPECT_TRUE(
+      Eigen::Vector4d(1., 2., 3., 5.).isApprox(skeleton->getPositions()));
+}
+
+TEST(MetaSkeletonStateSpace, PermutedDofs_HaveFlatLayout)
+{
+  auto skeleton = Skeleton::create();
+  auto joint = skeleton->createJointAndBodyNodePair<TranslationalJoint>().first;
+
+  auto group = dart::dynamics::Group::create();
+  group->addDof(joint->getDof(2));
+  group->addDof(joint->getDof(1));
+  group->addDof(joint->getDof(0));
+
+  MetaSkeletonStateSpace space(group);
+  ASSERT_TRUE(space.hasFlatLayout());
+  EXPECT_EQ(std::vector<std::size_t>({2u, 1u, 0u}), space.getDofIndices());
+
+  auto state = space.createState();
+  space.convertPositionsToState(Vector3d(1., 2., 3.), state);
+  EXPECT_TRUE(Vector3d(3., 2., 1.).isApprox(space.getFlatValues(state)));
+
+  Eigen::VectorXd positions;
+  space.convertStateToPositions(state, positions);
+  EXPECT_TRUE(Vector3d(1., 2., 3.).isApprox(positions));
+}
+
+TEST(MetaSkeletonStateSpace, SO2AndRnJoints_GetAndSetStateRoundTrip)
+{
+  auto skeleton = Skeleton::create();
+  auto joint1 = skeleton->createJointAndBodyNodePair<RevoluteJoint>().first;
+  auto joint2 = skeleton
+                    ->createJointAndBodyNodePair<PrismaticJoint>(
+                        joint1->getChildBodyNode())
+                    .first;
+  auto joint3 = skeleton
+                    ->createJointAndBodyNodePair<RevoluteJoint>(
+                        joint2->getChildBodyNode())
+                    .first;
+
+  // The DegreesOfFreedom are in a different order than the joints, which
+  // determine the order of the state.
+  auto group = dart::dynamics::Group::create();
+  group->addJoint(joint1, false);
+  group->addJoint(joint2, false);
+  group->addJoint(joint3, false);
+  group->addDof(joint3->getDof(0));
+  group->addDof(joint1->getDof(0));
+  group->addDof(joint2->getDof(0));
+
+  MetaSkeletonStateSpace space(group);
+  ASSERT_TRUE(space.hasFlatLayout());
+  ASSERT_EQ(3, space.getNumSubspaces());
+  ASSERT_EQ(std::vector<std::size_t>({1u, 2u, 0u}), space.getDofIndices());
+
+  const Vector3d positions(0.5, -1.5, 2.);
+  group->setPositions(positions);
+
+  auto state = space.createState();
+  space.getState(state);
+  EXPECT_DOUBLE_EQ(-1.5, state.getSubStateHandle<SO2>(0).getAngle());
+  EXPECT_DOUBLE_EQ(2., state.getSubStateHandle<R1>(1).getValue()[0]);
+  EXPECT_DOUBLE_EQ(0.5, state.getSubStateHandle<SO2>(2).getAngle());
+
+  group->setPositions(Vector3d::Zero());
+  space.setState(state);
+  EXPECT_TRUE(positions.isApprox(group->getPositions()));
+  EXPECT_DOUBLE_EQ(-1.5, joint1->getPosition(0));
+  EXPECT_DOUBLE_EQ(2., joint2->getPosition(0));
+  EXPECT_DOUBLE_EQ(0.5, joint3->getPosition(0));
+}
+
+TEST(MetaSkeletonStateSpace, FreeJoint_DoesNotHaveFlatLayout)
+{
+  auto skeleton = Skeleton::create();
+  skeleton->createJointAndBodyNodePair<FreeJoint>();
+
+  MetaSkeletonStateSpace space(skeleton);
+  EXPECT_FALSE(space.hasFlatLayout());
+
+  auto state = space.createState();
+  EXPECT_THROW(space.getFlatValues(state), std::logic_error);
+}
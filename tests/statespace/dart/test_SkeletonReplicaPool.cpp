@@ -0,0 +1,153 @@
+#include <thread>
+#include <dart/collision/fcl/fcl.hpp>
+#include <dart/dynamics/dynamics.hpp>
+#include <gtest/gtest.h>
+#include <aikido/statespace/dart/SkeletonReplicaPool.hpp>
+
+using dart::collision::FCLCollisionDetector;
+using dart::dynamics::BoxShape;
+using dart::dynamics::CollisionAspect;
+using dart::dynamics::Group;
+using dart::dynamics::RevoluteJoint;
+using dart::dynamics::Skeleton;
+using dart::dynamics::SkeletonPtr;
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+using aikido::statespace::dart::SkeletonReplica;
+using aikido::statespace::dart::SkeletonReplicaPool;
+
+class SkeletonReplicaPoolTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mSkeleton = Skeleton::create("Manipulator");
+
+    auto bodyNode1
+        = mSkeleton->createJointAndBodyNodePair<RevoluteJoint>().second;
+    auto bodyNode2 = mSkeleton
+                         ->createJointAndBodyNodePair<RevoluteJoint>(bodyNode1)
+                         .second;
+
+    std::shared_ptr<BoxShape> box(new BoxShape(Eigen::Vector3d::Ones()));
+    bodyNode2->createShapeNodeWith<CollisionAspect>(box);
+
+    mEnvironment = Skeleton::create("Environment");
+    mEnvironment->createJointAndBodyNodePair<RevoluteJoint>()
+        .second->createShapeNodeWith<CollisionAspect>(box);
+
+    mSkeleton->setPositions(Eigen::Vector2d(1., 2.));
+  }
+
+  SkeletonPtr mSkeleton;
+  SkeletonPtr mEnvironment;
+};
+
+TEST_F(SkeletonReplicaPoolTest, ThrowsOnNullSkeleton)
+{
+  EXPECT_THROW(SkeletonReplicaPool(nullptr), std::invalid_argument);
+}
+
+TEST_F(SkeletonReplicaPoolTest, ReplicaIsBoundToThread)
+{
+  SkeletonReplicaPool pool(mSkeleton);
+  EXPECT_EQ(0u, pool.getNumReplicas());
+
+  auto& replica = pool.getReplica();
+  EXPECT_EQ(&replica, &pool.getReplica());
+  EXPECT_EQ(1u, pool.getNumReplicas());
+
+  SkeletonReplica* otherReplica = nullptr;
+  std::thread thread([&]() { otherReplica = &pool.getReplica(); });
+  thread.join();
+
+  EXPECT_NE(&replica, otherReplica);
+  EXPECT_EQ(2u, pool.getNumReplicas());
+
+  // The replica of the exited thread is reused by the next thread.
+  SkeletonReplica* reusedReplica = nullptr;
+  std::thread reusingThread([&]() { reusedReplica = &pool.getReplica(); });
+  reusingThread.join();
+
+  EXPECT_EQ(otherReplica, reusedReplica);
+  EXPECT_EQ(2u, pool.getNumReplicas());
+}
+
+TEST_F(SkeletonReplicaPoolTest, ReplicaIsIndependentOfSkeleton)
+{
+  SkeletonReplicaPool pool(mSkeleton);
+  auto& replica = pool.getReplica();
+
+  auto skeleton = replica.getSkeleton(mSkeleton.get());
+  EXPECT_NE(mSkeleton, skeleton);
+  EXPECT_TRUE(Eigen::Vector2d(1., 2.).isApprox(skeleton->getPositions()));
+
+  skeleton->setPositions(Eigen::Vector2d(3., 4.));
+  EXPECT_TRUE(Eigen::Vector2d(1., 2.).isApprox(mSkeleton->getPositions()));
+
+  EXPECT_THROW(
+      replica.getSkeleton(mEnvironment.get()), std::invalid_argument);
+}
+
+TEST_F(SkeletonReplicaPoolTest, GetStateSpace)
+{
+  auto group = Group::create();
+  group->addDof(mSkeleton->getDof(1));
+  auto stateSpace = std::make_shared<MetaSkeletonStateSpace>(group);
+
+  SkeletonReplicaPool pool(mSkeleton);
+  auto& replica = pool.getReplica();
+
+  auto replicaStateSpace = replica.getStateSpace(stateSpace);
+  EXPECT_EQ(replicaStateSpace, replica.getStateSpace(stateSpace));
+  EXPECT_EQ(
+      replica.getSkeleton(mSkeleton.get())->getDof(1),
+      replicaStateSpace->getMetaSkeleton()->getDof(0));
+
+  auto state = stateSpace->createState();
+  stateSpace->convertPositionsToState(Eigen::VectorXd::Constant(1, 5.), state);
+  replicaStateSpace->setState(state);
+
+  EXPECT_DOUBLE_EQ(5., replica.getSkeleton(mSkeleton.get())->getPosition(1));
+  EXPECT_DOUBLE_EQ(2., mSkeleton->getPosition(1));
+}
+
+TEST_F(SkeletonReplicaPoolTest, GetCollisionGroup)
+{
+  auto detector = FCLCollisionDetector::create();
+  std::shared_ptr<dart::collision::CollisionGroup> group
+      = detector->createCollisionGroup(mSkeleton.get(), mEnvironment.get());
+
+  SkeletonReplicaPool pool(mSkeleton);
+  auto& replica = pool.getReplica();
+
+  auto replicaDetector = replica.getCollisionDetector(detector.get());
+  EXPECT_NE(detector, replicaDetector);
+
+  auto replicaGroup = replica.getCollisionGroup(group);
+  EXPECT_EQ(replicaGroup, replica.getCollisionGroup(group));
+  EXPECT_EQ(replicaDetector.get(), replicaGroup->getCollisionDetector());
+  ASSERT_EQ(2u, replicaGroup->getNumShapeFrames());
+
+  // The manipulator is replicated, but the environment is shared.
+  auto skeleton = replica.getSkeleton(mSkeleton.get());
+  EXPECT_TRUE(replicaGroup->hasShapeFrame(
+      skeleton->getBodyNode(1)->getShapeNode(0)));
+  EXPECT_TRUE(replicaGroup->hasShapeFrame(
+      mEnvironment->getBodyNode(0)->getShapeNode(0)));
+}
+
+TEST_F(SkeletonReplicaPoolTest, GetSourceShapeFrame)
+{
+  SkeletonReplicaPool pool(mSkeleton);
+  auto& replica = pool.getReplica();
+
+  auto shapeNode = mSkeleton->getBodyNode(1)->getShapeNode(0);
+  auto replicaShapeNode = replica.getShapeFrame(shapeNode);
+  EXPECT_NE(shapeNode, replicaShapeNode);
+  EXPECT_EQ(shapeNode, replica.getSourceShapeFrame(replicaShapeNode));
+
+  // The environment is shared, so it is its own source.
+  auto environmentShapeNode = mEnvironment->getBodyNode(0)->getShapeNode(0);
+  EXPECT_EQ(
+      environmentShapeNode, replica.getSourceShapeFrame(environmentShapeNode));
+}
@@ -1,11 +1,13 @@
 #include <gtest/gtest.h>
 #include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
 #include <aikido/statespace/Rn.hpp>
 #include <aikido/statespace/SE2.hpp>
 #include <aikido/statespace/SO2.hpp>
 #include <aikido/statespace/SO3.hpp>
 
 using aikido::statespace::CartesianProduct;
+using aikido::statespace::GeodesicInterpolator;
 using aikido::statespace::R2;
 using aikido::statespace::R3;
 using aikido::statespace::SO2;
@@ -179,3 +181,152 @@ TEST(CartesianProduct, PrintState)
   std::cout.precision(3);
   space.print(source, std::cout);
 }
+
+TEST(CartesianProduct, BatchOperationsMatchSingleOperations)
+{
+  auto space = std::make_shared<CartesianProduct>(
+      std::vector<aikido::statespace::StateSpacePtr>(
+          {std::make_shared<SO2>(),
+           std::make_shared<R3>(),
+           std::make_shared<SO3>()}));
+
+  const std::size_t numStates = 5;
+  const std::size_t stride = space->getStateSizeInBytes();
+  std::unique_ptr<char[]> buffer1(new char[numStates * stride]);
+  std::unique_ptr<char[]> buffer2(new char[numStates * stride]);
+  std::unique_ptr<char[]> bufferOut(new char[numStates * stride]);
+
+  auto getState = [&](std::unique_ptr<char[]>& _buffer, std::size_t _index) {
+    return static_cast<CartesianProduct::State*>(
+        reinterpret_cast<aikido::statespace::StateSpace::State*>(
+            _buffer.get() + _index * stride));
+  };
+
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    space->allocateStateInBuffer(getState(buffer1, i));
+    space->allocateStateInBuffer(getState(buffer2, i));
+    space->allocateStateInBuffer(getState(bufferOut, i));
+  }
+
+  const Eigen::MatrixXd tangents1 = Eigen::MatrixXd::Random(7, numStates);
+  const Eigen::MatrixXd tangents2 = Eigen::MatrixXd::Random(7, numStates);
+  space->expMapBatch(tangents1, getState(buffer1, 0), stride);
+  space->expMapBatch(tangents2, getState(buffer2, 0), stride);
+  space->composeBatch(
+      getState(buffer1, 0),
+      stride,
+      getState(buffer2, 0),
+      stride,
+      getState(bufferOut, 0),
+      stride,
+      numStates);
+
+  Eigen::MatrixXd batchTangents(7, numStates);
+  space->logMapBatch(getState(bufferOut, 0), stride, batchTangents);
+
+  auto state1 = space->createState();
+  auto state2 = space->createState();
+  auto out = space->createState();
+  Eigen::VectorXd tangent;
+
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    space->expMap(tangents1.col(i), state1);
+    space->expMap(tangents2.col(i), state2);
+    space->compose(state1, state2, out);
+    space->logMap(out, tangent);
+
+    EXPECT_TRUE(tangent.isApprox(batchTangents.col(i)));
+  }
+
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    space->freeStateInBuffer(getState(buffer1, i));
+    space->freeStateInBuffer(getState(buffer2, i));
+    space->freeStateInBuffer(getState(bufferOut, i));
+  }
+}
+
+TEST(CartesianProduct, InterpolateBatchMatchesInterpolate)
+{
+  auto space = std::make_shared<CartesianProduct>(
+      std::vector<aikido::statespace::StateSpacePtr>(
+          {std::make_shared<SO2>(), std::make_shared<R3>()}));
+  GeodesicInterpolator interpolator(space);
+
+  auto from = space->createState();
+  from.getSubStateHandle<SO2>(0).setAngle(0.5);
+  from.getSubStateHandle<R3>(1).setValue(Eigen::Vector3d(1., 2., 3.));
+
+  auto to = space->createState();
+  to.getSubStateHandle<SO2>(0).setAngle(-1.5);
+  to.getSubStateHandle<R3>(1).setValue(Eigen::Vector3d(-1., 4., 0.));
+
+  const Eigen::VectorXd alphas = Eigen::VectorXd::LinSpaced(11, 0., 1.);
+  const std::size_t stride = space->getStateSizeInBytes();
+  std::unique_ptr<char[]> buffer(new char[alphas.size() * stride]);
+  for (int i = 0; i < alphas.size(); ++i)
+    space->allocateStateInBuffer(buffer.get() + i * stride);
+
+  auto states = reinterpret_cast<aikido::statespace::StateSpace::State*>(
+      buffer.get());
+  interpolator.interpolateBatch(from, to, alphas, states, stride);
+
+  auto expected = space->createState();
+  Eigen::VectorXd expectedTangent;
+  Eigen::VectorXd actualTangent;
+
+  for (int i = 0; i < alphas.size(); ++i)
+  {
+    interpolator.interpolate(from, to, alphas[i], expected);
+    space->logMap(expected, expectedTangent);
+    space->logMap(
+        reinterpret_cast<aikido::statespace::StateSpace::State*>(
+            buffer.get() + i * stride),
+        actualTangent);
+
+    EXPECT_TRUE(expectedTangent.isApprox(actualTangent));
+  }
+}
+
+TEST(CartesianProduct, PreparedInterpolationMatchesInterpolate)
+{
+  auto space = std::make_shared<CartesianProduct>(
+      std::vector<aikido::statespace::StateSpacePtr>(
+          {std::make_shared<SO2>(), std::make_shared<R3>()}));
+  GeodesicInterpolator interpolator(space);
+
+  auto from = space->createState();
+  from.getSubStateHandle<SO2>(0).setAngle(0.5);
+  from.getSubStateHandle<R3>(1).setValue(Eigen::Vector3d(1., 2., 3.));
+
+  auto to = space->createState();
+  to.getSubStateHandle<SO2>(0).setAngle(-1.5);
+  to.getSubStateHandle<R3>(1).setValue(Eigen::Vector3d(-1., 4., 0.));
+
+  const auto edge = interpolator.prepare(from, to);
+
+  auto expected = space->createState();
+  auto actual = space->createState();
+  Eigen::VectorXd expectedTangent;
+  Eigen::VectorXd actualTangent;
+
+  for (const double alpha : {0., 0.25, 0.6, 1.})
+  {
+    interpolator.interpolate(from, to, alpha, expected);
+    edge->interpolate(alpha, actual);
+    space->logMap(expected, expectedTangent);
+    space->logMap(actual, actualTangent);
+    EXPECT_TRUE(expectedTangent.isApprox(actualTangent));
+
+    interpolator.getDerivative(from, to, 1, alpha, expectedTangent);
+    edge->getDerivative(1, alpha, actualTangent);
+    EXPECT_TRUE(expectedTangent.isApprox(actualTangent));
+  }
+
+  edge->getDerivative(2, 0.5, actualTangent);
+  EXPECT_TRUE(actualTangent.isZero());
+  EXPECT_THROW(
+      edge->getDerivative(0, 0.5, actualTangent), std::invalid_argument);
+}
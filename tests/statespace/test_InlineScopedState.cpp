@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/InlineScopedState.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SE3.hpp>
+#include <aikido/statespace/SO2.hpp>
+
+using aikido::statespace::InlineScopedState;
+using aikido::statespace::Rn;
+using aikido::statespace::SE3;
+using aikido::statespace::SO2;
+
+TEST(InlineScopedState, SmallStateIsStoredInline)
+{
+  SO2 so2;
+  InlineScopedState<SO2::StateHandle> state(&so2);
+  EXPECT_TRUE(state.isInline());
+  EXPECT_EQ(&so2, state.getStateSpace());
+
+  state.setAngle(M_PI_4);
+  EXPECT_DOUBLE_EQ(M_PI_4, state.getAngle());
+}
+
+TEST(InlineScopedState, LargeStateIsStoredOnHeap)
+{
+  Rn rn(32);
+  InlineScopedState<Rn::StateHandle> state(&rn);
+  EXPECT_FALSE(state.isInline());
+
+  const Eigen::VectorXd value = Eigen::VectorXd::LinSpaced(32, 0., 31.);
+  state.setValue(value);
+  EXPECT_TRUE(state.getValue().isApprox(value));
+}
+
+TEST(InlineScopedState, BufferSizeIsConfigurable)
+{
+  SE3 se3;
+  InlineScopedState<SE3::StateHandle, 8> smallBuffer(&se3);
+  EXPECT_FALSE(smallBuffer.isInline());
+
+  InlineScopedState<SE3::StateHandle, sizeof(SE3::State)> exactBuffer(&se3);
+  EXPECT_TRUE(exactBuffer.isInline());
+  EXPECT_TRUE(
+      exactBuffer.getIsometry().isApprox(Eigen::Isometry3d::Identity()));
+}
@@ -206,3 +206,70 @@ TEST(Rn, PrintStateRx)
   source.setValue(Eigen::Vector4d(0, 1, 2, 3));
   rvss.print(source, std::cout);
 }
+
+//==============================================================================
+TEST(Rn, ComposeBatchR3)
+{
+  R3 rvss;
+
+  // Pack states in an array with some padding between them.
+  constexpr std::size_t stride = 4 * sizeof(double);
+  double values1[8] = {1, 2, 3, 0, 4, 5, 6, 0};
+  double values2[8] = {2, 3, 4, 0, 5, 6, 7, 0};
+  double out[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+  using State = R3::State;
+  rvss.composeBatch(
+      reinterpret_cast<const State*>(values1),
+      stride,
+      reinterpret_cast<const State*>(values2),
+      stride,
+      reinterpret_cast<State*>(out),
+      stride,
+      2);
+
+  EXPECT_TRUE(
+      rvss.getValue(reinterpret_cast<State*>(out))
+          .isApprox(Eigen::Vector3d(3, 5, 7)));
+  EXPECT_TRUE(
+      rvss.getValue(reinterpret_cast<State*>(out + 4))
+          .isApprox(Eigen::Vector3d(9, 11, 13)));
+  EXPECT_EQ(0., out[3]);
+
+  // A stride of zero broadcasts the first input.
+  rvss.composeBatch(
+      reinterpret_cast<const State*>(values1),
+      0,
+      reinterpret_cast<const State*>(values2),
+      stride,
+      reinterpret_cast<State*>(out),
+      stride,
+      2);
+
+  EXPECT_TRUE(
+      rvss.getValue(reinterpret_cast<State*>(out + 4))
+          .isApprox(Eigen::Vector3d(6, 8, 10)));
+}
+
+//==============================================================================
+TEST(Rn, ExpMapLogMapBatchRx)
+{
+  Rn rvss(3);
+
+  Eigen::MatrixXd tangents(3, 4);
+  tangents << 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12;
+
+  std::vector<double> buffer(3 * 4);
+  auto states = reinterpret_cast<Rn::State*>(buffer.data());
+  rvss.expMapBatch(tangents, states, 3 * sizeof(double));
+
+  for (int i = 0; i < 4; ++i)
+  {
+    auto state = reinterpret_cast<Rn::State*>(buffer.data() + 3 * i);
+    EXPECT_TRUE(rvss.getValue(state).isApprox(tangents.col(i)));
+  }
+
+  Eigen::MatrixXd out(3, 4);
+  rvss.logMapBatch(states, 3 * sizeof(double), out);
+  EXPECT_TRUE(out.isApprox(tangents));
+}
@@ -107,3 +107,33 @@ TEST(SO2, PrintState)
   source.setAngle(M_PI);
   so2.print(source, std::cout);
 }
+
+TEST(SO2, BatchOperations)
+{
+  SO2 so2;
+
+  std::vector<SO2::State> states1(3);
+  std::vector<SO2::State> states2(3);
+  std::vector<SO2::State> out(3);
+  constexpr std::size_t stride = sizeof(SO2::State);
+
+  Eigen::MatrixXd tangents(1, 3);
+  tangents << M_PI / 4, M_PI / 3, M_PI / 2;
+  so2.expMapBatch(tangents, states1.data(), stride);
+  so2.expMapBatch(tangents.reverse(), states2.data(), stride);
+
+  for (int i = 0; i < 3; ++i)
+    EXPECT_DOUBLE_EQ(tangents(0, i), states1[i].getAngle());
+
+  so2.composeBatch(
+      states1.data(), stride, states2.data(), stride, out.data(), stride, 3);
+
+  Eigen::MatrixXd outTangents(1, 3);
+  so2.logMapBatch(out.data(), stride, outTangents);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_DOUBLE_EQ(
+        states1[i].getAngle() + states2[i].getAngle(), outTangents(0, i));
+  }
+}
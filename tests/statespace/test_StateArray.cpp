@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SE3.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/statespace/StateArray.hpp>
+
+using aikido::statespace::R3;
+using aikido::statespace::Rn;
+using aikido::statespace::SE3;
+using aikido::statespace::SO2;
+using aikido::statespace::StateArray;
+using aikido::statespace::STATE_ARRAY_BUFFER_SIZE;
+
+TEST(StateArray, StatesAreAligned)
+{
+  SE3 se3;
+  StateArray states(&se3, 5);
+  EXPECT_EQ(5u, states.getSize());
+  EXPECT_EQ(se3.getStateStrideInBytes(), states.getStride());
+  EXPECT_GE(states.getStride(), se3.getStateSizeInBytes());
+  EXPECT_EQ(0u, states.getStride() % alignof(std::max_align_t));
+
+  for (std::size_t i = 0; i < states.getSize(); ++i)
+  {
+    const auto address = reinterpret_cast<std::uintptr_t>(states.getState(i));
+    EXPECT_EQ(0u, address % alignof(std::max_align_t));
+    EXPECT_TRUE(se3.getIsometry(static_cast<SE3::State*>(states.getState(i)))
+                    .isApprox(Eigen::Isometry3d::Identity()));
+  }
+}
+
+TEST(StateArray, SmallArrayIsStoredInline)
+{
+  SO2 so2;
+  const auto capacity = StateArray::getInlineCapacity(&so2);
+  EXPECT_EQ(STATE_ARRAY_BUFFER_SIZE / so2.getStateStrideInBytes(), capacity);
+
+  StateArray states(&so2, capacity);
+  EXPECT_TRUE(states.isInline());
+
+  Eigen::MatrixXd tangents(1, capacity);
+  for (std::size_t i = 0; i < capacity; ++i)
+    tangents(0, i) = 0.01 * i;
+  so2.expMapBatch(tangents, states.getState(0), states.getStride());
+
+  for (std::size_t i = 0; i < capacity; ++i)
+  {
+    EXPECT_DOUBLE_EQ(
+        0.01 * i, so2.getAngle(static_cast<SO2::State*>(states.getState(i))));
+  }
+}
+
+TEST(StateArray, LargeArrayIsStoredOnHeap)
+{
+  R3 r3;
+  StateArray states(&r3, StateArray::getInlineCapacity(&r3) + 1);
+  EXPECT_FALSE(states.isInline());
+
+  StateArray empty(&r3, 0);
+  EXPECT_EQ(0u, empty.getSize());
+  EXPECT_TRUE(empty.isInline());
+}
+
+TEST(StateArray, InlineCapacityIsAtLeastOne)
+{
+  Rn rn(2 * STATE_ARRAY_BUFFER_SIZE / sizeof(double));
+  EXPECT_EQ(1u, StateArray::getInlineCapacity(&rn));
+
+  StateArray states(&rn, 1);
+  EXPECT_FALSE(states.isInline());
+  rn.setValue(
+      static_cast<Rn::State*>(states.getState(0)),
+      Eigen::VectorXd::Ones(rn.getDimension()));
+  EXPECT_EQ(
+      static_cast<double>(rn.getDimension()),
+      rn.getValue(static_cast<Rn::State*>(states.getState(0))).sum());
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/statespace/StatePool.hpp>
+
+using aikido::statespace::CartesianProduct;
+using aikido::statespace::PooledState;
+using aikido::statespace::R3;
+using aikido::statespace::SO2;
+using aikido::statespace::StatePool;
+
+TEST(StatePool, ThrowsOnNullStateSpace)
+{
+  EXPECT_THROW(StatePool(nullptr), std::invalid_argument);
+}
+
+TEST(StatePool, ThrowsOnZeroBlockSize)
+{
+  EXPECT_THROW(StatePool(std::make_shared<SO2>(), 0), std::invalid_argument);
+}
+
+TEST(StatePool, ReusesReleasedStates)
+{
+  StatePool pool(std::make_shared<R3>(), 2);
+  EXPECT_EQ(0u, pool.getCapacity());
+
+  auto state1 = pool.acquireState();
+  EXPECT_EQ(2u, pool.getCapacity());
+  EXPECT_EQ(1u, pool.getNumAvailableStates());
+
+  pool.releaseState(state1);
+  EXPECT_EQ(2u, pool.getNumAvailableStates());
+
+  auto state2 = pool.acquireState();
+  EXPECT_EQ(state1, state2);
+  EXPECT_EQ(2u, pool.getCapacity());
+
+  pool.releaseState(state2);
+}
+
+TEST(StatePool, GrowsWhenExhausted)
+{
+  StatePool pool(std::make_shared<SO2>(), 1);
+
+  auto state1 = pool.acquireState();
+  auto state2 = pool.acquireState();
+  auto state3 = pool.acquireState();
+  EXPECT_NE(state1, state2);
+  EXPECT_NE(state2, state3);
+  EXPECT_LE(3u, pool.getCapacity());
+
+  pool.releaseState(state3);
+  pool.releaseState(state2);
+  pool.releaseState(state1);
+  EXPECT_EQ(pool.getCapacity(), pool.getNumAvailableStates());
+}
+
+TEST(StatePool, Reserve)
+{
+  StatePool pool(std::make_shared<SO2>());
+  pool.reserve(20);
+  EXPECT_EQ(20u, pool.getCapacity());
+  EXPECT_EQ(20u, pool.getNumAvailableStates());
+
+  pool.reserve(10);
+  EXPECT_EQ(20u, pool.getCapacity());
+}
+
+TEST(StatePool, PooledStateInitializesState)
+{
+  auto space = std::make_shared<R3>();
+  StatePool pool(space);
+
+  {
+    PooledState<R3::StateHandle> state(space.get(), &pool);
+    state.setValue(Eigen::Vector3d(1., 2., 3.));
+    EXPECT_EQ(pool.getCapacity() - 1, pool.getNumAvailableStates());
+  }
+  EXPECT_EQ(pool.getCapacity(), pool.getNumAvailableStates());
+
+  // Reused states are reinitialized by allocateStateInBuffer.
+  PooledState<R3::StateHandle> state(space.get(), &pool);
+  EXPECT_TRUE(state.getValue().isZero());
+}
+
+TEST(StatePool, PooledStateThrowsOnMismatchedStateSpace)
+{
+  auto space = std::make_shared<SO2>();
+  SO2 otherSpace;
+  StatePool pool(space);
+
+  EXPECT_THROW(
+      PooledState<SO2::StateHandle>(&otherSpace, &pool), std::invalid_argument);
+}
+
+TEST(StatePool, CreateState)
+{
+  auto space = std::make_shared<CartesianProduct>(
+      std::vector<aikido::statespace::StateSpacePtr>(
+          {std::make_shared<SO2>(), std::make_shared<R3>()}));
+  StatePool pool(space);
+
+  auto state1 = pool.createState();
+  auto state2 = pool.createState();
+  space->getIdentity(state1);
+  space->copyState(state1, state2);
+  EXPECT_EQ(space.get(), state2.getStateSpace());
+
+  auto moved = std::move(state2);
+  EXPECT_EQ(nullptr, state2.getState());
+  EXPECT_NE(nullptr, moved.getState());
+}
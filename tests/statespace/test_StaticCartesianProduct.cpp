@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SE2.hpp>
+#include <aikido/statespace/SE3.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/statespace/SO3.hpp>
+#include <aikido/statespace/StaticCartesianProduct.hpp>
+
+using aikido::statespace::CartesianProduct;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::R2;
+using aikido::statespace::R6;
+using aikido::statespace::SE2;
+using aikido::statespace::SE3;
+using aikido::statespace::SO2;
+using aikido::statespace::SO3;
+using aikido::statespace::StateSpacePtr;
+using aikido::statespace::StaticCartesianProduct;
+
+using StaticSpace = StaticCartesianProduct<R6, SO2, SO3, R2, SE3>;
+
+//==============================================================================
+static std::shared_ptr<CartesianProduct> createDynamicSpace(
+    const StaticSpace& _staticSpace)
+{
+  std::vector<StateSpacePtr> subspaces;
+  for (std::size_t i = 0; i < _staticSpace.getNumSubspaces(); ++i)
+    subspaces.emplace_back(_staticSpace.getSubspace<>(i));
+  return std::make_shared<CartesianProduct>(subspaces);
+}
+
+//==============================================================================
+static void setRandomState(
+    const CartesianProduct& _space, CartesianProduct::State* _state)
+{
+  const Eigen::VectorXd tangent
+      = Eigen::VectorXd::Random(_space.getDimension());
+  _space.expMap(tangent, _state);
+}
+
+//==============================================================================
+static void expectStatesEqual(
+    const CartesianProduct& _space,
+    const CartesianProduct::State* _state1,
+    const CartesianProduct::State* _state2)
+{
+  Eigen::VectorXd tangent1, tangent2;
+  _space.logMap(_state1, tangent1);
+  _space.logMap(_state2, tangent2);
+  EXPECT_TRUE(tangent1.isApprox(tangent2, 1e-12));
+}
+
+TEST(StaticCartesianProduct, CompileTimeConstants)
+{
+  StaticSpace space;
+  auto dynamicSpace = createDynamicSpace(space);
+
+  EXPECT_EQ(5u, StaticSpace::NumSubspacesAtCompileTime);
+  EXPECT_EQ(space.getNumSubspaces(), StaticSpace::NumSubspacesAtCompileTime);
+  EXPECT_EQ(dynamicSpace->getDimension(), StaticSpace::DimensionAtCompileTime);
+  EXPECT_EQ(dynamicSpace->getDimension(), space.getDimension());
+  EXPECT_EQ(
+      dynamicSpace->getStateSizeInBytes(),
+      StaticSpace::StateSizeInBytesAtCompileTime);
+  EXPECT_EQ(dynamicSpace->getStateSizeInBytes(), space.getStateSizeInBytes());
+}
+
+TEST(StaticCartesianProduct, SubspacesMatchCartesianProduct)
+{
+  StaticSpace space;
+
+  EXPECT_EQ(space.getSubspace<R6>(0), space.getStaticSubspace<0>());
+  EXPECT_EQ(space.getSubspace<SO2>(1), space.getStaticSubspace<1>());
+  EXPECT_EQ(space.getSubspace<SE3>(4), space.getStaticSubspace<4>());
+
+  auto state = space.createState();
+  EXPECT_EQ(
+      space.getSubState<SO2>(state, 1), space.getStaticSubState<1>(state));
+  EXPECT_EQ(
+      space.getSubState<R2>(state, 3), space.getStaticSubState<3>(state));
+  EXPECT_EQ(
+      space.getSubState<SE3>(state, 4), space.getStaticSubState<4>(state));
+}
+
+TEST(StaticCartesianProduct, ThrowsOnNullSubspace)
+{
+  using Space = StaticCartesianProduct<R2, SO2>;
+  EXPECT_THROW(
+      Space(std::make_shared<R2>(), nullptr), std::invalid_argument);
+}
+
+TEST(StaticCartesianProduct, MatchesCartesianProduct)
+{
+  auto space = std::make_shared<StaticSpace>();
+  auto dynamicSpace = createDynamicSpace(*space);
+
+  auto s1 = space->createState();
+  auto s2 = space->createState();
+  auto out = space->createState();
+  auto expected = space->createState();
+  setRandomState(*space, s1);
+  setRandomState(*space, s2);
+
+  space->compose(s1, s2, out);
+  dynamicSpace->compose(s1, s2, expected);
+  expectStatesEqual(*dynamicSpace, out, expected);
+
+  space->getInverse(s1, out);
+  dynamicSpace->getInverse(s1, expected);
+  expectStatesEqual(*dynamicSpace, out, expected);
+
+  space->getIdentity(out);
+  dynamicSpace->getIdentity(expected);
+  expectStatesEqual(*dynamicSpace, out, expected);
+
+  space->copyState(s1, out);
+  expectStatesEqual(*dynamicSpace, s1, out);
+
+  const Eigen::VectorXd tangent
+      = Eigen::VectorXd::Random(space->getDimension());
+  space->expMap(tangent, out);
+  dynamicSpace->expMap(tangent, expected);
+  expectStatesEqual(*dynamicSpace, out, expected);
+
+  Eigen::VectorXd staticTangent, dynamicTangent;
+  space->logMap(s1, staticTangent);
+  dynamicSpace->logMap(s1, dynamicTangent);
+  EXPECT_TRUE(staticTangent.isApprox(dynamicTangent));
+}
+
+TEST(StaticCartesianProduct, BatchMatchesCartesianProduct)
+{
+  using Space = StaticCartesianProduct<SE2, R2, SO3, SO2, SE3>;
+  auto space = std::make_shared<Space>();
+
+  std::vector<StateSpacePtr> subspaces;
+  for (std::size_t i = 0; i < space->getNumSubspaces(); ++i)
+    subspaces.emplace_back(space->getSubspace<>(i));
+  auto dynamicSpace = std::make_shared<CartesianProduct>(subspaces);
+
+  constexpr std::size_t numStates = 5;
+  const auto stride = space->getStateStrideInBytes();
+  std::vector<char> buffer1(numStates * stride);
+  std::vector<char> buffer2(numStates * stride);
+  std::vector<char> outBuffer(numStates * stride);
+  std::vector<char> expectedBuffer(numStates * stride);
+  const auto getState = [&](std::vector<char>& _buffer, std::size_t _index) {
+    return reinterpret_cast<CartesianProduct::State*>(
+        _buffer.data() + _index * stride);
+  };
+  for (auto buffer : {&buffer1, &buffer2, &outBuffer, &expectedBuffer})
+  {
+    for (std::size_t i = 0; i < numStates; ++i)
+      space->allocateStateInBuffer(getState(*buffer, i));
+  }
+
+  const Eigen::MatrixXd tangents
+      = Eigen::MatrixXd::Random(space->getDimension(), numStates);
+  space->expMapBatch(tangents, getState(buffer1, 0), stride);
+  space->expMapBatch(
+      Eigen::MatrixXd::Random(space->getDimension(), numStates),
+      getState(buffer2, 0),
+      stride);
+
+  // expMapBatch matches expMap.
+  dynamicSpace->expMapBatch(tangents, getState(expectedBuffer, 0), stride);
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    expectStatesEqual(
+        *dynamicSpace, getState(buffer1, i), getState(expectedBuffer, i));
+  }
+
+  // composeBatch matches compose, including a broadcast first argument.
+  space->composeBatch(
+      getState(buffer1, 0),
+      0,
+      getState(buffer2, 0),
+      stride,
+      getState(outBuffer, 0),
+      stride,
+      numStates);
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    dynamicSpace->compose(
+        getState(buffer1, 0),
+        getState(buffer2, i),
+        getState(expectedBuffer, i));
+    expectStatesEqual(
+        *dynamicSpace, getState(outBuffer, i), getState(expectedBuffer, i));
+  }
+
+  // logMapBatch matches logMap.
+  Eigen::MatrixXd logTangents(space->getDimension(), numStates);
+  space->logMapBatch(getState(outBuffer, 0), stride, logTangents);
+  Eigen::VectorXd expectedTangent;
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    dynamicSpace->logMap(getState(outBuffer, i), expectedTangent);
+    EXPECT_TRUE(logTangents.col(i).isApprox(expectedTangent, 1e-12));
+  }
+
+  Eigen::MatrixXd wrongSize(3, numStates);
+  EXPECT_THROW(
+      space->expMapBatch(wrongSize, getState(buffer1, 0), stride),
+      std::runtime_error);
+  EXPECT_THROW(
+      space->logMapBatch(getState(buffer1, 0), stride, wrongSize),
+      std::invalid_argument);
+  for (auto buffer : {&buffer1, &buffer2, &outBuffer, &expectedBuffer})
+  {
+    for (std::size_t i = numStates; i > 0; --i)
+      space->freeStateInBuffer(getState(*buffer, i - 1));
+  }
+}
+
+TEST(StaticCartesianProduct, ThrowsOnAliasedArguments)
+{
+  StaticSpace space;
+  auto s1 = space.createState();
+  auto s2 = space.createState();
+
+  EXPECT_THROW(space.compose(s1, s2, s1), std::invalid_argument);
+  EXPECT_THROW(space.getInverse(s1, s1), std::invalid_argument);
+}
+
+TEST(StaticCartesianProduct, ThrowsOnIncorrectTangentSize)
+{
+  StaticSpace space;
+  auto state = space.createState();
+
+  EXPECT_THROW(
+      space.expMap(Eigen::VectorXd::Zero(3), state), std::runtime_error);
+}
+
+TEST(StaticCartesianProduct, GeodesicInterpolator)
+{
+  auto space = std::make_shared<StaticCartesianProduct<R2, SO2>>();
+  GeodesicInterpolator interpolator(space);
+
+  auto from = space->createState();
+  from.getSubStateHandle<R2>(0).setValue(Eigen::Vector2d(1., 2.));
+  from.getSubStateHandle<SO2>(1).setAngle(0.);
+
+  auto to = space->createState();
+  to.getSubStateHandle<R2>(0).setValue(Eigen::Vector2d(3., 6.));
+  to.getSubStateHandle<SO2>(1).setAngle(M_PI_2);
+
+  auto out = space->createState();
+  interpolator.interpolate(from, to, 0.5, out);
+
+  EXPECT_TRUE(out.getSubStateHandle<R2>(0).getValue().isApprox(
+      Eigen::Vector2d(2., 4.)));
+  EXPECT_DOUBLE_EQ(M_PI_4, out.getSubStateHandle<SO2>(1).getAngle());
+}
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/trajectory/Spline.hpp>
+
+// Measures the cost of evaluating long cubic spline trajectories, e.g. the
+// output of a retimer, at increasing times as an executor does and at random
+// times.
+
+using aikido::statespace::R6;
+using aikido::trajectory::Spline;
+
+static const int NUM_ITERATIONS = 1000000;
+
+//==============================================================================
+template <class Function>
+static double timeNanoseconds(Function _function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_ITERATIONS; ++i)
+    _function(i);
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count()
+         / NUM_ITERATIONS;
+}
+
+//==============================================================================
+static void benchmark(std::size_t _numSegments)
+{
+  auto space = std::make_shared<R6>();
+  auto startState = space->createState();
+  space->setValue(startState, Eigen::VectorXd::Zero(6));
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> segmentDuration(0.01, 0.02);
+
+  Spline trajectory(space);
+  trajectory.addSegment(
+      Eigen::MatrixXd::Random(6, 4), segmentDuration(rng), startState);
+  for (std::size_t i = 1; i < _numSegments; ++i)
+    trajectory.addSegment(Eigen::MatrixXd::Random(6, 4), segmentDuration(rng));
+
+  const double startTime = trajectory.getStartTime();
+  const double duration = trajectory.getDuration();
+
+  std::uniform_real_distribution<double> distribution(
+      startTime, startTime + duration);
+  std::vector<double> randomTimes(NUM_ITERATIONS);
+  for (auto& t : randomTimes)
+    t = distribution(rng);
+
+  auto out = space->createState();
+  Eigen::VectorXd tangentVector;
+
+  const double sequentialTime = timeNanoseconds([&](int i) {
+    const double t = startTime + duration * i / NUM_ITERATIONS;
+    trajectory.evaluate(t, out);
+  });
+  const double randomTime = timeNanoseconds([&](int i) {
+    trajectory.evaluate(randomTimes[i], out);
+  });
+  const double derivativeTime = timeNanoseconds([&](int i) {
+    const double t = startTime + duration * i / NUM_ITERATIONS;
+    trajectory.evaluateDerivative(t, 1, tangentVector);
+  });
+
+  // Sample positions and velocities at 1 ms, one time at a time and with
+  // evaluateBatch and evaluateDerivativeBatch.
+  const int numSamples = static_cast<int>(duration / 1e-3) + 1;
+  const Eigen::VectorXd times = Eigen::VectorXd::LinSpaced(
+      numSamples, startTime, startTime + duration);
+  Eigen::MatrixXd positions(6, numSamples);
+  Eigen::MatrixXd velocities(6, numSamples);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numSamples; ++i)
+  {
+    trajectory.evaluate(times[i], out);
+    space->logMap(out, tangentVector);
+    positions.col(i) = tangentVector;
+    trajectory.evaluateDerivative(times[i], 1, tangentVector);
+    velocities.col(i) = tangentVector;
+  }
+  const double sampleTime = std::chrono::duration<double, std::nano>(
+                                std::chrono::steady_clock::now() - start)
+                                .count()
+                            / numSamples;
+
+  start = std::chrono::steady_clock::now();
+  trajectory.evaluateBatch(times, positions);
+  trajectory.evaluateDerivativeBatch(times, 1, velocities);
+  const double sampleBatchTime = std::chrono::duration<double, std::nano>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count()
+                                 / numSamples;
+
+  std::cout << _numSegments << " segments:\n"
+            << "  evaluate (sequential):   " << sequentialTime << " ns\n"
+            << "  evaluate (random):       " << randomTime << " ns\n"
+            << "  evaluateDerivative:      " << derivativeTime << " ns\n"
+            << "  sample at 1 ms:          " << sampleTime
+            << " ns per sample\n"
+            << "  sample at 1 ms, batched: " << sampleBatchTime
+            << " ns per sample\n";
+}
+
+//==============================================================================
+int main()
+{
+  benchmark(10);
+  benchmark(2000);
+  benchmark(100000);
+
+  return 0;
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <aikido/statespace/Rn.hpp>
 #include <aikido/trajectory/Interpolated.hpp>
@@ -84,3 +85,168 @@ TEST_F(InterpolatedTest, EvaluateDerivative)
   traj->evaluateDerivative(6, 1, tangentVector);
   EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d(5. / 4, -2. / 4)));
 }
+
+TEST_F(InterpolatedTest, AddWaypointBetweenWaypoints)
+{
+  auto state = rvss->createState();
+  rvss->setValue(state, Eigen::Vector2d(1, 5));
+  traj->addWaypoint(2, state);
+  rvss->setValue(state, Eigen::Vector2d(-2, 0));
+  traj->addWaypoint(0, state);
+  EXPECT_EQ(5u, traj->getNumWaypoints());
+
+  auto istate = rvss->createState();
+  traj->evaluate(0.5, istate);
+  EXPECT_TRUE(rvss->getValue(istate).isApprox(Eigen::Vector2d(-1, 0)));
+
+  traj->evaluate(1.5, istate);
+  EXPECT_TRUE(rvss->getValue(istate).isApprox(Eigen::Vector2d(.5, 2.5)));
+
+  traj->evaluate(2.5, istate);
+  EXPECT_TRUE(rvss->getValue(istate).isApprox(Eigen::Vector2d(2, 4)));
+
+  traj->evaluate(6, istate);
+  EXPECT_TRUE(
+      rvss->getValue(istate).isApprox(
+          Eigen::Vector2d(3 + 5 * 0.75, 3 - 2 * .75)));
+
+  Eigen::VectorXd tangentVector;
+  traj->evaluateDerivative(2.5, 1, tangentVector);
+  EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d(2, -2)));
+}
+
+TEST_F(InterpolatedTest, EvaluateBatch)
+{
+  Eigen::VectorXd times(9);
+  times << -1., 1., 1.5, 2., 3., 6., 7., 8., 2.5;
+
+  Eigen::MatrixXd positions;
+  traj->evaluateBatch(times, positions);
+  ASSERT_EQ(2, positions.rows());
+  ASSERT_EQ(times.size(), positions.cols());
+
+  Eigen::MatrixXd velocities;
+  traj->evaluateDerivativeBatch(times, 1, velocities);
+  ASSERT_EQ(2, velocities.rows());
+  ASSERT_EQ(times.size(), velocities.cols());
+
+  auto state = rvss->createState();
+  Eigen::VectorXd tangentVector;
+  for (int i = 0; i < times.size(); ++i)
+  {
+    traj->evaluate(times[i], state);
+    EXPECT_TRUE(rvss->getValue(state).isApprox(positions.col(i)));
+
+    traj->evaluateDerivative(times[i], 1, tangentVector);
+    EXPECT_TRUE(tangentVector.isApprox(velocities.col(i)));
+  }
+
+  Eigen::MatrixXd accelerations;
+  traj->evaluateDerivativeBatch(times, 2, accelerations);
+  EXPECT_TRUE(accelerations.isZero());
+
+  // More times between two waypoints than are evaluated at once.
+  times = Eigen::VectorXd::LinSpaced(500, 0., 8.);
+  traj->evaluateBatch(times, positions);
+  for (int i = 0; i < times.size(); ++i)
+  {
+    traj->evaluate(times[i], state);
+    EXPECT_TRUE(rvss->getValue(state).isApprox(positions.col(i)));
+  }
+}
+
+TEST_F(InterpolatedTest, SampleUniform)
+{
+  Eigen::MatrixXd positions, velocities, accelerations;
+  const auto times
+      = traj->sampleUniform(0.25, positions, velocities, accelerations);
+
+  ASSERT_EQ(25, times.size());
+  EXPECT_DOUBLE_EQ(1., times[0]);
+  EXPECT_DOUBLE_EQ(7., times[24]);
+  EXPECT_EQ(times.size(), positions.cols());
+  EXPECT_EQ(times.size(), velocities.cols());
+  EXPECT_EQ(times.size(), accelerations.cols());
+
+  EXPECT_TRUE(positions.col(2).isApprox(Eigen::Vector2d(.75, .75)));
+  EXPECT_TRUE(positions.col(24).isApprox(Eigen::Vector2d(8, 1)));
+  EXPECT_TRUE(velocities.col(2).isApprox(Eigen::Vector2d(1.5, 1.5)));
+
+  EXPECT_THROW(
+      traj->sampleUniform(0., positions, velocities, accelerations),
+      std::invalid_argument);
+}
+
+TEST_F(InterpolatedTest, EvaluateManyWaypointsInAnyOrder)
+{
+  // Waypoint i is at time i with value (i, -i).
+  const int numWaypoints = 50;
+  auto trajectory = make_shared<Interpolated>(rvss, interpolator);
+  auto state = rvss->createState();
+  for (int i = 0; i < numWaypoints; ++i)
+  {
+    rvss->setValue(state, Eigen::Vector2d(i, -i));
+    trajectory->addWaypoint(i, state);
+  }
+
+  Eigen::VectorXd tangentVector;
+  const auto expectValue = [&](double _t) {
+    const double clamped = std::min(std::max(_t, 0.), numWaypoints - 1.);
+    trajectory->evaluate(_t, state);
+    EXPECT_TRUE(
+        rvss->getValue(state).isApprox(Eigen::Vector2d(clamped, -clamped)));
+
+    trajectory->evaluateDerivative(_t, 1, tangentVector);
+    if (_t <= 0. || _t > numWaypoints - 1.)
+      EXPECT_TRUE(tangentVector.isZero());
+    else
+      EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d(1., -1.)));
+  };
+
+  for (double t = -1.; t <= numWaypoints + 1.; t += 0.25)
+    expectValue(t);
+
+  for (double t = numWaypoints + 1.; t >= -1.; t -= 0.75)
+    expectValue(t);
+
+  for (int i = 0; i < numWaypoints; ++i)
+    expectValue((i * 37) % numWaypoints + 0.5);
+}
+
+TEST_F(InterpolatedTest, ReserveAndAddWaypointsOutOfOrder)
+{
+  auto trajectory = make_shared<Interpolated>(rvss, interpolator);
+  trajectory->reserve(4);
+
+  const auto getWaypointValue = [&](std::size_t _index) {
+    return rvss->getValue(
+        static_cast<const R2::State*>(trajectory->getWaypoint(_index)));
+  };
+
+  auto state = rvss->createState();
+  for (int i : {4, 0, 2, 6, 1, 5, 3})
+  {
+    rvss->setValue(state, Eigen::Vector2d(i, 2 * i));
+    trajectory->addWaypoint(i, state);
+  }
+
+  ASSERT_EQ(7u, trajectory->getNumWaypoints());
+  for (int i = 0; i < 7; ++i)
+  {
+    EXPECT_DOUBLE_EQ(i, trajectory->getWaypointTime(i));
+    EXPECT_TRUE(getWaypointValue(i).isApprox(Eigen::Vector2d(i, 2 * i)));
+  }
+
+  trajectory->evaluate(2.5, state);
+  EXPECT_TRUE(rvss->getValue(state).isApprox(Eigen::Vector2d(2.5, 5)));
+
+  // Adding a waypoint of the trajectory itself copies it before the
+  // waypoints are moved.
+  trajectory->addWaypoint(-1., trajectory->getWaypoint(6));
+  trajectory->addWaypoint(7., trajectory->getWaypoint(0));
+  EXPECT_TRUE(getWaypointValue(0).isApprox(Eigen::Vector2d(6, 12)));
+  EXPECT_TRUE(getWaypointValue(8).isApprox(Eigen::Vector2d(6, 12)));
+
+  trajectory->evaluate(-0.5, state);
+  EXPECT_TRUE(rvss->getValue(state).isApprox(Eigen::Vector2d(3, 6)));
+}
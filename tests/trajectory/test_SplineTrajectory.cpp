@@ -273,6 +273,53 @@ TEST_F(SplineTest, evaluate_Middle_ReturnsInterpolation)
   EXPECT_TRUE(Vector2d(45.00, 52.00).isApprox(state.getValue()));
 }
 
+TEST_F(SplineTest, evaluate_ManySegments_FindsSegmentInAnyOrder)
+{
+  // Segment i is constant and has duration i + 1, so it starts at
+  // 3 + i * (i + 1) / 2.
+  const std::size_t numSegments = 100;
+  const auto startTime = [](std::size_t _index) {
+    return 3. + 0.5 * _index * (_index + 1);
+  };
+
+  Spline trajectory(mStateSpace, 3.);
+  for (std::size_t i = 0; i < numSegments; ++i)
+  {
+    Eigen::Matrix<double, 2, 1> coefficients(static_cast<double>(i), 0.);
+    trajectory.addSegment(coefficients, i + 1., mStartState);
+  }
+
+  EXPECT_DOUBLE_EQ(startTime(numSegments), trajectory.getEndTime());
+  for (std::size_t i = 0; i <= numSegments; ++i)
+    EXPECT_DOUBLE_EQ(startTime(i), trajectory.getWaypointTime(i));
+
+  auto state = mStateSpace->createState();
+  const auto expectSegment = [&](std::size_t _index, double _t) {
+    trajectory.evaluate(_t, state);
+    EXPECT_DOUBLE_EQ(START_VALUE[0] + _index, state.getValue()[0]);
+  };
+
+  for (std::size_t i = 0; i < numSegments; ++i)
+  {
+    expectSegment(i, startTime(i) + 0.5);
+    expectSegment(i, startTime(i + 1));
+  }
+
+  for (std::size_t i = numSegments; i-- > 0;)
+    expectSegment(i, startTime(i) + 0.5);
+
+  for (std::size_t i = 0; i < numSegments; ++i)
+  {
+    const auto index = (i * 37) % numSegments;
+    expectSegment(index, startTime(index) + 0.5);
+  }
+
+  // Times outside of the trajectory belong to the first or last segment.
+  expectSegment(0, 0.);
+  expectSegment(numSegments - 1, startTime(numSegments) + 1.);
+  expectSegment(numSegments - 1, startTime(numSegments) + 2.);
+}
+
 TEST_F(SplineTest, evaluateDerivative_IsEmpty_Throws)
 {
   Spline trajectory(mStateSpace, 3.);
@@ -354,3 +401,89 @@ TEST_F(SplineTest, EvaluateDerivative_HigherOrder_ReturnsZero)
   trajectory.evaluateDerivative(7.5, 3, tangentVector);
   EXPECT_TRUE(Vector2d::Zero().isApprox(tangentVector));
 }
+
+TEST_F(SplineTest, evaluate_HighDimension_ReturnsPolynomial)
+{
+  auto stateSpace = std::make_shared<Rn>(40);
+  auto startState = stateSpace->createState();
+  const Eigen::VectorXd startValue = Eigen::VectorXd::Random(40);
+  startState.setValue(startValue);
+
+  const Eigen::MatrixXd coefficients = Eigen::MatrixXd::Random(40, 4);
+
+  Spline trajectory(stateSpace, 3.);
+  trajectory.addSegment(coefficients, 2., startState);
+
+  const double t = 1.5;
+  const Eigen::VectorXd expectedValue
+      = startValue + coefficients.col(0) + t * coefficients.col(1)
+        + t * t * coefficients.col(2) + t * t * t * coefficients.col(3);
+
+  auto state = stateSpace->createState();
+  trajectory.evaluate(3. + t, state);
+  EXPECT_TRUE(expectedValue.isApprox(state.getValue()));
+
+  Eigen::VectorXd tangentVector;
+  trajectory.evaluateDerivative(3. + t, 3, tangentVector);
+  EXPECT_TRUE((6. * coefficients.col(3)).isApprox(tangentVector));
+}
+
+TEST_F(SplineTest, evaluateBatch_MatchesEvaluate)
+{
+  Eigen::Matrix<double, 2, 3> coefficients1, coefficients2, coefficients3;
+  coefficients1 << 0., 0., 1., 0., 1., 1.;
+  coefficients2 << 0., 1., 2., 0., 2., 2.;
+  coefficients3 << 0., 2., 3., 0., 3., 3.;
+
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(coefficients1, 1., mStartState);
+  trajectory.addSegment(coefficients2, 2.);
+  trajectory.addSegment(coefficients3, 3.);
+
+  Eigen::VectorXd times(10);
+  times << 2., 3., 3.5, 4., 4.5, 5., 7.5, 9., 10., 3.25;
+
+  Eigen::MatrixXd positions;
+  trajectory.evaluateBatch(times, positions);
+  ASSERT_EQ(2, positions.rows());
+  ASSERT_EQ(times.size(), positions.cols());
+
+  Eigen::MatrixXd velocities, accelerations, jerks;
+  trajectory.evaluateDerivativeBatch(times, 1, velocities);
+  trajectory.evaluateDerivativeBatch(times, 2, accelerations);
+  trajectory.evaluateDerivativeBatch(times, 3, jerks);
+
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+  for (int i = 0; i < times.size(); ++i)
+  {
+    trajectory.evaluate(times[i], state);
+    EXPECT_TRUE(state.getValue().isApprox(positions.col(i)));
+
+    trajectory.evaluateDerivative(times[i], 1, tangentVector);
+    EXPECT_TRUE(tangentVector.isApprox(velocities.col(i)));
+
+    trajectory.evaluateDerivative(times[i], 2, tangentVector);
+    EXPECT_TRUE(tangentVector.isApprox(accelerations.col(i)));
+  }
+  EXPECT_TRUE(jerks.isZero());
+
+  // More times in a segment than are evaluated at once.
+  times = Eigen::VectorXd::LinSpaced(500, 2., 10.);
+  trajectory.evaluateBatch(times, positions);
+  for (int i = 0; i < times.size(); ++i)
+  {
+    trajectory.evaluate(times[i], state);
+    EXPECT_TRUE(state.getValue().isApprox(positions.col(i)));
+  }
+}
+
+TEST_F(SplineTest, evaluateBatch_IsEmpty_Throws)
+{
+  Spline trajectory(mStateSpace, 3.);
+
+  Eigen::MatrixXd positions;
+  EXPECT_THROW(
+      trajectory.evaluateBatch(Eigen::VectorXd::Constant(1, 3.), positions),
+      std::logic_error);
+}